@@ -42,6 +42,8 @@ AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitia
 	StatsBarsWidgetComponent->SetupAttachment(GetRootComponent());
 	StatsBarsWidgetComponent->SetIsReplicated(true);
 	StatsBarsWidgetComponent->SetHiddenInGame(true);
+	StatsBarsWidgetComponent->SetTickMode(ETickMode::Automatic); // Only tick the stats bars while they're rendered
+	StatsBarsWidgetComponent->PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 
@@ -55,7 +57,7 @@ void AEnemy::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 	
-	if (Player && StatsBarsWidgetComponent)
+	if (Player && StatsBarsWidgetComponent && !StatsBarsWidgetComponent->bHiddenInGame)
 	{
 		FVector WidgetRotationVector = Player->GetCameraLocation() - GetActorLocation();
 		FRotator WidgetRotation = FRotator(0, WidgetRotationVector.Rotation().Yaw, 0);
@@ -262,7 +264,7 @@ void AEnemy::WithinPlayerRadiusPeriphery_Implementation(AActor* SourceCharacter,
 	if (Character && Character->IsLocallyControlled())
 	{
 		Player = Character;
-		StatsBarsWidgetComponent->SetHiddenInGame(false);
+		SetStatsBarsVisibility(true);
 
 		// if (AIController)
 		// {
@@ -295,17 +297,27 @@ void AEnemy::OutsideOfPlayerRadiusPeriphery_Implementation(AActor* SourceCharact
 
 	if (Player == SourceCharacter)
 	{
-		StatsBarsWidgetComponent->SetHiddenInGame(true);
+		SetStatsBarsVisibility(false);
 	}
 	else
 	{
 		ACharacterBase* Character = Cast<ACharacterBase>(SourceCharacter);
 		if (Character && Character->IsLocallyControlled())
 		{
-			StatsBarsWidgetComponent->SetHiddenInGame(true);
+			SetStatsBarsVisibility(false);
 		}
 	}
 }
+
+
+void AEnemy::SetStatsBarsVisibility(const bool bVisible)
+{
+	if (!StatsBarsWidgetComponent) return;
+
+	// Hidden stats bars don't need to tick
+	StatsBarsWidgetComponent->SetHiddenInGame(!bVisible);
+	StatsBarsWidgetComponent->SetComponentTickEnabled(bVisible);
+}
 #pragma endregion 
 
 
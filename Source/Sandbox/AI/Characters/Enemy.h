@@ -201,6 +201,9 @@ protected:
 	/** Logic when a character unregisters it within it's periphery */
 	virtual void OutsideOfPlayerRadiusPeriphery_Implementation(AActor* SourceCharacter, EPeripheryType PeripheryType) override;
 
+	/** Shows or hides the stats bars, and only ticks them while they're shown */
+	virtual void SetStatsBarsVisibility(bool bVisible);
+
 
 
 	
@@ -4,7 +4,12 @@
 #include "Sandbox/AI/Characters/Npc.h"
 
 #include "Sandbox/AI/Controllers/AIControllerBase.h"
+#include "Sandbox/AI/Significance/NpcSignificanceSubsystem.h"
+#include "BrainComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Components/SphereComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Perception/AISense_Sight.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Characters/Components/Inventory/InventoryComponent.h"
 #include "Sandbox/Data/Enums/CollisionChannels.h"
@@ -38,6 +43,14 @@ ANpc::ANpc(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitialize
 	Inventory->SetIsReplicated(false);
 
 	AIControllerClass = AAIControllerBase::StaticClass();
+
+	// Significance
+	Significance = ENpcSignificance::Critical;
+	bSightEnabled = true;
+	DefaultVisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	// The mesh only allocates its update rate parameters if they're enabled when it's registered, the significance toggles them afterwards
+	if (GetMesh()) GetMesh()->bEnableUpdateRateOptimizations = !IsRunningDedicatedServer();
 }
 
 
@@ -47,6 +60,25 @@ ANpc::ANpc(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitialize
 void ANpc::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Update less often when the players aren't near
+	if (GetMesh()) DefaultVisibilityBasedAnimTickOption = GetMesh()->VisibilityBasedAnimTickOption;
+	ApplySignificanceSettings(FNpcSignificanceSettings::Get(Significance));
+	if (UNpcSignificanceSubsystem* SignificanceSubsystem = UNpcSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterNpc(this);
+	}
+}
+
+
+void ANpc::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNpcSignificanceSubsystem* SignificanceSubsystem = UNpcSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterNpc(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -131,6 +163,96 @@ TArray<ACharacterBase*>& ANpc::GetCharactersInPeriphery()
 
 
 
+#pragma region Significance
+void ANpc::SetSignificance(const ENpcSignificance NewSignificance, const bool bNewSightEnabled)
+{
+	if (bSightEnabled != bNewSightEnabled)
+	{
+		bSightEnabled = bNewSightEnabled;
+		ApplySightEnabled();
+	}
+	
+	if (Significance == NewSignificance) return;
+
+	if (bDebugCharacterInformation)
+	{
+		UE_LOGFMT(SignificanceLog, Log, "{0}: {1}'s significance changed from {2} to {3}", *UEnum::GetValueAsString(GetLocalRole()), *GetName(), *UEnum::GetValueAsString(Significance), *UEnum::GetValueAsString(NewSignificance));
+	}
+
+	Significance = NewSignificance;
+	ApplySignificanceSettings(FNpcSignificanceSettings::Get(Significance));
+}
+
+
+void ANpc::ApplySignificanceSettings(const FNpcSignificanceSettings& Settings)
+{
+	SetActorTickInterval(Settings.ActorTickInterval);
+
+	if (USkeletalMeshComponent* SkeletalMesh = GetMesh())
+	{
+		SkeletalMesh->SetComponentTickInterval(Settings.AnimationTickInterval);
+		SkeletalMesh->VisibilityBasedAnimTickOption = Settings.bOnlyTickMontagesWhenNotRendered
+			? FMath::Max(DefaultVisibilityBasedAnimTickOption, EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered)
+			: DefaultVisibilityBasedAnimTickOption;
+		
+		// Update rate optimizations handle skipping frames at a distance, this only adjusts how often it updates while it isn't rendered.
+		// Dedicated servers skip animation frames that root motion and hit detection rely on
+		SkeletalMesh->bEnableUpdateRateOptimizations = Settings.bUpdateRateOptimizations && !IsRunningDedicatedServer();
+		if (SkeletalMesh->AnimUpdateRateParams) SkeletalMesh->AnimUpdateRateParams->BaseNonRenderedUpdateRate = Settings.NonRenderedAnimationUpdateRate;
+	}
+
+	// Simulated proxies interpolate towards the replicated movement while they tick, so only the server's simulation is throttled
+	if (UCharacterMovementComponent* MovementComponent = GetCharacterMovement())
+	{
+		MovementComponent->SetComponentTickInterval(HasAuthority() ? Settings.MovementTickInterval : 0.0f);
+	}
+
+	// Only the server has the ai controller
+	AAIController* AIControllerRef = GetController<AAIController>();
+	if (!AIControllerRef) return;
+
+	AIControllerRef->SetActorTickInterval(Settings.AITickInterval);
+	if (UBrainComponent* BrainComponent = AIControllerRef->GetBrainComponent())
+	{
+		BrainComponent->SetComponentTickInterval(Settings.AITickInterval);
+	}
+}
+
+
+void ANpc::ApplySightEnabled()
+{
+	// Only the server has the ai controller
+	const AAIController* AIControllerRef = GetController<AAIController>();
+	UAIPerceptionComponent* PerceptionComponent = AIControllerRef ? AIControllerRef->GetAIPerceptionComponent() : nullptr;
+	if (PerceptionComponent)
+	{
+		PerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), bSightEnabled);
+	}
+}
+
+
+ENpcSignificance ANpc::GetSignificance() const
+{
+	return Significance;
+}
+
+
+bool ANpc::IsSightEnabled() const
+{
+	return bSightEnabled;
+}
+
+
+bool ANpc::IsInCombat() const
+{
+	const AAIControllerBase* AIControllerRef = GetController<AAIControllerBase>();
+	return AIControllerRef && AIControllerRef->IsInCombat();
+}
+#pragma endregion
+
+
+
+
 #pragma region Utility
 F_NpcInformation& ANpc::GetNpcInformation()
 {
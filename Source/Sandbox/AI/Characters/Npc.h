@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Sandbox/Characters/CharacterBase.h"
+#include "Sandbox/Data/Enums/SignificanceTypes.h"
 #include "Sandbox/Data/Structs/NpcInformation.h"
 // #include "Sandbox/Data/Structs/AISenseInformation.h" // Included in Npc Information
 // #include "Sandbox/Data/Structs/InventoryInformation.h" // Included in Npc Information
@@ -13,6 +14,8 @@
 class AAIControllerBase;
 class UDataTable;
 class USphereComponent;
+struct FNpcSignificanceSettings;
+enum class EVisibilityBasedAnimTickOption : uint8;
 
 
 /**
@@ -62,6 +65,9 @@ public:
 protected:
 	/** Called when play begins for this actor. */
 	virtual void BeginPlay() override;
+
+	/** Overridable function called whenever this actor is being removed from a level */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	/** 
 	 * Called when this Pawn is possessed. Only called on the server (or in standalone).
@@ -117,6 +123,46 @@ protected:
 	
 
 	
+//----------------------------------------------------------------------------------------------------------------------//
+// Significance																											//
+//----------------------------------------------------------------------------------------------------------------------//
+protected:
+	/** How significant the npc is to the players, which determines how often it updates. Npcs update every frame until they're scored */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Significance") ENpcSignificance Significance;
+
+	/** Whether the npc perceives with sight. This only depends on the distance to the players and combat, not whether the npc is rendered */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Significance") bool bSightEnabled;
+
+	/** The mesh's visibility based anim tick option before it was adjusted for the significance */
+	EVisibilityBasedAnimTickOption DefaultVisibilityBasedAnimTickOption;
+
+public:
+	/**
+	 * Updates the significance of the npc, and adjusts how often it updates. @ref UNpcSignificanceSubsystem
+	 *
+	 * @param NewSignificance					How significant the npc is to the players, which adjusts the tick intervals
+	 * @param bNewSightEnabled					Whether the npc perceives with sight
+	 */
+	virtual void SetSignificance(ENpcSignificance NewSignificance, bool bNewSightEnabled);
+
+	/** Returns how significant the npc is to the players */
+	UFUNCTION(BlueprintCallable, Category = "Significance") ENpcSignificance GetSignificance() const;
+
+	/** Returns true if the npc perceives with sight */
+	UFUNCTION(BlueprintCallable, Category = "Significance") bool IsSightEnabled() const;
+
+	/** Returns true if the npc is fighting, which keeps it at full significance */
+	UFUNCTION(BlueprintCallable, Category = "Significance") virtual bool IsInCombat() const;
+
+
+protected:
+	/** Adjusts the tick intervals of the npc's actor, mesh, movement and ai to a significance */
+	virtual void ApplySignificanceSettings(const FNpcSignificanceSettings& Settings);
+
+	/** Enables or disables the ai's sight */
+	virtual void ApplySightEnabled();
+
+	
 //-------------------------------------------------------------------------------------//
 // Utility																			   //
 //-------------------------------------------------------------------------------------//
@@ -149,6 +149,7 @@ FRotator AAIControllerBase::GetSpawnRotation() const { return Blackboard->GetVal
 void AAIControllerBase::SetSelfActor(ANpc* SelfActor) { Blackboard->SetValueAsObject(_SpawnLocation, SelfActor); }
 void AAIControllerBase::SetSpawnLocation(const FVector SpawnLocation) { Blackboard->SetValueAsVector(_SpawnLocation, SpawnLocation); }
 void AAIControllerBase::SetSpawnRotation(const FRotator SpawnRotation) { Blackboard->SetValueAsRotator(_SpawnRotation, SpawnRotation); }
+bool AAIControllerBase::IsInCombat() const { return CurrentTarget || (Blackboard && Blackboard->GetValueAsObject(_TargetActor)); }
 
 
 ETeamAttitude::Type AAIControllerBase::GetTeamAttitudeTowards(const AActor& Other) const
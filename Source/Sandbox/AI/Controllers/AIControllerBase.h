@@ -142,6 +142,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI|Character") virtual void SetSelfActor(ANpc* SelfActor);
 	UFUNCTION(BlueprintCallable, Category = "AI|Character") virtual void SetSpawnLocation(FVector SpawnLocation);
 	UFUNCTION(BlueprintCallable, Category = "AI|Character") virtual void SetSpawnRotation(FRotator SpawnRotation);
+
+	/** Returns true if the ai has a target it's fighting */
+	UFUNCTION(BlueprintCallable, Category = "AI|Character") virtual bool IsInCombat() const;
 	
 	/** Retrieved owner attitude toward given Other character */
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
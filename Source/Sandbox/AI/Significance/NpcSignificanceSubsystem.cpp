@@ -0,0 +1,426 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NpcSignificanceSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/AI/Characters/Enemy.h"
+#include "Sandbox/AI/Characters/Npc.h"
+
+DEFINE_LOG_CATEGORY(SignificanceLog);
+
+DECLARE_STATS_GROUP(TEXT("NpcSignificance"), STATGROUP_NpcSignificance, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Update Significance"), STAT_NpcSignificanceUpdate, STATGROUP_NpcSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Critical Npcs"), STAT_CriticalNpcs, STATGROUP_NpcSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Npcs"), STAT_HighNpcs, STATGROUP_NpcSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium Npcs"), STAT_MediumNpcs, STATGROUP_NpcSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Npcs"), STAT_LowNpcs, STATGROUP_NpcSignificance);
+
+
+static TAutoConsoleVariable<bool> CVarSignificance(
+	TEXT("Sandbox.Significance.Enabled"),
+	true,
+	TEXT("Whether npcs update less often when they aren't significant to the players. Disabling this updates every npc every frame")
+);
+
+static TAutoConsoleVariable<float> CVarSignificanceUpdateInterval(
+	TEXT("Sandbox.Significance.UpdateInterval"),
+	0.25f,
+	TEXT("How often in seconds the significance of the npcs is updated")
+);
+
+static TAutoConsoleVariable<float> CVarSignificanceCriticalDistance(
+	TEXT("Sandbox.Significance.CriticalDistance"),
+	1500.0f,
+	TEXT("Npcs within this distance in cm of a player update every frame")
+);
+
+static TAutoConsoleVariable<float> CVarSignificanceHighDistance(
+	TEXT("Sandbox.Significance.HighDistance"),
+	4000.0f,
+	TEXT("Visible npcs within this distance in cm of a player are highly significant")
+);
+
+static TAutoConsoleVariable<float> CVarSignificanceMediumDistance(
+	TEXT("Sandbox.Significance.MediumDistance"),
+	8000.0f,
+	TEXT("Visible npcs within this distance in cm of a player are moderately significant, and npcs further away have a low significance")
+);
+
+static TAutoConsoleVariable<int32> CVarSignificanceForceTier(
+	TEXT("Sandbox.Significance.ForceTier"),
+	-1,
+	TEXT("Forces every npc to a significance (0: Critical, 1: High, 2: Medium, 3: Low). -1 scores the npcs normally")
+);
+
+/** How much further npcs need to be before they move to a lower tier */
+static constexpr float SignificanceHysteresis = 0.1f;
+
+
+const FNpcSignificanceSettings& FNpcSignificanceSettings::Get(const ENpcSignificance Significance)
+{
+	// Actor, animation, update rate optimizations, non rendered animation rate, only tick montages when not rendered, movement, ai, sight
+	static const FNpcSignificanceSettings Settings[static_cast<int32>(ENpcSignificance::Max)] =
+	{
+		{ 0.0f, 0.0f, false, 1, false, 0.0f, 0.0f, true },			// Critical
+		{ 0.0f, 0.0f, true, 1, false, 0.0f, 0.1f, true },			// High
+		{ 0.1f, 0.033f, true, 8, false, 0.033f, 0.25f, true },		// Medium
+		{ 0.5f, 0.1f, true, 16, true, 0.1f, 0.5f, false },			// Low
+	};
+
+	return Settings[FMath::Min(static_cast<int32>(Significance), static_cast<int32>(ENpcSignificance::Low))];
+}
+
+
+
+
+#pragma region Subsystem
+UNpcSignificanceSubsystem::UNpcSignificanceSubsystem()
+{
+	LastUpdateTime = -1;
+	ForcedSignificance = -1;
+}
+
+
+UNpcSignificanceSubsystem* UNpcSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UNpcSignificanceSubsystem>() : nullptr;
+}
+
+
+bool UNpcSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UNpcSignificanceSubsystem::Deinitialize()
+{
+	Npcs.Empty();
+	ViewLocations.Empty();
+	Super::Deinitialize();
+}
+
+
+TStatId UNpcSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNpcSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+
+void UNpcSignificanceSubsystem::Tick(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	if (!World || Npcs.IsEmpty()) return;
+
+	// Disabling significance updates every npc every frame
+	const int32 Forced = CVarSignificance.GetValueOnGameThread() ? CVarSignificanceForceTier.GetValueOnGameThread() : static_cast<int32>(ENpcSignificance::Critical);
+	const double Time = World->GetTimeSeconds();
+	if (Forced == ForcedSignificance && LastUpdateTime >= 0 && Time - LastUpdateTime < CVarSignificanceUpdateInterval.GetValueOnGameThread()) return;
+
+	LastUpdateTime = Time;
+	ForcedSignificance = Forced;
+	UpdateSignificance();
+}
+
+
+void UNpcSignificanceSubsystem::RegisterNpc(ANpc* Npc)
+{
+	if (!Npc || Npcs.Contains(Npc)) return;
+	Npcs.Add(Npc);
+}
+
+
+void UNpcSignificanceSubsystem::UnregisterNpc(ANpc* Npc)
+{
+	Npcs.RemoveSingleSwap(Npc, false);
+}
+
+
+int32 UNpcSignificanceSubsystem::GetNumNpcs() const
+{
+	return Npcs.Num();
+}
+
+
+int32 UNpcSignificanceSubsystem::GetNumNpcs(const ENpcSignificance Significance) const
+{
+	int32 Count = 0;
+	for (const TWeakObjectPtr<ANpc>& Npc : Npcs)
+	{
+		if (Npc.IsValid() && Npc->GetSignificance() == Significance) Count++;
+	}
+
+	return Count;
+}
+#pragma endregion
+
+
+
+
+#pragma region Significance
+void UNpcSignificanceSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_NpcSignificanceUpdate);
+	UpdateViewLocations();
+
+	const bool bForced = ForcedSignificance >= 0 && ForcedSignificance < static_cast<int32>(ENpcSignificance::Max);
+	int32 NumNpcs[static_cast<int32>(ENpcSignificance::Max)] = {};
+	for (int32 Index = Npcs.Num() - 1; Index >= 0; Index--)
+	{
+		ANpc* Npc = Npcs[Index].Get();
+		if (!Npc)
+		{
+			Npcs.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		ENpcSignificance Significance = bForced ? static_cast<ENpcSignificance>(ForcedSignificance) : CalculateSignificance(Npc);
+		if (!bForced && Significance > Npc->GetSignificance())
+		{
+			Significance = FMath::Max(Npc->GetSignificance(), CalculateSignificance(Npc, true));
+		}
+
+		const bool bSightEnabled = bForced
+			? FNpcSignificanceSettings::Get(Significance).bSightEnabled
+			: CalculateSightEnabled(GetViewDistance(Npc), Npc->IsInCombat(), Npc->IsSightEnabled());
+
+		Npc->SetSignificance(Significance, bSightEnabled);
+		NumNpcs[static_cast<int32>(Significance)]++;
+	}
+
+	SET_DWORD_STAT(STAT_CriticalNpcs, NumNpcs[static_cast<int32>(ENpcSignificance::Critical)]);
+	SET_DWORD_STAT(STAT_HighNpcs, NumNpcs[static_cast<int32>(ENpcSignificance::High)]);
+	SET_DWORD_STAT(STAT_MediumNpcs, NumNpcs[static_cast<int32>(ENpcSignificance::Medium)]);
+	SET_DWORD_STAT(STAT_LowNpcs, NumNpcs[static_cast<int32>(ENpcSignificance::Low)]);
+}
+
+
+ENpcSignificance UNpcSignificanceSubsystem::CalculateSignificance(const ANpc* Npc, const bool bDropTier) const
+{
+	if (!Npc) return ENpcSignificance::Low;
+
+	// Dedicated servers don't render, so every npc is treated as visible
+	const bool bVisible = GetWorld()->GetNetMode() == NM_DedicatedServer || Npc->WasRecentlyRendered(0.2f);
+	return CalculateSignificanceTier(GetViewDistance(Npc), bVisible, Npc->IsInCombat(), bDropTier);
+}
+
+
+double UNpcSignificanceSubsystem::GetViewDistance(const ANpc* Npc) const
+{
+	if (!Npc || ViewLocations.IsEmpty()) return TNumericLimits<double>::Max();
+
+	const FVector Location = Npc->GetActorLocation();
+	double DistanceSquared = TNumericLimits<double>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Location, ViewLocation));
+	}
+
+	return FMath::Sqrt(DistanceSquared);
+}
+
+
+ENpcSignificance UNpcSignificanceSubsystem::CalculateSignificanceTier(const double Distance, const bool bVisible, const bool bInCombat, const bool bDropTier)
+{
+	if (bInCombat) return ENpcSignificance::Critical;
+
+	const float Scale = bDropTier ? 1.f + SignificanceHysteresis : 1.f;
+	if (Distance <= CVarSignificanceCriticalDistance.GetValueOnGameThread() * Scale) return ENpcSignificance::Critical;
+
+	int32 Significance = static_cast<int32>(ENpcSignificance::Low);
+	if (Distance <= CVarSignificanceHighDistance.GetValueOnGameThread() * Scale) Significance = static_cast<int32>(ENpcSignificance::High);
+	else if (Distance <= CVarSignificanceMediumDistance.GetValueOnGameThread() * Scale) Significance = static_cast<int32>(ENpcSignificance::Medium);
+
+	// Npcs that aren't visible drop a tier
+	if (!bVisible) Significance = FMath::Min(Significance + 1, static_cast<int32>(ENpcSignificance::Low));
+
+	return static_cast<ENpcSignificance>(Significance);
+}
+
+
+bool UNpcSignificanceSubsystem::CalculateSightEnabled(const double Distance, const bool bInCombat, const bool bSightEnabled)
+{
+	// The tier the npc would be in if it was visible, npcs keep their sight until they're a bit further than the distance that enabled it
+	return FNpcSignificanceSettings::Get(CalculateSignificanceTier(Distance, true, bInCombat, bSightEnabled)).bSightEnabled;
+}
+
+
+void UNpcSignificanceSubsystem::UpdateViewLocations()
+{
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!PlayerController) continue;
+
+		if (PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+		{
+			ViewLocations.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+		}
+		else if (const APawn* Pawn = PlayerController->GetPawn())
+		{
+			ViewLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+}
+#pragma endregion
+
+
+
+
+#pragma region Benchmark
+#if !UE_BUILD_SHIPPING
+/** The frames each phase of the benchmark waits for the npcs to settle before they're timed */
+static constexpr int32 BenchmarkWarmupFrames = 10;
+
+/** A benchmark of the game thread time spent on npcs at each significance */
+struct FNpcSignificanceBenchmark
+{
+	TWeakObjectPtr<UWorld> World;
+	TSubclassOf<ANpc> NpcClass;
+	int32 NumNpcs = 0;
+	int32 FramesPerPhase = 0;
+
+	/** -1 is the baseline without any npcs, afterwards it's the significance the npcs are forced to */
+	int32 Phase = -1;
+	int32 Frame = 0;
+
+	/** The cycles of the current world tick, and of every timed frame in the phase */
+	uint64 TickStartCycles = 0;
+	uint64 PhaseCycles = 0;
+
+	/** The average milliseconds of the world tick in each phase */
+	double Results[static_cast<int32>(ENpcSignificance::Max) + 1] = {};
+
+	TArray<TWeakObjectPtr<ANpc>> SpawnedNpcs;
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle PostActorTickHandle;
+};
+
+static FNpcSignificanceBenchmark Benchmark;
+
+
+static void StopSignificanceBenchmark()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(Benchmark.TickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(Benchmark.PostActorTickHandle);
+	Benchmark.TickStartHandle.Reset();
+	Benchmark.PostActorTickHandle.Reset();
+
+	for (const TWeakObjectPtr<ANpc>& Npc : Benchmark.SpawnedNpcs)
+	{
+		if (!Npc.IsValid()) continue;
+		if (AController* Controller = Npc->GetController()) Controller->Destroy();
+		Npc->Destroy();
+	}
+
+	Benchmark.SpawnedNpcs.Empty();
+	CVarSignificanceForceTier->Set(-1, ECVF_SetByCode);
+}
+
+
+static void SpawnBenchmarkNpcs(UWorld* World)
+{
+	// Spawn the npcs in a grid around the player, or the center of the world
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const FVector Origin = PlayerController && PlayerController->GetPawn() ? PlayerController->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+	const int32 Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Benchmark.NumNpcs)));
+	const float Spacing = 300.f;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 Index = 0; Index < Benchmark.NumNpcs; Index++)
+	{
+		const FVector Offset((Index % Columns - Columns / 2) * Spacing, (Index / Columns - Columns / 2) * Spacing, 0);
+		ANpc* Npc = World->SpawnActor<ANpc>(Benchmark.NpcClass, Origin + Offset, FRotator::ZeroRotator, SpawnParameters);
+		if (!Npc) continue;
+
+		if (!Npc->GetController()) Npc->SpawnDefaultController();
+		Benchmark.SpawnedNpcs.Add(Npc);
+	}
+}
+
+
+static void OnBenchmarkTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == Benchmark.World.Get()) Benchmark.TickStartCycles = FPlatformTime::Cycles64();
+}
+
+
+static void OnBenchmarkPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != Benchmark.World.Get() || !Benchmark.TickStartCycles) return;
+
+	Benchmark.Frame++;
+	if (Benchmark.Frame > BenchmarkWarmupFrames) Benchmark.PhaseCycles += FPlatformTime::Cycles64() - Benchmark.TickStartCycles;
+	if (Benchmark.Frame < BenchmarkWarmupFrames + Benchmark.FramesPerPhase) return;
+
+	Benchmark.Results[Benchmark.Phase + 1] = FPlatformTime::ToMilliseconds64(Benchmark.PhaseCycles) / Benchmark.FramesPerPhase;
+	Benchmark.Phase++;
+	Benchmark.Frame = 0;
+	Benchmark.PhaseCycles = 0;
+
+	if (Benchmark.Phase == 0)
+	{
+		SpawnBenchmarkNpcs(World);
+	}
+
+	if (Benchmark.Phase < static_cast<int32>(ENpcSignificance::Max))
+	{
+		CVarSignificanceForceTier->Set(Benchmark.Phase, ECVF_SetByCode);
+		return;
+	}
+
+	const int32 NumNpcs = FMath::Max(Benchmark.SpawnedNpcs.Num(), 1);
+	UE_LOGFMT(SignificanceLog, Display, "Significance benchmark: {0} {1}, {2} frames per tier. Baseline world tick: {3}ms",
+		Benchmark.SpawnedNpcs.Num(), *GetNameSafe(Benchmark.NpcClass), Benchmark.FramesPerPhase, Benchmark.Results[0]);
+	for (int32 Significance = 0; Significance < static_cast<int32>(ENpcSignificance::Max); Significance++)
+	{
+		const double TickTime = Benchmark.Results[Significance + 1];
+		UE_LOGFMT(SignificanceLog, Display, "  {0}: world tick {1}ms, {2}us per npc",
+			*UEnum::GetDisplayValueAsText(static_cast<ENpcSignificance>(Significance)).ToString(), TickTime, (TickTime - Benchmark.Results[0]) * 1000.0 / NumNpcs);
+	}
+
+	StopSignificanceBenchmark();
+}
+
+
+static void RunSignificanceBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->IsGameWorld()) return;
+	if (Benchmark.TickStartHandle.IsValid()) StopSignificanceBenchmark();
+
+	Benchmark = FNpcSignificanceBenchmark();
+	Benchmark.World = World;
+	Benchmark.NumNpcs = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+	Benchmark.FramesPerPhase = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 300;
+	Benchmark.NpcClass = AEnemy::StaticClass();
+	if (Args.Num() > 2)
+	{
+		Benchmark.NpcClass = LoadClass<ANpc>(nullptr, *Args[2]);
+		if (!Benchmark.NpcClass)
+		{
+			UE_LOGFMT(SignificanceLog, Error, "{0}() {1} isn't an npc class", *FString(__FUNCTION__), *Args[2]);
+			return;
+		}
+	}
+
+	Benchmark.TickStartHandle = FWorldDelegates::OnWorldTickStart.AddStatic(&OnBenchmarkTickStart);
+	Benchmark.PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&OnBenchmarkPostActorTick);
+	UE_LOGFMT(SignificanceLog, Display, "{0}() Timing {1} {2} for {3} frames at each significance", *FString(__FUNCTION__), Benchmark.NumNpcs, *GetNameSafe(Benchmark.NpcClass), Benchmark.FramesPerPhase);
+}
+
+
+static FAutoConsoleCommandWithWorldAndArgs SignificanceBenchmarkCommand(
+	TEXT("Sandbox.Significance.Benchmark"),
+	TEXT("Spawns npcs, forces them to each significance and logs the world tick time per npc. Runs headless (-nullrhi -ExecCmds). Sandbox.Significance.Benchmark [Count = 100] [Frames = 300] [NpcClass]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunSignificanceBenchmark)
+);
+#endif
+#pragma endregion
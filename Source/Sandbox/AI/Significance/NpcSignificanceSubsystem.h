@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sandbox/Data/Enums/SignificanceTypes.h"
+#include "NpcSignificanceSubsystem.generated.h"
+
+class ANpc;
+
+DECLARE_LOG_CATEGORY_EXTERN(SignificanceLog, Log, All);
+
+
+/**
+ * How often an npc character's actor, animation, movement and ai update at a significance
+ */
+struct SANDBOX_API FNpcSignificanceSettings
+{
+	/** The tick interval of the character, 0 ticks every frame */
+	float ActorTickInterval = 0;
+
+	/** The tick interval of the character's mesh, which updates the animation */
+	float AnimationTickInterval = 0;
+
+	/** Whether the mesh's update rate optimizations skip animation frames at a distance. Dedicated servers never use them. @ref USkinnedMeshComponent::bEnableUpdateRateOptimizations */
+	bool bUpdateRateOptimizations = true;
+
+	/** How many frames the animation skips while the mesh isn't rendered, 1 updates every frame. @ref FAnimUpdateRateParameters::BaseNonRenderedUpdateRate */
+	int32 NonRenderedAnimationUpdateRate = 4;
+
+	/** Only ticks montages while the mesh isn't rendered, unless the mesh is already set to tick less */
+	bool bOnlyTickMontagesWhenNotRendered = false;
+
+	/** The tick interval of the character's movement on the server. Clients smooth the replicated movement every frame */
+	float MovementTickInterval = 0;
+
+	/** The tick interval of the ai controller and it's behavior tree */
+	float AITickInterval = 0;
+
+	/** Whether the ai perceives with sight. Hearing and damage are always perceived. @ref UNpcSignificanceSubsystem::CalculateSightEnabled */
+	bool bSightEnabled = true;
+
+	/** Returns the settings of a significance */
+	static const FNpcSignificanceSettings& Get(ENpcSignificance Significance);
+
+};
+
+
+/**
+ * Scores npc characters by how significant they are to the players, and reduces the update rates of the ones that aren't. @ref ANpc::SetSignificance \n\n
+ *
+ * Each update finds the distance from every npc to the closest player, whether it was recently rendered, and whether it's in combat, and places it in a significance tier.
+ *	- Npcs in combat or right next to a player are always critical, and update every frame
+ *	- Npcs that aren't visible drop a tier. Dedicated servers don't render, so they only use the distance and combat state
+ *	- Sight only uses the distance and combat state. Rendering is only known for the host's view, and other players can still be watching the npc
+ *	- Npcs only move to a lower tier once they're a bit further than the distance that moved them up, so they don't switch back and forth on the edge of a tier
+ *	- Npcs register themselves on BeginPlay and unregister on EndPlay
+ *	- Tuned with the Sandbox.Significance console variables, and Sandbox.Significance.Benchmark times the npcs at each tier in non shipping builds
+ *	- The Sandbox.AI.Significance automation tests check the tiers
+ */
+UCLASS()
+class SANDBOX_API UNpcSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The registered npcs */
+	TArray<TWeakObjectPtr<ANpc>> Npcs;
+
+	/** The locations of the players the npcs are scored against */
+	TArray<FVector> ViewLocations;
+
+	/** The time of the last update */
+	double LastUpdateTime;
+
+	/** The significance every npc was forced to during the last update, or -1 */
+	int32 ForcedSignificance;
+
+
+public:
+	UNpcSignificanceSubsystem();
+
+	/** Retrieves the significance subsystem of the world */
+	static UNpcSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Only game worlds have npcs to score */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Clears the npcs */
+	virtual void Deinitialize() override;
+
+	/** Updates the significance of the npcs when it's time for another update */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Starts scoring an npc */
+	virtual void RegisterNpc(ANpc* Npc);
+
+	/** Stops scoring an npc */
+	virtual void UnregisterNpc(ANpc* Npc);
+
+	/**
+	 * Calculates how significant an npc is to the players
+	 *
+	 * @param Npc								The npc character
+	 * @param bDropTier							Whether the npc is moving to a lower tier, which uses slightly further distances
+	 * @returns									The npc's significance
+	 */
+	virtual ENpcSignificance CalculateSignificance(const ANpc* Npc, bool bDropTier = false) const;
+
+	/** Returns the distance from an npc to the closest player */
+	virtual double GetViewDistance(const ANpc* Npc) const;
+
+	/**
+	 * Places an npc in a significance tier
+	 *
+	 * @param Distance							The distance from the npc to the closest player
+	 * @param bVisible							Whether the npc was recently rendered
+	 * @param bInCombat							Whether the npc is fighting
+	 * @param bDropTier							Whether the npc is moving to a lower tier, which uses slightly further distances
+	 * @returns									The npc's significance
+	 */
+	static ENpcSignificance CalculateSignificanceTier(double Distance, bool bVisible, bool bInCombat, bool bDropTier = false);
+
+	/**
+	 * Whether an npc perceives with sight. Only the distance and combat state are used, so npcs the host isn't rendering can still see the other players
+	 *
+	 * @param Distance							The distance from the npc to the closest player
+	 * @param bInCombat							Whether the npc is fighting
+	 * @param bSightEnabled						Whether the npc's sight is currently enabled, which uses slightly further distances before disabling it
+	 * @returns									Whether the npc's sight is enabled
+	 */
+	static bool CalculateSightEnabled(double Distance, bool bInCombat, bool bSightEnabled = false);
+
+	/** Returns the amount of registered npcs */
+	int32 GetNumNpcs() const;
+
+	/** Returns the amount of registered npcs at a significance */
+	int32 GetNumNpcs(ENpcSignificance Significance) const;
+
+
+protected:
+	/** Updates the significance of every registered npc, and removes the npcs that are no longer valid */
+	virtual void UpdateSignificance();
+
+	/** Finds the locations of the players. Local players use their camera, and remote players use their pawn */
+	virtual void UpdateViewLocations();
+
+
+};
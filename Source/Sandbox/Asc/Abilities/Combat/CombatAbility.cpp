@@ -180,6 +180,13 @@ void UCombatAbility::CalculateAttributeModifications_Implementation()
 	// Weapon damage and attribute calculations
 	const F_ArmamentInformation& ArmamentInformation = Armament->GetArmamentInformation();
 	AttackInfo = bUseTestCombatInformation ? TestDamageStats : ArmamentInformation.BaseDamageStats;
+	CompileAttackPayload();
+}
+
+
+void UCombatAbility::CompileAttackPayload()
+{
+	AttackPayload = FAttackPayload::Compile(AttackInfo);
 }
 #pragma endregion 
 
@@ -222,14 +229,6 @@ void UCombatAbility::HandleMeleeAttack(const FGameplayAbilityTargetDataHandle& T
 		return;
 	}
 	
-	const UMMOAttributeSet* AttributeSet = Cast<UMMOAttributeSet>(AbilitySystem->GetAttributeSet(UMMOAttributeSet::StaticClass()));
-	if (!AttributeSet)
-	{
-		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() Something happened to the ({2})'s attribute set while trying to handle a melee attack",
-			*UEnum::GetValueAsString(GetOwningActorFromActorInfo()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwningActorFromActorInfo()));
-		return;
-	}
-	
 	AActor* TargetCharacter = TargetAsc->GetAvatarActor();
 	if (!TargetCharacter)
 	{
@@ -271,30 +270,16 @@ void UCombatAbility::HandleMeleeAttack(const FGameplayAbilityTargetDataHandle& T
 	// Custom gameplay effect information. Modifying gameplay effect spec is valid, but dangerous when retrieving the owning spec for pre execute -> /* Non const access. Be careful with this, especially when modifying a spec after attribute capture. */
 	// ValidTransientAggregatorIdentifiers -> The ExecutionCalculation reads this value in using special capture functions similar to the Attribute capture functions. (ExecutionParams.AttemptCalculateTransientAggregatorMagnitude())
 	
-	// We're just going to use attributes, valid client side prediction attack calculations, and if we need any other information let's just use the custom gameplay effect
-	UMMOAttributeSet* Attributes = const_cast<UMMOAttributeSet*>(AttributeSet);
-	if (Attributes)
+	// The attack's damages are sent as SetByCallers. Compile them for every hit, in case the attack information was calculated or adjusted in blueprints
+	CompileAttackPayload();
+	if (AttackPayload.IsEmpty())
 	{
-		if (AttackInfo.Contains(Attributes->GetDamage_StandardAttribute())) Attributes->SetDamage_Standard(AttackInfo[Attributes->GetDamage_StandardAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_SlashAttribute())) Attributes->SetDamage_Slash(AttackInfo[Attributes->GetDamage_SlashAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_PierceAttribute())) Attributes->SetDamage_Pierce(AttackInfo[Attributes->GetDamage_PierceAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_StrikeAttribute())) Attributes->SetDamage_Strike(AttackInfo[Attributes->GetDamage_StrikeAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_PoiseAttribute())) Attributes->SetDamage_Poise(AttackInfo[Attributes->GetDamage_PoiseAttribute()]);
-
-		if (AttackInfo.Contains(Attributes->GetDamage_MagicAttribute())) Attributes->SetDamage_Magic(AttackInfo[Attributes->GetDamage_MagicAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_IceAttribute())) Attributes->SetDamage_Ice(AttackInfo[Attributes->GetDamage_IceAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_FireAttribute())) Attributes->SetDamage_Fire(AttackInfo[Attributes->GetDamage_FireAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_HolyAttribute())) Attributes->SetDamage_Holy(AttackInfo[Attributes->GetDamage_HolyAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetDamage_LightningAttribute())) Attributes->SetDamage_Lightning(AttackInfo[Attributes->GetDamage_LightningAttribute()]);
-		
-		if (AttackInfo.Contains(Attributes->GetBleedAttribute())) Attributes->SetBleed(AttackInfo[Attributes->GetBleedAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetPoisonAttribute())) Attributes->SetPoison(AttackInfo[Attributes->GetPoisonAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetFrostbiteAttribute())) Attributes->SetFrostbite(AttackInfo[Attributes->GetFrostbiteAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetCurseAttribute())) Attributes->SetCurse(AttackInfo[Attributes->GetCurseAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetMadnessAttribute())) Attributes->SetMadness(AttackInfo[Attributes->GetMadnessAttribute()]);
-		if (AttackInfo.Contains(Attributes->GetSleepAttribute())) Attributes->SetSleep(AttackInfo[Attributes->GetSleepAttribute()]);
+		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s attack information for {3} doesn't have any damage, the attack won't deal damage!",
+			*UEnum::GetValueAsString(GetOwningActorFromActorInfo()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwningActorFromActorInfo()), *GetNameSafe(Armament));
 	}
 	
+	AttackPayload.ApplyToSpec(*ExecCalcHandle.Data.Get());
+	
 	// Create the execution calculation and add any additional information to the handle
 	const FGameplayEffectSpec* ExecCalc = ExecCalcHandle.Data.Get();
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Sandbox/Asc/Abilities/CharacterGameplayAbility.h"
+#include "Sandbox/Asc/Information/AttackPayload.h"
 #include "Sandbox/Data/Structs/CombatInformation.h"
 #include "CombatAbility.generated.h"
 
@@ -40,6 +41,9 @@ protected:
 	/** The attack information (damages and any other attribute modifications) for the armament, */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Combat") TMap<FGameplayAttribute, float> AttackInfo;
 
+	/** The attack information compiled for the damage calculation. Compiled from the attack information for every hit, so changes to the attack information during the attack are sent */
+	FAttackPayload AttackPayload;
+
 	/** The default montage section used when a combat montage is activated */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat") FName DefaultMontageSection;
 	
@@ -110,6 +114,10 @@ protected:
 	virtual void CalculateAttributeModifications_Implementation();
 
 
+	/** Compiles the attack information into the attack payload. Every hit compiles it before it's sent to the damage calculation */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Combat") virtual void CompileAttackPayload();
+
+
 protected:
 	/**
 	 * Handles melee attack target data and creating an exec calc effect context to pass to damage calculations
@@ -152,9 +152,16 @@ void UMeleeAttack::ActivateAbility(const FGameplayAbilitySpecHandle Handle, cons
 		else if (!IsRightHandAbility()) TracedWeapons.Add(CombatComponent->GetArmament(false));
 		else TracedWeapons.Add(CombatComponent->GetArmament());
 		
-		MeleeOverlapHandle = UAbilityTask_TargetOverlap::CreateOverlapDataTask(this, TracedWeapons);
+		MeleeOverlapHandle = UAbilityTask_TargetOverlap::CreateOverlapDataTask(this, TracedWeapons, TraceSettings);
 		MeleeOverlapHandle->OnValidOverlap.AddDynamic(this, &UMeleeAttack::OnOverlappedTarget);
 		// MeleeOverlapHandle->ReadyForActivation(); // During attack frames
+
+		// Roll back the hits the server rejects. The last attack's binding might still be waiting on the server
+		UAbilitySystem* AbilitySystem = Cast<UAbilitySystem>(GetAbilitySystemComponentFromActorInfo());
+		if (IsPredictingClient() && AbilitySystem && !PredictedHitsRejectedHandle.IsValid())
+		{
+			PredictedHitsRejectedHandle = AbilitySystem->OnPredictedHitsRejected.AddUObject(this, &UMeleeAttack::OnPredictedHitsRejected);
+		}
 	}
 }
 
@@ -189,13 +196,55 @@ void UMeleeAttack::OnEndAttackFrames_Implementation(bool bRightHand)
 	{
 		if (MeleeOverlapHandle && PrimaryAttackState == EAttackFramesState::Finished && SecondaryAttackState == EAttackFramesState::Finished)
 		{
-			MeleeOverlapHandle->EndTask();
+			MeleeOverlapHandle->FinishAttackFrames();
 		}
 	}
 	else if (MeleeOverlapHandle)
 	{
-		MeleeOverlapHandle->EndTask();
+		MeleeOverlapHandle->FinishAttackFrames();
+	}
+}
+
+
+void UMeleeAttack::OnPredictedHitsRejected(const FPredictionKey& PredictionKey, const TArray<AActor*>& Targets)
+{
+	// The server handled the last attack's hits
+	const bool bPendingHits = PendingHitsPredictionKey.IsValidKey() && PredictionKey.Current == PendingHitsPredictionKey.Current;
+	if (bPendingHits && !IsActive())
+	{
+		StopRollingBackPredictedHits();
+	}
+
+	// Rejections from the last attack don't affect the targets of the current one
+	if (bPendingHits && IsActive()) return;
+
+	for (AActor* Target : Targets)
+	{
+		PrimaryHitActors.RemoveSingleSwap(Target, false);
+		SecondaryHitActors.RemoveSingleSwap(Target, false);
+	}
+}
+
+
+void UMeleeAttack::OnPendingHitsPredictionKeyResolved(const int16 PredictionKey)
+{
+	// Another attack is waiting on its own hits
+	if (IsActive() || PredictionKey != PendingHitsPredictionKey.Current) return;
+
+	StopRollingBackPredictedHits();
+}
+
+
+void UMeleeAttack::StopRollingBackPredictedHits()
+{
+	UAbilitySystem* AbilitySystem = Cast<UAbilitySystem>(GetAbilitySystemComponentFromActorInfo());
+	if (AbilitySystem && PredictedHitsRejectedHandle.IsValid())
+	{
+		AbilitySystem->OnPredictedHitsRejected.Remove(PredictedHitsRejectedHandle);
 	}
+
+	PredictedHitsRejectedHandle.Reset();
+	PendingHitsPredictionKey = FPredictionKey();
 }
 
 
@@ -209,5 +258,17 @@ void UMeleeAttack::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGa
 	if (AttackFramesHandle) AttackFramesHandle->EndTask();
 	if (MeleeOverlapHandle) MeleeOverlapHandle->EndTask();
 
+	// The server can still reject the hits that were just sent, keep rolling them back until it's handled their prediction key
+	FPredictionKey HitsPredictionKey = MeleeOverlapHandle ? MeleeOverlapHandle->GetTargetDataPredictionKey() : FPredictionKey();
+	if (PredictedHitsRejectedHandle.IsValid() && HitsPredictionKey.IsValidKey())
+	{
+		PendingHitsPredictionKey = HitsPredictionKey;
+		HitsPredictionKey.NewRejectOrCaughtUpDelegate(FPredictionKeyEvent::CreateUObject(this, &UMeleeAttack::OnPendingHitsPredictionKeyResolved, HitsPredictionKey.Current));
+	}
+	else
+	{
+		StopRollingBackPredictedHits();
+	}
+
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
@@ -29,9 +29,18 @@ protected: // TODO: Either adjust the ability task limit, or create additional t
 	UPROPERTY(BlueprintReadWrite) UAbilityTask_WaitInputRelease* InputReleasedHandle;
 
 	/**** Attack trace logic ****/
+	/** How the armaments trace for targets during the attack frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability|Combat|Attack Frames") F_MeleeTraceSettings TraceSettings;
+	
 	/** The handle that traces for overlaps during the attack animation */
 	UPROPERTY(BlueprintReadWrite) UAbilityTask_TargetOverlap* MeleeOverlapHandle;
 
+	/** The predicting client's binding for when the server rejects the attack's hits. It stays bound after the attack ends until the server has handled the hits */
+	FDelegateHandle PredictedHitsRejectedHandle;
+
+	/** The prediction key of the hits from the last attack that the server hasn't handled yet */
+	FPredictionKey PendingHitsPredictionKey;
+
 	// I don't want to add tags to the character's state, attack frames are specific to the attack
 	/** The handle for the beginning and ending of attack frames logic */
 	UPROPERTY(BlueprintReadWrite) UAbilityTask_WaitGameplayEvent* AttackFramesHandle;
@@ -82,6 +91,20 @@ protected:
 	 */
 	virtual void OnEndAttackFrames_Implementation(bool bRightHand) override;
 
+	/**
+	 * Rolls back the predicted hits on targets that the server rejected, so they can be hit again during this attack
+	 *
+	 * @param PredictionKey						The prediction key the hits were sent with
+	 * @param Targets							The targets of the rejected hits
+	 */
+	virtual void OnPredictedHitsRejected(const FPredictionKey& PredictionKey, const TArray<AActor*>& Targets);
+
+	/** Stops rolling back the last attack's hits once the server has caught up to or rejected their prediction key */
+	virtual void OnPendingHitsPredictionKeyResolved(int16 PredictionKey);
+
+	/** Unbinds the rollback of predicted hits */
+	virtual void StopRollingBackPredictedHits();
+
 	
 	/** This is a delegate binding for gameplay event information that's sent to this character during this task */
 	UFUNCTION(BlueprintCallable) virtual void OnEndOfMontage();
@@ -393,6 +393,7 @@ void UMeleeCombatAbility::CalculateAttributeModifications_Implementation()
 
 	// TODO: Add a function from the combat component that handles attribute adjustments based on the weapon stats, current attack, and armament stance
 	
+	CompileAttackPayload();
 }
 #pragma endregion
 
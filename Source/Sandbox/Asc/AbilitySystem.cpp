@@ -4,6 +4,7 @@
 #include "AbilitySystem.h"
 
 #include "EnhancedInputComponent.h"
+#include "GameplayCueManager.h"
 #include "Logging/StructuredLog.h"
 
 DEFINE_LOG_CATEGORY(AbilityLog);
@@ -293,6 +294,60 @@ TArray<FGameplayAbilitySpecHandle> UAbilitySystem::AddAbilities(TArray<FGameplay
 }
 
 
+TArray<FGameplayAbilitySpecHandle> UAbilitySystem::UpdateAbilities(const TArray<FGameplayAbilitySpecHandle>& CurrentHandles, const TArray<FGameplayAbilityInfo>& NewAbilities)
+{
+	if (!IsOwnerActorAuthoritative())
+	{
+		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() Updating Abilities on non authoritative actor is not allowed! {2}",
+			*UEnum::GetValueAsString(GetOwnerActor()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwnerActor()));
+		return {};
+	}
+
+	// Grants and removals are deferred until the lock is released, and are replicated together
+	ABILITYLIST_SCOPE_LOCK();
+	
+	TArray<FGameplayAbilitySpecHandle> SpecHandles;
+	SpecHandles.Init(FGameplayAbilitySpecHandle(), NewAbilities.Num());
+	TArray<FGameplayAbilitySpecHandle> RemovedHandles;
+	for (const FGameplayAbilitySpecHandle& Handle : CurrentHandles)
+	{
+		if (!Handle.IsValid() || SpecHandles.Contains(Handle) || RemovedHandles.Contains(Handle)) continue;
+
+		// Keep the abilities that are still in the set. Entries that share a spec keep it for each of them
+		const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(Handle);
+		bool bKeptAbility = false;
+		for (int32 Index = 0; Spec && Spec->Ability && Index < NewAbilities.Num(); Index++)
+		{
+			const FGameplayAbilityInfo& Ability = NewAbilities[Index];
+			if (SpecHandles[Index].IsValid() || Ability.Ability != Spec->Ability->GetClass()) continue;
+			if (Ability.Level != Spec->Level || static_cast<int32>(Ability.InputId) != Spec->InputID) continue;
+
+			SpecHandles[Index] = Handle;
+			bKeptAbility = true;
+		}
+
+		if (!bKeptAbility) RemovedHandles.Add(Handle);
+	}
+
+	// Remove the abilities that left the set, and add the new ones
+	RemoveGameplayAbilities(RemovedHandles);
+	int32 GrantedAbilities = 0;
+	for (int32 Index = 0; Index < NewAbilities.Num(); Index++)
+	{
+		if (SpecHandles[Index].IsValid()) continue;
+		
+		SpecHandles[Index] = AddAbility(NewAbilities[Index]);
+		GrantedAbilities++;
+	}
+
+	UE_LOGFMT(AbilityLog, Verbose, "{0}() {1} removed {2} abilities and granted {3} abilities",
+		*FString(__FUNCTION__), *GetNameSafe(GetOwnerActor()), RemovedHandles.Num(), GrantedAbilities);
+
+	SpecHandles.RemoveAll([](const FGameplayAbilitySpecHandle& Handle) { return !Handle.IsValid(); });
+	return SpecHandles;
+}
+
+
 FGameplayAbilitySpec UAbilitySystem::GetAbilitySpec(TSubclassOf<UGameplayAbility> GameplayAbility)
 {
 	for (auto &[Id, Map] : AddedAbilityHandles)
@@ -775,6 +830,58 @@ void UAbilitySystem::OnAnyGameplayEffectRemoved(const FActiveGameplayEffect& Eff
 
 
 
+#pragma region Predicted Hits
+void UAbilitySystem::AddPredictedHits(FPredictionKey PredictionKey, const TArray<FPredictedHit>& Hits)
+{
+	if (!PredictionKey.IsValidKey() || Hits.IsEmpty()) return;
+
+	TArray<FPredictedHit>* KeyHits = PredictedHits.Find(PredictionKey);
+	if (!KeyHits)
+	{
+		// Remove the cues once the server has handled the key, or if it rejects it entirely
+		PredictionKey.NewCaughtUpDelegate().BindUObject(this, &UAbilitySystem::RemovePredictedHits, PredictionKey);
+		PredictionKey.NewRejectedDelegate().BindUObject(this, &UAbilitySystem::RemovePredictedHits, PredictionKey);
+		KeyHits = &PredictedHits.Add(PredictionKey);
+	}
+
+	KeyHits->Append(Hits);
+}
+
+
+void UAbilitySystem::RemovePredictedHits(const FPredictionKey PredictionKey)
+{
+	TArray<FPredictedHit> Hits;
+	if (!PredictedHits.RemoveAndCopyValue(PredictionKey, Hits)) return;
+
+	for (const FPredictedHit& Hit : Hits)
+	{
+		if (Hit.Target.IsValid()) UGameplayCueManager::RemoveGameplayCue_NonReplicated(Hit.Target.Get(), Hit.Cue, Hit.Parameters);
+	}
+}
+
+
+void UAbilitySystem::Client_RejectPredictedHits_Implementation(const FPredictionKey PredictionKey, const TArray<AActor*>& Targets)
+{
+	if (TArray<FPredictedHit>* Hits = PredictedHits.Find(PredictionKey))
+	{
+		for (int32 Index = Hits->Num() - 1; Index >= 0; Index--)
+		{
+			const FPredictedHit& Hit = (*Hits)[Index];
+			if (!Targets.Contains(Hit.Target.Get())) continue;
+
+			if (Hit.Target.IsValid()) UGameplayCueManager::RemoveGameplayCue_NonReplicated(Hit.Target.Get(), Hit.Cue, Hit.Parameters);
+			Hits->RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	UE_LOGFMT(AbilityLog, Log, "{0}() The server rejected {1} of {2}'s predicted hits", *FString(__FUNCTION__), Targets.Num(), *GetNameSafe(GetAvatarActor()));
+	OnPredictedHitsRejected.Broadcast(PredictionKey, Targets);
+}
+#pragma endregion 
+
+
+
+
 #pragma region Utility
 void UAbilitySystem::K2_AddLooseGameplayTag(FGameplayTag Tag)
 {
@@ -48,6 +48,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FOnGameplayEffectStackChange, FGam
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FOnGameplayEffectTimeChange,  FGameplayTagContainer, AssetTags, FGameplayTagContainer, GrantedTags, FActiveGameplayEffectHandle, ActiveHandle, float, NewStartTime, float, NewDuration);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnGameplayEffectRemoved, FGameplayTagContainer, AssetTags, FGameplayTagContainer, GrantedTags, FActiveGameplayEffectHandle, ActiveHandle);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGameplayTagStackChange, FGameplayTag, GameplayTag, int32, NewTagCount);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPredictedHitsRejected, const FPredictionKey&, const TArray<AActor*>&);
 
 
 /**
@@ -80,6 +81,23 @@ struct F_MultiAbilityHandle
 // NextDebugTarget or PgUpKey 
 
 
+/**
+ * A hit that a client predicted before the server validated it, and the cue that was played on the target
+ */
+struct FPredictedHit
+{
+	/** The target that was hit */
+	TWeakObjectPtr<AActor> Target;
+
+	/** The non replicated cue that's played on the target until the server handles the hit */
+	FGameplayTag Cue;
+
+	/** The cue's parameters */
+	FGameplayCueParameters Parameters;
+
+};
+
+
 /** The core ActorComponent for interfacing with the GameplayAbilities System
  *	This inherits from multiple classes
  *		- GameplayTasksComponent
@@ -180,6 +198,17 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual TArray<FGameplayAbilitySpecHandle> AddAbilities(const TArray<FGameplayAbilityInfo> NewAbilities);
 
+	/**
+	 * Updates a set of granted abilities to a new set of abilities. Only the abilities that aren't in the new set are removed, and only the new abilities are added,
+	 * so the abilities that stay keep their spec handles and aren't cancelled if they're active. Every change is batched into a single update of the ability list.
+	 * This will be ignored if the actor is not authoritative.
+	 *
+	 * @param CurrentHandles		The handles of the currently granted abilities
+	 * @param NewAbilities			The abilities that should be granted. Abilities with the same class, level, and input ID as a granted ability keep that ability
+	 * @returns						The handles of the granted abilities, in the same order as NewAbilities without the abilities that couldn't be granted
+	 */
+	virtual TArray<FGameplayAbilitySpecHandle> UpdateAbilities(const TArray<FGameplayAbilitySpecHandle>& CurrentHandles, const TArray<FGameplayAbilityInfo>& NewAbilities);
+
 	/**
 	 * Searches for an ability that's already been granted to the player using the class reference
 	 *
@@ -348,6 +377,35 @@ public:
 	
 	
 	
+//------------------------------------------------------------------------------------------//
+// Predicted Hits																			//
+//------------------------------------------------------------------------------------------//
+public:
+	/** Called on the client when the server rejects some of it's predicted hits */
+	FOnPredictedHitsRejected OnPredictedHitsRejected;
+
+	/**
+	 * Keeps track of the hits a client predicted before sending them to the server. Their cues are removed when the server rejects the hits, or once it has handled the prediction key and it's own cues have replicated
+	 *
+	 * @param PredictionKey			The prediction key the hits were sent to the server with
+	 * @param Hits					The predicted hits, with the cues that are already playing on the targets
+	 */
+	virtual void AddPredictedHits(FPredictionKey PredictionKey, const TArray<FPredictedHit>& Hits);
+
+	/** Removes the cues of the hits that were predicted with a prediction key */
+	virtual void RemovePredictedHits(FPredictionKey PredictionKey);
+
+	/** Rolls back the client's predicted hits that the server rejected */
+	UFUNCTION(Client, Reliable) virtual void Client_RejectPredictedHits(FPredictionKey PredictionKey, const TArray<AActor*>& Targets);
+
+
+protected:
+	/** The hits that the client predicted and the server hasn't handled yet */
+	TMap<FPredictionKey, TArray<FPredictedHit>> PredictedHits;
+
+	
+	
+	
 //------------------------------------------------------------------------------------------//
 // Utility																					//
 //------------------------------------------------------------------------------------------//
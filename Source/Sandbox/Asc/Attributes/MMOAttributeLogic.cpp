@@ -8,11 +8,14 @@
 #include "Sandbox/Asc/AbilitySystem.h"
 #include "Sandbox/Asc/Information/SandboxTags.h"
 #include "Sandbox/Characters/CharacterBase.h"
+#include "Sandbox/Characters/Player/PlayerCharacter.h"
 #include "Sandbox/Combat/CombatComponent.h"
+#include "Sandbox/Combat/CombatTelemetry.h"
 #include "Sandbox/Combat/Weapons/Armament.h"
 #include "Sandbox/Data/Enums/AttributeTypes.h"
 #include "Sandbox/Data/Enums/HitDirection.h"
 #include "Sandbox/Data/Enums/HitReacts.h"
+#include "Sandbox/Data/Interfaces/Save/LevelSaveInformationInterface.h"
 
 
 bool UMMOAttributeLogic::PreGameplayEffectExecute(FGameplayEffectModCallbackData& Data)
@@ -204,34 +207,20 @@ void UMMOAttributeLogic::PostGameplayEffectExecute(const FGameplayEffectModCallb
 			}
 		}
 
+		// Npcs are saved with the level, so let the next level save know their attributes have changed
+		if (!Cast<APlayerCharacter>(Character)) ILevelSaveInformationInterface::MarkLevelSaveDirty(Character);
+
 		
-		// Health/Poise: (100)(10), Damage/Poise: (-10)(10) ->  Bleed: (0) / Frostbite: (0) / Cursed: (0)
-		FString BleedDamage = FString("");
-		FString FrostbiteDamage = FString("");
-		FString PoisonDamage = FString("");
-		FString MadnessDamage = FString("");
-		FString CurseDamage = FString("");
-		FString SleepDamage = FString("");
-		if (Statuses.bCharacterBled || Statuses.BleedBuildup > 0) BleedDamage = FString("Bleed(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.BleedBuildup)).Append(") / ");
-		if (Statuses.bWasFrostbitten || Statuses.FrostbiteBuildup > 0) FrostbiteDamage = FString("Frostbite(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.FrostbiteBuildup)).Append(") / ");
-		if (Statuses.bWasPoisoned || Statuses.PoisonBuildup > 0) PoisonDamage = FString("Poison(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.PoisonBuildup)).Append(") / ");
-		if (Statuses.bWasMaddened || Statuses.MadnessBuildup > 0) MadnessDamage = FString("Madness(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.MadnessBuildup)).Append(") / ");
-		if (Statuses.bWasCursed || Statuses.CurseBuildup > 0) CurseDamage = FString("Curse(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.CurseBuildup)).Append(") / ");
-		if (Statuses.bSlept || Statuses.SleepBuildup > 0) SleepDamage = FString("Sleep(").Append(Statuses.bCharacterBled ? "Proc" : "").Append(FString::FromInt(Statuses.SleepBuildup)).Append(")");
-		UE_LOGFMT(LogTemp, Warning, "{0}::AttributeLogic() {1} attacked {2} with {3}! \n"
-			"Health/Poise: ({4})({5}), Damage: ({6})({7}) {8} {9} {10} {11} {12} {13} {14} \n",
-
-			*UEnum::GetValueAsString(Props.SourceCharacter->GetLocalRole()),
-			*GetNameSafe(Props.SourceCharacter), *GetNameSafe(Props.TargetCharacter), *GetNameSafe(Props.Context.GetSourceObject()),
-			
-			FMath::CeilToInt(GetHealth()), FMath::CeilToInt(GetPoise()),
-			FMath::CeilToInt(-CombatInfo.MagicDamageTaken - CombatInfo.DamageTaken),
-			FMath::CeilToInt(-CombatInfo.PoiseDamageTaken),
-			
-			Statuses.StatusProc() || Statuses.StatusDamage() ? FString("->  ") : FString(""),
-			
-			BleedDamage, FrostbiteDamage, CurseDamage, PoisonDamage, MadnessDamage, SleepDamage
-		);
+		// Record the attack for balancing
+		COMBAT_TELEMETRY(Damage, Props.SourceCharacter, Character, CombatInfo.DamageTaken, CombatInfo.MagicDamageTaken, CombatInfo.PoiseDamageTaken, CurrentHealth);
+		if (Statuses.bWasCursed || Statuses.CurseBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Curse, Statuses.bWasCursed, Statuses.CurseBuildup);
+		if (Statuses.bCharacterBled || Statuses.BleedBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Bleed, Statuses.bCharacterBled, Statuses.BleedBuildup);
+		if (Statuses.bWasPoisoned || Statuses.PoisonBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Poison, Statuses.bWasPoisoned, Statuses.PoisonBuildup);
+		if (Statuses.bWasFrostbitten || Statuses.FrostbiteBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Frostbite, Statuses.bWasFrostbitten, Statuses.FrostbiteBuildup);
+		if (Statuses.bWasMaddened || Statuses.MadnessBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Madness, Statuses.bWasMaddened, Statuses.MadnessBuildup);
+		if (Statuses.bSlept || Statuses.SleepBuildup > 0) COMBAT_TELEMETRY(Status, Props.SourceCharacter, Character, EDamageChannel::Sleep, Statuses.bSlept, Statuses.SleepBuildup);
+		if (CombatInfo.bPoiseBroken) COMBAT_TELEMETRY(PoiseBreak, Props.SourceCharacter, Character, CombatInfo.HitStun, CombatInfo.HitDirection, CombatInfo.PoiseDamageTaken);
+		if (CurrentHealth <= 0.0) COMBAT_TELEMETRY(Death, Props.SourceCharacter, Character, CurrentHealth);
 	}
 
 	OnPostGameplayEffectExecute.Broadcast(Props);
@@ -6,6 +6,11 @@
 #include "AbilitySystemComponent.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Asc/Attributes/MMOAttributeSet.h"
+#include "Sandbox/Asc/Information/AttackPayload.h"
+
+// The attack payload's channels are read into the damage channels in order
+static_assert(static_cast<int32>(EDamageChannel::Curse) - static_cast<int32>(EDamageChannel::Standard) == FDamageChannels::NumDamageChannels, "EDamageChannel's damage channels should match FDamageChannels::Damage");
+static_assert(static_cast<int32>(EDamageChannel::Poise) - static_cast<int32>(EDamageChannel::Curse) == FDamageChannels::NumStatusChannels, "EDamageChannel's status channels should match FDamageChannels::Status");
 
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
@@ -129,7 +134,34 @@ struct FDamageStatics
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UMMOAttributeSet, Madness, Source, true);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UMMOAttributeSet, Curse, Source, true);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UMMOAttributeSet, Sleep, Source, true);
+
+
+		// Damage and status channels, in the order of FDamageChannels
+		const FGameplayEffectAttributeCaptureDefinition Damages[] = { Damage_StandardDef, Damage_SlashDef, Damage_PierceDef, Damage_StrikeDef, Damage_MagicDef, Damage_IceDef, Damage_FireDef, Damage_HolyDef, Damage_LightningDef };
+		const FGameplayEffectAttributeCaptureDefinition Defences[] = { Defence_StandardDef, Defence_SlashDef, Defence_PierceDef, Defence_StrikeDef, Resistance_MagicDef, Resistance_IceDef, Resistance_FireDef, Resistance_HolyDef, Resistance_LightningDef };
+		const FGameplayEffectAttributeCaptureDefinition Negations[] = { Negation_StandardDef, Negation_SlashDef, Negation_PierceDef, Negation_StrikeDef, Negation_MagicDef, Negation_IceDef, Negation_FireDef, Negation_HolyDef, Negation_LightningDef };
+		const FGameplayEffectAttributeCaptureDefinition Statuses[] = { CurseDef, BleedDef, PoisonDef, FrostbiteDef, MadnessDef, SleepDef };
+		const FGameplayEffectAttributeCaptureDefinition Resistances[] = { ImmunityDef, RobustnessDef, ImmunityDef, RobustnessDef, FocusDef, FocusDef };
+		for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+		{
+			DamageChannelDefs[Index] = Damages[Index];
+			DefenceChannelDefs[Index] = Defences[Index];
+			NegationChannelDefs[Index] = Negations[Index];
+		}
+		
+		for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+		{
+			StatusChannelDefs[Index] = Statuses[Index];
+			ResistanceChannelDefs[Index] = Resistances[Index];
+		}
 	}
+
+	/**** Channels ****/
+	FGameplayEffectAttributeCaptureDefinition DamageChannelDefs[FDamageChannels::NumDamageChannels];
+	FGameplayEffectAttributeCaptureDefinition DefenceChannelDefs[FDamageChannels::NumDamageChannels];
+	FGameplayEffectAttributeCaptureDefinition NegationChannelDefs[FDamageChannels::NumDamageChannels];
+	FGameplayEffectAttributeCaptureDefinition StatusChannelDefs[FDamageChannels::NumStatusChannels];
+	FGameplayEffectAttributeCaptureDefinition ResistanceChannelDefs[FDamageChannels::NumStatusChannels];
 };
 
 
@@ -224,11 +256,19 @@ void UDamageCalculation_Default::Execute_Implementation(const FGameplayEffectCus
 	
 	
 	// Retrieve the attribute information
-	FDamageCalculation_Attributes AttributeInformation;
-	CalculateCapturedRelevantAttributes(EvaluationParameters, ExecutionParams, AttributeInformation);
-	
-	const FDamageCalculations_AttackInformation& AttackInfo = AttributeInformation.AttackInformation;
-	const FDamageCalculations_Attributes_Target& PlayerStats = AttributeInformation.TargetAttributes;
+	FDamageChannels Channels;
+	CaptureDamageChannels(EvaluationParameters, ExecutionParams, Channels);
+
+	float Damage_Poise = 0;
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().Damage_PoiseDef, EvaluationParameters, Damage_Poise);
+
+	// Attacks send their damages with the spec, which replaces the base value of the attacker's damage attributes. Any buffs on the damage attributes are still applied on top of it
+	FAttackPayload AttackPayload;
+	if (FAttackPayload::ReadFromSpec(*Spec, AttackPayload))
+	{
+		CaptureAttackPayload(EvaluationParameters, ExecutionParams, AttackPayload, Channels);
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitudeWithBase(DamageStatics().Damage_PoiseDef, EvaluationParameters, AttackPayload.Get(EDamageChannel::Poise), Damage_Poise);
+	}
 
 	// Retrieve any information from gameplay effects
 	
@@ -238,7 +278,7 @@ void UDamageCalculation_Default::Execute_Implementation(const FGameplayEffectCus
 	//----------------------------------------------------------------------------------------------//
 	// Damage Calculations																			//
 	//----------------------------------------------------------------------------------------------//
-	FDamageCalculations_AttackInformation CalculatedDamage;
+	FDamageChannelResults CalculatedDamage;
 
 	/**
 		Weapon damage calculations (calculated before the execution calculation) -> needs server validation to be safe
@@ -289,24 +329,7 @@ void UDamageCalculation_Default::Execute_Implementation(const FGameplayEffectCus
 	
 
 	// damage - defence stats // remaining damage * damage negation
-	CalculatedDamage.Damage_Standard = DamageCalculation(AttackInfo.Damage_Standard, PlayerStats.Defence_Standard, PlayerStats.Negation_Standard);
-	CalculatedDamage.Damage_Slash = DamageCalculation(AttackInfo.Damage_Slash, PlayerStats.Defence_Slash, PlayerStats.Negation_Slash);
-	CalculatedDamage.Damage_Pierce = DamageCalculation(AttackInfo.Damage_Pierce, PlayerStats.Defence_Pierce, PlayerStats.Negation_Pierce);
-	CalculatedDamage.Damage_Strike = DamageCalculation(AttackInfo.Damage_Strike, PlayerStats.Defence_Strike, PlayerStats.Negation_Strike);
-	CalculatedDamage.Damage_Poise = AttackInfo.Damage_Poise;
-	
-	CalculatedDamage.Damage_Magic = DamageCalculation(AttackInfo.Damage_Magic, PlayerStats.Resistance_Magic, PlayerStats.Negation_Magic);
-	CalculatedDamage.Damage_Ice = DamageCalculation(AttackInfo.Damage_Ice, PlayerStats.Resistance_Ice, PlayerStats.Negation_Ice);
-	CalculatedDamage.Damage_Fire = DamageCalculation(AttackInfo.Damage_Fire, PlayerStats.Resistance_Fire, PlayerStats.Negation_Fire);
-	CalculatedDamage.Damage_Holy = DamageCalculation(AttackInfo.Damage_Holy, PlayerStats.Resistance_Holy, PlayerStats.Negation_Holy);
-	CalculatedDamage.Damage_Lightning = DamageCalculation(AttackInfo.Damage_Lightning, PlayerStats.Resistance_Lightning, PlayerStats.Negation_Lightning);
-	
-	CalculatedDamage.Curse = StatusCalculation(AttackInfo.Curse, PlayerStats.Immunity, 0);
-	CalculatedDamage.Bleed = StatusCalculation(AttackInfo.Bleed, PlayerStats.Robustness, 0);
-	CalculatedDamage.Poison = StatusCalculation(AttackInfo.Poison, PlayerStats.Immunity, 0);
-	CalculatedDamage.Frostbite = StatusCalculation(AttackInfo.Frostbite, PlayerStats.Robustness, 0);
-	CalculatedDamage.Madness = StatusCalculation(AttackInfo.Madness, PlayerStats.Focus, 0);
-	CalculatedDamage.Sleep = StatusCalculation(AttackInfo.Sleep, PlayerStats.Focus, 0);
+	CalculateChannels(Channels, CalculatedDamage);
 	
 
 	// If there's anything we need to add to the gameplay effect before the attribute handles it, here is the place to handle it
@@ -316,45 +339,33 @@ void UDamageCalculation_Default::Execute_Implementation(const FGameplayEffectCus
 
 
 	// Add the calculated damages to output modifications
-	const FGameplayModifierEvaluatedData Eval_Damage_Standard(UMMOAttributeSet::GetDamage_StandardAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Standard);
-	const FGameplayModifierEvaluatedData Eval_Damage_Slash(UMMOAttributeSet::GetDamage_SlashAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Slash);
-	const FGameplayModifierEvaluatedData Eval_Damage_Pierce(UMMOAttributeSet::GetDamage_PierceAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Pierce);
-	const FGameplayModifierEvaluatedData Eval_Damage_Strike(UMMOAttributeSet::GetDamage_StrikeAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Strike);
-	const FGameplayModifierEvaluatedData Eval_Damage_Poise(UMMOAttributeSet::GetDamage_PoiseAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Poise);
-	
-	const FGameplayModifierEvaluatedData Eval_Damage_Magic(UMMOAttributeSet::GetDamage_MagicAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Magic);
-	const FGameplayModifierEvaluatedData Eval_Damage_Ice(UMMOAttributeSet::GetDamage_IceAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Ice);
-	const FGameplayModifierEvaluatedData Eval_Damage_Fire(UMMOAttributeSet::GetDamage_FireAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Fire);
-	const FGameplayModifierEvaluatedData Eval_Damage_Holy(UMMOAttributeSet::GetDamage_HolyAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Holy);
-	const FGameplayModifierEvaluatedData Eval_Damage_Lightning(UMMOAttributeSet::GetDamage_LightningAttribute(), EGameplayModOp::Override, CalculatedDamage.Damage_Lightning);
-
-	const FGameplayModifierEvaluatedData Eval_Curse(UMMOAttributeSet::GetCurseAttribute(), EGameplayModOp::Override, CalculatedDamage.Curse);
-	const FGameplayModifierEvaluatedData Eval_Bleed(UMMOAttributeSet::GetBleedAttribute(), EGameplayModOp::Override, CalculatedDamage.Bleed);
-	const FGameplayModifierEvaluatedData Eval_Poison(UMMOAttributeSet::GetPoisonAttribute(), EGameplayModOp::Override, CalculatedDamage.Poison);
-	const FGameplayModifierEvaluatedData Eval_Frostbite(UMMOAttributeSet::GetFrostbiteAttribute(), EGameplayModOp::Override, CalculatedDamage.Frostbite);
-	const FGameplayModifierEvaluatedData Eval_Madness(UMMOAttributeSet::GetMadnessAttribute(), EGameplayModOp::Override, CalculatedDamage.Madness);
-	const FGameplayModifierEvaluatedData Eval_Sleep(UMMOAttributeSet::GetSleepAttribute(), EGameplayModOp::Override, CalculatedDamage.Sleep);
+	static const FGameplayAttribute DamageAttributes[] = {
+		UMMOAttributeSet::GetDamage_StandardAttribute(), UMMOAttributeSet::GetDamage_SlashAttribute(), UMMOAttributeSet::GetDamage_PierceAttribute(), UMMOAttributeSet::GetDamage_StrikeAttribute(),
+		UMMOAttributeSet::GetDamage_MagicAttribute(), UMMOAttributeSet::GetDamage_IceAttribute(), UMMOAttributeSet::GetDamage_FireAttribute(), UMMOAttributeSet::GetDamage_HolyAttribute(), UMMOAttributeSet::GetDamage_LightningAttribute()
+	};
+	static const FGameplayAttribute StatusAttributes[] = {
+		UMMOAttributeSet::GetCurseAttribute(), UMMOAttributeSet::GetBleedAttribute(), UMMOAttributeSet::GetPoisonAttribute(),
+		UMMOAttributeSet::GetFrostbiteAttribute(), UMMOAttributeSet::GetMadnessAttribute(), UMMOAttributeSet::GetSleepAttribute()
+	};
 
 	// Each calculation is done individually. The effect context handles these in the same order they're created
 	// They however, use the same effect context which might be helpful for how you handle calculations
-	/* if (CalculatedDamage.Damage_Standard != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Standard);
-	/* if (CalculatedDamage.Damage_Slash != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Slash);
-	/* if (CalculatedDamage.Damage_Pierce != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Pierce);
-	/* if (CalculatedDamage.Damage_Strike != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Strike);
-	/* if (CalculatedDamage.Damage_Strike != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Poise);
+	for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+	{
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(DamageAttributes[Index], EGameplayModOp::Override, CalculatedDamage.Damage[Index]));
+
+		// Poise damage isn't mitigated, and is added after the physical damages
+		if (DamageAttributes[Index] == UMMOAttributeSet::GetDamage_StrikeAttribute())
+		{
+			OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UMMOAttributeSet::GetDamage_PoiseAttribute(), EGameplayModOp::Override, Damage_Poise));
+		}
+	}
 	
-	/* if (CalculatedDamage.Damage_Magic != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Magic);
-	/* if (CalculatedDamage.Damage_Ice != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Ice);
-	/* if (CalculatedDamage.Damage_Fire != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Fire);
-	/* if (CalculatedDamage.Damage_Holy != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Holy);
-	/* if (CalculatedDamage.Damage_Lightning != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Damage_Lightning);
+	for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+	{
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(StatusAttributes[Index], EGameplayModOp::Override, CalculatedDamage.Status[Index]));
+	}
 	
-	/* if (CalculatedDamage.Curse != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Curse);
-	/* if (CalculatedDamage.Bleed != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Bleed);
-	/* if (CalculatedDamage.Poison != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Poison);
-	/* if (CalculatedDamage.Frostbite != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Frostbite);
-	/* if (CalculatedDamage.Madness != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Madness);
-	/* if (CalculatedDamage.Sleep != 0) */ OutExecutionOutput.AddOutputModifier(Eval_Sleep);
 	OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UMMOAttributeSet::GetDamageCalculationAttribute(), EGameplayModOp::Multiplicitive, 1));
 }
 
@@ -424,9 +435,10 @@ void UDamageCalculation_Default::CalculateCapturedRelevantAttributes(
 
 float UDamageCalculation_Default::DamageCalculation(const float IncomingDamage, const float Defence, const float DamageNegation) const
 {
-	float DamageAfterArmor = FMath::Clamp(IncomingDamage - Defence, 0, IncomingDamage);
-	float DamageNegationCalc = (100 - DamageNegation) * 0.01;
-	float MitigatedDamage = DamageAfterArmor * DamageNegationCalc;
+	// Single precision throughout, to match the vectorized channels
+	const float DamageAfterArmor = FMath::Clamp(IncomingDamage - Defence, 0.0f, IncomingDamage);
+	const float DamageNegationCalc = (100.0f - DamageNegation) * 0.01f;
+	const float MitigatedDamage = DamageAfterArmor * DamageNegationCalc;
 
 	// UE_LOGFMT(LogTemp, Log, "DamageAfterArmor: {0}, DamageNegationCalc: {1}, MitigatedDamage: {3}", DamageAfterArmor, DamageNegationCalc, MitigatedDamage);
 	return MitigatedDamage;
@@ -435,6 +447,118 @@ float UDamageCalculation_Default::DamageCalculation(const float IncomingDamage,
 
 float UDamageCalculation_Default::StatusCalculation(const float StatusDamage, const float Resistance, const float StatusNegation) const
 {
-	return FMath::Clamp(StatusDamage - Resistance, 0, StatusDamage) * ((100 - StatusNegation) / 100); 
+	return FMath::Clamp(StatusDamage - Resistance, 0.0f, StatusDamage) * ((100.0f - StatusNegation) / 100.0f); 
+}
+
+
+void UDamageCalculation_Default::CaptureDamageChannels(const FAggregatorEvaluateParameters& EvaluationParameters, const FGameplayEffectCustomExecutionParameters& ExecutionParams, FDamageChannels& Channels) const
+{
+	const FDamageStatics& Statics = DamageStatics();
+	for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+	{
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Statics.DamageChannelDefs[Index], EvaluationParameters, Channels.Damage[Index]);
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Statics.DefenceChannelDefs[Index], EvaluationParameters, Channels.Defence[Index]);
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Statics.NegationChannelDefs[Index], EvaluationParameters, Channels.Negation[Index]);
+	}
+
+	// Statuses don't have negations yet
+	for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+	{
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Statics.StatusChannelDefs[Index], EvaluationParameters, Channels.Status[Index]);
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Statics.ResistanceChannelDefs[Index], EvaluationParameters, Channels.Resistance[Index]);
+	}
+}
+
+
+void UDamageCalculation_Default::CaptureAttackPayload(const FAggregatorEvaluateParameters& EvaluationParameters, const FGameplayEffectCustomExecutionParameters& ExecutionParams, const FAttackPayload& AttackPayload, FDamageChannels& Channels) const
+{
+	const FDamageStatics& Statics = DamageStatics();
+	for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+	{
+		const float BaseDamage = AttackPayload.Channels[static_cast<int32>(EDamageChannel::Standard) + Index];
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitudeWithBase(Statics.DamageChannelDefs[Index], EvaluationParameters, BaseDamage, Channels.Damage[Index]);
+	}
+
+	for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+	{
+		const float BaseStatus = AttackPayload.Channels[static_cast<int32>(EDamageChannel::Curse) + Index];
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitudeWithBase(Statics.StatusChannelDefs[Index], EvaluationParameters, BaseStatus, Channels.Status[Index]);
+	}
+}
+
+
+void UDamageCalculation_Default::CalculateChannels(const FDamageChannels& Channels, FDamageChannelResults& Results) const
+{
+	if (UsesDefaultChannelCalculations())
+	{
+		CalculateDamageChannels(Channels, Results);
+		return;
+	}
+
+	for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+	{
+		Results.Damage[Index] = DamageCalculation(Channels.Damage[Index], Channels.Defence[Index], Channels.Negation[Index]);
+	}
+
+	for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+	{
+		Results.Status[Index] = StatusCalculation(Channels.Status[Index], Channels.Resistance[Index], Channels.StatusNegation[Index]);
+	}
+}
+
+
+bool UDamageCalculation_Default::UsesDefaultChannelCalculations() const
+{
+	// Blueprints can't override the calculations, so only the closest native class matters
+	const UClass* NativeClass = GetClass();
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	return NativeClass == UDamageCalculation_Default::StaticClass();
+}
+
+
+/** FMath::Clamp for each lane, (X < Min ? Min : X < Max ? X : Max) */
+static FORCEINLINE VectorRegister4Float VectorClampChannels(const VectorRegister4Float& X, const VectorRegister4Float& Min, const VectorRegister4Float& Max)
+{
+	return VectorSelect(VectorCompareLT(X, Min), Min, VectorMin(X, Max));
+}
+
+
+void UDamageCalculation_Default::CalculateDamageChannels(const FDamageChannels& Channels, FDamageChannelResults& Results)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Hundred = VectorSetFloat1(100.0f);
+	const VectorRegister4Float Percent = VectorSetFloat1(0.01f);
+
+	// Same as DamageCalculation
+	for (int32 Index = 0; Index < FDamageChannels::DamageWidth; Index += 4)
+	{
+		const VectorRegister4Float Damage = VectorLoadAligned(&Channels.Damage[Index]);
+		const VectorRegister4Float DamageAfterArmor = VectorClampChannels(VectorSubtract(Damage, VectorLoadAligned(&Channels.Defence[Index])), Zero, Damage);
+		const VectorRegister4Float DamageNegation = VectorMultiply(VectorSubtract(Hundred, VectorLoadAligned(&Channels.Negation[Index])), Percent);
+		VectorStoreAligned(VectorMultiply(DamageAfterArmor, DamageNegation), &Results.Damage[Index]);
+	}
+
+	// Same as StatusCalculation
+	for (int32 Index = 0; Index < FDamageChannels::StatusWidth; Index += 4)
+	{
+		const VectorRegister4Float Status = VectorLoadAligned(&Channels.Status[Index]);
+		const VectorRegister4Float StatusAfterResistance = VectorClampChannels(VectorSubtract(Status, VectorLoadAligned(&Channels.Resistance[Index])), Zero, Status);
+		const VectorRegister4Float StatusNegation = VectorDivide(VectorSubtract(Hundred, VectorLoadAligned(&Channels.StatusNegation[Index])), Hundred);
+		VectorStoreAligned(VectorMultiply(StatusAfterResistance, StatusNegation), &Results.Status[Index]);
+	}
+}
+
+
+void UDamageCalculation_Default::CalculateDamageChannels(const TConstArrayView<FDamageChannels> Channels, const TArrayView<FDamageChannelResults> Results)
+{
+	check(Channels.Num() == Results.Num());
+	for (int32 Index = 0; Index < Channels.Num(); Index++)
+	{
+		CalculateDamageChannels(Channels[Index], Results[Index]);
+	}
 }
 
@@ -6,6 +6,8 @@
 #include "GameplayEffectExecutionCalculation.h"
 #include "DamageCalculation_Default.generated.h"
 
+struct FAttackPayload;
+
 
 /**
  * The attacker's damage information used during the calculation
@@ -158,6 +160,54 @@ struct FDamageCalculation_Attributes
 };
 
 
+/**
+ * The damage and status channels of an attack against a target, laid out for calculating every channel at once. @ref UDamageCalculation_Default::CalculateDamageChannels \n\n
+ *
+ * Damage channels are Standard, Slash, Pierce, Strike, Magic, Ice, Fire, Holy and Lightning, and status channels are Curse, Bleed, Poison, Frostbite, Madness and Sleep.
+ * Each block is padded to a multiple of the vector width, and the padding is left at zero.
+ */
+struct SANDBOX_API FDamageChannels
+{
+	static constexpr int32 NumDamageChannels = 9;
+	static constexpr int32 NumStatusChannels = 6;
+	static constexpr int32 DamageWidth = 12;
+	static constexpr int32 StatusWidth = 8;
+
+	/** The attack's damage of each damage channel */
+	alignas(16) float Damage[DamageWidth] = {};
+	
+	/** The target's defence or resistance against each damage channel */
+	alignas(16) float Defence[DamageWidth] = {};
+	
+	/** The target's damage negation against each damage channel */
+	alignas(16) float Negation[DamageWidth] = {};
+	
+	/** The attack's buildup of each status channel */
+	alignas(16) float Status[StatusWidth] = {};
+	
+	/** The target's resistance against each status channel */
+	alignas(16) float Resistance[StatusWidth] = {};
+	
+	/** The target's negation against each status channel */
+	alignas(16) float StatusNegation[StatusWidth] = {};
+
+};
+
+
+/**
+ * The calculated damage and status buildup of each channel. @ref FDamageChannels
+ */
+struct SANDBOX_API FDamageChannelResults
+{
+	/** The mitigated damage of each damage channel */
+	alignas(16) float Damage[FDamageChannels::DamageWidth] = {};
+	
+	/** The mitigated buildup of each status channel */
+	alignas(16) float Status[FDamageChannels::StatusWidth] = {};
+
+};
+
+
 /**
  * 
  */
@@ -172,7 +222,8 @@ public:
 	/** Handles damage calculations against a target */
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
 
-	/** Retrieves the relevant attributes to capture for calculations */
+	/** Retrieves the relevant attributes to capture for calculations. Execute captures the channels with CaptureDamageChannels instead, this is only kept for subclasses that still use it */
+	UE_DEPRECATED(5.2, "The damage calculation no longer uses this, capture the attributes with CaptureDamageChannels instead")
 	virtual void CalculateCapturedRelevantAttributes(const FAggregatorEvaluateParameters& EvaluationParameters, const FGameplayEffectCustomExecutionParameters& ExecutionParams, FDamageCalculation_Attributes& AttributeInformation) const;
 
 	/** Handles the damage calculation for any specific attack */
@@ -181,5 +232,49 @@ public:
 	/** Handles the status damage calculation for any specific attack */
 	virtual float StatusCalculation(float StatusDamage, float Resistance, float StatusNegation) const;
 
+	/** Captures every damage and status channel of the attack and target in one pass */
+	virtual void CaptureDamageChannels(const FAggregatorEvaluateParameters& EvaluationParameters, const FGameplayEffectCustomExecutionParameters& ExecutionParams, FDamageChannels& Channels) const;
+
+	/**
+	 * Captures the attack's damage and status channels with the attack payload as their base values, so buffs on the attacker's damage attributes still apply
+	 *
+	 * @param EvaluationParameters				The source and target tags
+	 * @param ExecutionParams					The execution's captured attributes
+	 * @param AttackPayload						The damages the attack sent with the spec
+	 * @param Channels							The channels the attack's damage and status buildup are captured to
+	 */
+	virtual void CaptureAttackPayload(const FAggregatorEvaluateParameters& EvaluationParameters, const FGameplayEffectCustomExecutionParameters& ExecutionParams, const FAttackPayload& AttackPayload, FDamageChannels& Channels) const;
+
+	/**
+	 * Calculates the damage and status buildup of every channel. Uses the vectorized calculations unless DamageCalculation or StatusCalculation are overridden
+	 *
+	 * @param Channels							The attack and target's channels
+	 * @param Results							The calculated damage and status buildup
+	 */
+	virtual void CalculateChannels(const FDamageChannels& Channels, FDamageChannelResults& Results) const;
+
+	/**
+	 * Whether this calculation uses the default DamageCalculation and StatusCalculation, which lets every channel be calculated at once. @ref CalculateDamageChannels \n\n
+	 * Blueprints can't override them, so this is true unless a native subclass is between this class and the blueprint.
+	 * Native subclasses that don't override either calculation can return true to keep the vectorized calculations.
+	 */
+	virtual bool UsesDefaultChannelCalculations() const;
+
+	/**
+	 * Calculates every damage and status channel at once with vector math. Matches DamageCalculation and StatusCalculation for each channel
+	 *
+	 * @param Channels							The attack and target's channels
+	 * @param Results							The calculated damage and status buildup
+	 */
+	static void CalculateDamageChannels(const FDamageChannels& Channels, FDamageChannelResults& Results);
+
+	/**
+	 * Calculates the damage of multiple attacks and targets at once, for attacks that hit many targets
+	 *
+	 * @param Channels							Each attack and target's channels
+	 * @param Results							The calculated damage and status buildup of each attack, which should be the same size as the channels
+	 */
+	static void CalculateDamageChannels(TConstArrayView<FDamageChannels> Channels, TArrayView<FDamageChannelResults> Results);
+
 	
 };
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Asc/Effects/StatusEffectRegistry.h"
+
+#include "AbilitySystemComponent.h"
+#include "Engine/Engine.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Asc/Information/SandboxTags.h"
+#include "Sandbox/Data/Enums/AttributeTypes.h"
+
+DEFINE_LOG_CATEGORY(StatusEffectRegistryLog);
+
+
+#pragma region Subsystem
+UStatusEffectRegistry* UStatusEffectRegistry::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UStatusEffectRegistry>() : nullptr;
+}
+
+
+void UStatusEffectRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	DurationTag = FGameplayTag::RequestGameplayTag(Tag_Data_Duration);
+	PreventionDefinitions = {
+		{ECombatAttribute::Health, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Regen_Health), FGameplayTag::RequestGameplayTag(Tag_Block_Regen_Health)},
+		{ECombatAttribute::Poise, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Regen_Poise), FGameplayTag::RequestGameplayTag(Tag_Block_Regen_Poise)},
+		{ECombatAttribute::Stamina, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Regen_Stamina), FGameplayTag::RequestGameplayTag(Tag_Block_Regen_Stamina)},
+		{ECombatAttribute::Mana, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Regen_Mana), FGameplayTag::RequestGameplayTag(Tag_Block_Regen_Mana)},
+		{ECombatAttribute::CurseBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Curse), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Curse)},
+		{ECombatAttribute::BleedBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Bleed), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Bleed)},
+		{ECombatAttribute::PoisonBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Poison), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Poison)},
+		{ECombatAttribute::FrostbiteBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Frostbite), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Frostbite)},
+		{ECombatAttribute::MadnessBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Madness), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Madness)},
+		{ECombatAttribute::SleepBuildup, FGameplayTag::RequestGameplayTag(Tag_GameplayEffect_Block_Buildup_Sleep), FGameplayTag::RequestGameplayTag(Tag_Block_Buildup_Sleep)}
+	};
+
+	// Create each attribute's prevention effect up front, combinations are created when they're first used
+	for (int32 Index = 0; Index < PreventionDefinitions.Num(); Index++)
+	{
+		const uint32 PreventionBits = 1u << Index;
+		PreventionEffects.Add(PreventionBits, CreatePreventionEffect(PreventionBits));
+	}
+}
+
+
+void UStatusEffectRegistry::Deinitialize()
+{
+	PreventionEffects.Empty();
+	PreventionDefinitions.Empty();
+	Super::Deinitialize();
+}
+#pragma endregion
+
+
+
+
+#pragma region Prevention Effects
+const UGameplayEffect* UStatusEffectRegistry::GetPreventionEffect(const TArray<ECombatAttribute>& Attributes)
+{
+	check(IsInGameThread());
+
+	uint32 PreventionBits = 0;
+	for (const ECombatAttribute Attribute : Attributes)
+	{
+		const int32 Index = PreventionDefinitions.IndexOfByPredicate([Attribute](const FPreventionDefinition& Definition) { return Definition.Attribute == Attribute; });
+		if (Index == INDEX_NONE)
+		{
+			UE_LOGFMT(StatusEffectRegistryLog, Warning, "{0}() {1} can't be prevented from accumulating!", *FString(__FUNCTION__), *UEnum::GetValueAsString(Attribute));
+			continue;
+		}
+
+		PreventionBits |= 1u << Index;
+	}
+
+	if (!PreventionBits) return nullptr;
+	if (const TObjectPtr<UGameplayEffect>* PreventionEffect = PreventionEffects.Find(PreventionBits)) return *PreventionEffect;
+	return PreventionEffects.Add(PreventionBits, CreatePreventionEffect(PreventionBits));
+}
+
+
+FGameplayEffectSpecHandle UStatusEffectRegistry::MakePreventionSpec(const UAbilitySystemComponent* AbilitySystem, const TArray<ECombatAttribute>& Attributes, const float Duration)
+{
+	const UGameplayEffect* PreventionEffect = GetPreventionEffect(Attributes);
+	if (!AbilitySystem || !PreventionEffect || Duration <= 0)
+	{
+		return FGameplayEffectSpecHandle();
+	}
+
+	FGameplayEffectSpec* PreventionSpec = new FGameplayEffectSpec(PreventionEffect, AbilitySystem->MakeEffectContext(), 1);
+	PreventionSpec->SetSetByCallerMagnitude(DurationTag, Duration);
+	return FGameplayEffectSpecHandle(PreventionSpec);
+}
+
+
+const FPreventionDefinition* UStatusEffectRegistry::FindPreventionDefinition(const ECombatAttribute Attribute) const
+{
+	return PreventionDefinitions.FindByPredicate([Attribute](const FPreventionDefinition& Definition) { return Definition.Attribute == Attribute; });
+}
+
+
+int32 UStatusEffectRegistry::GetNumPreventionEffects() const
+{
+	return PreventionEffects.Num();
+}
+
+
+UGameplayEffect* UStatusEffectRegistry::CreatePreventionEffect(const uint32 PreventionBits)
+{
+	const FName EffectName = MakeUniqueObjectName(this, UGameplayEffect::StaticClass(), FName("GE_PreventAccumulation"));
+	UGameplayEffect* PreventionEffect = NewObject<UGameplayEffect>(this, EffectName, RF_Transient);
+
+	FSetByCallerFloat DurationMagnitude;
+	DurationMagnitude.DataTag = DurationTag;
+	PreventionEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	PreventionEffect->DurationMagnitude = FGameplayEffectModifierMagnitude(DurationMagnitude);
+	PreventionEffect->StackDurationRefreshPolicy = EGameplayEffectStackingDurationPolicy::RefreshOnSuccessfulApplication;
+
+	for (int32 Index = 0; Index < PreventionDefinitions.Num(); Index++)
+	{
+		if (!(PreventionBits & (1u << Index))) continue;
+		PreventionEffect->InheritableGameplayEffectTags.AddTag(PreventionDefinitions[Index].EffectTag);
+		PreventionEffect->InheritableOwnedTagsContainer.AddTag(PreventionDefinitions[Index].StateTag);
+	}
+
+	UE_LOGFMT(StatusEffectRegistryLog, Verbose, "{0}() Created {1} for prevention bits {2}", *FString(__FUNCTION__), *EffectName.ToString(), PreventionBits);
+	return PreventionEffect;
+}
+#pragma endregion
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "StatusEffectRegistry.generated.h"
+
+class UAbilitySystemComponent;
+enum class ECombatAttribute : uint8;
+DECLARE_LOG_CATEGORY_EXTERN(StatusEffectRegistryLog, Log, All);
+
+
+/**
+ * An attribute that can be prevented from regenerating or building up, and the tags of it's prevention effect
+ */
+struct SANDBOX_API FPreventionDefinition
+{
+	/** The attribute that's prevented from accumulating */
+	ECombatAttribute Attribute;
+
+	/** The gameplay effect tag of the prevention effect */
+	FGameplayTag EffectTag;
+
+	/** The state tag that's granted while the attribute is prevented from accumulating */
+	FGameplayTag StateTag;
+
+};
+
+
+/**
+ * Shared, immutable gameplay effect definitions for preventing attributes from regenerating or building up. @ref UCombatComponent::GetPreventAttributeAccumulationSpec \n\n
+ *
+ * The prevention effect of each attribute is created once when the engine starts, instead of every time an attribute is prevented, and combinations of attributes are created the first time they're used.
+ * Each definition's duration is a SetByCaller magnitude (Data.Duration), so one definition handles every duration and the duration is set on the spec that's applied.
+ *
+ *	- Definitions are owned by the registry and shouldn't be edited after they're created
+ *	- Characters apply prevention effects as specs, which don't create new objects
+ */
+UCLASS()
+class SANDBOX_API UStatusEffectRegistry : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The prevention effect of each combination of attributes, by the attributes' prevention bits */
+	UPROPERTY(Transient) TMap<uint32, TObjectPtr<UGameplayEffect>> PreventionEffects;
+
+	/** The attributes that can be prevented from accumulating. An attribute's index is it's prevention bit */
+	TArray<FPreventionDefinition> PreventionDefinitions;
+
+	/** The SetByCaller tag of the prevention effects' duration */
+	FGameplayTag DurationTag;
+
+
+public:
+	/** Retrieves the status effect registry */
+	static UStatusEffectRegistry* Get();
+
+	/** Creates the prevention effect of each attribute */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Clears the prevention effects */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Returns the shared gameplay effect that prevents attributes from accumulating, and creates it if this combination of attributes hasn't been used yet
+	 *
+	 * @param Attributes						The attributes that are prevented from accumulating
+	 * @returns									The prevention effect, or nullptr if none of the attributes can be prevented
+	 */
+	virtual const UGameplayEffect* GetPreventionEffect(const TArray<ECombatAttribute>& Attributes);
+
+	/**
+	 * Creates a spec of the prevention effect for an ability system, with it's duration set
+	 *
+	 * @param AbilitySystem						The ability system that's applying the effect
+	 * @param Attributes						The attributes that are prevented from accumulating
+	 * @param Duration							How long the attributes are prevented from accumulating
+	 * @returns									The spec, which is invalid if none of the attributes can be prevented
+	 */
+	virtual FGameplayEffectSpecHandle MakePreventionSpec(const UAbilitySystemComponent* AbilitySystem, const TArray<ECombatAttribute>& Attributes, float Duration);
+
+	/** Returns the prevention tags of an attribute, or nullptr if it can't be prevented */
+	const FPreventionDefinition* FindPreventionDefinition(ECombatAttribute Attribute) const;
+
+	/** Returns the amount of prevention effects that have been created */
+	int32 GetNumPreventionEffects() const;
+
+
+protected:
+	/** Creates the prevention effect for a combination of attributes */
+	virtual UGameplayEffect* CreatePreventionEffect(uint32 PreventionBits);
+
+
+};
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Asc/Information/AttackPayload.h"
+
+#include "GameplayEffect.h"
+#include "Sandbox/Asc/Attributes/MMOAttributeSet.h"
+#include "Sandbox/Asc/Information/SandboxTags.h"
+
+
+/** The attribute of each damage channel, in the order of EDamageChannel */
+static FGameplayAttribute (*const ChannelAttributes[])() = {
+	&UMMOAttributeSet::GetDamage_StandardAttribute,
+	&UMMOAttributeSet::GetDamage_SlashAttribute,
+	&UMMOAttributeSet::GetDamage_PierceAttribute,
+	&UMMOAttributeSet::GetDamage_StrikeAttribute,
+	&UMMOAttributeSet::GetDamage_MagicAttribute,
+	&UMMOAttributeSet::GetDamage_IceAttribute,
+	&UMMOAttributeSet::GetDamage_FireAttribute,
+	&UMMOAttributeSet::GetDamage_HolyAttribute,
+	&UMMOAttributeSet::GetDamage_LightningAttribute,
+	&UMMOAttributeSet::GetCurseAttribute,
+	&UMMOAttributeSet::GetBleedAttribute,
+	&UMMOAttributeSet::GetPoisonAttribute,
+	&UMMOAttributeSet::GetFrostbiteAttribute,
+	&UMMOAttributeSet::GetMadnessAttribute,
+	&UMMOAttributeSet::GetSleepAttribute,
+	&UMMOAttributeSet::GetDamage_PoiseAttribute
+};
+static_assert(UE_ARRAY_COUNT(ChannelAttributes) == static_cast<int32>(EDamageChannel::Max), "Every damage channel needs an attribute");
+
+
+FAttackPayload FAttackPayload::Compile(const TMap<FGameplayAttribute, float>& AttackInfo)
+{
+	FAttackPayload Payload;
+	for (int32 Index = 0; Index < static_cast<int32>(EDamageChannel::Max); Index++)
+	{
+		if (const float* Value = AttackInfo.Find(ChannelAttributes[Index]()))
+		{
+			Payload.Channels[Index] = *Value;
+		}
+	}
+
+	return Payload;
+}
+
+
+bool FAttackPayload::IsEmpty() const
+{
+	for (const float Value : Channels)
+	{
+		if (Value != 0) return false;
+	}
+
+	return true;
+}
+
+
+void FAttackPayload::ApplyToSpec(FGameplayEffectSpec& Spec) const
+{
+	for (int32 Index = 0; Index < static_cast<int32>(EDamageChannel::Max); Index++)
+	{
+		if (Channels[Index] == 0) continue;
+		Spec.SetSetByCallerMagnitude(GetChannelTag(static_cast<EDamageChannel>(Index)), Channels[Index]);
+	}
+}
+
+
+bool FAttackPayload::ReadFromSpec(const FGameplayEffectSpec& Spec, FAttackPayload& OutPayload)
+{
+	// Only the channels that have a value are on the spec, so match the spec's magnitudes against the channels instead of looking up each channel
+	bool bHasPayload = false;
+	for (const auto& [Tag, Magnitude] : Spec.SetByCallerTagMagnitudes)
+	{
+		for (int32 Index = 0; Index < static_cast<int32>(EDamageChannel::Max); Index++)
+		{
+			if (GetChannelTag(static_cast<EDamageChannel>(Index)) != Tag) continue;
+			OutPayload.Channels[Index] = Magnitude;
+			bHasPayload = true;
+			break;
+		}
+	}
+
+	return bHasPayload;
+}
+
+
+const FGameplayTag& FAttackPayload::GetChannelTag(const EDamageChannel Channel)
+{
+	static const FGameplayTag ChannelTags[] = {
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Standard),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Slash),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Pierce),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Strike),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Magic),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Ice),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Fire),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Holy),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Lightning),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Curse),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Bleed),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Poison),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Frostbite),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Madness),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Status_Sleep),
+		FGameplayTag::RequestGameplayTag(Tag_Data_Damage_Poise)
+	};
+	static_assert(UE_ARRAY_COUNT(ChannelTags) == static_cast<int32>(EDamageChannel::Max), "Every damage channel needs a tag");
+
+	return ChannelTags[static_cast<int32>(Channel)];
+}
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "GameplayTagContainer.h"
+#include "Sandbox/Data/Enums/AttributeTypes.h"
+
+struct FGameplayEffectSpec;
+
+
+/**
+ * The damage and status buildup of an attack, compiled once per combo step from the ability's attack information. @ref UCombatAbility::AttackInfo \n\n
+ *
+ * The payload is added to the damage calculation's spec as SetByCaller magnitudes (Data.Damage / Data.Status) and read back by the execution calculation,
+ * so attacks don't have to write the damages to the attacker's attribute set before every hit.
+ */
+struct SANDBOX_API FAttackPayload
+{
+	/** The value of each damage channel */
+	float Channels[static_cast<int32>(EDamageChannel::Max)] = {};
+
+	/** Returns the value of a damage channel */
+	float Get(const EDamageChannel Channel) const { return Channels[static_cast<int32>(Channel)]; }
+
+	/** Returns true if none of the damage channels have a value */
+	bool IsEmpty() const;
+
+	/**
+	 * Compiles an attack's attribute modifications into a payload. Attributes that aren't damage channels are ignored
+	 *
+	 * @param AttackInfo						The damages and attribute modifications of the attack
+	 * @returns									The attack payload
+	 */
+	static FAttackPayload Compile(const TMap<FGameplayAttribute, float>& AttackInfo);
+
+	/** Adds the payload to a spec as SetByCaller magnitudes. Channels without a value aren't added */
+	void ApplyToSpec(FGameplayEffectSpec& Spec) const;
+
+	/**
+	 * Reads a payload from a spec's SetByCaller magnitudes
+	 *
+	 * @param Spec								The damage calculation's spec
+	 * @param OutPayload						The attack payload
+	 * @returns									True if the spec has an attack payload
+	 */
+	static bool ReadFromSpec(const FGameplayEffectSpec& Spec, FAttackPayload& OutPayload);
+
+	/** Returns the SetByCaller tag of a damage channel */
+	static const FGameplayTag& GetChannelTag(EDamageChannel Channel);
+
+};
@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MeleeTargetData.h"
+
+bool FGameplayAbilityTargetData_MeleeHit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	FGameplayAbilityTargetData_ActorArray::NetSerialize(Ar, Map, bOutSuccess);
+	Ar << ClientTimeStamp;
+	Ar << HitAge;
+
+	bOutSuccess = bOutSuccess && !Ar.IsError();
+	return true;
+}
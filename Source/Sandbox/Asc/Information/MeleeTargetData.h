@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "MeleeTargetData.generated.h"
+
+
+/**
+ * Target data for a melee hit. It's the armament and the target (@ref FGameplayAbilityTargetData_ActorArray), the impact point and normal in the source location,
+ * and the server time the attacking client saw the hit at, which is used to rewind the target on the server. @ref ULagCompensationSubsystem
+ */
+USTRUCT(BlueprintType)
+struct SANDBOX_API FGameplayAbilityTargetData_MeleeHit : public FGameplayAbilityTargetData_ActorArray
+{
+	GENERATED_BODY()
+
+	/** The server time that the attacking client was viewing the target at when the hit happened */
+	UPROPERTY() double ClientTimeStamp = 0;
+
+	/** How long the hit waited on the client before it was sent to the server. The attack frames' hits are sent together once they've finished */
+	UPROPERTY() float HitAge = 0;
+
+	/** Returns the impact point of the hit */
+	FVector GetImpactPoint() const { return SourceLocation.LiteralTransform.GetLocation(); }
+
+	
+	//-----------------------------------------------------------------------------------//
+	// Boiler plate code																 //
+	//-----------------------------------------------------------------------------------//
+	/** Returns the actual struct used for serialization, subclasses must override this! */
+	virtual UScriptStruct* GetScriptStruct() const override
+	{
+		return StaticStruct();
+	}
+
+	/** Custom serialization, subclasses must override this */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	
+};
+
+
+template<>
+struct TStructOpsTypeTraits<FGameplayAbilityTargetData_MeleeHit> : public TStructOpsTypeTraitsBase2<FGameplayAbilityTargetData_MeleeHit>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
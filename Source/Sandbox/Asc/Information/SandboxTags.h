@@ -81,6 +81,29 @@
 #define Tag_GameplayEffect_Status_Sleep FName("GameplayEffect.Status.Sleep")
 
 
+// ; Gameplay Effect Data (SetByCaller magnitudes)
+#define Tag_Data FName("Data")
+#define Tag_Data_Duration FName("Data.Duration")
+#define Tag_Data_Damage FName("Data.Damage")
+#define Tag_Data_Damage_Standard FName("Data.Damage.Standard")
+#define Tag_Data_Damage_Slash FName("Data.Damage.Slash")
+#define Tag_Data_Damage_Pierce FName("Data.Damage.Pierce")
+#define Tag_Data_Damage_Strike FName("Data.Damage.Strike")
+#define Tag_Data_Damage_Magic FName("Data.Damage.Magic")
+#define Tag_Data_Damage_Ice FName("Data.Damage.Ice")
+#define Tag_Data_Damage_Fire FName("Data.Damage.Fire")
+#define Tag_Data_Damage_Holy FName("Data.Damage.Holy")
+#define Tag_Data_Damage_Lightning FName("Data.Damage.Lightning")
+#define Tag_Data_Damage_Poise FName("Data.Damage.Poise")
+#define Tag_Data_Status FName("Data.Status")
+#define Tag_Data_Status_Curse FName("Data.Status.Curse")
+#define Tag_Data_Status_Bleed FName("Data.Status.Bleed")
+#define Tag_Data_Status_Poison FName("Data.Status.Poison")
+#define Tag_Data_Status_Frostbite FName("Data.Status.Frostbite")
+#define Tag_Data_Status_Madness FName("Data.Status.Madness")
+#define Tag_Data_Status_Sleep FName("Data.Status.Sleep")
+
+
 // ; Gameplay Ability Tag Events
 #define Tag_Event_Montage FName("Event.Montage")
 #define Tag_Event_Montage_SpawnProjectile FName("Event.Montage.SpawnProjectile")
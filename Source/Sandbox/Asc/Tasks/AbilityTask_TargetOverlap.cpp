@@ -9,12 +9,32 @@
 #include "Logging/StructuredLog.h"
 #include "Sandbox/AI/Characters/Enemy.h"
 #include "Sandbox/Combat/Weapons/Armament.h"
+#include "Sandbox/Combat/LagCompensationSubsystem.h"
+#include "Sandbox/Asc/Information/MeleeTargetData.h"
+#include "GameplayCueManager.h"
 
-UAbilityTask_TargetOverlap* UAbilityTask_TargetOverlap::CreateOverlapDataTask(UGameplayAbility* OwningAbility, const TArray<AArmament*> Armaments, const bool bDebug)
+/** The most sweeps a hitbox is split into during a single frame */
+static constexpr int32 MaxHitboxSubSteps = 16;
+
+
+FHitboxSweep::FHitboxSweep(AArmament* Armament, UPrimitiveComponent* Hitbox) :
+	Armament(Armament),
+	Hitbox(Hitbox),
+	PreviousTransform(Hitbox ? Hitbox->GetComponentTransform() : FTransform::Identity)
+{
+}
+
+
+UAbilityTask_TargetOverlap* UAbilityTask_TargetOverlap::CreateOverlapDataTask(UGameplayAbility* OwningAbility, const TArray<AArmament*> Armaments, const F_MeleeTraceSettings TraceSettings, const bool bDebug)
 {
 	UAbilityTask_TargetOverlap* Task = NewAbilityTask<UAbilityTask_TargetOverlap>(OwningAbility);
 	Task->Armaments = Armaments;
+	Task->TraceSettings = TraceSettings;
 	Task->bDebugTask = bDebug;
+	Task->bTickingTask = TraceSettings.HitDetection == EMeleeHitDetection::Sweep;
+	Task->bReceivedTargetData = false;
+	Task->bFinishedAttackFrames = false;
+	Task->AttackFramesStartTime = 0;
 	return Task;
 }
 
@@ -72,6 +92,8 @@ void UAbilityTask_TargetOverlap::Activate()
 	FScopedPredictionWindow ScopedPrediction(ASC, IsPredictingClient());
 	if (!IsLocallyControlled())
 	{
+		AttackFramesStartTime = ULagCompensationSubsystem::GetServerWorldTime(Character);
+
 		// Get the ability spec and the prediction key to replicate the target data
 		const FGameplayAbilitySpecHandle SpecHandle = GetAbilitySpecHandle();
 		const FPredictionKey ActivationPredictionKey = GetActivationPredictionKey();
@@ -85,7 +107,26 @@ void UAbilityTask_TargetOverlap::Activate()
 		if (!bCalledDelegate) SetWaitingOnRemotePlayerData();
 	}
 	
-	// TODO: add Client side prediction
+	if (TraceSettings.HitDetection == EMeleeHitDetection::Sweep)
+	{
+		// Only the client that's attacking traces for targets, the server waits for their target data
+		if (!IsPredictingClient() && !IsLocallyControlled()) return;
+
+		SweepParams = FCollisionQueryParams(SCENE_QUERY_STAT(MeleeHitboxSweep), false, Character);
+		for (auto &[Armament, Hitboxes] : ArmamentHitboxes)
+		{
+			SweepParams.AddIgnoredActor(Armament);
+			for (UPrimitiveComponent* Hitbox : Hitboxes)
+			{
+				if (Hitbox) HitboxSweeps.Add(FHitboxSweep(Armament, Hitbox));
+			}
+		}
+
+		// Targets that are already overlapping are caught by the first sweep, since it doesn't move
+		SweepHitboxes();
+		return;
+	}
+	
 	for (auto &[Armament, Hitboxes] : ArmamentHitboxes)
 	{
 		for (UPrimitiveComponent* OverlapComponent : Hitboxes)
@@ -98,164 +139,332 @@ void UAbilityTask_TargetOverlap::Activate()
 }
 
 
+void UAbilityTask_TargetOverlap::TickTask(float DeltaTime)
+{
+	Super::TickTask(DeltaTime);
+	if (HitboxSweeps.IsEmpty()) return;
+	
+	SweepHitboxes();
+}
+
+
 void UAbilityTask_TargetOverlap::OnTraceOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	AActor* Character = Ability->GetAvatarActorFromActorInfo();
- 	if (Character == OtherActor) return;
+	// Search for the armament we attacked with using it's hitboxes
+	for (AArmament* Armament : Armaments)
+	{
+		if (Armament && Armament->GetArmamentHitboxes().Contains(OverlappedComponent))
+		{
+			// Overlaps that weren't from a sweep don't have an impact point, use the closest point on the target to the hitbox
+			FHitResult Hit = SweepResult;
+			if (!bFromSweep && OverlappedComponent && OtherComp)
+			{
+				OtherComp->GetClosestPointOnCollision(OverlappedComponent->GetComponentLocation(), Hit.ImpactPoint);
+				Hit.Location = Hit.ImpactPoint;
+			}
+			
+			HandleTargetHit(Armament, OverlappedComponent, OtherActor, Hit);
+		}
+	}
+}
+
+
+void UAbilityTask_TargetOverlap::SweepHitboxes()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	// Sweep every hitbox before handling any of the hits, so an attack's targets are all found from the same poses
+	TArray<TPair<int32, FHitResult>> Hits;
+	TArray<FHitResult> SweepResults;
+	for (int32 Index = 0; Index < HitboxSweeps.Num(); Index++)
+	{
+		FHitboxSweep& Sweep = HitboxSweeps[Index];
+		UPrimitiveComponent* Hitbox = Sweep.Hitbox.Get();
+		if (!Hitbox || !Sweep.Armament.IsValid()) continue;
+
+		const FTransform& Previous = Sweep.PreviousTransform;
+		const FTransform Current = Hitbox->GetComponentTransform();
+		const FCollisionShape Shape = Hitbox->GetCollisionShape();
+		const FCollisionResponseParams ResponseParams(Hitbox->GetCollisionResponseToChannels());
+
+		// Split the path into sub steps based on how far the hitbox traveled, including how far it's edges swung around it's center
+		const float Distance = FVector::Dist(Previous.GetLocation(), Current.GetLocation()) + Previous.GetRotation().AngularDistance(Current.GetRotation()) * Shape.GetExtent().Size();
+		const int32 SubSteps = FMath::Clamp(FMath::Max(TraceSettings.SubSteps, FMath::CeilToInt(Distance / FMath::Max(TraceSettings.MaxSubStepDistance, 1.f))), 1, MaxHitboxSubSteps);
+
+		FVector Start = Previous.GetLocation();
+		for (int32 Step = 1; Step <= SubSteps; Step++)
+		{
+			const FVector End = FMath::Lerp(Previous.GetLocation(), Current.GetLocation(), static_cast<float>(Step) / SubSteps);
+			const FQuat Rotation = FQuat::Slerp(Previous.GetRotation(), Current.GetRotation(), (Step - 0.5f) / SubSteps);
+
+			SweepResults.Reset();
+			World->SweepMultiByChannel(SweepResults, Start, End, Rotation, Hitbox->GetCollisionObjectType(), Shape, SweepParams, ResponseParams);
+			for (const FHitResult& Hit : SweepResults)
+			{
+				Hits.Add(TPair<int32, FHitResult>(Index, Hit));
+			}
+			
+			Start = End;
+		}
+
+		Sweep.PreviousTransform = Current;
+	}
+
+	for (const auto& [Index, Hit] : Hits)
+	{
+		if (!HitboxSweeps.IsValidIndex(Index)) continue;
+		HandleTargetHit(HitboxSweeps[Index].Armament.Get(), HitboxSweeps[Index].Hitbox.Get(), Hit.GetActor(), Hit);
+	}
+}
+
+
+void UAbilityTask_TargetOverlap::HandleTargetHit(AArmament* Armament, UPrimitiveComponent* Hitbox, AActor* Target, const FHitResult& Hit)
+{
+	AActor* Character = Ability ? Ability->GetAvatarActorFromActorInfo() : nullptr;
+ 	if (!Armament || !Character || Character == Target) return;
 
-	ACharacterBase* Target = Cast<ACharacterBase>(OtherActor);
-	if (!Target) return;
+	ACharacterBase* TargetCharacter = Cast<ACharacterBase>(Target);
+	if (!TargetCharacter) return;
 
+	// Each armament only hits a target once per swing
+	const TPair<TObjectKey<AArmament>, TObjectKey<AActor>> HitKey(Armament, Target);
+	if (HitTargets.Contains(HitKey)) return;
 
-	AEnemy* AITarget = Cast<AEnemy>(OtherActor);
-	UAbilitySystem* TargetAsc = Target->GetAbilitySystem<UAbilitySystem>();
+	AEnemy* AITarget = Cast<AEnemy>(Target);
+	UAbilitySystem* TargetAsc = TargetCharacter->GetAbilitySystem<UAbilitySystem>();
 	if (!TargetAsc && !AITarget)
 	{
 		UE_LOGFMT(AbilityLog, Log, "{0}::{1}() {2} Attacked a character with an invalid ability system component! Target: {3}",
-			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), *GetNameSafe(Target)
+			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), *GetNameSafe(TargetCharacter)
 		);
 		return;
 	}
 	
-	if (IsPredictingClient() || IsLocallyControlled())
+	if (!IsPredictingClient() && !IsLocallyControlled()) return;
+	if (!ShouldBroadcastAbilityTaskDelegates())
 	{
-		// This might need to always activate so every attack has their data mapped to an individual place in the AbilityTargetDataMap
-		if (!GetActivationPredictionKey().IsValidForMorePrediction())
-		{
-			FScopedPredictionWindow(Ability->GetAbilitySystemComponentFromActorInfo(), true);
-		}
+		if (bDebugTask) UE_LOGFMT(AbilityLog, Warning, "{0} did not broadcast overlap event!: {1} {2}()", *GetNameSafe(Character), *GetName(), *FString(__FUNCTION__));
+		return;
+	}
 
-		if (bDebugTask)
-		{
-			UE_LOGFMT(AbilityLog, Warning, "{0}: {1}'s armament {2} overlapped with {3}! {4} {5}()",
-				*UEnum::GetValueAsString(Character->GetLocalRole()),
-				*GetNameSafe(Character),
-				*GetNameSafe(OverlappedComponent),
-				*GetNameSafe(OtherActor),
-				*GetName(),
-				FString(__FUNCTION__)
-			);
-		}
+	if (bDebugTask)
+	{
+		UE_LOGFMT(AbilityLog, Warning, "{0}: {1}'s armament {2} hit {3} at {4}! {5} {6}()",
+			*UEnum::GetValueAsString(Character->GetLocalRole()),
+			*GetNameSafe(Character),
+			*GetNameSafe(Hitbox),
+			*GetNameSafe(Target),
+			*Hit.ImpactPoint.ToString(),
+			*GetName(),
+			FString(__FUNCTION__)
+		);
+	}
+
+	HitTargets.Add(HitKey);
+	FGameplayAbilityTargetData_MeleeHit* Data = new FGameplayAbilityTargetData_MeleeHit();
+	Data->ClientTimeStamp = ULagCompensationSubsystem::GetViewTime(Character);
+
+	// The impact point and the direction of the hit
+	FGameplayAbilityTargetingLocationInfo LocationInfo;
+	LocationInfo.LiteralTransform.SetLocation(Hit.ImpactPoint);
+	if (!Hit.ImpactNormal.IsNearlyZero()) LocationInfo.LiteralTransform.SetRotation(Hit.ImpactNormal.ToOrientationQuat());
+	LocationInfo.LocationType = EGameplayAbilityTargetingLocationType::LiteralTransform;
+	LocationInfo.SourceAbility = Ability;
+	LocationInfo.SourceActor = Armament;
+	Data->SourceLocation = LocationInfo;
+	
+	TArray<TWeakObjectPtr<AActor>> TargetInformation;
+	TargetInformation.Add(Armament); // Add the armament that we attacked with
+	TargetInformation.Add(Target); // Add the target character
+	Data->SetActors(TargetInformation);
 
+	// The server receives every hit of the attack frames together, once they've finished
+	const TSharedPtr<FGameplayAbilityTargetData> SharedData(Data);
+	if (IsPredictingClient())
+	{
+		PendingTargetData.Data.Add(SharedData);
 
-		if (ShouldBroadcastAbilityTaskDelegates())
+		// Play the hit cue on the target right away, it's removed once the server handles the hit
+		if (TraceSettings.PredictedHitCue.IsValid())
 		{
-			for (AArmament* Armament : Armaments)
-			{
-				// Search for the armament we attacked with using it's hitboxes
-				if (Armament && Armament->GetArmamentHitboxes().Contains(OverlappedComponent))
-				{
-					// TODO: Find out how to send valid information across the server
-					FGameplayAbilityTargetDataHandle TargetData = FGameplayAbilityTargetDataHandle();
-					// FGameplayAbilityTargetData_SingleTargetHit* Data = new FGameplayAbilityTargetData_SingleTargetHit(); // We can just use the weapon location on the server for proper hit reaction
-					FGameplayAbilityTargetData_ActorArray* Data = new FGameplayAbilityTargetData_ActorArray();
-
-					FGameplayAbilityTargetingLocationInfo LocationInfo;
-					LocationInfo.LiteralTransform.SetLocation(SweepResult.ImpactPoint);
-					LocationInfo.LocationType = EGameplayAbilityTargetingLocationType::LiteralTransform;
-					LocationInfo.SourceAbility = Ability;
-					LocationInfo.SourceActor = Armament;
-					Data->SourceLocation = LocationInfo;
-					
-					TArray<TWeakObjectPtr<AActor>> TargetInformation;
-					TargetInformation.Add(Armament); // Add the armament that we attacked with
-					TargetInformation.Add(OtherActor); // Add the target character
-					Data->SetActors(TargetInformation);
-					TargetData.Add(Data);
-					
-					// Send the replicated data to the server
-					if (AbilitySystemComponent.Get())
-					{
-						AbilitySystemComponent->ServerSetReplicatedTargetData(
-							GetAbilitySpecHandle(),
-							GetActivationPredictionKey(),
-							TargetData,
-							FGameplayTag(),
-							AbilitySystemComponent->ScopedPredictionKey
-						);
-					}
-
-					if (OnValidOverlap.IsBound())
-					{
-						if (bDebugTask) UE_LOGFMT(AbilityLog, Log, "{0} sending attack information from weapon {1}", *GetNameSafe(Character), *GetNameSafe(Armament));
-						OnValidOverlap.Broadcast(TargetData, TargetAsc);
-					}
-					else if (bDebugTask)
-					{
-						UE_LOGFMT(AbilityLog, Log, "{0}'s {1} traced a target without any listeners. Target {2}", *GetNameSafe(Character), *GetNameSafe(Armament), *GetNameSafe(OtherActor));
-					}
-				}
-			}
+			FPredictedHit PredictedHit;
+			PredictedHit.Target = Target;
+			PredictedHit.Cue = TraceSettings.PredictedHitCue;
+			PredictedHit.Parameters.Location = Hit.ImpactPoint;
+			PredictedHit.Parameters.Normal = Hit.ImpactNormal;
+			PredictedHit.Parameters.Instigator = Character;
+			PredictedHit.Parameters.EffectCauser = Armament;
+			PredictedHit.Parameters.SourceObject = Armament;
+			UGameplayCueManager::AddGameplayCue_NonReplicated(Target, PredictedHit.Cue, PredictedHit.Parameters);
+			PredictedHits.Add(PredictedHit);
 		}
-		else if (bDebugTask) UE_LOGFMT(AbilityLog, Warning, "{0} did not broadcast overlap event!: {1} {2}()", *GetNameSafe(Character), *GetName(), *FString(__FUNCTION__));
+	}
+
+	// Predict the attack locally
+	FGameplayAbilityTargetDataHandle TargetData;
+	TargetData.Data.Add(SharedData);
+	if (OnValidOverlap.IsBound())
+	{
+		if (bDebugTask) UE_LOGFMT(AbilityLog, Log, "{0} predicting attack information from weapon {1}", *GetNameSafe(Character), *GetNameSafe(Armament));
+		OnValidOverlap.Broadcast(TargetData, TargetAsc);
+	}
+	else if (bDebugTask)
+	{
+		UE_LOGFMT(AbilityLog, Log, "{0}'s {1} traced a target without any listeners. Target {2}", *GetNameSafe(Character), *GetNameSafe(Armament), *GetNameSafe(Target));
 	}
 }
 
 
-void UAbilityTask_TargetOverlap::OnTargetDataReplicatedCallback(const FGameplayAbilityTargetDataHandle& DataHandle, FGameplayTag ActivationTag)
+void UAbilityTask_TargetOverlap::SendPendingTargetData()
 {
-	ACharacterBase* Character = AbilitySystemComponent.Get() ? Cast<ACharacterBase>(AbilitySystemComponent->GetAvatarActor()) : nullptr;
-	if (!Character)
+	UAbilitySystem* ASC = Cast<UAbilitySystem>(AbilitySystemComponent.Get());
+	if (!ASC) return;
+
+	// The hits waited until the attack frames finished, let the server know how long so they can be rewound further
+	const double ViewTime = ULagCompensationSubsystem::GetViewTime(ASC->GetAvatarActor());
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : PendingTargetData.Data)
 	{
-		UE_LOGFMT(AbilityLog, Error, "{1}() {2}'s Replicated weapon overlap target data was sent when the character information wasn't valid!",
-			*FString(__FUNCTION__), *GetNameSafe(AbilitySystemComponent.Get()));
-		return;
+		if (!Data.IsValid() || Data->GetScriptStruct() != FGameplayAbilityTargetData_MeleeHit::StaticStruct()) continue;
+
+		FGameplayAbilityTargetData_MeleeHit* MeleeHit = static_cast<FGameplayAbilityTargetData_MeleeHit*>(Data.Get());
+		MeleeHit->HitAge = FMath::Max(static_cast<float>(ViewTime - MeleeHit->ClientTimeStamp), 0.f);
 	}
 
-	// Retrieve the target information
-	TArray<TWeakObjectPtr<AActor>> TargetInformation;
-	for (TSharedPtr<FGameplayAbilityTargetData> Data : DataHandle.Data)
+	// Every hit is sent with one prediction key, which the predicted hits are rolled back with if the server rejects them.
+	// The hits are sent even if there weren't any, the server's task waits for them before it ends
+	FScopedPredictionWindow ScopedPrediction(ASC, true);
+	TargetDataPredictionKey = ASC->ScopedPredictionKey;
+	ASC->AddPredictedHits(ASC->ScopedPredictionKey, PredictedHits);
+	ASC->ServerSetReplicatedTargetData(
+		GetAbilitySpecHandle(),
+		GetActivationPredictionKey(),
+		PendingTargetData,
+		FGameplayTag(),
+		ASC->ScopedPredictionKey
+	);
+
+	if (bDebugTask)
 	{
-		if (!Data.IsValid()) continue;
-		TargetInformation = Data->GetActors();
+		UE_LOGFMT(AbilityLog, Log, "{0}() {1} sent {2} hits to the server", *FString(__FUNCTION__), *GetNameSafe(ASC->GetAvatarActor()), PendingTargetData.Data.Num());
 	}
 
-	if (TargetInformation.IsEmpty())
+	PendingTargetData.Clear();
+	PredictedHits.Empty();
+}
+
+
+void UAbilityTask_TargetOverlap::FinishAttackFrames()
+{
+	// The server keeps listening for the client's hits, which are sent once their attack frames have finished
+	if (IsForRemoteClient() && !bReceivedTargetData)
 	{
-		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s Replicated weapon overlap target data was sent without any information!",
-			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character));
+		bFinishedAttackFrames = true;
 		return;
 	}
-	
-	// Retrieve the character and the weapon
-	AArmament* OverlappedArmament = nullptr;
-	ACharacterBase* TargetCharacter = nullptr;
-	for (TWeakObjectPtr<AActor> Actor : TargetInformation)
+
+	EndTask();
+}
+
+
+void UAbilityTask_TargetOverlap::OnTargetDataReplicatedCallback(const FGameplayAbilityTargetDataHandle& DataHandle, FGameplayTag ActivationTag)
+{
+	UAbilitySystem* ASC = Cast<UAbilitySystem>(AbilitySystemComponent.Get());
+	ACharacterBase* Character = ASC ? Cast<ACharacterBase>(ASC->GetAvatarActor()) : nullptr;
+	if (!Character)
 	{
-		if (!Actor.Get()) continue;
+		UE_LOGFMT(AbilityLog, Error, "{0}() {1}'s Replicated weapon overlap target data was sent when the character information wasn't valid!",
+			*FString(__FUNCTION__), *GetNameSafe(AbilitySystemComponent.Get()));
+		return;
+	}
 
-		// Check if this is the target we attacked
-		if (Cast<ACharacterBase>(Actor.Get())) TargetCharacter = Cast<ACharacterBase>(Actor.Get());
+	const FPredictionKey PredictionKey = ASC->ScopedPredictionKey;
+	ASC->ConsumeClientReplicatedTargetData(GetAbilitySpecHandle(), GetActivationPredictionKey());
+	bReceivedTargetData = true;
 
-		// Check if this is the weapon we attacked with
-		if (Cast<AArmament>(Actor.Get())) OverlappedArmament = Cast<AArmament>(Actor.Get());
+	if (DataHandle.Data.IsEmpty() && bDebugTask)
+	{
+		UE_LOGFMT(AbilityLog, Log, "{0}::{1}() {2}'s attack frames didn't hit anything",
+			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character));
 	}
 
-	if (!OverlappedArmament || !TargetCharacter)
+	// Handle each of the hits from the client's attack frames
+	TArray<AActor*> RejectedTargets;
+	ULagCompensationSubsystem* LagCompensation = ULagCompensationSubsystem::Get(Character);
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : DataHandle.Data)
 	{
-		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s Replicated weapon overlap target data is missing information! Weapon: {3}, Target: {4}",
-			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), *GetNameSafe(OverlappedArmament), *GetNameSafe(TargetCharacter));
+		if (!Data.IsValid()) continue;
+
+		// Retrieve the character and the weapon
+		AArmament* OverlappedArmament = nullptr;
+		ACharacterBase* TargetCharacter = nullptr;
+		for (const TWeakObjectPtr<AActor>& Actor : Data->GetActors())
+		{
+			if (!Actor.Get()) continue;
+
+			// Check if this is the target we attacked
+			if (Cast<ACharacterBase>(Actor.Get())) TargetCharacter = Cast<ACharacterBase>(Actor.Get());
+
+			// Check if this is the weapon we attacked with
+			if (Cast<AArmament>(Actor.Get())) OverlappedArmament = Cast<AArmament>(Actor.Get());
+		}
+
+		if (!OverlappedArmament || !TargetCharacter)
+		{
+			UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s Replicated weapon overlap target data is missing information! Weapon: {3}, Target: {4}",
+				*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), *GetNameSafe(OverlappedArmament), *GetNameSafe(TargetCharacter));
+			continue;
+		}
+
+		// Validate the hit against where the client saw the target. The hit can't have waited longer than the attack has been active on the server
+		if (LagCompensation && Data->GetScriptStruct() == FGameplayAbilityTargetData_MeleeHit::StaticStruct())
+		{
+			const FGameplayAbilityTargetData_MeleeHit* MeleeHit = static_cast<const FGameplayAbilityTargetData_MeleeHit*>(Data.Get());
+			const float HitAge = FMath::Min(MeleeHit->HitAge, static_cast<float>(ULagCompensationSubsystem::GetServerWorldTime(Character) - AttackFramesStartTime));
+			if (!LagCompensation->ValidateHit(Character, TargetCharacter, MeleeHit->GetImpactPoint(), MeleeHit->ClientTimeStamp, HitAge))
+			{
+				RejectedTargets.Add(TargetCharacter);
+				continue;
+			}
+		}
+
+		UAbilitySystem* TargetAsc = TargetCharacter->GetAbilitySystem<UAbilitySystem>();
+		if (!TargetAsc)
+		{
+			// AI character replicated information on clients (shouldn't happen)
+			UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s weapon overlap attacked a character without an ability system!",
+				*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character));
+		}
+
+		if (ShouldBroadcastAbilityTaskDelegates())
+		{
+			FGameplayAbilityTargetDataHandle TargetData;
+			TargetData.Data.Add(Data);
+			OnValidOverlap.Broadcast(TargetData, TargetAsc);
+		}
 	}
 
-	UAbilitySystem* TargetAsc = TargetCharacter->GetAbilitySystem<UAbilitySystem>();
-	if (!TargetAsc)
+	// Roll back the client's hits that weren't valid
+	if (!RejectedTargets.IsEmpty())
 	{
-		// AI character replicated information on clients (shouldn't happen)
-		UE_LOGFMT(AbilityLog, Error, "{0}::{1}() {2}'s weapon overlap attacked a character without an ability system!",
-			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character));
-		// return;
+		ASC->Client_RejectPredictedHits(PredictionKey, RejectedTargets);
 	}
 
-	if (ShouldBroadcastAbilityTaskDelegates())
+	if (bFinishedAttackFrames)
 	{
-		AbilitySystemComponent->ConsumeClientReplicatedTargetData(GetAbilitySpecHandle(), GetActivationPredictionKey());
-		OnValidOverlap.Broadcast(DataHandle, TargetAsc);
+		EndTask();
 	}
 }
 
 
 void UAbilityTask_TargetOverlap::OnDestroy(bool AbilityEnded)
 {
+	// Send the hits from the attack frames to the server
+	if (IsPredictingClient())
+	{
+		SendPendingTargetData();
+	}
+	
 	for (AArmament* Armament : Armaments)
 	{
 		if (!Armament) continue;
@@ -268,6 +477,14 @@ void UAbilityTask_TargetOverlap::OnDestroy(bool AbilityEnded)
 			OverlapComponent->OnComponentBeginOverlap.RemoveDynamic(this, &UAbilityTask_TargetOverlap::OnTraceOverlap);
 		}
 	}
-	
+
+	// Stop listening for the client's hits
+	if (AbilitySystemComponent.Get() && !IsLocallyControlled())
+	{
+		AbilitySystemComponent->AbilityTargetDataSetDelegate(GetAbilitySpecHandle(), GetActivationPredictionKey()).RemoveAll(this);
+	}
+
+	HitboxSweeps.Empty();
+	HitTargets.Empty();
 	Super::OnDestroy(AbilityEnded);
 }
@@ -3,20 +3,42 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "UObject/ObjectKey.h"
+#include "Sandbox/Asc/AbilitySystem.h"
+#include "Sandbox/Data/Structs/CombatInformation.h"
 #include "AbilityTask_TargetOverlap.generated.h"
 
-class UAbilitySystem;
 class AArmament;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAbilityTask_TargetOverlapDataSignature, const FGameplayAbilityTargetDataHandle&, DataHandle, UAbilitySystem*, TargetAsc);
 
 
+/** A hitbox that's swept from it's previous pose to it's current pose during the attack frames */
+struct FHitboxSweep
+{
+	FHitboxSweep(AArmament* Armament, UPrimitiveComponent* Hitbox);
+
+	/** The armament the hitbox belongs to */
+	TWeakObjectPtr<AArmament> Armament;
+
+	/** The hitbox */
+	TWeakObjectPtr<UPrimitiveComponent> Hitbox;
+
+	/** The hitbox's transform after the last sweep */
+	FTransform PreviousTransform;
+	
+};
+
+
 /**
- * TODO: This is target data that hasn't been tested on whether this sends multiple target data values, and that those values are getting mixed together in the AbilityTargetDataMap
- *		- Test that this sends multiple targets to an ability, and successfully applies damage to all the enemies (slow down the attack a bunch and check that prediction keys are staying valid and it's working
- *		- Idk how to test this, and we don't have TDD in place yet, but we need to make sure that multiple target data mappings are being uniquely added to the AbilityTargetDataMap
- *				(it's based on the ability and prediction key, which we're not making multiple of) -> this should be an easy fix though
+ * Traces the armaments for targets during an attack's frames, and sends the hits to the server. \n\n
+ *
+ * The attacking client predicts each hit as soon as it happens (OnValidOverlap and the PredictedHitCue), and every hit from the attack frames is sent to the server together in a single target data handle once they've finished.
+ * The server validates each hit, and the hits it rejects are rolled back on the client with the prediction key they were sent with. @ref UAbilitySystem::Client_RejectPredictedHits
+ *	- Call FinishAttackFrames() instead of EndTask() once the attack frames end, the server's task waits for the client's hits before it ends
+ *	- Each hit includes how long it waited on the client, so hits from the start of long attack frames are still rewound to when they happened
  */
 UCLASS()
 class SANDBOX_API UAbilityTask_TargetOverlap : public UAbilityTask
@@ -26,32 +48,94 @@ class SANDBOX_API UAbilityTask_TargetOverlap : public UAbilityTask
 public:
 	/** Retrieves the target's overlap data from the client and replicates it to the server */
 	UFUNCTION(BlueprintCallable, Category="Ability|Tasks", meta = (DisplayName = "Get Target Overlap Data", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true"))
-	static UAbilityTask_TargetOverlap* CreateOverlapDataTask(UGameplayAbility* OwningAbility, TArray<AArmament*> Armaments, bool bDebug = false);
+	static UAbilityTask_TargetOverlap* CreateOverlapDataTask(UGameplayAbility* OwningAbility, TArray<AArmament*> Armaments, F_MeleeTraceSettings TraceSettings, bool bDebug = false);
 
-	/** Delegate for when the overlap data has been replicated to the server */
+	/** Delegate for when a target has been hit. Broadcasts right away on the attacking client, and once the hit has been validated on the server */
 	UPROPERTY(BlueprintAssignable)
 	FAbilityTask_TargetOverlapDataSignature OnValidOverlap;
 
+	/** Ends the task once the attack frames have finished. On the server this waits until the client's hits have been received */
+	UFUNCTION(BlueprintCallable, Category="Ability|Tasks")
+	virtual void FinishAttackFrames();
+
+	/** Returns the prediction key the client's hits were sent with, which isn't valid until the attack frames have finished */
+	const FPredictionKey& GetTargetDataPredictionKey() const { return TargetDataPredictionKey; }
+
 	
 protected:
 	/** The weapons that we're using for overlaps */
 	UPROPERTY(BlueprintReadWrite) TArray<AArmament*> Armaments;
 	
+	/** How the armaments trace for targets */
+	UPROPERTY(BlueprintReadWrite) F_MeleeTraceSettings TraceSettings;
+	
 	/** Whether we should debug the task information */
 	bool bDebugTask;
 
+	/** The hitboxes that are swept each frame */
+	TArray<FHitboxSweep> HitboxSweeps;
+
+	/** The query params shared by every sweep during the attack */
+	FCollisionQueryParams SweepParams;
+
+	/** The targets each armament has already hit during this swing */
+	TSet<TPair<TObjectKey<AArmament>, TObjectKey<AActor>>> HitTargets;
+
+	/** The client's hits that are sent to the server once the attack frames have finished */
+	FGameplayAbilityTargetDataHandle PendingTargetData;
+
+	/** The cues the client has played for the pending hits */
+	TArray<FPredictedHit> PredictedHits;
+
+	/** The prediction key the client's hits were sent with */
+	FPredictionKey TargetDataPredictionKey;
+
+	/** Whether the server has received the client's hits */
+	bool bReceivedTargetData;
+
+	/** Whether the attack frames have finished, and the server's only waiting on the client's hits */
+	bool bFinishedAttackFrames;
+
+	/** The server time the attack frames began at on the server. The client's hits can't have waited longer than this */
+	double AttackFramesStartTime;
+
 	
 protected:
 	/** Called to trigger the actual task once the delegates have been set up */
 	virtual void Activate() override;
 
+	/** Sweeps the hitboxes along their path since the last frame */
+	virtual void TickTask(float DeltaTime) override;
+
 	/** Overlap event function to capture a primitive object's overlap event */	
 	UFUNCTION() void OnTraceOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	/** Once the input information has made it to the server, retrieves the input information */
+	/**
+	 * Sweeps every hitbox from it's previous pose to it's current pose, and handles the new targets once every sweep has finished. \n\n
+	 * The path between the poses is split into sub steps, so fast swings don't pass through targets between frames
+	 */
+	virtual void SweepHitboxes();
+
+	/**
+	 * Predicts an armament's hit on a target and adds it to the pending target data, if the armament hasn't already hit them during this swing
+	 *
+	 * @param Armament							The armament that hit the target
+	 * @param Hitbox							The armament's hitbox
+	 * @param Target							The target
+	 * @param Hit								The impact information
+	 */
+	virtual void HandleTargetHit(AArmament* Armament, UPrimitiveComponent* Hitbox, AActor* Target, const FHitResult& Hit);
+
+	/**
+	 * Sends the pending hits to the server with a new prediction key, and tracks the predicted cues with it. Each hit includes how long it waited, so the server can rewind it further. \n\n
+	 * The hits are sent even if the attack frames didn't hit anything, so the server's task knows it can finish
+	 */
+	virtual void SendPendingTargetData();
+
+	/** Once the client's hits have made it to the server, validates each of them and rejects the invalid ones */
 	void OnTargetDataReplicatedCallback(const FGameplayAbilityTargetDataHandle& DataHandle, FGameplayTag ActivationTag);
 
-	/** Unbind the component overlap of this armament */
+	/** Sends the pending hits and unbinds the component overlap of this armament */
 	virtual void OnDestroy(bool AbilityEnded) override;
 	
 	
@@ -20,6 +20,9 @@
 #include "Net/UnrealNetwork.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Game/MultiplayerGameMode.h"
+#include "Sandbox/Game/Saving/SaveableActorRegistry.h"
+#include "Sandbox/Combat/CombatGridSubsystem.h"
+#include "Sandbox/Combat/LagCompensationSubsystem.h"
 
 
 ACharacterBase::ACharacterBase(const FObjectInitializer& ObjectInitializer) : Super(
@@ -79,6 +82,44 @@ void ACharacterBase::BeginPlay()
 	if (Gauntlets) Armor_Gauntlets = Gauntlets->GetSkeletalMeshAsset();
 	if (Helm) Armor_Helm = Helm->GetSkeletalMeshAsset();
 	if (Chest) Armor_Chest = Chest->GetSkeletalMeshAsset();
+
+	// Level save information
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->RegisterActor(this);
+	}
+
+	// Melee hit validation
+	if (ULagCompensationSubsystem* LagCompensation = ULagCompensationSubsystem::Get(this))
+	{
+		LagCompensation->RegisterCharacter(this);
+	}
+
+	// Target locking and nearby character queries
+	if (UCombatGridSubsystem* CombatGrid = UCombatGridSubsystem::Get(this))
+	{
+		CombatGrid->RegisterCharacter(this);
+	}
+}
+
+void ACharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->UnregisterActor(this);
+	}
+
+	if (ULagCompensationSubsystem* LagCompensation = ULagCompensationSubsystem::Get(this))
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	if (UCombatGridSubsystem* CombatGrid = UCombatGridSubsystem::Get(this))
+	{
+		CombatGrid->UnregisterCharacter(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACharacterBase::PossessedBy(AController* NewController)
@@ -174,7 +215,7 @@ F_LevelSaveInformation_Actor ACharacterBase::SaveToLevel_Implementation()
 	SaveConfig.Location = GetActorLocation();
 	SaveConfig.Actor = this;
 	SaveConfig.Rotation = GetActorRotation();
-	SaveConfig.Class = GetClass()->StaticClass();
+	SaveConfig.Class = GetClass();
 	
 	SaveConfig.UpdateConfig(
 	SaveComponent->HandlesSaving(ESaveType::Attributes), 
@@ -644,6 +644,9 @@ public:
 protected:
 	/** Called when play begins for this actor. */
 	virtual void BeginPlay() override;
+
+	/** Called when the actor is being removed from the level */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	/** 
 	 * Called when this Pawn is possessed. Only called on the server (or in standalone).
@@ -6,6 +6,7 @@
 #include "Components/CapsuleComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "KismetTraceUtils.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Asc/AbilitySystem.h"
 #include "Sandbox/Characters/Components/Camera/CharacterCameraLogic.h"
@@ -20,6 +21,87 @@ namespace CharacterMovementConstants // @ref 5.4
 	const float VERTICAL_SLOPE_NORMAL_Z = 0.001f; // Slope is vertical if Abs(Normal.Z) <= this threshold. Accounts for precision problems that sometimes angle normals slightly off horizontal for vertical surface.
 }
 
+namespace MoveDataQuantization
+{
+	/** Input is sent with 8 bits per axis, keyboard input (-1, 0, 1) stays exact */
+	constexpr int32 InputAxisMax = 127;
+
+	/** Ledge and mantle targets are sent relative to the character with 12 bits per axis, at a quarter unit precision (+-511 units) */
+	constexpr int32 TargetAxisMax = 2047;
+	constexpr float TargetPrecision = 4.f;
+
+	int32 QuantizeInputAxis(const float Value) { return FMath::RoundToInt(FMath::Clamp(Value, -1.f, 1.f) * InputAxisMax); }
+	float DequantizeInputAxis(const int32 Value) { return static_cast<float>(Value) / InputAxisMax; }
+	FVector2D QuantizeInput(const FVector2D& Input) { return FVector2D(DequantizeInputAxis(QuantizeInputAxis(Input.X)), DequantizeInputAxis(QuantizeInputAxis(Input.Y))); }
+
+	void SerializeBit(FArchive& Ar, bool& bValue)
+	{
+		uint8 Bit = bValue ? 1 : 0;
+		Ar.SerializeBits(&Bit, 1);
+		bValue = Bit != 0;
+	}
+
+	/** Serializes a ledge or mantle target, relative to the previous move's target and the character's location */
+	void SerializeTarget(FArchive& Ar, UPackageMap* PackageMap, FVector_NetQuantize10& Target, const FVector& Baseline, const FVector& Origin, const bool bCanBeRelative)
+	{
+		bool bChanged = Target != Baseline;
+		SerializeBit(Ar, bChanged);
+		if (!bChanged)
+		{
+			Target = Baseline;
+			return;
+		}
+
+		bool bHasTarget = !Target.IsZero();
+		SerializeBit(Ar, bHasTarget);
+		if (!bHasTarget)
+		{
+			Target = FVector_NetQuantize10::ZeroVector;
+			return;
+		}
+
+		// Targets are near the character, fall back to the full location if they're out of range or the character's location is relative to it's base
+		const FVector Delta = (Target - Origin) * TargetPrecision;
+		bool bRelative = bCanBeRelative && Delta.GetAbsMax() < TargetAxisMax;
+		SerializeBit(Ar, bRelative);
+		if (!bRelative)
+		{
+			bool bSuccess = true;
+			Target.NetSerialize(Ar, PackageMap, bSuccess);
+			return;
+		}
+
+		FVector QuantizedDelta;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			uint32 Value = FMath::RoundToInt(Delta[Axis]) + TargetAxisMax;
+			Ar.SerializeInt(Value, TargetAxisMax * 2 + 1);
+			QuantizedDelta[Axis] = static_cast<int32>(Value) - TargetAxisMax;
+		}
+
+		if (Ar.IsLoading()) Target = Origin + QuantizedDelta / TargetPrecision;
+	}
+}
+
+DECLARE_STATS_GROUP(TEXT("AdvancedMovement"), STATGROUP_AdvancedMovement, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Movement Traces"), STAT_MovementTraces, STATGROUP_AdvancedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shared Movement Traces"), STAT_SharedMovementTraces, STATGROUP_AdvancedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Revalidated Movement Traces"), STAT_RevalidatedMovementTraces, STATGROUP_AdvancedMovement);
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarMovementTraceStats(
+	TEXT("Sandbox.Movement.TraceStats"),
+	false,
+	TEXT("Logs each character's movement traces per second, and how many probes were shared instead of traced")
+);
+
+static TAutoConsoleVariable<bool> CVarMovementNetStats(
+	TEXT("Sandbox.Movement.NetStats"),
+	false,
+	TEXT("Logs each client's upstream movement bandwidth, and how many moves are sent per packet")
+);
+#endif
+
 
 
 UAdvancedMovementComponent::UAdvancedMovementComponent()
@@ -219,6 +301,19 @@ UAdvancedMovementComponent::UAdvancedMovementComponent()
 
 	// Other
 	TraceDuration = 5;
+	MovementQuerySignature = 0;
+	MovementQueryFrame = 0;
+#if !UE_BUILD_SHIPPING
+	NumMovementTraces = 0;
+	NumSharedMovementTraces = 0;
+	MovementTraceStatsTime = 0;
+	NumMovePackets = 0;
+	NumPackedMoves = 0;
+	NumMovePacketBits = 0;
+	MovementNetStatsTime = 0;
+	NumServerCorrections = 0;
+	NumLoggedServerCorrections = 0;
+#endif
 }
 
 
@@ -348,6 +443,8 @@ void UAdvancedMovementComponent::TickComponent(float DeltaTime, ELevelTick TickT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	Time += DeltaTime;
+	UpdateMovementTraceStats();
+	UpdateMovementNetStats();
 }
 #pragma endregion 
 
@@ -1594,42 +1691,12 @@ bool UAdvancedMovementComponent::WallJumpValid(float deltaTime, const FVector& O
 	const FVector InputDir = Start + InputVector * WallJumpValidDistance;
 	const FVector Front = Start + UpdatedComponent->GetForwardVector() * WallJumpValidDistance;
 	
-	TArray<AActor*> CharacterActors;
-	CharacterOwner->GetAllChildActors(CharacterActors); // TODO: Investigate if this includes player spawned actors
-	CharacterActors.AddUnique(CharacterOwner);
-
 	// Check whether there's a wall in front or behind the player
-	UKismetSystemLibrary::LineTraceSingle(
-		GetWorld(),
-		Start,
-		InputDir,
-		MovementChannel,
-		false,
-		CharacterActors,
-		bDebugWallJumpTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		JumpHit,
-		true,
-		FColor::Emerald,
-		FColor::Blue,
-		TraceDuration
-	);
+	MovementTrace(JumpHit, Start, InputDir, 0, false, bDebugWallJumpTrace, FColor::Emerald, FColor::Blue);
 
 	if (!JumpHit.bBlockingHit)
 	{
-		UKismetSystemLibrary::LineTraceSingle(
-			GetWorld(),
-			Start,
-			Front,
-			MovementChannel,
-			false,
-			CharacterActors,
-			bDebugWallJumpTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-			JumpHit,
-			true,
-			FColor::Cyan,
-			FColor::Blue,
-			TraceDuration
-		);
+		MovementTrace(JumpHit, Start, Front, 0, false, bDebugWallJumpTrace, FColor::Cyan, FColor::Blue);
 
 		if (!JumpHit.bBlockingHit)
 		{
@@ -2219,10 +2286,6 @@ bool UAdvancedMovementComponent::CheckIfSafeToMantleLedge()
 	float CrouchHalfHeight = GetCrouchedHalfHeight();
 	float CrouchDifference = CharacterHalfHeight - CrouchHalfHeight;
 	
-	TArray<AActor*> CharacterActors; 
-	CharacterOwner->GetAllChildActors(CharacterActors);
-	CharacterActors.AddUnique(CharacterOwner);
-	
 	// Search for a wall
 	FVector InitialTraceStart = UpdatedComponent->GetComponentLocation() - FVector(0, 0, MantleTraceHeightOffset);
 	FVector InitialTraceEnd = InitialTraceStart + UpdatedComponent->GetForwardVector() * MantleTraceDistance;
@@ -2230,12 +2293,7 @@ bool UAdvancedMovementComponent::CheckIfSafeToMantleLedge()
 	// else InitialTraceEnd = InitialTraceStart + (-MantleWallNormal * MantleTraceDistance);
 	
 	FHitResult Wall;
-	UKismetSystemLibrary::LineTraceSingleForObjects(
-		GetWorld(), InitialTraceStart, InitialTraceEnd,
-		MantleObjects,false, CharacterActors,
-		bDebugMantleAndClimbTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		Wall,true, FColor::Emerald, FColor::Red, TraceDuration
-	);
+	MovementTrace(Wall, InitialTraceStart, InitialTraceEnd, 0, true, bDebugMantleAndClimbTrace, FColor::Emerald, FColor::Red);
 	if (!Wall.IsValidBlockingHit())
 	{
 		return false;
@@ -2245,12 +2303,7 @@ bool UAdvancedMovementComponent::CheckIfSafeToMantleLedge()
 	const FVector LedgeSurfaceEnd = Wall.Location + (-Wall.Normal * MantleSurfaceTraceFromLedgeOffset);
 	const FVector LedgeSurfaceStart = LedgeSurfaceEnd + FVector(0, 0, MantleSecondTraceDistance);
 	FHitResult Ledge;
-	UKismetSystemLibrary::LineTraceSingleForObjects(
-		GetWorld(), LedgeSurfaceStart, LedgeSurfaceEnd,
-		MantleObjects, false, CharacterActors,
-		bDebugMantleAndClimbTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		Ledge, true, FColor::Emerald, FColor::Red, TraceDuration
-	);
+	MovementTrace(Ledge, LedgeSurfaceStart, LedgeSurfaceEnd, 0, true, bDebugMantleAndClimbTrace, FColor::Emerald, FColor::Red);
 	if (!Ledge.IsValidBlockingHit() || LedgeSurfaceStart.Equals(Ledge.ImpactPoint, 1))
 	{
 		return false;
@@ -2261,12 +2314,7 @@ bool UAdvancedMovementComponent::CheckIfSafeToMantleLedge()
 	FVector ClimbStart = FrontOfLedgeMidpoint + (FVector(0, 0, (CharacterHalfHeightNoHemisphere - CrouchDifference) * 2)) - FVector(0, 0, MantleTraceHeightOffset);
 	FVector ClimbEnd = FVector(ClimbStart.X, ClimbStart.Y, UpdatedComponent->GetComponentLocation().Z + MantleTraceHeightOffset - CharacterHalfHeightNoHemisphere);
 	FHitResult ClimbSpace;
-	UKismetSystemLibrary::SphereTraceSingleForObjects(
-		GetWorld(), ClimbStart, ClimbEnd, CharacterRadius,
-		MantleObjects, false, CharacterActors,
-		bDebugMantleAndClimbTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		ClimbSpace, true, FColor::Turquoise, FColor::Red, TraceDuration
-	);
+	MovementTrace(ClimbSpace, ClimbStart, ClimbEnd, CharacterRadius, true, bDebugMantleAndClimbTrace, FColor::Turquoise, FColor::Red);
 	if (ClimbSpace.IsValidBlockingHit())
 	{
 		return false;
@@ -2276,21 +2324,11 @@ bool UAdvancedMovementComponent::CheckIfSafeToMantleLedge()
 	FVector LedgeWalkStart = Ledge.Location + FVector(0, 0, MantleTraceHeightOffset + CharacterHemisphereHeight);
 	FVector LedgeWalkEnd = LedgeWalkStart + FVector(0, 0, CharacterHalfHeightNoHemisphere * 2);
 	FHitResult LedgeRoom;
-	UKismetSystemLibrary::SphereTraceSingleForObjects(
-		GetWorld(), LedgeWalkStart, LedgeWalkEnd, CharacterRadius,
-		MantleObjects, false, CharacterActors,
-		bDebugMantleAndClimbTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		LedgeRoom, true, FColor::Emerald, FColor::Emerald,TraceDuration
-	);
+	MovementTrace(LedgeRoom, LedgeWalkStart, LedgeWalkEnd, CharacterRadius, true, bDebugMantleAndClimbTrace, FColor::Emerald, FColor::Emerald);
 	if (LedgeRoom.IsValidBlockingHit())
 	{
 		LedgeWalkEnd -= FVector(0, 0, CrouchDifference * 2);
-		UKismetSystemLibrary::SphereTraceSingleForObjects(
-			GetWorld(), LedgeWalkStart, LedgeWalkEnd, CharacterRadius,
-			MantleObjects, false, CharacterActors,
-			bDebugMantleAndClimbTrace ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-			LedgeRoom, true, FColor::Emerald, FColor::Red,TraceDuration
-		);
+		MovementTrace(LedgeRoom, LedgeWalkStart, LedgeWalkEnd, CharacterRadius, true, bDebugMantleAndClimbTrace, FColor::Emerald, FColor::Red);
 
 		if (LedgeRoom.IsValidBlockingHit())
 		{
@@ -2527,6 +2565,31 @@ void UAdvancedMovementComponent::MoveAutonomous(float ClientTimeStamp, float Del
 }
 
 
+void UAdvancedMovementComponent::ServerMovePacked_ClientSend(const FCharacterServerMovePackedBits& PackedBits)
+{
+#if !UE_BUILD_SHIPPING
+	if (MovementNetStatsTime != 0)
+	{
+		NumMovePackets++;
+		NumPackedMoves += 1 + CustomMoveDataContainer.bHasPendingMove + CustomMoveDataContainer.bHasOldMove;
+		NumMovePacketBits += PackedBits.DataBits.Num();
+	}
+#endif
+
+	Super::ServerMovePacked_ClientSend(PackedBits);
+}
+
+
+void UAdvancedMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+#if !UE_BUILD_SHIPPING
+	if (!MoveResponse.IsGoodMove()) NumServerCorrections++;
+#endif
+
+	Super::ClientHandleMoveResponse(MoveResponse);
+}
+
+
 void UAdvancedMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
 {
 	Super::UpdateFromCompressedFlags(Flags);
@@ -2578,7 +2641,7 @@ bool UAdvancedMovementComponent::FMSavedMove::CanCombineWith(const FSavedMovePtr
 {
 	// Set which moves can be combined together. This will depend on the bit flags that are used.
 	const FMSavedMove* NewSavedMove = static_cast<FMSavedMove*>(NewMove.Get());
-	if (!PlayerInput.Equals(NewSavedMove->PlayerInput, 0.1)) return false;
+	if (PlayerInput != NewSavedMove->PlayerInput) return false; // Input is quantized, so moves with the same input are sent identically
 	if (SavedRequestToStartWallJumping != NewSavedMove->SavedRequestToStartWallJumping) return false;
 	if (SavedRequestToStartAiming != NewSavedMove->SavedRequestToStartAiming) return false;
 	if (SavedRequestToStartMantling != NewSavedMove->SavedRequestToStartMantling) return false;
@@ -2591,14 +2654,33 @@ bool UAdvancedMovementComponent::FMSavedMove::CanCombineWith(const FSavedMovePtr
 bool UAdvancedMovementComponent::FMCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
 {
 	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
-	const bool bIsSaving = Ar.IsSaving();
-	bool bLocalSuccess = true;
+	FMCharacterNetworkMoveDataContainer& MoveDataContainer = static_cast<UAdvancedMovementComponent&>(CharacterMovement).CustomMoveDataContainer;
+	const FMCharacterNetworkMoveData* Baseline = MoveDataContainer.SerializedMoveData;
+
+	// Input is only sent when it's changed from the previous move in the packet
+	const FVector2D BaselineInput = Baseline ? Baseline->MoveData_Input : FVector2D::ZeroVector;
+	bool bInputChanged = MoveData_Input != BaselineInput;
+	MoveDataQuantization::SerializeBit(Ar, bInputChanged);
+	if (bInputChanged)
+	{
+		uint32 InputX = MoveDataQuantization::QuantizeInputAxis(MoveData_Input.X) + MoveDataQuantization::InputAxisMax;
+		uint32 InputY = MoveDataQuantization::QuantizeInputAxis(MoveData_Input.Y) + MoveDataQuantization::InputAxisMax;
+		Ar.SerializeInt(InputX, MoveDataQuantization::InputAxisMax * 2 + 1);
+		Ar.SerializeInt(InputY, MoveDataQuantization::InputAxisMax * 2 + 1);
+		MoveData_Input.X = MoveDataQuantization::DequantizeInputAxis(static_cast<int32>(InputX) - MoveDataQuantization::InputAxisMax);
+		MoveData_Input.Y = MoveDataQuantization::DequantizeInputAxis(static_cast<int32>(InputY) - MoveDataQuantization::InputAxisMax);
+	}
+	else
+	{
+		MoveData_Input = BaselineInput;
+	}
 
-	// Save move values
-	MoveData_Input.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	SerializeOptionalValue<FVector_NetQuantize10>(bIsSaving, Ar, MoveData_LedgeClimbLocation, FVector_NetQuantize10::ZeroVector);
-	SerializeOptionalValue<FVector_NetQuantize10>(bIsSaving, Ar, MoveData_MantleLocation, FVector_NetQuantize10::ZeroVector);
-	
+	// The targets are sent relative to the move's location, unless it's relative to a moving base
+	const bool bCanBeRelative = MovementBase == nullptr;
+	MoveDataQuantization::SerializeTarget(Ar, PackageMap, MoveData_LedgeClimbLocation, Baseline ? Baseline->MoveData_LedgeClimbLocation : FVector::ZeroVector, Location, bCanBeRelative);
+	MoveDataQuantization::SerializeTarget(Ar, PackageMap, MoveData_MantleLocation, Baseline ? Baseline->MoveData_MantleLocation : FVector::ZeroVector, Location, bCanBeRelative);
+
+	MoveDataContainer.SerializedMoveData = this;
 	return !Ar.IsError();
 }
 
@@ -2616,6 +2698,13 @@ UAdvancedMovementComponent::FMCharacterNetworkMoveDataContainer::FMCharacterNetw
 }
 
 
+bool UAdvancedMovementComponent::FMCharacterNetworkMoveDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap)
+{
+	SerializedMoveData = nullptr;
+	return FCharacterNetworkMoveDataContainer::Serialize(CharacterMovement, Ar, PackageMap);
+}
+
+
 void UAdvancedMovementComponent::FMSavedMove::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
 {
 	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
@@ -2686,7 +2775,7 @@ void UAdvancedMovementComponent::StartSprinting() { SprintPressed = true; }
 void UAdvancedMovementComponent::StopSprinting() { SprintPressed = false; }
 void UAdvancedMovementComponent::StartAiming() { AimPressed = true; }
 void UAdvancedMovementComponent::StopAiming() { AimPressed = false; }
-void UAdvancedMovementComponent::UpdatePlayerInput(const FVector2D& InputVector) { PlayerInput = InputVector; }
+void UAdvancedMovementComponent::UpdatePlayerInput(const FVector2D& InputVector) { PlayerInput = MoveDataQuantization::QuantizeInput(InputVector); } // Predict with the same input the server receives
 void UAdvancedMovementComponent::StartWallJump() { WallJumpPressed = true; }
 void UAdvancedMovementComponent::StopWallJump() { WallJumpPressed = false; }
 void UAdvancedMovementComponent::DisableStrafeSwayPhysics() { AirStrafeSwayPhysics = false; }
@@ -3017,6 +3106,252 @@ void UAdvancedMovementComponent::ResetCharacterCameraLogic()
 // }
 
 
+void UAdvancedMovementComponent::InvalidateMovementQueryParams()
+{
+	MovementQuerySignature = 0;
+}
+
+
+bool UAdvancedMovementComponent::MovementTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, const float Radius, const bool bObjectQuery, const bool bDebug, const FColor TraceColor, const FColor TraceHitColor)
+{
+	UWorld* World = GetWorld();
+	OutHit = FHitResult(Start, End);
+	if (!World) return false;
+	UpdateMovementQueryParams();
+
+	// Share identical probes from this frame
+	const uint64 Frame = GFrameCounter;
+	const FMovementTraceResult* SharedTrace = MovementTraceCache.FindByPredicate([&](const FMovementTraceResult& Trace)
+	{
+		return Trace.Matches(Start, End, Radius, bObjectQuery, Frame);
+	});
+
+	bool bHit;
+	if (SharedTrace)
+	{
+		OutHit = SharedTrace->Hit;
+		bHit = OutHit.bBlockingHit;
+		INC_DWORD_STAT(STAT_SharedMovementTraces);
+#if !UE_BUILD_SHIPPING
+		NumSharedMovementTraces++;
+#endif
+	}
+	else
+	{
+		if (bObjectQuery && !MantleObjectQueryParams.IsValid()) return false;
+
+		const ECollisionChannel TraceChannel = UEngineTypes::ConvertToCollisionChannel(MovementChannel);
+		auto TraceProbe = [&](FHitResult& Hit, const FVector& TraceEnd)
+		{
+			if (Radius > 0)
+			{
+				const FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
+				return bObjectQuery
+					? World->SweepSingleByObjectType(Hit, Start, TraceEnd, FQuat::Identity, MantleObjectQueryParams, Sphere, MovementQueryParams)
+					: World->SweepSingleByChannel(Hit, Start, TraceEnd, FQuat::Identity, TraceChannel, Sphere, MovementQueryParams);
+			}
+
+			return bObjectQuery
+				? World->LineTraceSingleByObjectType(Hit, Start, TraceEnd, MantleObjectQueryParams, MovementQueryParams)
+				: World->LineTraceSingleByChannel(Hit, Start, TraceEnd, TraceChannel, MovementQueryParams);
+		};
+
+		// A static hit from the previous frame only needs the path up to it traced again, which stops short of the hit so it doesn't find the same object
+		FMovementTraceResult* PreviousTrace = MovementTraceCache.FindByPredicate([&](const FMovementTraceResult& Trace)
+		{
+			return Trace.CanRevalidate(Start, End, Radius, bObjectQuery, Frame);
+		});
+
+		if (PreviousTrace)
+		{
+			FHitResult Blocker;
+			const double RevalidateDistance = PreviousTrace->Hit.Distance - 1.0;
+			if (RevalidateDistance > 0 && TraceProbe(Blocker, Start + (End - Start).GetSafeNormal() * RevalidateDistance))
+			{
+				OutHit = Blocker;
+				OutHit.TraceEnd = End;
+				OutHit.Time = Blocker.Distance / FVector::Dist(Start, End);
+			}
+			else
+			{
+				OutHit = PreviousTrace->Hit;
+			}
+
+			bHit = true;
+			PreviousTrace->Frame = Frame;
+			PreviousTrace->Hit = OutHit;
+
+			INC_DWORD_STAT(STAT_RevalidatedMovementTraces);
+		}
+		else
+		{
+			bHit = TraceProbe(OutHit, End);
+
+			// Only this and the previous frame's traces are kept, and the previous frame's are replaced first
+			MovementTraceCache.RemoveAllSwap([Frame](const FMovementTraceResult& Trace) { return Trace.Frame + 1 < Frame; }, false);
+			if (MovementTraceCache.Num() == 16)
+			{
+				const int32 PreviousIndex = MovementTraceCache.IndexOfByPredicate([Frame](const FMovementTraceResult& Trace) { return Trace.Frame != Frame; });
+				MovementTraceCache.RemoveAtSwap(PreviousIndex != INDEX_NONE ? PreviousIndex : 0, 1, false);
+			}
+			MovementTraceCache.Add({Start, End, Radius, bObjectQuery, Frame, OutHit});
+		}
+
+		INC_DWORD_STAT(STAT_MovementTraces);
+#if !UE_BUILD_SHIPPING
+		NumMovementTraces++;
+#endif
+	}
+
+#if ENABLE_DRAW_DEBUG
+	if (bDebug)
+	{
+		if (Radius > 0) DrawDebugSphereTraceSingle(World, Start, End, Radius, EDrawDebugTrace::ForDuration, bHit, OutHit, TraceColor, TraceHitColor, TraceDuration);
+		else DrawDebugLineTraceSingle(World, Start, End, EDrawDebugTrace::ForDuration, bHit, OutHit, TraceColor, TraceHitColor, TraceDuration);
+	}
+#endif
+
+	return bHit;
+}
+
+
+bool FMovementTraceResult::CanRevalidate(const FVector& InStart, const FVector& InEnd, const float InRadius, const bool bInObjectQuery, const uint64 InFrame) const
+{
+	if (Frame + 1 != InFrame || !Hit.bBlockingHit || Hit.bStartPenetrating || !IsSameProbe(InStart, InEnd, InRadius, bInObjectQuery)) return false;
+
+	// The object could have been destroyed, or had its collision turned off
+	const UPrimitiveComponent* Component = Hit.GetComponent();
+	return Component && Component->IsRegistered() && Component->IsCollisionEnabled() && Component->Mobility == EComponentMobility::Static;
+}
+
+
+void UAdvancedMovementComponent::UpdateMovementQueryParams()
+{
+	// Attachments only need to be checked once per frame, no matter how many substeps or probes there are
+	if (MovementQuerySignature != 0 && MovementQueryFrame == GFrameCounter) return;
+	MovementQueryFrame = GFrameCounter;
+
+	const uint32 Signature = GetMovementQuerySignature();
+	if (Signature == MovementQuerySignature) return;
+	MovementQuerySignature = Signature;
+
+	TArray<AActor*> CharacterActors;
+	if (CharacterOwner)
+	{
+		CharacterOwner->GetAttachedActors(CharacterActors, true, true);
+		CharacterOwner->GetAllChildActors(CharacterActors);
+		CharacterActors.AddUnique(CharacterOwner);
+	}
+
+	MovementQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(AdvancedMovementTrace), false);
+	MovementQueryParams.AddIgnoredActors(CharacterActors);
+	MantleObjectQueryParams = FCollisionObjectQueryParams(MantleObjects);
+	MovementTraceCache.Reset();
+}
+
+
+uint32 UAdvancedMovementComponent::GetMovementQuerySignature() const
+{
+	uint32 Signature = HashCombine(GetTypeHash(CharacterOwner.Get()), GetTypeHash(MovementChannel.GetValue()));
+	for (const TEnumAsByte<EObjectTypeQuery> ObjectType : MantleObjects)
+	{
+		Signature = HashCombine(Signature, GetTypeHash(ObjectType.GetValue()));
+	}
+
+	// Armaments and holsters are attached to the character's mesh, and anything else that's spawned for the character is attached to the capsule
+	const USceneComponent* AttachParents[] = { UpdatedComponent.Get(), CharacterOwner ? CharacterOwner->GetMesh() : nullptr };
+	for (const USceneComponent* AttachParent : AttachParents)
+	{
+		if (!AttachParent) continue;
+		for (const USceneComponent* AttachChild : AttachParent->GetAttachChildren())
+		{
+			if (AttachChild && AttachChild->GetOwner() != CharacterOwner) Signature = HashCombine(Signature, GetTypeHash(AttachChild->GetOwner()));
+		}
+	}
+
+	return Signature ? Signature : 1;
+}
+
+
+void UAdvancedMovementComponent::UpdateMovementTraceStats()
+{
+#if !UE_BUILD_SHIPPING
+	if (!CVarMovementTraceStats.GetValueOnGameThread())
+	{
+		MovementTraceStatsTime = 0;
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (MovementTraceStatsTime == 0)
+	{
+		NumMovementTraces = 0;
+		NumSharedMovementTraces = 0;
+		MovementTraceStatsTime = CurrentTime;
+		return;
+	}
+
+	const double Elapsed = CurrentTime - MovementTraceStatsTime;
+	if (Elapsed < 1) return;
+
+	// Every shared probe used to be it's own trace
+	UE_LOGFMT(Movement, Display, "{0}() {1}: {2} traces/s, {3} probes/s before sharing ({4} shared)",
+		*FString(__FUNCTION__),
+		*GetNameSafe(CharacterOwner),
+		*FString::SanitizeFloat(NumMovementTraces / Elapsed, 1),
+		*FString::SanitizeFloat((NumMovementTraces + NumSharedMovementTraces) / Elapsed, 1),
+		NumSharedMovementTraces
+	);
+
+	NumMovementTraces = 0;
+	NumSharedMovementTraces = 0;
+	MovementTraceStatsTime = CurrentTime;
+#endif
+}
+
+
+void UAdvancedMovementComponent::UpdateMovementNetStats()
+{
+#if !UE_BUILD_SHIPPING
+	if (!CVarMovementNetStats.GetValueOnGameThread() || !CharacterOwner || !CharacterOwner->IsLocallyControlled() || CharacterOwner->HasAuthority())
+	{
+		MovementNetStatsTime = 0;
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (MovementNetStatsTime == 0)
+	{
+		NumMovePackets = 0;
+		NumPackedMoves = 0;
+		NumMovePacketBits = 0;
+		NumLoggedServerCorrections = NumServerCorrections;
+		MovementNetStatsTime = CurrentTime;
+		return;
+	}
+
+	const double Elapsed = CurrentTime - MovementNetStatsTime;
+	if (Elapsed < 1) return;
+
+	UE_LOGFMT(Movement, Display, "{0}() {1}: {2} bytes/s upstream, {3} packets/s, {4} moves/packet, {5} bits/move, {6} corrections",
+		*FString(__FUNCTION__),
+		*GetNameSafe(CharacterOwner),
+		*FString::SanitizeFloat(NumMovePacketBits / 8.0 / Elapsed, 1),
+		*FString::SanitizeFloat(NumMovePackets / Elapsed, 1),
+		*FString::SanitizeFloat(NumMovePackets ? static_cast<double>(NumPackedMoves) / NumMovePackets : 0, 2),
+		*FString::SanitizeFloat(NumPackedMoves ? static_cast<double>(NumMovePacketBits) / NumPackedMoves : 0, 1),
+		NumServerCorrections - NumLoggedServerCorrections
+	);
+
+	NumMovePackets = 0;
+	NumPackedMoves = 0;
+	NumMovePacketBits = 0;
+	NumLoggedServerCorrections = NumServerCorrections;
+	MovementNetStatsTime = CurrentTime;
+#endif
+}
+
+
 void UAdvancedMovementComponent::DebugGroundMovement(FString Message, FColor Color, bool DrawSphere)
 {
 	if (!bDebugGroundMovement) return;
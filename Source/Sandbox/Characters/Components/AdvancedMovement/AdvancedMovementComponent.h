@@ -162,6 +162,50 @@ You will also need to extend FCharacterNetworkMoveDataContainer so that it can s
 
 
 
+/**
+ * A movement probe and it's result, kept so the other probes of a movement update can share it. @ref UAdvancedMovementComponent::MovementTrace
+ */
+struct FMovementTraceResult
+{
+	/** The start of the trace */
+	FVector Start;
+
+	/** The end of the trace */
+	FVector End;
+
+	/** The radius of the sphere that was swept, or 0 for line traces */
+	float Radius;
+
+	/** Whether the trace was against the mantle objects instead of the movement channel */
+	bool bObjectQuery;
+
+	/** The frame the trace was performed on */
+	uint64 Frame;
+
+	/** The result of the trace */
+	FHitResult Hit;
+
+	/** Returns true if this is the result of an identical probe on the same frame */
+	bool Matches(const FVector& InStart, const FVector& InEnd, const float InRadius, const bool bInObjectQuery, const uint64 InFrame) const
+	{
+		return Frame == InFrame && IsSameProbe(InStart, InEnd, InRadius, bInObjectQuery);
+	}
+
+	/**
+	 * Returns true if this is an identical probe from the previous frame that hit a static object.
+	 * Static objects can't move, so the probe only needs to check the path up to the hit for anything that's moved in front of it
+	 */
+	bool CanRevalidate(const FVector& InStart, const FVector& InEnd, float InRadius, bool bInObjectQuery, uint64 InFrame) const;
+
+	/** Returns true if the probes have the same shape and query, and their start and end are within a tenth of a unit */
+	bool IsSameProbe(const FVector& InStart, const FVector& InEnd, const float InRadius, const bool bInObjectQuery) const
+	{
+		return bObjectQuery == bInObjectQuery && Radius == InRadius && Start.Equals(InStart, 0.1) && End.Equals(InEnd, 0.1);
+	}
+
+};
+
+
 /*
 * Bhop like movement inspired by the source engine
 */
@@ -753,6 +797,38 @@ protected:
 	
 	/** A reference to the character */
 	UPROPERTY(BlueprintReadWrite, Category = "Character Movement (General Settings)") TObjectPtr<ACharacterCameraLogic> Character;
+
+	/** The query params for movement traces, with the character and everything that's attached to it ignored */
+	FCollisionQueryParams MovementQueryParams;
+
+	/** The object query params for the mantle objects */
+	FCollisionObjectQueryParams MantleObjectQueryParams;
+
+	/** The character's attachments and trace settings when the query params were built, they're rebuilt once these change */
+	uint32 MovementQuerySignature;
+
+	/** The frame the character's attachments were last checked */
+	uint64 MovementQueryFrame;
+
+	/** The traces of the current and previous frame, for sharing probes within a movement update and revalidating static hits on the next one */
+	TArray<FMovementTraceResult, TInlineAllocator<16>> MovementTraceCache;
+
+#if !UE_BUILD_SHIPPING
+	/** The traces that were performed and shared since the trace stats were last logged (Sandbox.Movement.TraceStats) */
+	int32 NumMovementTraces;
+	int32 NumSharedMovementTraces;
+	double MovementTraceStatsTime;
+
+	/** The move packets, moves, and bits that were sent to the server since the net stats were last logged (Sandbox.Movement.NetStats) */
+	int32 NumMovePackets;
+	int32 NumPackedMoves;
+	int64 NumMovePacketBits;
+	double MovementNetStatsTime;
+
+	/** The corrections the client has received from the server, and the amount since the net stats were last logged */
+	int32 NumServerCorrections;
+	int32 NumLoggedServerCorrections;
+#endif
 	
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------//
@@ -1080,6 +1156,12 @@ public:
 
 	/* Process a move at the given time stamp, given the compressed flags representing various events that occurred (ie jump). */
 	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	/** On the client, sends the packed moves to the server. This also captures the upstream movement stats (Sandbox.Movement.NetStats) */
+	virtual void ServerMovePacked_ClientSend(const FCharacterServerMovePackedBits& PackedBits) override;
+
+	/** On the client, handles the server's response to a move. This also counts the server's corrections */
+	virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
 	
 	
 	//////////////////////////////////////////////////////////////////
@@ -1094,6 +1176,9 @@ public:
 		FVector_NetQuantize10 MoveData_MantleLocation;
 		
 		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+		// @brief Bit packs the custom move data. Values that are unchanged from the previous move in the packet are elided,
+		// input is sent with 8 bits per axis, and the ledge and mantle targets are sent relative to the character's location with 12 bits per axis
 		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
 	
 		
@@ -1108,6 +1193,12 @@ public:
 	public:
 		FMCharacterNetworkMoveDataContainer();
 		FMCharacterNetworkMoveData CustomDefaultMoveData[3]; // [New, Pending, Old];
+
+		// The move that was previously serialized in the current packet, each move's custom data is sent relative to it
+		const FMCharacterNetworkMoveData* SerializedMoveData = nullptr;
+
+		// @brief Serializes the moves of a packet, in the same order on the client and the server
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
 	
 		
 	};
@@ -1302,6 +1393,9 @@ public:
 	/** Allow the information component access to this component's variables */
 	friend class UInformationComponent;
 
+	/** Allow the movement simulation to step this component's movement with recorded input */
+	friend class FMovementSimulation;
+
 	
 	/**
 	 * Calculate slide vector along a surface.
@@ -1334,6 +1428,41 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category="Components|Movement", DisplayName="Update Camera Logic After Climbing")
 	void UpdateCameraLogicAfterClimbing(EMovementMode Mode, uint8 CustomMode);
 	
+	/** Rebuilds the movement query params the next time the character traces, for attachments that aren't attached to the character's mesh or capsule */
+	UFUNCTION(BlueprintCallable) virtual void InvalidateMovementQueryParams();
+
+	
+protected:
+	/**
+	 * Traces against the movement channel, or sweeps a sphere against the mantle objects, using the character's cached query params.
+	 * Identical probes within a frame share their results, and a probe that hit a static object on the previous frame is only traced up to that hit
+	 * 
+	 * @param OutHit					The result of the trace
+	 * @param Start						The start of the trace
+	 * @param End						The end of the trace
+	 * @param Radius					The radius of the sphere to sweep, or 0 for a line trace
+	 * @param bObjectQuery				Whether to trace against the mantle objects instead of the movement channel
+	 * @param bDebug					Whether to draw the trace
+	 * @param TraceColor				The debug color of the trace
+	 * @param TraceHitColor				The debug color of the trace after it's hit something
+	 * @returns							true if the trace hit something
+	 */
+	virtual bool MovementTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, float Radius, bool bObjectQuery, bool bDebug, FColor TraceColor, FColor TraceHitColor);
+
+	/** Rebuilds the movement query params if the character's attachments or trace settings have changed */
+	virtual void UpdateMovementQueryParams();
+
+	/** Returns a hash of the actors that are attached to the character, and the movement channel and mantle objects */
+	virtual uint32 GetMovementQuerySignature() const;
+
+	/** Logs the character's traces per second while Sandbox.Movement.TraceStats is enabled */
+	void UpdateMovementTraceStats();
+
+	/** Logs the client's upstream movement bandwidth and moves per packet while Sandbox.Movement.NetStats is enabled */
+	void UpdateMovementNetStats();
+
+	
+public:
 	/** Util function for printing debug messages */
 	virtual void DebugGroundMovement(FString Message, FColor Color, bool DrawSphere = false);
 
@@ -0,0 +1,423 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Characters/Components/AdvancedMovement/MovementSimulation.h"
+
+#if !UE_BUILD_SHIPPING
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Sandbox/Characters/Components/AdvancedMovement/AdvancedMovementComponent.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+
+static TAutoConsoleVariable<float> CVarMovementSimulationTolerance(
+	TEXT("Sandbox.Movement.Simulate.Tolerance"),
+	1.0f,
+	TEXT("How far in cm a simulated frame can be from the golden trace before the simulation has diverged")
+);
+
+/** Identifies movement recordings ('MSIM'), and the version of their layout */
+static constexpr uint32 MovementRecordingMagic = 0x4D49534D;
+static constexpr uint32 MovementRecordingVersion = 2;
+static constexpr uint32 MovementRecordingMapVersion = 2;
+
+
+/** The recording or replay that's in progress */
+struct FMovementSimulationSession
+{
+	/** The character that's being recorded or replayed */
+	TWeakObjectPtr<ACharacter> Character;
+
+	/** The recording's name */
+	FString Name;
+
+	/** The recording */
+	FMovementRecording Recording;
+
+	/** Whether the character is replaying the recording instead of being recorded */
+	bool bReplay = false;
+
+	/** The next frame to replay, or the amount of frames to record */
+	int32 Frame = 0;
+	int32 NumFrames = 0;
+
+	/** How long the session's been running */
+	double Duration = 0;
+
+	/** The character's server corrections when the replay started */
+	int32 StartCorrections = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
+
+static FMovementSimulationSession Session;
+
+
+
+
+#pragma region Recording
+FArchive& operator<<(FArchive& Ar, FMovementInputFrame& Frame)
+{
+	uint8 Flags = static_cast<uint8>(Frame.Flags);
+	Ar << Frame.InputVector << Frame.PlayerInput << Frame.Yaw << Flags;
+	Frame.Flags = static_cast<EMovementInputFlags>(Flags);
+	return Ar;
+}
+
+
+void FMovementRecording::Serialize(FArchive& Ar, const uint32 Version)
+{
+	FString ClassPath = CharacterClass.ToString();
+	Ar << ClassPath << StartLocation << StartRotation << TimeStep << Frames << GoldenTrace;
+	if (Version >= MovementRecordingMapVersion) Ar << MapName;
+	if (Ar.IsLoading()) CharacterClass = FSoftClassPath(ClassPath);
+}
+
+
+bool FMovementRecording::Save(const FString& Name)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	uint32 Magic = MovementRecordingMagic;
+	uint32 Version = MovementRecordingVersion;
+	Writer << Magic << Version;
+	Serialize(Writer, Version);
+
+	return FFileHelper::SaveArrayToFile(Data, *GetPath(Name));
+}
+
+
+bool FMovementRecording::Load(const FString& Name)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetPath(Name))) return false;
+
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != MovementRecordingMagic || Version == 0 || Version > MovementRecordingVersion) return false;
+
+	// Recordings from before the map was saved are simulated in whichever map is open
+	Serialize(Reader, Version);
+	return !Reader.IsError();
+}
+
+
+FString FMovementRecording::GetPath(const FString& Name)
+{
+	return GetDirectory() / Name + TEXT(".msim");
+}
+
+
+FString FMovementRecording::GetDirectory()
+{
+	return FPaths::ProjectDir() / TEXT("Tests") / TEXT("MovementSimulation");
+}
+#pragma endregion
+
+
+
+
+#pragma region Session
+bool FMovementSimulation::StartRecording(ACharacter* Character, const FString& Name, const float Duration)
+{
+	if (!Character || !Cast<UAdvancedMovementComponent>(Character->GetCharacterMovement()) || Name.IsEmpty()) return false;
+
+	StopSession();
+	Session.Character = Character;
+	Session.Name = Name;
+	Session.bReplay = false;
+	Session.Recording = FMovementRecording();
+	Session.Recording.CharacterClass = FSoftClassPath(Character->GetClass());
+	Session.Recording.MapName = UWorld::RemovePIEPrefix(Character->GetWorld()->GetOutermost()->GetName());
+	Session.Recording.StartLocation = Character->GetActorLocation();
+	Session.Recording.StartRotation = Character->GetActorRotation();
+	Session.NumFrames = FMath::Max(1, FMath::RoundToInt(Duration / Session.Recording.TimeStep));
+	Session.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FMovementSimulation::TickSession));
+
+	UE_LOGFMT(Movement, Display, "{0}() Recording {1} for {2} seconds", *FString(__FUNCTION__), *GetNameSafe(Character), Duration);
+	return true;
+}
+
+
+bool FMovementSimulation::StartReplay(ACharacter* Character, const FString& Name)
+{
+	UAdvancedMovementComponent* MovementComponent = Character ? Cast<UAdvancedMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!MovementComponent) return false;
+
+	StopSession();
+	if (!Session.Recording.Load(Name) || Session.Recording.Frames.IsEmpty())
+	{
+		UE_LOGFMT(Movement, Warning, "{0}() Couldn't load the movement recording {1}", *FString(__FUNCTION__), *FMovementRecording::GetPath(Name));
+		return false;
+	}
+
+	// The player's own input would overwrite the recording
+	if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController())) Character->DisableInput(PlayerController);
+
+	Session.Character = Character;
+	Session.Name = Name;
+	Session.bReplay = true;
+	Session.Frame = 0;
+	Session.StartCorrections = MovementComponent->NumServerCorrections;
+	Session.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FMovementSimulation::TickSession));
+	return true;
+}
+
+
+bool FMovementSimulation::TickSession(const float DeltaTime)
+{
+	ACharacter* Character = Session.Character.Get();
+	UAdvancedMovementComponent* MovementComponent = Character ? Cast<UAdvancedMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!MovementComponent)
+	{
+		Session.TickerHandle.Reset();
+		StopSession();
+		return false;
+	}
+
+	Session.Duration += DeltaTime;
+	if (!Session.bReplay)
+	{
+		Session.Recording.Frames.Add(CaptureFrame(*Character, *MovementComponent));
+		if (Session.Recording.Frames.Num() < Session.NumFrames) return true;
+
+		// Simulations step each frame with the average frame time of the recording
+		Session.Recording.TimeStep = Session.Duration / Session.Recording.Frames.Num();
+		const bool bSaved = Session.Recording.Save(Session.Name);
+		UE_LOGFMT(Movement, Display, "{0}() {1} {2} frames of {3} to {4}",
+			*FString(__FUNCTION__), bSaved ? TEXT("Saved") : TEXT("Couldn't save"), Session.Recording.Frames.Num(), *GetNameSafe(Character), *FMovementRecording::GetPath(Session.Name));
+	}
+	else
+	{
+		if (Session.Frame < Session.Recording.Frames.Num())
+		{
+			const FMovementInputFrame& Frame = Session.Recording.Frames[Session.Frame++];
+			ApplyFrame(*Character, *MovementComponent, Frame);
+			Character->AddMovementInput(Frame.InputVector);
+			if (AController* Controller = Character->GetController())
+			{
+				FRotator ControlRotation = Controller->GetControlRotation();
+				ControlRotation.Yaw = Frame.Yaw;
+				Controller->SetControlRotation(ControlRotation);
+			}
+			return true;
+		}
+
+		UE_LOGFMT(Movement, Display, "{0}() Replayed {1} frames of {2} on {3} in {4} seconds, {5} server corrections",
+			*FString(__FUNCTION__), Session.Frame, *Session.Name, *GetNameSafe(Character), Session.Duration, MovementComponent->NumServerCorrections - Session.StartCorrections);
+	}
+
+	Session.TickerHandle.Reset();
+	StopSession();
+	return false;
+}
+
+
+void FMovementSimulation::StopSession()
+{
+	if (Session.TickerHandle.IsValid()) FTSTicker::GetCoreTicker().RemoveTicker(Session.TickerHandle);
+
+	ACharacter* Character = Session.Character.Get();
+	if (Session.bReplay && Character)
+	{
+		ApplyFrame(*Character, *CastChecked<UAdvancedMovementComponent>(Character->GetCharacterMovement()), FMovementInputFrame());
+		if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController())) Character->EnableInput(PlayerController);
+	}
+
+	Session = FMovementSimulationSession();
+}
+
+
+FMovementInputFrame FMovementSimulation::CaptureFrame(const ACharacter& Character, const UAdvancedMovementComponent& MovementComponent)
+{
+	FMovementInputFrame Frame;
+	Frame.InputVector = Character.GetLastMovementInputVector();
+	Frame.PlayerInput = MovementComponent.PlayerInput;
+	Frame.Yaw = Character.GetControlRotation().Yaw;
+	if (Character.bPressedJump) Frame.Flags |= EMovementInputFlags::Jump;
+	if (MovementComponent.bWantsToCrouch) Frame.Flags |= EMovementInputFlags::Crouch;
+	if (MovementComponent.SprintPressed) Frame.Flags |= EMovementInputFlags::Sprint;
+	if (MovementComponent.AimPressed) Frame.Flags |= EMovementInputFlags::Aim;
+	if (MovementComponent.Mantling) Frame.Flags |= EMovementInputFlags::Mantle;
+	if (MovementComponent.WallJumpPressed) Frame.Flags |= EMovementInputFlags::WallJump;
+	return Frame;
+}
+
+
+void FMovementSimulation::ApplyFrame(ACharacter& Character, UAdvancedMovementComponent& MovementComponent, const FMovementInputFrame& Frame)
+{
+	MovementComponent.PlayerInput = Frame.PlayerInput;
+	MovementComponent.bWantsToCrouch = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::Crouch);
+	MovementComponent.SprintPressed = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::Sprint);
+	MovementComponent.AimPressed = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::Aim);
+	MovementComponent.Mantling = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::Mantle);
+	MovementComponent.WallJumpPressed = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::WallJump);
+	Character.bPressedJump = EnumHasAnyFlags(Frame.Flags, EMovementInputFlags::Jump);
+}
+#pragma endregion
+
+
+
+
+#pragma region Simulation
+bool FMovementSimulation::Simulate(UWorld* World, const FString& Name, const bool bUpdateGolden)
+{
+	FMovementRecording Recording;
+	if (!World || !Recording.Load(Name) || Recording.Frames.IsEmpty())
+	{
+		UE_LOGFMT(Movement, Warning, "{0}() Couldn't load the movement recording {1}", *FString(__FUNCTION__), *FMovementRecording::GetPath(Name));
+		return false;
+	}
+
+	UClass* CharacterClass = Recording.CharacterClass.TryLoadClass<ACharacter>();
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	ACharacter* Character = CharacterClass ? World->SpawnActor<ACharacter>(CharacterClass, Recording.StartLocation, Recording.StartRotation, SpawnParameters) : nullptr;
+	UAdvancedMovementComponent* MovementComponent = Character ? Cast<UAdvancedMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!MovementComponent)
+	{
+		if (Character) Character->Destroy();
+		UE_LOGFMT(Movement, Warning, "{0}() Couldn't spawn {1} with the advanced movement component", *FString(__FUNCTION__), *Recording.CharacterClass.ToString());
+		return false;
+	}
+
+	// The simulation steps the movement itself, so neither the component's tick or an ai controller move the character in between
+	MovementComponent->SetComponentTickEnabled(false);
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->UnPossess();
+		Controller->Destroy();
+	}
+
+	TArray<FVector> Trace;
+	Trace.Reserve(Recording.Frames.Num());
+	uint64 TotalCycles = 0;
+	uint64 MaxCycles = 0;
+	for (const FMovementInputFrame& Frame : Recording.Frames)
+	{
+		ApplyFrame(*Character, *MovementComponent, Frame);
+		if (Character->bUseControllerRotationYaw) Character->SetActorRotation(FRotator(0, Frame.Yaw, 0));
+
+		// The same steps as a locally controlled move (ControlledCharacterMove), with only PerformMovement timed
+		MovementComponent->Time += Recording.TimeStep;
+		Character->CheckJumpInput(Recording.TimeStep);
+		MovementComponent->Acceleration = MovementComponent->ScaleInputAcceleration(MovementComponent->ConstrainInputAcceleration(Frame.InputVector));
+		MovementComponent->AnalogInputModifier = MovementComponent->ComputeAnalogInputModifier();
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		MovementComponent->PerformMovement(Recording.TimeStep);
+		const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+		TotalCycles += Cycles;
+		MaxCycles = FMath::Max(MaxCycles, Cycles);
+
+		Character->ClearJumpInput(Recording.TimeStep);
+		Trace.Add(Character->GetActorLocation());
+	}
+
+	Character->Destroy();
+	UE_LOGFMT(Movement, Display, "{0}() {1}: {2} frames, {3} us per PerformMovement ({4} us max)",
+		*FString(__FUNCTION__), *Name, Trace.Num(),
+		*FString::SanitizeFloat(FPlatformTime::ToMilliseconds64(TotalCycles) * 1000.0 / Trace.Num(), 2),
+		*FString::SanitizeFloat(FPlatformTime::ToMilliseconds64(MaxCycles) * 1000.0, 2)
+	);
+
+	if (bUpdateGolden || Recording.GoldenTrace.IsEmpty())
+	{
+		Recording.GoldenTrace = MoveTemp(Trace);
+		const bool bSaved = Recording.Save(Name);
+		UE_LOGFMT(Movement, Display, "{0}() {1} the golden trace of {2}", *FString(__FUNCTION__), bSaved ? TEXT("Saved") : TEXT("Couldn't save"), *Name);
+		return bSaved;
+	}
+
+	// Find the first frame that's diverged from the golden trace
+	const float Tolerance = CVarMovementSimulationTolerance.GetValueOnGameThread();
+	int32 DivergedFrame = Trace.Num() == Recording.GoldenTrace.Num() ? INDEX_NONE : FMath::Min(Trace.Num(), Recording.GoldenTrace.Num());
+	double MaxError = 0;
+	for (int32 Index = 0; Index < FMath::Min(Trace.Num(), Recording.GoldenTrace.Num()); Index++)
+	{
+		const double Error = FVector::Dist(Trace[Index], Recording.GoldenTrace[Index]);
+		MaxError = FMath::Max(MaxError, Error);
+		if (Error > Tolerance && (DivergedFrame == INDEX_NONE || Index < DivergedFrame)) DivergedFrame = Index;
+	}
+
+	if (DivergedFrame != INDEX_NONE)
+	{
+		UE_LOGFMT(Movement, Error, "{0}() {1} diverged from the golden trace on frame {2}, final location: ({3}), golden: ({4}), max error: {5} cm",
+			*FString(__FUNCTION__), *Name, DivergedFrame, *Trace.Last().ToString(), *Recording.GoldenTrace.Last().ToString(), *FString::SanitizeFloat(MaxError, 2));
+		return false;
+	}
+
+	UE_LOGFMT(Movement, Display, "{0}() {1} matched the golden trace, max error: {2} cm", *FString(__FUNCTION__), *Name, *FString::SanitizeFloat(MaxError, 2));
+	return true;
+}
+#pragma endregion
+
+
+
+
+#pragma region Commands
+static ACharacter* GetLocalCharacter(const UWorld* World)
+{
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	return PlayerController ? PlayerController->GetCharacter() : nullptr;
+}
+
+
+static void RecordMovement(const TArray<FString>& Args, UWorld* World)
+{
+	const float Duration = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 0.1f) : 10.f;
+	if (Args.IsEmpty() || !FMovementSimulation::StartRecording(GetLocalCharacter(World), Args[0], Duration))
+	{
+		UE_LOGFMT(Movement, Warning, "{0}() Record the local player's movement with Sandbox.Movement.Record <Name> [Seconds = 10]", *FString(__FUNCTION__));
+	}
+}
+
+
+static void SimulateMovement(const TArray<FString>& Args, UWorld* World)
+{
+	if (Args.IsEmpty())
+	{
+		UE_LOGFMT(Movement, Warning, "{0}() Simulate a recording with Sandbox.Movement.Simulate <Name> [UpdateGolden]", *FString(__FUNCTION__));
+		return;
+	}
+
+	FMovementSimulation::Simulate(World, Args[0], Args.Num() > 1 && Args[1] == TEXT("UpdateGolden"));
+}
+
+
+static void ReplayMovement(const TArray<FString>& Args, UWorld* World)
+{
+	if (Args.IsEmpty() || !FMovementSimulation::StartReplay(GetLocalCharacter(World), Args[0]))
+	{
+		UE_LOGFMT(Movement, Warning, "{0}() Replay a recording on the local player with Sandbox.Movement.Replay <Name>", *FString(__FUNCTION__));
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs MovementRecordCommand(
+	TEXT("Sandbox.Movement.Record"),
+	TEXT("Records the local player's movement input to Tests/MovementSimulation. Sandbox.Movement.Record <Name> [Seconds = 10]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RecordMovement)
+);
+
+static FAutoConsoleCommandWithWorldAndArgs MovementSimulateCommand(
+	TEXT("Sandbox.Movement.Simulate"),
+	TEXT("Simulates a movement recording at a fixed timestep, checks it against the golden trace and times PerformMovement. Sandbox.Movement.Simulate <Name> [UpdateGolden]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SimulateMovement)
+);
+
+static FAutoConsoleCommandWithWorldAndArgs MovementReplayCommand(
+	TEXT("Sandbox.Movement.Replay"),
+	TEXT("Replays a movement recording on the local player through client prediction, and counts the server corrections. Sandbox.Movement.Replay <Name>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ReplayMovement)
+);
+#pragma endregion
+#endif
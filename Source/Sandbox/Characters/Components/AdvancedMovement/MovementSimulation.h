@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class ACharacter;
+class UAdvancedMovementComponent;
+
+
+#if !UE_BUILD_SHIPPING
+/** The buttons that were held during a recorded input frame */
+enum class EMovementInputFlags : uint8
+{
+	None			= 0,
+	Jump			= 1 << 0,
+	Crouch			= 1 << 1,
+	Sprint			= 1 << 2,
+	Aim				= 1 << 3,
+	Mantle			= 1 << 4,
+	WallJump		= 1 << 5
+};
+ENUM_CLASS_FLAGS(EMovementInputFlags)
+
+
+/**
+ * A single frame of a character's movement input
+ */
+struct FMovementInputFrame
+{
+	/** The movement input the character consumed, in world space */
+	FVector InputVector = FVector::ZeroVector;
+
+	/** The player's input (forwards, sideways) */
+	FVector2D PlayerInput = FVector2D::ZeroVector;
+
+	/** The yaw of the control rotation */
+	float Yaw = 0;
+
+	/** The buttons that were held */
+	EMovementInputFlags Flags = EMovementInputFlags::None;
+
+	friend FArchive& operator<<(FArchive& Ar, FMovementInputFrame& Frame);
+
+};
+
+
+/**
+ * A recorded input stream, and the golden trace that simulations of it are checked against. Saved to Tests/MovementSimulation/<Name>.msim in the project, so they're committed with the movement changes they check
+ */
+struct FMovementRecording
+{
+	/** The character that was recorded */
+	FSoftClassPath CharacterClass;
+
+	/** The package of the map the character was recorded in */
+	FString MapName;
+
+	/** Where the character started */
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+
+	/** The fixed timestep each frame is simulated with */
+	float TimeStep = 1.f / 60.f;
+
+	/** The input of each frame */
+	TArray<FMovementInputFrame> Frames;
+
+	/** The character's location after each frame, from the simulation that was saved as the golden trace */
+	TArray<FVector> GoldenTrace;
+
+	/** Saves the recording */
+	bool Save(const FString& Name);
+
+	/** Loads a recording, returns false if it doesn't exist or it's from a different version */
+	bool Load(const FString& Name);
+
+	/** Returns the file of a recording */
+	static FString GetPath(const FString& Name);
+
+	/** Returns the version controlled folder recordings are saved to */
+	static FString GetDirectory();
+
+
+protected:
+	void Serialize(FArchive& Ar, uint32 Version);
+
+};
+
+
+/**
+ * Records and replays the advanced movement with fixed input streams, so changes to the movement can be checked against previous behavior. @ref UAdvancedMovementComponent \n\n
+ *
+ * Recordings are captured from the local player (Sandbox.Movement.Record), and can be used in two ways:
+ *	- Sandbox.Movement.Simulate spawns a copy of the character at the recording's start and steps it's movement at a fixed timestep, without it's controller or tick.
+ *		The trace is checked against the recording's golden trace, and the time spent in each PerformMovement call is logged.
+ *		The Sandbox.Movement.Simulation automation tests simulate every recording with a golden trace in its map, and fail if any of them diverged
+ *	- Sandbox.Movement.Replay drives the local player with the recording through the regular client prediction, and counts the server's corrections.
+ *		Latency and packet loss are added with the engine's net emulation (NetEmulation.PktLag, NetEmulation.PktLoss)
+ */
+class FMovementSimulation
+{
+public:
+	/** Records the character's input for a duration, and saves it once it's finished */
+	static bool StartRecording(ACharacter* Character, const FString& Name, float Duration);
+
+	/**
+	 * Simulates a recording in a world, and checks it against the golden trace
+	 *
+	 * @param World								The world to spawn the character in
+	 * @param Name								The recording
+	 * @param bUpdateGolden						Saves this simulation as the golden trace. Recordings without a golden trace always save it
+	 * @returns									False if the simulation diverged from the golden trace, or couldn't be run
+	 */
+	static bool Simulate(UWorld* World, const FString& Name, bool bUpdateGolden);
+
+	/** Drives the character with a recording, and logs the server corrections once it's finished */
+	static bool StartReplay(ACharacter* Character, const FString& Name);
+
+
+protected:
+	/** Records or replays the current frame of the session */
+	static bool TickSession(float DeltaTime);
+
+	/** Ends the current recording or replay */
+	static void StopSession();
+
+	/** Captures the character's current input */
+	static FMovementInputFrame CaptureFrame(const ACharacter& Character, const UAdvancedMovementComponent& MovementComponent);
+
+	/** Applies an input frame's buttons to the character */
+	static void ApplyFrame(ACharacter& Character, UAdvancedMovementComponent& MovementComponent, const FMovementInputFrame& Frame);
+
+};
+#endif
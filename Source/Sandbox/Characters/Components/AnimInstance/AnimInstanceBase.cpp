@@ -4,6 +4,7 @@
 #include "AnimInstanceBase.h"
 
 #include "AbilitySystemGlobals.h"
+#include "Animation/Skeleton.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Characters/CharacterBase.h"
@@ -20,6 +21,7 @@ void UAnimInstanceBase::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 	GetCharacterInformation();
+	UpdateCurveHandles();
 }
 
 
@@ -36,7 +38,22 @@ void UAnimInstanceBase::InitializeAbilitySystem(UAbilitySystemComponent* Asc)
 void UAnimInstanceBase::NativeUpdateAnimation(float DeltaTime)
 {
 	Super::NativeUpdateAnimation(DeltaTime);
-	if (!GetCharacterInformation())
+	Snapshot.bValid = GetCharacterInformation();
+	if (!Snapshot.bValid)
+	{
+		return;
+	}
+
+	// Only copy the character's values here, the calculations are handled on worker threads
+	UpdateCurveHandles();
+	GatherCharacterSnapshot();
+}
+
+
+void UAnimInstanceBase::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaTime);
+	if (!Snapshot.bValid)
 	{
 		return;
 	}
@@ -51,39 +68,64 @@ void UAnimInstanceBase::NativeUpdateAnimation(float DeltaTime)
 }
 
 
+void UAnimInstanceBase::GatherCharacterSnapshot()
+{
+	// Movement component values
+	Snapshot.MaxWalkSpeed = MovementComponent->GetMaxWalkSpeed();
+	Snapshot.MaxCrouchSpeed = MovementComponent->MaxWalkSpeedCrouched;
+	Snapshot.MaxSpeed = MovementComponent->GetMaxSpeed();
+	Snapshot.SprintSpeedMultiplier = MovementComponent->SprintSpeedMultiplier;
+	Snapshot.CrouchSprintSpeedMultiplier = MovementComponent->CrouchSprintSpeedMultiplier;
+	
+	// The character's velocity and rotations
+	Snapshot.Input = MovementComponent->GetPlayerInput();
+	Snapshot.Acceleration = MovementComponent->GetCurrentAcceleration();
+	Snapshot.Velocity = Character->GetVelocity();
+	Snapshot.Rotation = Character->GetActorRotation();
+	Snapshot.ForwardVector = Character->GetActorForwardVector();
+	Snapshot.AimRotation = Character->GetBaseAimRotation();
+	
+	// Movement state
+	Snapshot.MovementMode = MovementComponent->MovementMode;
+	Snapshot.CustomMovementMode = MovementComponent->CustomMovementMode;
+	Snapshot.bSprinting = MovementComponent->IsRunning();
+	Snapshot.bCrouching = Character->bIsCrouched;
+	Snapshot.bWalking = MovementComponent->IsWalking();
+	if (PlayerCharacter) Snapshot.CameraStyle = PlayerCharacter->Execute_GetCameraStyle(PlayerCharacter);
+}
+
+
 void UAnimInstanceBase::GetCharacterMovementValues(float DeltaTime)
 {
 	// Movement component values
-	MaxWalkSpeed = MovementComponent->GetMaxWalkSpeed();
-	MaxCrouchSpeed = MovementComponent->MaxWalkSpeedCrouched;
-	MaxRunSpeed = MovementComponent->GetMaxWalkSpeed() * MovementComponent->SprintSpeedMultiplier;
+	MaxWalkSpeed = Snapshot.MaxWalkSpeed;
+	MaxCrouchSpeed = Snapshot.MaxCrouchSpeed;
+	MaxRunSpeed = Snapshot.MaxWalkSpeed * Snapshot.SprintSpeedMultiplier;
 	
 	// The character's velocity, speed and rotation
-	Input = MovementComponent->GetPlayerInput();
-	Acceleration = MovementComponent->GetCurrentAcceleration();
+	Input = Snapshot.Input;
+	Acceleration = Snapshot.Acceleration;
 	Acceleration_N = Acceleration.GetSafeNormal();
-	Velocity = Character->GetVelocity(); 
+	Velocity = Snapshot.Velocity; 
 	Velocity_N = Velocity.GetSafeNormal();
 	Speed = Velocity.Size();
-	Speed_N = UKismetMathLibrary::MapRangeClamped(Speed, -MovementComponent->GetMaxSpeed(), MovementComponent->GetMaxSpeed(), -1, 1);
-	Rotation = Character->GetActorRotation();
+	Speed_N = UKismetMathLibrary::MapRangeClamped(Speed, -Snapshot.MaxSpeed, Snapshot.MaxSpeed, -1, 1);
+	Rotation = Snapshot.Rotation;
 	
 	// This is the movement vector based on where the player is facing
 	DirectionalVelocity = UKismetMathLibrary::Quat_UnrotateVector(Rotation.Quaternion(), Velocity); // The speed of the forward vector direction
-	RelativeVelocity = UKismetMathLibrary::Quat_UnrotateVector(Velocity.ToOrientationQuat(), Character->GetActorRotation().Vector()); // Movement inputs
+	RelativeVelocity = UKismetMathLibrary::Quat_UnrotateVector(Velocity.ToOrientationQuat(), Rotation.Vector()); // Movement inputs
 	if (!bIsMoving) RelativeVelocity = FVector::ZeroVector;
 	
 	// The essentials for character movement calculations
-	MovementMode = MovementComponent->MovementMode;
-	CustomMovementMode = MovementComponent->CustomMovementMode;
+	MovementMode = Snapshot.MovementMode;
+	CustomMovementMode = Snapshot.CustomMovementMode;
 	bIsAccelerating = Acceleration.Size() > 0 ? true : false;
 	bIsMoving = !Velocity.IsNearlyZero(1);
-	bSprinting = MovementComponent->IsRunning();
-	bCrouching = Character->bIsCrouched;
-	bWalking = !bSprinting && MovementComponent->IsWalking();
-
-	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(Character);
-	if (PlayerCharacter)CameraStyle = PlayerCharacter->Execute_GetCameraStyle(PlayerCharacter);
+	bSprinting = Snapshot.bSprinting;
+	bCrouching = Snapshot.bCrouching;
+	bWalking = !bSprinting && Snapshot.bWalking;
+	if (PlayerCharacter) CameraStyle = Snapshot.CameraStyle;
 
 	// Blendspace forwards and sideways values (converted into -1, 1) for handling multiple blendspaces
 	WalkRunValues = FVector2D(
@@ -91,7 +133,7 @@ void UAnimInstanceBase::GetCharacterMovementValues(float DeltaTime)
 		UKismetMathLibrary::MapRangeClamped(DirectionalVelocity.Y, -MaxRunSpeed, MaxRunSpeed, -1, 1)
 	);
 
-	const float MaxCrouchSprintSpeed = MaxCrouchSpeed * MovementComponent->CrouchSprintSpeedMultiplier;
+	const float MaxCrouchSprintSpeed = MaxCrouchSpeed * Snapshot.CrouchSprintSpeedMultiplier;
 	CrouchWalkValues = FVector2D(
 		UKismetMathLibrary::MapRangeClamped(DirectionalVelocity.X, -MaxCrouchSprintSpeed, MaxCrouchSprintSpeed, -1, 1),
 		UKismetMathLibrary::MapRangeClamped(DirectionalVelocity.Y, -MaxCrouchSprintSpeed, MaxCrouchSprintSpeed, -1, 1)
@@ -102,7 +144,7 @@ void UAnimInstanceBase::GetCharacterMovementValues(float DeltaTime)
 void UAnimInstanceBase::CalculateYawAndLean(float DeltaTime)
 {
 	// Offset yaw for strafing on the server (Looking up or down)
-	AimRotation = Character->GetBaseAimRotation(); // The current direction the character is facing in the world // GetBaseAimRotation: built in function to grab the offset of where the character is aiming
+	AimRotation = Snapshot.AimRotation; // The current direction the character is facing in the world // GetBaseAimRotation: built in function to grab the offset of where the character is aiming
 	Yaw = AimRotation.Yaw; 
 	Pitch = -AimRotation.Pitch;
 	RelativeRotation = UKismetMathLibrary::NormalizedDeltaRotator(Rotation, AimRotation); // The rotation relative to the character's current rotation
@@ -123,7 +165,7 @@ void UAnimInstanceBase::CalculateYawAndLean(float DeltaTime)
 	if (CustomMovementMode != MOVE_Custom_WallRunning) WallRunLeanAmount = FVector2D::ZeroVector;
 	else
 	{
-		FVector WallRunVector = RelativeVelocity - Character->GetActorForwardVector();
+		FVector WallRunVector = RelativeVelocity - Snapshot.ForwardVector;
 		WallRunLeanAmount = FVector2D(
 			UKismetMathLibrary::FInterpTo(WallRunLeanAmount.X, WallRunVector.X * 1.5, DeltaTime, WallRunLeanInterpSpeed),
 			UKismetMathLibrary::FInterpTo(WallRunLeanAmount.Y, WallRunVector.Y * 1.5, DeltaTime, WallRunLeanInterpSpeed)
@@ -197,46 +239,91 @@ void UAnimInstanceBase::CalculateMovementDirection()
 
 void UAnimInstanceBase::UpdateCurveValues()
 {
-	// Montage Overrides
-	Montage_Head = GetCurveValue(Curve_Montage_Head);
-	Montage_Pelvis = GetCurveValue(Curve_Montage_Pelvis);
-	Montage_Spine = GetCurveValue(Curve_Montage_Spine);
-	Montage_Legs = GetCurveValue(Curve_Montage_Legs);
-	Montage_Arm_L = GetCurveValue(Curve_Montage_Arm_L);
-	Montage_Arm_R = GetCurveValue(Curve_Montage_Arm_R);
-	Montage_Hand_L = GetCurveValue(Curve_Montage_Hand_L);
-	Montage_Hand_R = GetCurveValue(Curve_Montage_Hand_R);
-
-	// Overlay Overrides
-	Layering_Head = GetCurveValue(Curve_Layering_Head);
-	Layering_Pelvis = GetCurveValue(Curve_Layering_Pelvis);
-	Layering_Spine = GetCurveValue(Curve_Layering_Spine);
-	Layering_Legs = GetCurveValue(Curve_Layering_Legs);
-	Layering_Arm_L = GetCurveValue(Curve_Layering_Arm_L);
-	Layering_Arm_R = GetCurveValue(Curve_Layering_Arm_R);
-
-	// IK influence
-	IK_Head = GetCurveValue(Curve_IK_Head);
-	IK_Pelvis = GetCurveValue(Curve_IK_Pelvis);
-	IK_Spine = GetCurveValue(Curve_IK_Spine);
-	IK_Feet = GetCurveValue(Curve_IK_Feet);
-	IK_Arm_L = GetCurveValue(Curve_IK_Arm_L);
-	IK_Arm_R = GetCurveValue(Curve_IK_Arm_R);
-	IK_Hand_L = GetCurveValue(Curve_IK_Hand_L);
-	IK_Hand_R = GetCurveValue(Curve_IK_Hand_R);
-
-	// Primary values
-	Turn_RotationAmount = GetCurveValue(Curve_Turn_RotationAmount);
-	Mask_Sprint = GetCurveValue(Curve_Mask_Sprint);
-	Mask_Lean = GetCurveValue(Curve_Mask_Lean);
-
-	// AO influence
-	AO_Head = GetCurveValue(Curve_AO_Head);
-	AO_Pelvis = GetCurveValue(Curve_AO_Pelvis);
-	AO_Spine = GetCurveValue(Curve_AO_Spine);
-	AO_Legs = GetCurveValue(Curve_AO_Legs);
-	AO_Arm_L = GetCurveValue(Curve_AO_Arm_L);
-	AO_Arm_R = GetCurveValue(Curve_AO_Arm_R);
+	// Curves the skeleton doesn't have are never evaluated, so they don't need to be searched for
+	const TMap<FName, float>& Curves = GetAnimationCurveList(EAnimCurveType::AttributeCurve);
+	const TArray<FAnimCurveBinding>& CurveBindings = GetCurveBindings();
+	for (const int32 CurveHandle : CurveHandles)
+	{
+		const FAnimCurveBinding& Binding = CurveBindings[CurveHandle];
+		const float* Value = Curves.Find(Binding.Name);
+		this->*Binding.Value = Value ? *Value : 0.0f;
+	}
+}
+
+
+void UAnimInstanceBase::UpdateCurveHandles()
+{
+	if (CurveHandleSkeleton == CurrentSkeleton) return;
+	CurveHandleSkeleton = CurrentSkeleton;
+
+	// The curve handles of each skeleton are only built once
+	static TMap<TObjectKey<USkeleton>, TArray<int32>> SkeletonCurveHandles;
+	if (const TArray<int32>* SkeletonHandles = SkeletonCurveHandles.Find(CurrentSkeleton))
+	{
+		CurveHandles = *SkeletonHandles;
+		return;
+	}
+
+	const TArray<FAnimCurveBinding>& CurveBindings = GetCurveBindings();
+	const FSmartNameMapping* CurveMapping = CurrentSkeleton ? CurrentSkeleton->GetSmartNameContainer(USkeleton::AnimCurveMappingName) : nullptr;
+	CurveHandles.Reset();
+	for (int32 Index = 0; Index < CurveBindings.Num(); Index++)
+	{
+		// Skeletons without a curve mapping search for every curve
+		if (!CurveMapping || CurveMapping->Exists(CurveBindings[Index].Name)) CurveHandles.Add(Index);
+		else this->*CurveBindings[Index].Value = 0.0f;
+	}
+
+	if (CurrentSkeleton) SkeletonCurveHandles.Add(CurrentSkeleton, CurveHandles);
+}
+
+
+const TArray<FAnimCurveBinding>& UAnimInstanceBase::GetCurveBindings()
+{
+	static const TArray<FAnimCurveBinding> CurveBindings = {
+		// Montage Overrides
+		{Curve_Montage_Head, &UAnimInstanceBase::Montage_Head},
+		{Curve_Montage_Pelvis, &UAnimInstanceBase::Montage_Pelvis},
+		{Curve_Montage_Spine, &UAnimInstanceBase::Montage_Spine},
+		{Curve_Montage_Legs, &UAnimInstanceBase::Montage_Legs},
+		{Curve_Montage_Arm_L, &UAnimInstanceBase::Montage_Arm_L},
+		{Curve_Montage_Arm_R, &UAnimInstanceBase::Montage_Arm_R},
+		{Curve_Montage_Hand_L, &UAnimInstanceBase::Montage_Hand_L},
+		{Curve_Montage_Hand_R, &UAnimInstanceBase::Montage_Hand_R},
+
+		// Overlay Overrides
+		{Curve_Layering_Head, &UAnimInstanceBase::Layering_Head},
+		{Curve_Layering_Pelvis, &UAnimInstanceBase::Layering_Pelvis},
+		{Curve_Layering_Spine, &UAnimInstanceBase::Layering_Spine},
+		{Curve_Layering_Legs, &UAnimInstanceBase::Layering_Legs},
+		{Curve_Layering_Arm_L, &UAnimInstanceBase::Layering_Arm_L},
+		{Curve_Layering_Arm_R, &UAnimInstanceBase::Layering_Arm_R},
+
+		// IK influence
+		{Curve_IK_Head, &UAnimInstanceBase::IK_Head},
+		{Curve_IK_Pelvis, &UAnimInstanceBase::IK_Pelvis},
+		{Curve_IK_Spine, &UAnimInstanceBase::IK_Spine},
+		{Curve_IK_Feet, &UAnimInstanceBase::IK_Feet},
+		{Curve_IK_Arm_L, &UAnimInstanceBase::IK_Arm_L},
+		{Curve_IK_Arm_R, &UAnimInstanceBase::IK_Arm_R},
+		{Curve_IK_Hand_L, &UAnimInstanceBase::IK_Hand_L},
+		{Curve_IK_Hand_R, &UAnimInstanceBase::IK_Hand_R},
+
+		// Primary values
+		{Curve_Turn_RotationAmount, &UAnimInstanceBase::Turn_RotationAmount},
+		{Curve_Mask_Sprint, &UAnimInstanceBase::Mask_Sprint},
+		{Curve_Mask_Lean, &UAnimInstanceBase::Mask_Lean},
+
+		// AO influence
+		{Curve_AO_Head, &UAnimInstanceBase::AO_Head},
+		{Curve_AO_Pelvis, &UAnimInstanceBase::AO_Pelvis},
+		{Curve_AO_Spine, &UAnimInstanceBase::AO_Spine},
+		{Curve_AO_Legs, &UAnimInstanceBase::AO_Legs},
+		{Curve_AO_Arm_L, &UAnimInstanceBase::AO_Arm_L},
+		{Curve_AO_Arm_R, &UAnimInstanceBase::AO_Arm_R}
+	};
+
+	return CurveBindings;
 }
 
 
@@ -294,6 +381,9 @@ bool UAnimInstanceBase::GetCharacter()
 		return false;
 	}
 
+	// Only players have camera styles, cache the cast instead of checking every update
+	PlayerCharacter = Cast<APlayerCharacter>(Character);
+
 	return true;
 }
 
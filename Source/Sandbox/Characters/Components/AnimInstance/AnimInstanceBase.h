@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayEffectTypes.h"
 #include "Animation/AnimInstance.h"
+#include "UObject/ObjectKey.h"
 #include "Sandbox/Data/Enums/InverseKinematicsState.h"
 #include "Sandbox/Data/Enums/MovementAnimCurveValues.h"
 #include "Sandbox/Data/Enums/MovementTypes.h"
@@ -24,7 +25,54 @@ DECLARE_LOG_CATEGORY_EXTERN(LogAnimationBlueprint, Log, NoLogging);
 #define EMD_Neutral EMovementDirection::MD_Neutral
 
 class ACharacterBase; 
+class APlayerCharacter;
 class UAdvancedMovementComponent;
+class UAnimInstanceBase;
+
+
+/**
+ * The character and movement component values the animation update needs. These are copied on the game thread, so the movement calculations can run on worker threads. @ref UAnimInstanceBase::NativeThreadSafeUpdateAnimation
+ */
+struct SANDBOX_API FAnimCharacterSnapshot
+{
+	FVector2D Input = FVector2D::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FVector ForwardVector = FVector::ForwardVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FRotator AimRotation = FRotator::ZeroRotator;
+	
+	float MaxWalkSpeed = 0;
+	float MaxCrouchSpeed = 0;
+	float MaxSpeed = 0;
+	float SprintSpeedMultiplier = 1;
+	float CrouchSprintSpeedMultiplier = 1;
+	
+	TEnumAsByte<EMovementMode> MovementMode = MOVE_None;
+	uint8 CustomMovementMode = 0;
+	bool bSprinting = false;
+	bool bCrouching = false;
+	bool bWalking = false;
+	FName CameraStyle;
+
+	/** Whether the snapshot was captured this frame */
+	bool bValid = false;
+
+};
+
+
+/**
+ * An animation curve, and the anim instance value it's copied to
+ */
+struct SANDBOX_API FAnimCurveBinding
+{
+	/** The curve's name */
+	FName Name;
+
+	/** The value the curve is copied to */
+	float UAnimInstanceBase::* Value;
+
+};
 
 
 /**
@@ -39,6 +87,7 @@ public:
 	virtual void NativeInitializeAnimation() override;
 	virtual void InitializeAbilitySystem(UAbilitySystemComponent* Asc);
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
 	
 
 //----------------------------------------------------------------------------------------------------------------------------------//
@@ -1369,6 +1418,7 @@ protected:
 protected:
 	UPROPERTY(Transient, BlueprintReadWrite, Category = "Movement|Utility") TObjectPtr<UAdvancedMovementComponent> MovementComponent;
 	UPROPERTY(Transient, BlueprintReadWrite, Category = "Movement|Utility") TObjectPtr<ACharacterBase> Character;
+	UPROPERTY(Transient, BlueprintReadWrite, Category = "Movement|Utility") TObjectPtr<APlayerCharacter> PlayerCharacter;
 	UPROPERTY(Transient, BlueprintReadWrite, Category = "Movement|Utility") bool bLocallyControlled;
 	
 	// Gameplay tags that can be mapped to blueprint variables. The variables will automatically update as the tags are added or removed
@@ -1383,8 +1433,21 @@ protected:
 // Movement Calculations														//
 //------------------------------------------------------------------------------//
 protected:
+	/** The character's values for this frame's animation update */
+	FAnimCharacterSnapshot Snapshot;
+
+	/** The indices of the curve bindings that the current skeleton has curves for, shared by every anim instance using the skeleton */
+	TArray<int32> CurveHandles;
+
+	/** The skeleton the curve handles were built for */
+	TObjectKey<USkeleton> CurveHandleSkeleton;
+	
+	
 	UAnimInstanceBase(const FObjectInitializer& ObjectInitializer);
 	
+	/** Copies the character and movement component values the animation update needs. This is the only part of the update that runs on the game thread */
+	virtual void GatherCharacterSnapshot();
+	
 	/** Calculates the character's base movement values */
 	virtual void GetCharacterMovementValues(float DeltaTime);
 
@@ -1393,6 +1456,12 @@ protected:
 
 	/** Finds the curve values and stores the information for bp reference */
 	virtual void UpdateCurveValues();
+
+	/** Finds which of the curve bindings the current skeleton has, if the skeleton has changed */
+	virtual void UpdateCurveHandles();
+
+	/** Returns the curves that are copied to the anim instance's curve values */
+	static const TArray<FAnimCurveBinding>& GetCurveBindings();
 	
 	/** Calculates the yaw, lean, and aim rotations for the character */
 	virtual void CalculateYawAndLean(float DeltaTime);
@@ -3,9 +3,14 @@
 
 #include "Sandbox/Characters/Components/Camera/CharacterCameraLogic.h"
 
+#include "AbilitySystemComponent.h"
+#include "Algo/BinarySearch.h"
 #include "Camera/CameraComponent.h"
+#include "Sandbox/Combat/CombatGridSubsystem.h"
 #include "Sandbox/Characters/Components/Camera/TargetLockSpringArm.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GenericTeamAgentInterface.h"
+#include "Sandbox/Asc/Information/SandboxTags.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Logging/StructuredLog.h"
 #include "Net/UnrealNetwork.h"
@@ -49,6 +54,8 @@ ACharacterCameraLogic::ACharacterCameraLogic(const FObjectInitializer& ObjectIni
 
 	TargetLockOffset = FVector(0.0, 0.0, 64.0);
 	TargetLockTransitionSpeed = 6.4;
+	bQueryTargetLockCharacters = false;
+	TargetLockViewAngle = 90.0f;
 }
 
 
@@ -329,8 +336,21 @@ void ACharacterCameraLogic::AdjustCameraFOV(const float DeltaTime)
 
 
 #pragma region Target Locking
+/** Returns the yaw from the player's forward vector to a target. Negative is to the right, positive is to the left */
+static float GetTargetLockAngle(const FVector& PlayerLocation, const FRotator& PlayerRotation, const FVector& TargetLocation)
+{
+	const FRotator PlayerToTargetRotation = (TargetLocation - PlayerLocation).Rotation();
+	return UKismetMathLibrary::NormalizedDeltaRotator(PlayerToTargetRotation, PlayerRotation).Yaw;
+}
+
+
 void ACharacterCameraLogic::AdjustCurrentTarget_Implementation(TArray<AActor*>& ActorsToIgnore, EPreviousTargetLockOrientation NextTargetDirection, float Radius)
 {
+	if (bQueryTargetLockCharacters)
+	{
+		QueryTargetLockCharacters(Radius, ActorsToIgnore);
+	}
+	
 	if (TargetLockCharacters.Num() == 0)
 	{
 		if (bDebugTargetLocking)
@@ -339,6 +359,7 @@ void ACharacterCameraLogic::AdjustCurrentTarget_Implementation(TArray<AActor*>&
 		}
 		
 		bCurrentTargetDelay = false;
+		TargetLockData.Empty();
 		SetCurrentTarget(nullptr);
 		TrySetServerCurrentTarget();
 		if (CameraStyle == CameraStyle_TargetLocking)
@@ -357,70 +378,33 @@ void ACharacterCameraLogic::AdjustCurrentTarget_Implementation(TArray<AActor*>&
 		return;
 	}
 	
-	const FVector PlayerLocation = GetActorLocation();
-	const FRotator BaseAimRotation = GetBaseAimRotation();
-	const FRotator PlayerRotation = FRotator(0.0f, BaseAimRotation.Yaw, BaseAimRotation.Roll);
-
 	// TODO: Update this to also account for how close the players are to the character
-	// Calculate the distance from the character and the angle from it's forward vector
-	TargetLockData.Empty();
-	for (AActor* Target : TargetLockCharacters)
-	{
-		if (Target == this) continue;
-		
-		FTargetLockInformation TargetLockInfo;
-		TargetLockInfo.Target = Target;
-
-		FVector PlayerToTarget = TargetLockInfo.Target->GetActorLocation() - PlayerLocation;
-		TargetLockInfo.DistanceToTarget = PlayerToTarget.Length(); 
-
-		const FRotator PlayerToTargetRotation = PlayerToTarget.Rotation();
-		const FRotator DeltaRotation = UKismetMathLibrary::NormalizedDeltaRotator(PlayerToTargetRotation, PlayerRotation);
-		TargetLockInfo.AngleFromForwardVector = DeltaRotation.Yaw; // Negative is to the right, positive is to the left
-		TargetLockData.Add(TargetLockInfo);
-		
-		// if (bDebugTargetLocking)
-		// {
-		// 	UE_LOGFMT(CameraLog, Log, "{0}: target {1}, RotationFromCharacter: {2}, DistanceToTarget: {3}",
-		// 		*UEnum::GetValueAsString(GetLocalRole()), *GetNameSafe(TargetLockInfo.Target), TargetLockInfo.AngleFromForwardVector, TargetLockInfo.DistanceToTarget
-		// 	);
-		// }
-	}
-	
-	// Adjust the array of the characters from left to right (180, -180)
-	TargetLockData.Sort([](const FTargetLockInformation& PreviousTargetData, const FTargetLockInformation& CurrentTargetData) {
-		return PreviousTargetData.AngleFromForwardVector > CurrentTargetData.AngleFromForwardVector;
-	});
+	// Calculate the distance from the character and the angle from it's forward vector, and sort the targets from left to right (180, -180)
+	UpdateTargetLockData();
+	if (TargetLockData.IsEmpty()) return;
 	// for (auto Target: TargetLockData) if (bDebugTargetLocking) UE_LOGFMT(CameraLog, Log, "Adjusted Target List: {0}, YawOffset: {1}", *GetNameSafe(Target.Target), Target.AngleFromForwardVector);
 	
-	int32 CurrentTargetIndex = 0;
-	float ClosestToCharacterYaw = 340.0f;
-	for (int32 Index = 0; Index != TargetLockData.Num(); ++Index)
+	FTargetLockInformation NextTarget;
+	if (CurrentTarget)
 	{
-		if (CurrentTarget)
+		// Find the current target, or where it would be if it's no longer a target lock character
+		const FVector PlayerLocation = GetActorLocation();
+		const FRotator BaseAimRotation = GetBaseAimRotation();
+		const float CurrentTargetAngle = GetTargetLockAngle(PlayerLocation, FRotator(0.0f, BaseAimRotation.Yaw, BaseAimRotation.Roll), CurrentTarget->GetActorLocation());
+		
+		int32 CurrentTargetIndex = FindTargetLockIndex(CurrentTargetAngle);
+		bool bFoundCurrentTarget = false;
+		for (int32 Index = CurrentTargetIndex; Index < TargetLockData.Num() && TargetLockData[Index].AngleFromForwardVector == CurrentTargetAngle; ++Index)
 		{
 			if (TargetLockData[Index].Target == CurrentTarget)
 			{
 				CurrentTargetIndex = Index;
+				bFoundCurrentTarget = true;
 				break;
 			}
 		}
-		else
-		{
-			// Find the target closest to where the character is looking
-			const float TargetToCharacterYaw = TargetLockData[Index].AngleFromForwardVector < 0.0f ? -1 * TargetLockData[Index].AngleFromForwardVector : TargetLockData[Index].AngleFromForwardVector;
-			if (TargetToCharacterYaw < ClosestToCharacterYaw)
-			{
-				CurrentTargetIndex = Index;
-				ClosestToCharacterYaw = TargetToCharacterYaw;
-			}
-		}
-	}
-	
-	// This is for navigating between the previous or next target
-	FTargetLockInformation NextTarget = TargetLockData[CurrentTargetIndex];
-	if (CurrentTarget)
-	{
+		
+		// This is for navigating between the previous or next target
 		if (NextTargetDirection == EPreviousTargetLockOrientation::Right)
 		{
 			if (TargetLockData.IsValidIndex(CurrentTargetIndex - 1)) NextTarget = TargetLockData[CurrentTargetIndex - 1];
@@ -428,10 +412,19 @@ void ACharacterCameraLogic::AdjustCurrentTarget_Implementation(TArray<AActor*>&
 		}
 		else
 		{
-			if (TargetLockData.IsValidIndex(CurrentTargetIndex + 1)) NextTarget = TargetLockData[CurrentTargetIndex + 1];
+			const int32 NextTargetIndex = bFoundCurrentTarget ? CurrentTargetIndex + 1 : CurrentTargetIndex;
+			if (TargetLockData.IsValidIndex(NextTargetIndex)) NextTarget = TargetLockData[NextTargetIndex];
 			else NextTarget = TargetLockData[0];
 		}
 	}
+	else
+	{
+		// Find the target closest to where the character is looking
+		const int32 Index = FindTargetLockIndex(0.0f);
+		if (!TargetLockData.IsValidIndex(Index)) NextTarget = TargetLockData.Last();
+		else if (Index > 0 && FMath::Abs(TargetLockData[Index - 1].AngleFromForwardVector) <= FMath::Abs(TargetLockData[Index].AngleFromForwardVector)) NextTarget = TargetLockData[Index - 1];
+		else NextTarget = TargetLockData[Index];
+	}
 
 	if (bDebugTargetLocking)
 	{
@@ -443,6 +436,106 @@ void ACharacterCameraLogic::AdjustCurrentTarget_Implementation(TArray<AActor*>&
 }
 
 
+void ACharacterCameraLogic::QueryTargetLockCharacters(const float Radius, const TArray<AActor*>& ActorsToIgnore)
+{
+	UCombatGridSubsystem* CombatGrid = UCombatGridSubsystem::Get(this);
+	if (!CombatGrid) return;
+	
+	const FRotator BaseAimRotation = GetBaseAimRotation();
+	TArray<ACharacterBase*> Characters;
+	CombatGrid->QueryCone(GetActorLocation(), FRotator(0.0f, BaseAimRotation.Yaw, 0.0f).Vector(), Radius, TargetLockViewAngle, Characters, this);
+	
+	TargetLockCharacters.Reset(Characters.Num());
+	for (ACharacterBase* Character : Characters)
+	{
+		if (IsValidTargetLockCandidate(Character, ActorsToIgnore)) TargetLockCharacters.Add(Character);
+	}
+
+	if (bDebugTargetLocking)
+	{
+		UE_LOGFMT(CameraLog, Log, "{0}: Found {1} target lock characters within {2} of {3}", *UEnum::GetValueAsString(GetLocalRole()), TargetLockCharacters.Num(), Radius, *GetName());
+	}
+}
+
+
+bool ACharacterCameraLogic::IsValidTargetLockCandidate_Implementation(ACharacterBase* Character, const TArray<AActor*>& ActorsToIgnore) const
+{
+	if (!Character || Character == this || ActorsToIgnore.Contains(Character)) return false;
+
+	const UAbilitySystemComponent* AbilitySystem = Character->GetAbilitySystemComponent();
+	if (AbilitySystem && AbilitySystem->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(Tag_State_Dead))) return false;
+
+	// Npcs are friendly through their controller's team. Clients don't have other characters' controllers, so subclasses that lock on from clients should also check this
+	const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Character->GetController());
+	if (TeamAgent && TeamAgent->GetTeamAttitudeTowards(*this) == ETeamAttitude::Friendly) return false;
+
+	// Don't lock onto characters behind walls
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TargetLockLineOfSight), false, this);
+	QueryParams.AddIgnoredActor(Character);
+	QueryParams.AddIgnoredActors(ActorsToIgnore);
+	const FVector ViewLocation = FollowCamera ? FollowCamera->GetComponentLocation() : GetPawnViewLocation();
+	return !GetWorld()->LineTraceTestByChannel(ViewLocation, Character->GetActorLocation() + TargetLockOffset, ECC_Visibility, QueryParams);
+}
+
+
+void ACharacterCameraLogic::UpdateTargetLockData()
+{
+	const FVector PlayerLocation = GetActorLocation();
+	const FRotator BaseAimRotation = GetBaseAimRotation();
+	const FRotator PlayerRotation = FRotator(0.0f, BaseAimRotation.Yaw, BaseAimRotation.Roll);
+
+	// The targets that don't have target lock data yet
+	TSet<AActor*> NewTargets;
+	NewTargets.Reserve(TargetLockCharacters.Num());
+	for (AActor* Target : TargetLockCharacters)
+	{
+		if (Target && Target != this) NewTargets.Add(Target);
+	}
+
+	// Update the previous targets, and remove the ones that are no longer target lock characters
+	for (int32 Index = TargetLockData.Num() - 1; Index >= 0; Index--)
+	{
+		FTargetLockInformation& TargetLockInfo = TargetLockData[Index];
+		if (!NewTargets.Remove(TargetLockInfo.Target))
+		{
+			TargetLockData.RemoveAt(Index, 1, false);
+			continue;
+		}
+
+		TargetLockInfo.DistanceToTarget = FVector::Dist(PlayerLocation, TargetLockInfo.Target->GetActorLocation());
+		TargetLockInfo.AngleFromForwardVector = GetTargetLockAngle(PlayerLocation, PlayerRotation, TargetLockInfo.Target->GetActorLocation());
+	}
+
+	for (AActor* Target : TargetLockCharacters)
+	{
+		if (!NewTargets.Remove(Target)) continue;
+		
+		const FVector TargetLocation = Target->GetActorLocation();
+		TargetLockData.Add(FTargetLockInformation(Target, FVector::Dist(PlayerLocation, TargetLocation), GetTargetLockAngle(PlayerLocation, PlayerRotation, TargetLocation)));
+	}
+	
+	// The previous order is usually still sorted, so an insertion sort only shifts the targets that moved past each other, and targets with the same angle don't swap places
+	for (int32 Index = 1; Index < TargetLockData.Num(); Index++)
+	{
+		const FTargetLockInformation TargetLockInfo = TargetLockData[Index];
+		int32 Position = Index;
+		while (Position > 0 && TargetLockData[Position - 1].AngleFromForwardVector < TargetLockInfo.AngleFromForwardVector)
+		{
+			TargetLockData[Position] = TargetLockData[Position - 1];
+			Position--;
+		}
+		
+		TargetLockData[Position] = TargetLockInfo;
+	}
+}
+
+
+int32 ACharacterCameraLogic::FindTargetLockIndex(const float AngleFromForwardVector) const
+{
+	return Algo::LowerBoundBy(TargetLockData, AngleFromForwardVector, &FTargetLockInformation::AngleFromForwardVector, TGreater<>());
+}
+
+
 void ACharacterCameraLogic::Server_SetTargetLockData_Implementation(AActor* Target)
 {
 	SetCurrentTarget(Target);
@@ -22,6 +22,10 @@ class SANDBOX_API ACharacterCameraLogic : public ACharacterBase, public ICameraP
 {
 	GENERATED_BODY()
 
+	/** The target lock automation tests check the target lock data directly */
+	friend class FTargetLockNeighboursTest;
+	friend class FTargetLockOrderTest;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
 	TObjectPtr<UCameraComponent> FollowCamera;
@@ -132,8 +136,20 @@ protected:
 	/** The list of target lock characters */
 	UPROPERTY(BlueprintReadWrite, Transient, Category = "Camera|Target Locking") TArray<AActor*> TargetLockCharacters;
 	
-	/** Metadata about each target lock character, used during AdjustCurrentTarget() to find the next target to transition to. Create your custom logic for how you transition to other targets there */
+	/**
+	 * Metadata about each target lock character, used during AdjustCurrentTarget() to find the next target to transition to. Create your custom logic for how you transition to other targets there.
+	 * This is kept between updates and stays sorted from left to right, so targets with the same angle don't swap places
+	 */
 	UPROPERTY(BlueprintReadWrite, Transient, Category = "Camera|Target Locking") TArray<FTargetLockInformation> TargetLockData;
+
+	/**
+	 * Whether the target lock characters are found with the combat grid during AdjustCurrentTarget(), instead of the ones added with SetTargetLockCharacters().
+	 * Only the characters that pass IsValidTargetLockCandidate() are used @ref UCombatGridSubsystem
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Target Locking") bool bQueryTargetLockCharacters;
+
+	/** The angle in degrees from where the character is looking that target lock characters are found within */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Target Locking", meta = (ClampMin = "0", ClampMax = "180")) float TargetLockViewAngle;
 	
 	/**** Target lock Replication interval values ****/
 	/** There's a delay between when the server sends the information to the server on the current target (because it isn't required, and only slightly affects the camera rotation). When the target lock updates, this helps updating the info */
@@ -288,7 +304,8 @@ public:
 public:
 	/**
 	 * Sorts through the target lock characters and sets the next active target. Finds how far away each target is, and their orientation to the player.
-	 * The array is sorted from left to right, and the active target is selected based on the next target's direction
+	 * The array is sorted from left to right, and the active target is selected based on the next target's direction.
+	 * If bQueryTargetLockCharacters is enabled, the target lock characters are the characters within the radius and view angle from the combat grid
 	 * 
 	 * @remarks Overriding this functions removes the default logic for transitioning between targets
 	 */
@@ -327,6 +344,25 @@ protected:
 	/** Resets the target lock delay to allow transition between targets */
 	UFUNCTION(BlueprintCallable, Category = "Camera|Target Locking") virtual void ResetCurrentTargetDelay();
 	
+	/** Replaces the target lock characters with the characters in the combat grid that are within the radius and view angle, and are valid targets */
+	UFUNCTION(BlueprintCallable, Category = "Camera|Target Locking") virtual void QueryTargetLockCharacters(float Radius, const TArray<AActor*>& ActorsToIgnore);
+
+	/**
+	 * Whether a character found by QueryTargetLockCharacters() can be target locked.
+	 * By default it has to be alive, not friendly, not ignored, and visible from the camera
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Camera|Target Locking") bool IsValidTargetLockCandidate(ACharacterBase* Character, const TArray<AActor*>& ActorsToIgnore) const;
+	virtual bool IsValidTargetLockCandidate_Implementation(ACharacterBase* Character, const TArray<AActor*>& ActorsToIgnore) const;
+
+	/**
+	 * Updates the angle and distance of each target lock character, and keeps the target lock data sorted from left to right.
+	 * The previous order is kept, so only the targets that moved past each other are shifted
+	 */
+	virtual void UpdateTargetLockData();
+
+	/** Returns the index in the target lock data of where a target with that angle from the player's forward vector would be */
+	int32 FindTargetLockIndex(float AngleFromForwardVector) const;
+	
 	/** Clears the array of target lock characters */
 	UFUNCTION(BlueprintCallable, Category = "Camera|Target Locking") virtual void ClearTargetLockCharacters(UPARAM(ref) TArray<AActor*>& ActorsToIgnore);
 	
@@ -8,6 +8,7 @@
 #include "Sandbox/World/Props/Items/Item.h"
 #include "Engine/PackageMapClient.h"
 #include "Logging/StructuredLog.h"
+#include "Net/UnrealNetwork.h"
 
 DEFINE_LOG_CATEGORY(InventoryLog);
 
@@ -18,6 +19,19 @@ UInventoryComponent::UInventoryComponent()
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
 	SetIsReplicatedByDefault(true);
+
+	ReplicatedInventory.Owner = this;
+	SavedInventoryLoadCount = 0;
+	bSavedInventoryLoaded = false;
+}
+
+
+void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME_CONDITION(UInventoryComponent, ReplicatedInventory, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UInventoryComponent, SavedInventoryLoadCount, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UInventoryComponent, bSavedInventoryLoaded, COND_OwnerOnly);
 }
 
 
@@ -115,7 +129,7 @@ void UInventoryComponent::Server_TryAddItem_Implementation(const FGuid& Id, cons
 
 F_Item UInventoryComponent::HandleAddItem_Implementation(const FGuid& Id, const FName DatabaseId, UObject* InventoryItemInterface, const EItemType Type)
 {
-	F_Item Item = *CreateInventoryObject();
+	F_Item Item = CreateInventoryObject();
 	const TScriptInterface<IInventoryItemInterface> InventoryInterface = InventoryItemInterface;
 	if (InventoryInterface.GetInterface()) Item = InventoryInterface->Execute_GetItem(InventoryInterface.GetObject());
 	if (!Item.IsValid())
@@ -134,7 +148,7 @@ F_Item UInventoryComponent::HandleAddItem_Implementation(const FGuid& Id, const
 	if (Item.IsValid())
 	{
 		Execute_InternalAddInventoryItem(this, Item);
-		return Item;
+		if (FindInventoryRecord(Item.Id)) return Item;
 	}
 
 	return FGuid();
@@ -151,14 +165,12 @@ void UInventoryComponent::Client_AddItemResponse_Implementation(const bool bSucc
 	}
 	else
 	{
+		// The item is replicated separately from the response, and might not have been added on the client yet
 		F_Item Item = F_Item();
-		if (ROLE_AutonomousProxy == GetOwner()->GetLocalRole())
-		{
-			Item = Execute_HandleAddItem(this, Id, DatabaseId, InventoryItemInterface, Type);
-		}
-		else if (ROLE_Authority == GetOwner()->GetLocalRole())
+		if (!Execute_GetItem(this, Item, Id, Type))
 		{
-			Execute_GetItem(this, Item, Id, Type);
+			Execute_GetDataBaseItem(this, DatabaseId, Item);
+			Item.Id = Id;
 		}
 		
 		Execute_HandleItemAdditionSuccess(this, Item.Id, Item.ItemName, InventoryItemInterface, Type);
@@ -263,7 +275,7 @@ bool UInventoryComponent::HandleTransferItem_Implementation(const FGuid& Id, UOb
 	// Find the item, and then transfer it to the other inventory
 	const TScriptInterface<IInventoryInterface> OtherInventory = OtherInventoryInterface;
 	if (!Id.IsValid() || !OtherInventory.GetInterface()) return false;
-	F_Item Item = *CreateInventoryObject();
+	F_Item Item = CreateInventoryObject();
 
 	// Search for the item in the player's inventory
 	Execute_GetItem(this, Item, Id, Type);
@@ -315,20 +327,9 @@ bool UInventoryComponent::HandleTransferItem_Implementation(const FGuid& Id, UOb
 }
 
 
-void UInventoryComponent::HandleTransferItemForOtherInventoryClientLogic(const FGuid& Id, const FName DatabaseId, const EItemType Type, const bool bAddItem) { Client_HandleTransferItemForOtherInventory(Id, DatabaseId, Type, bAddItem); }
-void UInventoryComponent::Client_HandleTransferItemForOtherInventory_Implementation(const FGuid& Id, const FName DatabaseId, const EItemType Type, const bool bAddItem)
+void UInventoryComponent::HandleTransferItemForOtherInventoryClientLogic(const FGuid& Id, const FName DatabaseId, const EItemType Type, const bool bAddItem)
 {
-	if (bAddItem)
-	{
-		F_Item Item = *CreateInventoryObject();
-		Execute_GetDataBaseItem(this, DatabaseId, Item);
-		Item.Id = Id;
-		Execute_InternalAddInventoryItem(this, Item);
-	}
-	else
-	{
-		Execute_InternalRemoveInventoryItem(this, Id, Type);
-	}
+	// The other inventory's items are replicated to it's client
 }
 
 
@@ -342,31 +343,7 @@ void UInventoryComponent::Client_TransferItemResponse_Implementation(const bool
 	}
 	else
 	{
-		// Handle removing or adding the item to the inventory on this character if it was transferred to them
-		if (ROLE_AutonomousProxy == GetOwner()->GetLocalRole()) // TODO: are extra checks on clients necessary?
-		{
-			// Add the item on the client
-			if (!bFromThisInventory)
-			{
-				// Execute_HandleTransferItem(this, Id, OtherInventoryInterface, Type, bWasFromThisInventory);
-				F_Item Item = *CreateInventoryObject();
-				Execute_GetDataBaseItem(this, DatabaseId, Item);
-				Item.Id = Id;
-				
-				if (Item.IsValid()) Execute_InternalAddInventoryItem(this, Item);
-				else if (bDebugInventory_Client || bDebugInventory_Server)
-				{
-					UE_LOGFMT(InventoryLog, Error, "({0}) {1}() invalid/unable to create item: {2}({3}) for {4}'s inventory",
-						*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), DatabaseId, *Id.ToString(), *Execute_GetPlayerId(this)
-					);
-				}
-			}
-			else
-			{
-				Execute_InternalRemoveInventoryItem(this, Id, Type);
-			}
-		}
-		
+		// The item is added to or removed from this inventory on the client through replication
 		Execute_HandleTransferItemSuccess(this, Id, OtherInventoryInterface, bFromThisInventory);
 		OnInventoryItemTransferSuccess.Broadcast(Id, OtherInventory, bFromThisInventory);
 	}
@@ -452,7 +429,7 @@ bool UInventoryComponent::HandleRemoveItem_Implementation(const FGuid& Id, const
 {
 	if (bDropItem)
 	{
-		F_Item Item = *CreateInventoryObject();
+		F_Item Item = CreateInventoryObject();
 		Execute_GetItem(this, Item, Id, Type);
 		
 		if (!Item.IsValid())
@@ -494,11 +471,7 @@ void UInventoryComponent::Client_RemoveItemResponse_Implementation(const bool bS
 	}
 	else
 	{
-		if (ROLE_AutonomousProxy == GetOwner()->GetLocalRole()) // TODO: are extra checks on clients necessary?
-		{
-			Execute_HandleRemoveItem(this, Id, Type, false, SpawnedItem);
-		}
-		
+		// The item is removed from the client's inventory through replication
 		Execute_HandleRemoveItemSuccess(this, Id, Type, bDropItem, SpawnedItem);
 		OnInventoryItemRemovalSuccess.Broadcast(Id, SpawnedItem);
 	}
@@ -553,18 +526,24 @@ F_InventorySaveInformation UInventoryComponent::GetInventorySaveInformation()
 		if (SaveInformation) SaveData = SaveInformation->CharacterInformation;
 	*/
 	
-	TArray<FS_Item> InventoryItems;
+	F_InventorySaveInformation SaveInformation;
+	const FItemCatalog* Catalog = GetItemCatalog();
+	if (Catalog)
+	{
+		SaveInformation.InventoryItems.Reserve(InventoryItems.Num() + UnresolvedSavedItems.Num());
+		for (const FInventoryRecord& Record : InventoryItems)
+		{
+			// Items whose row was removed are saved with their original name
+			if (UnresolvedSavedItems.Contains(Record.Id)) continue;
+			SaveInformation.InventoryItems.Add(FS_Item(Record.Id, Catalog->GetRowName(Record.RowIndex), Record.SortOrder));
+		}
+	}
 
-	if (!QuestItems.IsEmpty()) for (auto &[Id, Item] : QuestItems) InventoryItems.Add(CreateSavedItem(Item));
-	if (!CommonItems.IsEmpty()) for (auto &[Id, Item] : CommonItems) InventoryItems.Add(CreateSavedItem(Item));
-	if (!Weapons.IsEmpty()) for (auto &[Id, Item] : Weapons) InventoryItems.Add(CreateSavedItem(Item));
-	if (!Armors.IsEmpty()) for (auto &[Id, Item] : Armors) InventoryItems.Add(CreateSavedItem(Item));
-	if (!Materials.IsEmpty()) for (auto &[Id, Item] : Materials) InventoryItems.Add(CreateSavedItem(Item));
-	if (!Notes.IsEmpty()) for (auto &[Id, Item] : Notes) InventoryItems.Add(CreateSavedItem(Item));
+	for (const auto& [Id, SavedItem] : UnresolvedSavedItems)
+	{
+		SaveInformation.InventoryItems.Add(SavedItem);
+	}
 
-	// 
-	F_InventorySaveInformation SaveInformation;
-	SaveInformation.InventoryItems = InventoryItems;
 	SaveInformation.NetId = NetId;
 	SaveInformation.PlatformId = PlatformId;
 
@@ -589,65 +568,22 @@ void UInventoryComponent::LoadInventoryInformation(const F_InventorySaveInformat
 		SetPlayerId();
 	}
 	
-	// Server logic
+	// The items are added on the server, and replicated to the client through the inventory list
 	CurrentInventorySaveData = SaveInformation;
 	SaveState = ESaveState::ESave_SaveReady;
-
-	// Client logic
-	Client_BeginLoadingInventoryData();
-	
-	// Load inventory items @note We might get errors if we send over everything altogether, so this is divided into multiple functions
-	TArray<FS_Item> SavedItems;
-	for (int i = 0; i < SaveInformation.InventoryItems.Num(); i++)
-	{
-		SavedItems.Add(SaveInformation.InventoryItems[i]);
-		if (SavedItems.Num() >= 45)
-		{
-			Client_LoadSomeInventoryData(SavedItems);
-			SavedItems.Empty();
-		}
-	}
-	if (!SavedItems.IsEmpty())
-	{
-		Client_LoadSomeInventoryData(SavedItems);
-	}
-	
-	Client_LoadSaveDataCompleted();
 }
 
 
-void UInventoryComponent::Client_BeginLoadingInventoryData_Implementation()
-{
-	ClientInventorySaveData.NetId = NetId;
-	ClientInventorySaveData.PlatformId = PlatformId;
-
-	SaveState = ESaveState::ESave_Pending;
-	ClientInventorySaveData.InventoryItems.Empty();
-}
-void UInventoryComponent::Client_LoadSomeInventoryData_Implementation(const TArray<FS_Item>& Items)
-{
-	// Retrieve some of the items that were sent from the server
-	for (FS_Item Item : Items)
-	{
-		ClientInventorySaveData.InventoryItems.Add(Item);
-	}
-}
-void UInventoryComponent::Client_LoadSaveDataCompleted_Implementation()
+void UInventoryComponent::OnRep_SavedInventoryLoaded()
 {
 	if (!GetCharacter()) return;
 	if (bDebugSaveInformation || bDebugInventory_Client)
 	{
-		UE_LOGFMT(InventoryLog, Warning, "LoadSaveData finished on the {0}, inventory items: {1}", *UEnum::GetValueAsString(Character->GetLocalRole()), ClientInventorySaveData.InventoryItems.Num());
+		UE_LOGFMT(InventoryLog, Warning, "LoadSaveData finished on the {0}, inventory items: {1}", *UEnum::GetValueAsString(Character->GetLocalRole()), ReplicatedInventory.Items.Num());
 	}
-	
-	// Update the CurrentInventorySaveData value in preparation for when the inventory is updated
-	CurrentInventorySaveData = ClientInventorySaveData;
-	SaveState = ESaveState::ESave_SaveReady;
 
-	// Clear out the pending values
-	ClientInventorySaveData.NetId = NetId;
-	ClientInventorySaveData.PlatformId = PlatformId;
-	ClientInventorySaveData.InventoryItems.Empty();
+	SaveState = ESaveState::ESave_Saved;
+	OnLoadSaveData.Broadcast(bSavedInventoryLoaded);
 }
 
 
@@ -663,21 +599,26 @@ bool UInventoryComponent::UpdateInventoryInformation(const F_InventorySaveInform
 		);
 	}
 	
-	for (const FS_Item SavedItem : SaveInformation.InventoryItems)
+	// Saved items only need their database row, the rest of their information is retrieved from the item database cache
+	const FItemCatalog* Catalog = GetItemCatalog();
+	InventoryItems.Reserve(InventoryItems.Num() + SaveInformation.InventoryItems.Num());
+	for (const FS_Item& SavedItem : SaveInformation.InventoryItems)
 	{
-		F_Item Item;
-		Execute_GetDataBaseItem(this, SavedItem.ItemName, Item);
-
-		// Update the item information with saved item's information
-		Item.Id = SavedItem.Id;
-		Item.SortOrder = SavedItem.SortOrder;
-
-		if (Item.IsValid())
+		const int32 RowIndex = Catalog ? Catalog->FindRowIndex(SavedItem.ItemName) : INDEX_NONE;
+		if (SavedItem.Id.IsValid() && Catalog && RowIndex == INDEX_NONE)
+		{
+			// Keep the item until its row is added back to the item database
+			UE_LOGFMT(InventoryLog, Warning, "({0}) {1}() {2}({3}) isn't in the item database, it's kept in the save information but isn't added to the inventory",
+				*UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), SavedItem.ItemName, *SavedItem.Id.ToString()
+			);
+			UnresolvedSavedItems.Add(SavedItem.Id, SavedItem);
+			continue;
+		}
+		
+		if (!SavedItem.Id.IsValid() || !AddInventoryRecord(SavedItem.Id, RowIndex, SavedItem.SortOrder))
 		{
-			TMap<FGuid, F_Item>& InventoryList = GetInventoryList(Item.ItemType);
-			InventoryList.Add(Item.GetId(), Item);
+			bSuccessfullySavedInventory = false;
 		}
-		else bSuccessfullySavedInventory = false;
 	}
 
 	if (bDebugSaveInformation)
@@ -689,7 +630,9 @@ bool UInventoryComponent::UpdateInventoryInformation(const F_InventorySaveInform
 		
 	}
 
-	// Let the client know the save information has been completed
+	// Let the client know the save information has been completed. The replicated items are sent alongside this
+	bSavedInventoryLoaded = bSuccessfullySavedInventory;
+	SavedInventoryLoadCount++;
 	OnLoadSaveData.Broadcast(bSuccessfullySavedInventory);
 	return bSuccessfullySavedInventory;
 }
@@ -715,104 +658,300 @@ FS_Item UInventoryComponent::CreateSavedItem(const F_Item& Item) const
 
 
 
+#pragma region Replication
+FInventoryEntry UInventoryComponent::CreateInventoryEntry(const FInventoryRecord& Record)
+{
+	const FItemCatalog* Catalog = GetItemCatalog();
+	return FInventoryEntry(Record.Id, Catalog ? Catalog->GetRowName(Record.RowIndex) : NAME_None, Record.SortOrder, Record.StackCount);
+}
+
+
+void UInventoryComponent::HandleReplicatedEntryAdded(const FInventoryEntry& Entry)
+{
+	const FItemCatalog* Catalog = GetItemCatalog();
+	const FInventoryRecord* Record = AddInventoryRecord(Entry.Id, Catalog ? Catalog->FindRowIndex(Entry.ItemName) : INDEX_NONE, Entry.SortOrder, Entry.StackCount);
+	if (!Record)
+	{
+		UE_LOGFMT(InventoryLog, Error, "({0}) {1}() failed to find replicated item {2}({3}) in the item database for {4}'s inventory",
+			*UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), Entry.ItemName, *Entry.Id.ToString(), *Execute_GetPlayerId(this)
+		);
+		return;
+	}
+
+	if (OnReplicatedItemAdded.IsBound()) OnReplicatedItemAdded.Broadcast(CreateItemFromRecord(*Record));
+	if (bDebugInventory_Client)
+	{
+		UE_LOGFMT(InventoryLog, Log, "({0}) {1}() {2} + {3}({4})", *UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), *Execute_GetPlayerId(this), Entry.ItemName, *Entry.Id.ToString());
+	}
+}
+
+
+void UInventoryComponent::HandleReplicatedEntryChanged(const FInventoryEntry& Entry)
+{
+	const int32* Index = InventoryItemIndexes.Find(Entry.Id);
+	if (!Index)
+	{
+		HandleReplicatedEntryAdded(Entry);
+		return;
+	}
+
+	FInventoryRecord& Record = InventoryItems[*Index];
+	Record.SortOrder = Entry.SortOrder;
+	Record.StackCount = Entry.StackCount;
+	if (OnReplicatedItemChanged.IsBound()) OnReplicatedItemChanged.Broadcast(CreateItemFromRecord(Record));
+}
+
+
+void UInventoryComponent::HandleReplicatedEntryRemoved(const FInventoryEntry& Entry)
+{
+	const FInventoryRecord* Record = FindInventoryRecord(Entry.Id);
+	if (!Record) return;
+
+	const F_Item Item = OnReplicatedItemRemoved.IsBound() ? CreateItemFromRecord(*Record) : F_Item();
+	RemoveInventoryRecord(Entry.Id);
+	if (OnReplicatedItemRemoved.IsBound()) OnReplicatedItemRemoved.Broadcast(Item);
+
+	if (bDebugInventory_Client)
+	{
+		UE_LOGFMT(InventoryLog, Log, "({0}) {1}() {2} - {3}({4})", *UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), *Execute_GetPlayerId(this), Entry.ItemName, *Entry.Id.ToString());
+	}
+}
+#pragma endregion
+
+
+
+
 #pragma region Utility
 F_Item UInventoryComponent::InternalGetInventoryItem_Implementation(const FGuid& Id, EItemType InventorySectionToSearch)
 {
-	F_Item Item = *CreateInventoryObject();
+	// Every item is in the same index, the section isn't needed to find it
+	const FInventoryRecord* Record = FindInventoryRecord(Id);
+	return Record ? CreateItemFromRecord(*Record) : CreateInventoryObject();
+}
+
 
-	// Search for the item in the inventory, and return it
-	if (EItemType::Inv_None != InventorySectionToSearch)
+void UInventoryComponent::InternalRemoveInventoryItem_Implementation(const FGuid& Id, const EItemType InventorySectionToSearch)
+{
+	RemoveInventoryRecord(Id);
+}
+
+
+void UInventoryComponent::InternalAddInventoryItem_Implementation(const F_Item& Item)
+{
+	const FItemCatalog* Catalog = GetItemCatalog();
+	if (!AddInventoryRecord(Item.Id, Catalog ? Catalog->FindRowIndex(Item.ItemName) : INDEX_NONE, Item.SortOrder))
 	{
-		TMap<FGuid, F_Item>& InventoryList = GetInventoryList(InventorySectionToSearch);
-		if (InventoryList.Contains(Id))
-		{
-			Item = InventoryList[Id];
-			return Item;
-		}
+		UE_LOGFMT(InventoryLog, Error, "({0}) {1}() {2}({3}) isn't in the item database, it wasn't added to {4}'s inventory",
+			*UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), Item.ItemName, *Item.Id.ToString(), *Execute_GetPlayerId(this)
+		);
 	}
+}
+
+
+FInventoryRecord* UInventoryComponent::AddInventoryRecord(const FGuid& Id, const int32 RowIndex, const int32 SortOrder, const int32 StackCount)
+{
+	const FItemCatalog* Catalog = GetItemCatalog();
+	const F_Item* ItemData = Catalog ? Catalog->Get(RowIndex) : nullptr;
+	if (!Id.IsValid() || !ItemData) return nullptr;
 
-	// if nothing is specified then search through everything
-	for (int i = 0; i < static_cast<int>(EItemType::Inv_MAX); i++)
+	// Items that are already in the inventory are updated
+	FInventoryRecord* Record;
+	if (const int32* Index = InventoryItemIndexes.Find(Id))
 	{
-		const EItemType ItemType = static_cast<EItemType>(i);
-		TMap<FGuid, F_Item>& InventoryList = GetInventoryList(ItemType);
-		if (InventoryList.Contains(Id))
+		Record = &InventoryItems[*Index];
+		if (Record->ItemType != ItemData->ItemType)
 		{
-			Item = InventoryList[Id];
-			return Item;
+			ItemTypeIndexes[static_cast<int32>(Record->ItemType)].RemoveSingleSwap(*Index, false);
+			ItemTypeIndexes[static_cast<int32>(ItemData->ItemType)].Add(*Index);
 		}
 	}
-	
+	else
+	{
+		const int32 Index = InventoryItems.AddDefaulted();
+		InventoryItemIndexes.Add(Id, Index);
+		ItemTypeIndexes[static_cast<int32>(ItemData->ItemType)].Add(Index);
+		Record = &InventoryItems[Index];
+		Record->Id = Id;
+	}
+
+	Record->RowIndex = RowIndex;
+	Record->SortOrder = SortOrder;
+	Record->StackCount = StackCount;
+	Record->ItemType = ItemData->ItemType;
+
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		ReplicatedInventory.AddEntry(CreateInventoryEntry(*Record));
+	}
+
+	return Record;
+}
+
+
+bool UInventoryComponent::RemoveInventoryRecord(const FGuid& Id)
+{
+	int32 Index;
+	if (!InventoryItemIndexes.RemoveAndCopyValue(Id, Index)) return false;
+	UnresolvedSavedItems.Remove(Id);
+
+	ItemTypeIndexes[static_cast<int32>(InventoryItems[Index].ItemType)].RemoveSingleSwap(Index, false);
+
+	// The last item is moved into the removed item's slot
+	const int32 LastIndex = InventoryItems.Num() - 1;
+	if (Index != LastIndex)
+	{
+		const FInventoryRecord& MovedRecord = InventoryItems[LastIndex];
+		InventoryItemIndexes[MovedRecord.Id] = Index;
+		const int32 TypeIndex = ItemTypeIndexes[static_cast<int32>(MovedRecord.ItemType)].Find(LastIndex);
+		if (TypeIndex != INDEX_NONE) ItemTypeIndexes[static_cast<int32>(MovedRecord.ItemType)][TypeIndex] = Index;
+	}
+	InventoryItems.RemoveAtSwap(Index, 1, false);
+
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		ReplicatedInventory.RemoveEntry(Id);
+	}
+
+	return true;
+}
+
+
+const FInventoryRecord* UInventoryComponent::FindInventoryRecord(const FGuid& Id) const
+{
+	const int32* Index = InventoryItemIndexes.Find(Id);
+	return Index ? &InventoryItems[*Index] : nullptr;
+}
+
+
+const F_Item* UInventoryComponent::FindRecordItemData(const FInventoryRecord& Record)
+{
+	const FItemCatalog* Catalog = GetItemCatalog();
+	return Catalog ? Catalog->Get(Record.RowIndex) : nullptr;
+}
+
+
+F_Item UInventoryComponent::CreateItemFromRecord(const FInventoryRecord& Record)
+{
+	const F_Item* ItemData = FindRecordItemData(Record);
+	if (!ItemData) return CreateInventoryObject();
+
+	F_Item Item = *ItemData;
+	Item.Id = Record.Id;
+	Item.SortOrder = Record.SortOrder;
 	return Item;
 }
 
 
-void UInventoryComponent::InternalRemoveInventoryItem_Implementation(const FGuid& Id, const EItemType InventorySectionToSearch)
+void UInventoryComponent::GetInventoryItems(const EItemType Type, TArray<F_Item>& OutItems, const bool bSortItems)
 {
-	TMap<FGuid, F_Item>& InventoryList = GetInventoryList(InventorySectionToSearch);
-	if (InventoryList.Contains(Id))
+	if (Type >= EItemType::Inv_MAX) return;
+
+	TArray<int32> Indexes = ItemTypeIndexes[static_cast<int32>(Type)];
+	if (bSortItems)
+	{
+		Indexes.Sort([this](const int32 A, const int32 B) { return InventoryItems[A].SortOrder < InventoryItems[B].SortOrder; });
+	}
+
+	OutItems.Reserve(OutItems.Num() + Indexes.Num());
+	for (const int32 Index : Indexes)
 	{
-		InventoryList.Remove(Id);
+		OutItems.Add(CreateItemFromRecord(InventoryItems[Index]));
 	}
-	// else
-	// {
-	// 	for (int i = 0; i < static_cast<int>(EItemType::Inv_MAX); i++)
-	// 	{
-	// 		const EItemType ItemType = static_cast<EItemType>(i);
-	// 		InventoryList = GetInventoryList(ItemType);
-	// 		if (InventoryList.Contains(Id))
-	// 		{
-	// 			InventoryList.Remove(Id);
-	// 			return;
-	// 		}
-	// 	}
-	// }
 }
 
 
-void UInventoryComponent::InternalAddInventoryItem_Implementation(const F_Item& Item)
+int32 UInventoryComponent::GetInventoryItemCount() const
 {
-	TMap<FGuid, F_Item>& InventoryList = GetInventoryList(Item.ItemType);
-	InventoryList.Add(Item.Id, Item);
+	return InventoryItems.Num();
 }
 
 
-TMap<FGuid, F_Item>& UInventoryComponent::GetInventoryList(EItemType InventorySectionToSearch)
+TMap<FGuid, F_Item> UInventoryComponent::GetInventoryList(const EItemType InventorySectionToSearch)
 {
-	if (EItemType::Inv_QuestItem == InventorySectionToSearch) return QuestItems;
-	if (EItemType::Inv_Item == InventorySectionToSearch) return CommonItems;
-	if (EItemType::Inv_Weapon == InventorySectionToSearch) return Weapons;
-	if (EItemType::Inv_Armor == InventorySectionToSearch) return Armors;
-	if (EItemType::Inv_Material == InventorySectionToSearch) return Materials;
-	if (EItemType::Inv_Note == InventorySectionToSearch) return Notes;
-	
-	if (EItemType::Inv_Custom == InventorySectionToSearch)
+	// Sections that aren't valid return the common items
+	const EItemType Type = InventorySectionToSearch < EItemType::Inv_MAX ? InventorySectionToSearch : EItemType::Inv_Item;
+	const TArray<int32>& Indexes = ItemTypeIndexes[static_cast<int32>(Type)];
+	TMap<FGuid, F_Item> Items;
+	Items.Reserve(Indexes.Num());
+	for (const int32 Index : Indexes)
+	{
+		Items.Add(InventoryItems[Index].Id, CreateItemFromRecord(InventoryItems[Index]));
+	}
+
+	return Items;
+}
+
+
+const FItemCatalog* UInventoryComponent::GetItemCatalog()
+{
+	// Catalogs are rebuilt once their data table is edited, so it's retrieved from the subsystem each time instead of holding onto a stale copy
+	UItemCatalogSubsystem* CatalogSubsystem = UItemCatalogSubsystem::Get();
+	TSharedPtr<const FItemCatalog> Catalog = CatalogSubsystem ? CatalogSubsystem->GetItemCatalog(ItemDatabase) : nullptr;
+	if (Catalog != ItemCatalog)
 	{
-		// TODO: Custom item logic here (map enums to int values)
+		const TSharedPtr<const FItemCatalog> PreviousCatalog = ItemCatalog;
+		ItemCatalog = Catalog;
+		if (PreviousCatalog.IsValid() && ItemCatalog.IsValid()) ResolveInventoryRecords(*PreviousCatalog);
 	}
 
-	return CommonItems;
+	return ItemCatalog.Get();
 }
 
 
+void UInventoryComponent::ResolveInventoryRecords(const FItemCatalog& PreviousCatalog)
+{
+	// The rows could have been added, removed, or reordered, find each item's row again by it's name
+	for (int32 Index = 0; Index < InventoryItems.Num(); Index++)
+	{
+		FInventoryRecord& Record = InventoryItems[Index];
+		const FName RowName = PreviousCatalog.GetRowName(Record.RowIndex);
+		Record.RowIndex = ItemCatalog->FindRowIndex(RowName);
+
+		const F_Item* ItemData = ItemCatalog->Get(Record.RowIndex);
+		if (!ItemData)
+		{
+			UE_LOGFMT(InventoryLog, Warning, "({0}) {1}() {2}({3}) is no longer in the item database",
+				*UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), RowName, *Record.Id.ToString()
+			);
+
+			// Remember the row it was added with, so it's saved under the same name
+			if (!UnresolvedSavedItems.Contains(Record.Id)) UnresolvedSavedItems.Add(Record.Id, FS_Item(Record.Id, RowName, Record.SortOrder));
+			continue;
+		}
+
+		UnresolvedSavedItems.Remove(Record.Id);
+
+		if (Record.ItemType != ItemData->ItemType)
+		{
+			ItemTypeIndexes[static_cast<int32>(Record.ItemType)].RemoveSingleSwap(Index, false);
+			ItemTypeIndexes[static_cast<int32>(ItemData->ItemType)].Add(Index);
+			Record.ItemType = ItemData->ItemType;
+		}
+	}
+}
+
 
 bool UInventoryComponent::GetItem_Implementation(F_Item& ReturnedItem, FGuid Id, EItemType InventorySectionToSearch)
 {
 	if (!Id.IsValid()) return false;
 
 	// search for the item in the inventory
-	ReturnedItem = Execute_InternalGetInventoryItem(this, Id, InventorySectionToSearch);
-	if (ReturnedItem.IsValid()) return true;
-	return false;
+	const FInventoryRecord* Record = FindInventoryRecord(Id);
+	if (!Record) return false;
+
+	ReturnedItem = CreateItemFromRecord(*Record);
+	return ReturnedItem.IsValid();
 }
 
 
 bool UInventoryComponent::GetDataBaseItem_Implementation(const FName Id, F_Item& Item)
 {
-	if (!ItemDatabase || Id.IsNone()) return false;
-	if (const FInventory_ItemDatabase* ItemData = ItemDatabase->FindRow<FInventory_ItemDatabase>(Id, TEXT("Inventory Item Data Context")))
+	if (Id.IsNone()) return false;
+
+	const FItemCatalog* Catalog = GetItemCatalog();
+	if (const F_Item* ItemData = Catalog ? Catalog->Find(Id) : nullptr)
 	{
-		Item = ItemData->ItemInformation;
+		Item = *ItemData;
 		Item.Id = FGuid::NewGuid();
 		return true;
 	}
@@ -821,9 +960,9 @@ bool UInventoryComponent::GetDataBaseItem_Implementation(const FName Id, F_Item&
 }
 
 
-F_Item* UInventoryComponent::CreateInventoryObject() const
+F_Item UInventoryComponent::CreateInventoryObject() const
 {
-	return new F_Item();
+	return F_Item();
 }
 
 ESaveState UInventoryComponent::GetSaveState()
@@ -888,12 +1027,10 @@ TScriptInterface<IInventoryItemInterface> UInventoryComponent::SpawnWorldItem_Im
 
 FName UInventoryComponent::GetItemId(const FGuid& Id, EItemType Type, UObject* OtherInventory)
 {
-	F_Item Item;
-	Execute_GetItem(this, Item, Id, Type);
-
-	if (Item.IsValid())
+	if (const FInventoryRecord* Record = FindInventoryRecord(Id))
 	{
-		return Item.ItemName;
+		const F_Item* ItemData = FindRecordItemData(*Record);
+		return ItemData ? ItemData->ItemName : FName();
 	}
 	
 	const TScriptInterface<IInventoryInterface> Inventory = OtherInventory;
@@ -902,6 +1039,7 @@ FName UInventoryComponent::GetItemId(const FGuid& Id, EItemType Type, UObject* O
 		return FName();
 	}
 	
+	F_Item Item;
 	Inventory->Execute_GetItem(Inventory.GetObject(), Item, Id, Type);
 	return Item.ItemName;
 }
@@ -935,12 +1073,11 @@ void UInventoryComponent::ListInventory()
 	if (!GetCharacter()) return;
 	
 	TArray<FS_Item> ClientItems; // Used for capturing both the id and the database id
-	for (auto &[Id, Item] : QuestItems) ClientItems.Add(FS_Item(Id, Item.ItemName));
-	for (auto &[Id, Item] : CommonItems) ClientItems.Add(FS_Item(Id, Item.ItemName));
-	for (auto &[Id, Item] : Weapons) ClientItems.Add(FS_Item(Id, Item.ItemName));
-	for (auto &[Id, Item] : Armors) ClientItems.Add(FS_Item(Id, Item.ItemName));
-	for (auto &[Id, Item] : Materials) ClientItems.Add(FS_Item(Id, Item.ItemName));
-	for (auto &[Id, Item] : Notes) ClientItems.Add(FS_Item(Id, Item.ItemName));
+	for (const FInventoryRecord& Record : InventoryItems)
+	{
+		const F_Item* ItemData = FindRecordItemData(Record);
+		ClientItems.Add(FS_Item(Record.Id, ItemData ? ItemData->ItemName : FName()));
+	}
 	Server_ListInventory(ClientItems, Character->HasAuthority());
 }
 
@@ -963,35 +1100,25 @@ void UInventoryComponent::Server_ListInventory_Implementation(const TArray<FS_It
 	UE_LOGFMT(InventoryLog, Log, "//----------------------------------------------------------------------------------------------------------------------------------/");
 	
 	// List the server's inventory values
-	if (!Weapons.IsEmpty()) 
-	{
-		ListInventoryMap(Weapons, FString("Armaments"));
-		for (auto &[Id, Item] : Weapons) ServerInventoryList.Add(Id, Item.ItemName); 
-	}
-	if (!Armors.IsEmpty()) 
-	{
-		ListInventoryMap(Armors, FString("Armors"));
-		for (auto &[Id, Item] : Armors) ServerInventoryList.Add(Id, Item.ItemName); 
-	}
-	if (!CommonItems.IsEmpty()) 
+	const TPair<EItemType, FString> Sections[] = {
+		{ EItemType::Inv_Weapon, FString("Armaments") },
+		{ EItemType::Inv_Armor, FString("Armors") },
+		{ EItemType::Inv_Item, FString("Common Items") },
+		{ EItemType::Inv_QuestItem, FString("Quest Items") },
+		{ EItemType::Inv_Material, FString("Materials") },
+		{ EItemType::Inv_Note, FString("Notes") },
+		{ EItemType::Inv_Custom, FString("Custom Items") },
+		{ EItemType::Inv_None, FString("Other Items") }
+	};
+	for (const auto& [Type, ListName] : Sections)
 	{
-		ListInventoryMap(CommonItems, FString("Common Items"));
-		for (auto &[Id, Item] : CommonItems) ServerInventoryList.Add(Id, Item.ItemName); 
+		if (!ItemTypeIndexes[static_cast<int32>(Type)].IsEmpty()) ListInventoryType(Type, ListName);
 	}
-	if (!QuestItems.IsEmpty()) 
-	{
-		ListInventoryMap(QuestItems, FString("Quest Items"));
-		for (auto &[Id, Item] : QuestItems) ServerInventoryList.Add(Id, Item.ItemName); 
-	}
-	if (!Materials.IsEmpty()) 
-	{
-		ListInventoryMap(Materials, FString("Materials"));
-		for (auto &[Id, Item] : Materials) ServerInventoryList.Add(Id, Item.ItemName); 
-	}
-	if (!Notes.IsEmpty()) 
+
+	for (const FInventoryRecord& Record : InventoryItems)
 	{
-		ListInventoryMap(Notes, FString("Notes"));
-		for (auto &[Id, Item] : Notes) ServerInventoryList.Add(Id, Item.ItemName); 
+		const F_Item* ItemData = FindRecordItemData(Record);
+		ServerInventoryList.Add(Record.Id, ItemData ? ItemData->ItemName : FName());
 	}
 	
 	// List the inventory items on client and server
@@ -1017,7 +1144,7 @@ void UInventoryComponent::Server_ListInventory_Implementation(const TArray<FS_It
 }
 
 
-void UInventoryComponent::ListInventoryMap(const TMap<FGuid, F_Item>& Map, FString ListName)
+void UInventoryComponent::ListInventoryType(const EItemType Type, FString ListName)
 {
 	if (!GetCharacter()) return;
 
@@ -1026,7 +1153,9 @@ void UInventoryComponent::ListInventoryMap(const TMap<FGuid, F_Item>& Map, FStri
 	UE_LOGFMT(InventoryLog, Log, "// {0} ", ListName);
 	UE_LOGFMT(InventoryLog, Log, "//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~/");
 	UE_LOGFMT(InventoryLog, Log, " ");
-	for (auto &[Id, Item] : Map) ListInventoryItem(Item);
+	TArray<F_Item> Items;
+	GetInventoryItems(Type, Items);
+	for (const F_Item& Item : Items) ListInventoryItem(Item);
 }
 
 
@@ -7,6 +7,8 @@
 #include "Sandbox/Data/Enums/InventoryTypes.h"
 #include "Sandbox/Data/Structs/InventoryInformation.h"
 #include "Sandbox/Data/Interfaces/Inventory/InventoryInterface.h"
+#include "Sandbox/Characters/Components/Inventory/InventoryList.h"
+#include "Sandbox/Data/Catalog/ItemCatalogSubsystem.h"
 #include "InventoryComponent.generated.h"
 
 
@@ -28,13 +30,37 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInventoryItemRemovalFailureDelegat
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInventoryItemRemovalSuccessDelegate, const F_Item&, ItemData, UObject*, SpawnedItem);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLoadSaveDataInventoryDelegate, bool, bSuccessfullySavedInventory);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventoryReplicatedItemDelegate, const F_Item&, ItemData);
+
+
+/**
+ * A lightweight record of an item in the inventory. The item's static information is retrieved from the item database catalog (@ref FItemCatalog) with it's row index
+ */
+struct FInventoryRecord
+{
+	/** The unique id for this item */
+	FGuid Id;
+
+	/** The item's row in the item database cache */
+	int32 RowIndex = INDEX_NONE;
+
+	/** The sort order for the inventory item */
+	int32 SortOrder = -1;
+
+	/** The amount of this item in the stack */
+	int32 StackCount = 1;
+
+	/** The item type, used for retrieving the items of a specific type */
+	EItemType ItemType = EItemType::Inv_None;
+};
 
 
 /**
  * An inventory system for player's for storing and retrieving different inventory items in multiplayer with error handling in a safe and efficient way that even allows for customization, and works out of the box.
  * All you need to do is add the component to the character, and store and retrieve values from it. There's also logic for saving information, just search through the function list in the blueprint.
  *
- * @remarks We use remote procedure calls so replication doesn't have to try and handle everything, and only pass everything with references when we're storing information
+ * @remarks The inventory is replicated to the owning client through a fast array (@ref FInventoryList), so only the items that were added, changed, or removed are sent.
+ *			Remote procedure calls are only used for requesting changes and responding with whether they succeeded
  */
 UCLASS( Blueprintable, ClassGroup=(Inventory), meta=(BlueprintSpawnableComponent) )
 class SANDBOX_API UInventoryComponent : public UActorComponent, public IInventoryInterface
@@ -42,14 +68,26 @@ class SANDBOX_API UInventoryComponent : public UActorComponent, public IInventor
 	GENERATED_BODY()
 
 protected:
-	/**** Inventory ****/ // I've divided the inventory into maps for quick retrieval, however you're able to build with arrays and other things if you want to adjust the logic */
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> QuestItems;
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> CommonItems;
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> Weapons;
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> Armors;
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> Materials;
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory") TMap<FGuid, F_Item> Notes;
+	/**** Inventory ****/
+	/** Every item in the inventory. Items are only stored with their id and database row, everything else is retrieved from the item database cache */
+	TArray<FInventoryRecord> InventoryItems;
+
+	/** The index of each item in the inventory */
+	TMap<FGuid, int32> InventoryItemIndexes;
+
+	/** The indexes of the items of each type, for retrieving and sorting a specific section of the inventory */
+	TArray<int32> ItemTypeIndexes[static_cast<int32>(EItemType::Inv_MAX)];
+
+	/** The item database's catalog the items' row indexes were resolved with */
+	TSharedPtr<const FItemCatalog> ItemCatalog;
+
+	/** Saved items that aren't in the item database. They're kept with their row name and written back when the inventory is saved, so removing a row doesn't lose the item */
+	TMap<FGuid, FS_Item> UnresolvedSavedItems;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory") UDataTable* ItemDatabase;
+
+	/** The replicated inventory. The server adds every item to this, and clients build their inventory from it's entries */
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Inventory") FInventoryList ReplicatedInventory;
 	
 	/**** References and stored information ****/
 	/** The client's Net Id */
@@ -70,6 +108,7 @@ protected:
 protected:
 	UInventoryComponent();
 	virtual void BeginPlay() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	// Loading / Saving the inventory information should be handled in the player state!
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -201,18 +240,6 @@ protected:
 	 */
 	virtual bool HandleTransferItem_Implementation(const FGuid& Id, UObject* OtherInventoryInterface, const EItemType Type, bool& bFromThisInventory) override;
 	
-	/**
-	 * Utility function for handling updating the inventory information on other clients during an item transfer
-	 * 
-	 * @param Id										The unique id of the inventory item.
-	 * @param DatabaseId								The id for this item in the inventory
-	 * @param Type										The item type (used for item allocation)
-	 * @param bAddItem									Whether the item is being added or removed from the inventory
-	 * 
-	 * @remarks Client logic doesn't have any problems when invoking the handle logic on the client response functions, it's just problematic when there's multiple Clients (During a transfer)
-	 */
-	UFUNCTION(Client, Reliable) virtual void Client_HandleTransferItemForOtherInventory(const FGuid& Id, const FName DatabaseId, const EItemType Type, const bool bAddItem);
-	
 	/**
 	 * If the item was not transferred to the other inventory
 	 * 
@@ -244,7 +271,7 @@ public:
 	 * @param Type										The item type (used for item allocation)
 	 * @param bAddItem									Whether the item is being added or removed from the inventory
 	 * 
-	 * @remarks Client logic doesn't have any problems when invoking the handle logic on the client response functions, it's just problematic when there's multiple Clients (During a transfer)
+	 * @remarks The other inventory's items are replicated to it's client, so nothing needs to be sent here unless you've added custom client logic
 	 */
 	virtual void HandleTransferItemForOtherInventoryClientLogic(const FGuid& Id, const FName DatabaseId, const EItemType Type, const bool bAddItem) override;
 	
@@ -324,11 +351,14 @@ protected:
 	/** The save state of the inventory. Used when the player is saving information for communication between the server and client to determine when the client has retrieved it's save information  */
 	UPROPERTY(BlueprintReadWrite, Transient, Category = "Inventory|Saving") ESaveState SaveState;
 
-	/** The current inventory save data. This isn't updated until the server has sent all it's inventory information */
+	/** The current inventory save data. This is added to the inventory on the server, and the items are replicated to the client */
 	UPROPERTY(BlueprintReadWrite, Transient, Category = "Inventory|Saving") F_InventorySaveInformation CurrentInventorySaveData;
 
-	/** This is a value to store the information that's sent to the client. Once everything has been sent to the client, the current inventory save data is updated with this information */
-	UPROPERTY(BlueprintReadWrite, Transient, Category = "Inventory|Saving") F_InventorySaveInformation ClientInventorySaveData;
+	/** Incremented each time the server finishes loading saved inventory information. Lets the client know when it's save information has been loaded */
+	UPROPERTY(ReplicatedUsing = OnRep_SavedInventoryLoaded, Transient) int32 SavedInventoryLoadCount;
+
+	/** Whether every saved item was successfully added the last time the inventory was loaded */
+	UPROPERTY(Replicated, Transient) bool bSavedInventoryLoaded;
 	
 	
 public:
@@ -347,19 +377,11 @@ public:
 
 	
 protected:
-	/** Start sending saved inventory information to the client */
-	UFUNCTION(Client, Reliable) virtual void Client_BeginLoadingInventoryData();
-	
-	/** Sends some of the current save's inventory information to the client
-	 * @note this is done in multiple calls to avoid network issues (RPC's default data limits are 64kb)
-	 */
-	UFUNCTION(Client, Reliable) virtual void Client_LoadSomeInventoryData(const TArray<FS_Item>& Items);
-
-	/** Sets the current save data to the captured client information. Called once all the client information has been sent */
-	UFUNCTION(Client, Reliable) virtual void Client_LoadSaveDataCompleted();
+	/** Notifies the client once the server has loaded it's saved inventory. The items themselves are replicated through the inventory list */
+	UFUNCTION() virtual void OnRep_SavedInventoryLoaded();
 
 	/**
-	 * Updates the inventory information with the player state's current save data. This is called in UpdateInventoryAfterRetrievingSaveInformation() during play based on the SaveState of the inventory
+	 * Updates the inventory information with the player state's current save data. This is called on the server in UpdateInventoryAfterRetrievingSaveInformation() during play based on the SaveState of the inventory
 	 * 
 	 * @param SaveInformation			The save information object containing the player's inventory information
 	 * 
@@ -375,6 +397,36 @@ protected:
 
 	
 	
+//----------------------------------------------------------------------------------//
+// Replication																		//
+//----------------------------------------------------------------------------------//
+protected:
+	/** Delegate function for when a replicated item is added to the client's inventory. Helpful for ui elements to keep track of inventory updates */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Replication") FInventoryReplicatedItemDelegate OnReplicatedItemAdded;
+
+	/** Delegate function for when a replicated item's sort order or stack count changes on the client */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Replication") FInventoryReplicatedItemDelegate OnReplicatedItemChanged;
+
+	/** Delegate function for when a replicated item is removed from the client's inventory */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Replication") FInventoryReplicatedItemDelegate OnReplicatedItemRemoved;
+
+	/** Creates the replicated entry of an item in the inventory */
+	virtual FInventoryEntry CreateInventoryEntry(const FInventoryRecord& Record);
+
+	/** Adds an item that was replicated from the server to the client's inventory */
+	virtual void HandleReplicatedEntryAdded(const FInventoryEntry& Entry);
+
+	/** Updates an item in the client's inventory after it's entry changed on the server */
+	virtual void HandleReplicatedEntryChanged(const FInventoryEntry& Entry);
+
+	/** Removes an item from the client's inventory before it's entry is removed */
+	virtual void HandleReplicatedEntryRemoved(const FInventoryEntry& Entry);
+
+	/** The fast array callbacks route to the replicated entry functions */
+	friend struct FInventoryEntry;
+
+
+	
 //----------------------------------------------------------------------------------//
 // Utility																			//
 //----------------------------------------------------------------------------------//
@@ -419,10 +471,59 @@ public:
 	
 protected:
 	/**
-	 * Returns the inventory list specific to the item's type
-	 * @returns One of the inventory lists from this component
+	 * Returns the items of a specific type
+	 * 
+	 * @param Type						The item type
+	 * @param OutItems					The items of that type
+	 * @param bSortItems				Whether the items should be sorted by their sort order
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Inventory") virtual TMap<FGuid, F_Item>& GetInventoryList(EItemType InventorySectionToSearch);
+	UFUNCTION(BlueprintCallable, Category = "Inventory") virtual void GetInventoryItems(EItemType Type, TArray<F_Item>& OutItems, bool bSortItems = true);
+
+	/** Returns the amount of items in the inventory */
+	UFUNCTION(BlueprintCallable, Category = "Inventory") virtual int32 GetInventoryItemCount() const;
+
+	/**
+	 * Returns a copy of the inventory list specific to the item's type. Kept for blueprints that used the per section maps, @ref GetInventoryItems
+	 * @returns The items of that type, mapped by their id
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory") virtual TMap<FGuid, F_Item> GetInventoryList(EItemType InventorySectionToSearch);
+
+	/**** Inventory sections ****/ // The items of each section of the inventory, built from the inventory's records
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetQuestItems() { return GetInventoryList(EItemType::Inv_QuestItem); }
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetCommonItems() { return GetInventoryList(EItemType::Inv_Item); }
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetWeapons() { return GetInventoryList(EItemType::Inv_Weapon); }
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetArmors() { return GetInventoryList(EItemType::Inv_Armor); }
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetMaterials() { return GetInventoryList(EItemType::Inv_Material); }
+	UFUNCTION(BlueprintPure, Category = "Inventory") TMap<FGuid, F_Item> GetNotes() { return GetInventoryList(EItemType::Inv_Note); }
+
+	/** Returns an item's record without copying it's information, or nullptr if it isn't in the inventory */
+	const FInventoryRecord* FindInventoryRecord(const FGuid& Id) const;
+
+	/** Returns the static information of an item's record, or nullptr if it isn't in the item database */
+	const F_Item* FindRecordItemData(const FInventoryRecord& Record);
+
+	/** Creates the item information of a record */
+	virtual F_Item CreateItemFromRecord(const FInventoryRecord& Record);
+
+	/**
+	 * Adds an item to the inventory, or updates it if it's already in the inventory
+	 * 
+	 * @param Id						The unique id of the item
+	 * @param RowIndex					The item's row in the item database cache
+	 * @param SortOrder					The sort order of the item
+	 * @param StackCount				The amount of this item in the stack
+	 * @returns							The item's record, or nullptr if the row index isn't valid
+	 */
+	virtual FInventoryRecord* AddInventoryRecord(const FGuid& Id, int32 RowIndex, int32 SortOrder, int32 StackCount = 1);
+
+	/** Removes an item from the inventory. @returns false if the item isn't in the inventory */
+	virtual bool RemoveInventoryRecord(const FGuid& Id);
+
+	/** Returns the catalog of the item database. Updates the items' row indexes if the item database or it's catalog has changed */
+	const FItemCatalog* GetItemCatalog();
+
+	/** Finds the row index of every item in the current catalog, using their row names in the catalog they were added with */
+	virtual void ResolveInventoryRecords(const FItemCatalog& PreviousCatalog);
 
 	/**
 	 * Returns an item from one of the lists in this component.
@@ -443,7 +544,7 @@ protected:
 	 * 
 	 * @remarks If you want to subclass the Item object, use this function. And if you create any Items, do it with this function
 	 */
-	virtual F_Item* CreateInventoryObject() const override;
+	virtual F_Item CreateInventoryObject() const override;
 	
 	/** Access the save state on the client to know when to update the character information */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Saving and Loading") virtual ESaveState GetSaveState();
@@ -469,7 +570,7 @@ protected:
 	/** Listing inventory information -> @ref ListInventory, ListSavedCharacterInformation  */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Utilities|Listing") virtual void ListInventory();
 	UFUNCTION(Server, Reliable, Category = "Inventory|Utilities|Listing") virtual void Server_ListInventory(const TArray<FS_Item>& ClientItemList, bool bCalledFromServer);
-	UFUNCTION(Category = "Inventory|Utilities|Listing") virtual void ListInventoryMap(const TMap<FGuid, F_Item>& Map, FString ListName);
+	UFUNCTION(Category = "Inventory|Utilities|Listing") virtual void ListInventoryType(EItemType Type, FString ListName);
 	UFUNCTION(Category = "Inventory|Utilities|Listing") virtual void ListInventoryItem(const F_Item& Item);
 
 	UFUNCTION(Category = "Inventory|Utilities|Listing") virtual void ListSavedItem(const FS_Item& SavedItem);
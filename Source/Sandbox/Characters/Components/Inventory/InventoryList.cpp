@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Characters/Components/Inventory/InventoryList.h"
+
+#include "Sandbox/Characters/Components/Inventory/InventoryComponent.h"
+
+
+#pragma region Entry
+void FInventoryEntry::PreReplicatedRemove(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->HandleReplicatedEntryRemoved(*this);
+}
+
+
+void FInventoryEntry::PostReplicatedAdd(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->HandleReplicatedEntryAdded(*this);
+}
+
+
+void FInventoryEntry::PostReplicatedChange(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->HandleReplicatedEntryChanged(*this);
+}
+#pragma endregion
+
+
+
+
+#pragma region List
+void FInventoryList::AddEntry(const FInventoryEntry& Entry)
+{
+	if (FInventoryEntry* Existing = Items.FindByPredicate([&Entry](const FInventoryEntry& Item) { return Item.Id == Entry.Id; }))
+	{
+		Existing->ItemName = Entry.ItemName;
+		Existing->SortOrder = Entry.SortOrder;
+		Existing->StackCount = Entry.StackCount;
+		MarkItemDirty(*Existing);
+		return;
+	}
+
+	MarkItemDirty(Items.Add_GetRef(Entry));
+}
+
+
+bool FInventoryList::ChangeEntry(const FGuid& Id, const int32 SortOrder, const int32 StackCount)
+{
+	FInventoryEntry* Entry = Items.FindByPredicate([&Id](const FInventoryEntry& Item) { return Item.Id == Id; });
+	if (!Entry) return false;
+
+	if (Entry->SortOrder != SortOrder || Entry->StackCount != StackCount)
+	{
+		Entry->SortOrder = SortOrder;
+		Entry->StackCount = StackCount;
+		MarkItemDirty(*Entry);
+	}
+
+	return true;
+}
+
+
+bool FInventoryList::RemoveEntry(const FGuid& Id)
+{
+	const int32 Index = Items.IndexOfByPredicate([&Id](const FInventoryEntry& Item) { return Item.Id == Id; });
+	if (Index == INDEX_NONE) return false;
+
+	Items.RemoveAtSwap(Index, 1, false);
+	MarkArrayDirty();
+	return true;
+}
+
+
+void FInventoryList::Reset()
+{
+	if (Items.IsEmpty()) return;
+
+	Items.Reset();
+	MarkArrayDirty();
+}
+
+
+const FInventoryEntry* FInventoryList::FindEntry(const FGuid& Id) const
+{
+	return Items.FindByPredicate([&Id](const FInventoryEntry& Item) { return Item.Id == Id; });
+}
+#pragma endregion
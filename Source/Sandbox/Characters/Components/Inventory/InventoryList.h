@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "InventoryList.generated.h"
+
+class UInventoryComponent;
+struct FInventoryList;
+
+
+/**
+ * The replicated information of an item in the inventory. The rest of the item's information is retrieved from the item database on each client
+ */
+USTRUCT(BlueprintType)
+struct FInventoryEntry : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+		FInventoryEntry(
+			const FGuid& Id = FGuid(),
+			const FName& ItemName = FName(),
+			const int32 SortOrder = -1,
+			const int32 StackCount = 1
+		) :
+		Id(Id),
+		ItemName(ItemName),
+		SortOrder(SortOrder),
+		StackCount(StackCount)
+	{}
+
+	/** The unique id for this item */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) FGuid Id;
+
+	/** The database name reference of the item */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) FName ItemName;
+
+	/** The sort order for the inventory item */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 SortOrder;
+
+	/** The amount of this item in the stack */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 StackCount;
+
+
+public:
+	/** Fast array callbacks, these are only called on clients */
+	void PreReplicatedRemove(const FInventoryList& InArraySerializer);
+	void PostReplicatedAdd(const FInventoryList& InArraySerializer);
+	void PostReplicatedChange(const FInventoryList& InArraySerializer);
+};
+
+
+/**
+ * The replicated inventory of an @ref UInventoryComponent. Only the entries that were added, changed, or removed are sent to the client.
+ * This should only be edited on the server, and every edit needs to be marked dirty (which the helper functions handle)
+ */
+USTRUCT(BlueprintType)
+struct FInventoryList : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** The replicated items */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) TArray<FInventoryEntry> Items;
+
+	/** The inventory that receives the replication callbacks */
+	UPROPERTY(NotReplicated) TObjectPtr<UInventoryComponent> Owner;
+
+
+public:
+	/** Adds an entry, or updates the entry if the item is already in the list */
+	void AddEntry(const FInventoryEntry& Entry);
+
+	/** Updates the sort order and stack count of an entry. @returns false if the item isn't in the list */
+	bool ChangeEntry(const FGuid& Id, int32 SortOrder, int32 StackCount);
+
+	/** Removes an entry. @returns false if the item isn't in the list */
+	bool RemoveEntry(const FGuid& Id);
+
+	/** Removes every entry */
+	void Reset();
+
+	/** Returns the entry of an item, or nullptr if it isn't in the list */
+	const FInventoryEntry* FindEntry(const FGuid& Id) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryEntry, FInventoryList>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
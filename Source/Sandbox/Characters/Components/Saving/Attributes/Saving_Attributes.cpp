@@ -3,13 +3,13 @@
 
 #include "Saving_Attributes.h"
 
-#include "Kismet/GameplayStatics.h"
 #include "Sandbox/Asc/AbilitySystem.h"
 #include "Sandbox/Asc/GameplayAbilitiyUtilities.h"
 #include "Sandbox/Asc/Attributes/MMOAttributeSet.h"
 #include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Data/Save/Attributes/Saved_Attributes.h"
 #include "Sandbox/Characters/Components/Saving/SaveComponent.h"
+#include "Sandbox/Data/Save/SaveFunctionLibrary.h"
 
 bool USaving_Attributes::SaveData_Implementation(int32 Index)
 {
@@ -36,7 +36,7 @@ bool USaving_Attributes::SaveData_Implementation(int32 Index)
 	// Save the character's current attributes
 	SaveInformation->RetrieveAttributesFromAttributeSet(AttributeSet);
 	FString AttributeSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	UGameplayStatics::SaveGameToSlot(SaveInformation, AttributeSaveSlot, SaveComponent->GetUserIndex());
+	USaveFunctionLibrary::SaveGameToSlot(SaveComponent, SaveInformation, AttributeSaveSlot, SaveComponent->GetUserIndex());
 	return true;
 }
 
@@ -60,7 +60,7 @@ bool USaving_Attributes::LoadData_Implementation(int32 Index)
 
 	// Retrieve the attribute information
 	FString AttributeSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	USaved_Attributes* SavedAttributes = Cast<USaved_Attributes>(UGameplayStatics::LoadGameFromSlot(AttributeSaveSlot, SaveComponent->GetUserIndex()));
+	USaved_Attributes* SavedAttributes = Cast<USaved_Attributes>(USaveFunctionLibrary::LoadGameFromSlot(this, AttributeSaveSlot, SaveComponent->GetUserIndex()));
 	if (!SavedAttributes)
 	{
 		return false;
@@ -75,7 +75,7 @@ bool USaving_Attributes::LoadData_Implementation(int32 Index)
 FString USaving_Attributes::FormattedSaveInformation(const FString Slot) const
 {
 	// Retrieve Saved Combat Info
-	USaved_Attributes* Attributes = Cast<USaved_Attributes>(UGameplayStatics::LoadGameFromSlot(Slot, 0));
+	USaved_Attributes* Attributes = Cast<USaved_Attributes>(USaveFunctionLibrary::LoadGameFromSlot(this, Slot, 0));
 	if (!Attributes)
 	{
 		return FString();
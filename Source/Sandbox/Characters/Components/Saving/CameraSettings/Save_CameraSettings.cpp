@@ -3,11 +3,11 @@
 
 #include "Sandbox/Characters/Components/Saving/CameraSettings/Save_CameraSettings.h"
 
-#include "Kismet/GameplayStatics.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Characters/Components/Camera/CharacterCameraLogic.h"
 #include "Sandbox/Characters/Components/Saving/SaveComponent.h"
 #include "Sandbox/Data/Save/Settings/Camera/Saved_CameraSettings.h"
+#include "Sandbox/Data/Save/SaveFunctionLibrary.h"
 
 
 bool USave_CameraSettings::SaveData_Implementation(int32 Index)
@@ -36,7 +36,7 @@ bool USave_CameraSettings::SaveData_Implementation(int32 Index)
 	// Save the character's camera settings
 	SaveInformation->SaveFromCameraCharacter(Character);
 	FString CameraSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	return UGameplayStatics::SaveGameToSlot(SaveInformation, CameraSaveSlot, SaveComponent->GetUserIndex());
+	return USaveFunctionLibrary::SaveGameToSlot(SaveComponent, SaveInformation, CameraSaveSlot, SaveComponent->GetUserIndex());
 }
 
 
@@ -65,7 +65,7 @@ bool USave_CameraSettings::LoadData_Implementation(int32 Index)
 	
 	// Retrieve the camera settings
 	FString CameraSettingsSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	USaved_CameraSettings* CameraSettings = Cast<USaved_CameraSettings>(UGameplayStatics::LoadGameFromSlot(CameraSettingsSaveSlot, SaveComponent->GetUserIndex()));
+	USaved_CameraSettings* CameraSettings = Cast<USaved_CameraSettings>(USaveFunctionLibrary::LoadGameFromSlot(this, CameraSettingsSaveSlot, SaveComponent->GetUserIndex()));
 	if (!CameraSettings)
 	{
 		return false;
@@ -81,7 +81,7 @@ bool USave_CameraSettings::LoadData_Implementation(int32 Index)
 FString USave_CameraSettings::FormattedSaveInformation(const FString Slot) const
 {
 	// Retrieve Saved Combat Info
-	USaved_CameraSettings* CameraSettings = Cast<USaved_CameraSettings>(UGameplayStatics::LoadGameFromSlot(Slot, 0));
+	USaved_CameraSettings* CameraSettings = Cast<USaved_CameraSettings>(USaveFunctionLibrary::LoadGameFromSlot(this, Slot, 0));
 	if (!CameraSettings)
 	{
 		return FString();
@@ -3,12 +3,12 @@
 
 #include "Sandbox/Characters/Components/Saving/CombatComponent/Save_CombatData.h"
 
-#include "Kismet/GameplayStatics.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Characters/Components/Saving/SaveComponent.h"
 #include "Sandbox/Combat/CombatComponent.h"
 #include "Sandbox/Data/Save/Combat/Saved_CombatInfo.h"
+#include "Sandbox/Data/Save/SaveFunctionLibrary.h"
 
 
 bool USave_CombatData::SaveData_Implementation(int32 Index)
@@ -40,7 +40,7 @@ bool USave_CombatData::SaveData_Implementation(int32 Index)
 	// Save the character's camera settings
 	SaveInformation->SaveFromCombatComponent(CombatComponent);
 	FString CombatSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	return UGameplayStatics::SaveGameToSlot(SaveInformation, CombatSaveSlot, SaveComponent->GetUserIndex());
+	return USaveFunctionLibrary::SaveGameToSlot(SaveComponent, SaveInformation, CombatSaveSlot, SaveComponent->GetUserIndex());
 }
 
 bool USave_CombatData::LoadData_Implementation(int32 Index)
@@ -75,7 +75,7 @@ bool USave_CombatData::LoadData_Implementation(int32 Index)
 	
 	// Retrieve the combat info
 	FString CombatInfoSaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	USaved_CombatInfo* CombatInfo = Cast<USaved_CombatInfo>(UGameplayStatics::LoadGameFromSlot(CombatInfoSaveSlot, SaveComponent->GetUserIndex()));
+	USaved_CombatInfo* CombatInfo = Cast<USaved_CombatInfo>(USaveFunctionLibrary::LoadGameFromSlot(this, CombatInfoSaveSlot, SaveComponent->GetUserIndex()));
 	if (!CombatInfo)
 	{
 		return false;
@@ -88,6 +88,7 @@ bool USave_CombatData::LoadData_Implementation(int32 Index)
 	CombatComponent->AddArmamentToEquipSlot(CombatInfo->RightHandEquipSlot_One, EEquipSlot::RightHandSlotOne);
 	CombatComponent->AddArmamentToEquipSlot(CombatInfo->RightHandEquipSlot_Two, EEquipSlot::RightHandSlotTwo);
 	CombatComponent->AddArmamentToEquipSlot(CombatInfo->RightHandEquipSlot_Three, EEquipSlot::RightHandSlotThree);
+	CombatComponent->PrewarmArmaments();
 
 	// Equip the weapons
 	CombatComponent->CreateArmament(CombatInfo->PrimaryEquipSlot);
@@ -108,7 +109,7 @@ bool USave_CombatData::LoadData_Implementation(int32 Index)
 FString USave_CombatData::FormattedSaveInformation(const FString Slot) const
 {
 	// Retrieve Saved Combat Info
-	USaved_CombatInfo* CombatInfo = Cast<USaved_CombatInfo>(UGameplayStatics::LoadGameFromSlot(Slot, 0));
+	USaved_CombatInfo* CombatInfo = Cast<USaved_CombatInfo>(USaveFunctionLibrary::LoadGameFromSlot(this, Slot, 0));
 	if (!CombatInfo)
 	{
 		return FString();
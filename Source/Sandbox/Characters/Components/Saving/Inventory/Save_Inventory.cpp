@@ -3,12 +3,12 @@
 
 #include "Sandbox/Characters/Components/Saving/Inventory/Save_Inventory.h"
 
-#include "Kismet/GameplayStatics.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Characters/Components/Inventory/InventoryComponent.h"
 #include "Sandbox/Characters/Components/Saving/SaveComponent.h"
 #include "Sandbox/Data/Save/Inventory/Saved_Inventory.h"
+#include "Sandbox/Data/Save/SaveFunctionLibrary.h"
 
 
 bool USave_Inventory::SaveData_Implementation(int32 Index)
@@ -41,7 +41,7 @@ bool USave_Inventory::SaveData_Implementation(int32 Index)
 	
 	SaveInformation->SaveInformation = InventoryComponent->GetInventorySaveInformation();
 	FString InventorySaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	return UGameplayStatics::SaveGameToSlot(SaveInformation, InventorySaveSlot, SaveComponent->GetUserIndex());
+	return USaveFunctionLibrary::SaveGameToSlot(SaveComponent, SaveInformation, InventorySaveSlot, SaveComponent->GetUserIndex());
 }
 
 bool USave_Inventory::LoadData_Implementation(int32 Index)
@@ -66,7 +66,7 @@ bool USave_Inventory::LoadData_Implementation(int32 Index)
 	
 	// Retrieve the saved inventory
 	FString InventorySaveSlot = SaveComponent->GetSaveUrl(SaveType);
-	USaved_Inventory* InventoryData = Cast<USaved_Inventory>(UGameplayStatics::LoadGameFromSlot(InventorySaveSlot, SaveComponent->GetUserIndex()));
+	USaved_Inventory* InventoryData = Cast<USaved_Inventory>(USaveFunctionLibrary::LoadGameFromSlot(this, InventorySaveSlot, SaveComponent->GetUserIndex()));
 	if (!InventoryData)
 	{
 		return false;
@@ -80,7 +80,7 @@ bool USave_Inventory::LoadData_Implementation(int32 Index)
 FString USave_Inventory::FormattedSaveInformation(const FString Slot) const
 {
 	// Retrieve the saved inventory
-	USaved_Inventory* InventoryData = Cast<USaved_Inventory>(UGameplayStatics::LoadGameFromSlot(Slot, 0));
+	USaved_Inventory* InventoryData = Cast<USaved_Inventory>(USaveFunctionLibrary::LoadGameFromSlot(this, Slot, 0));
 	if (!InventoryData)
 	{
 		return FString();
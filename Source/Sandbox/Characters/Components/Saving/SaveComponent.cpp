@@ -11,6 +11,7 @@
 #include "Sandbox/Data/Save/Save.h"
 #include "Sandbox/Data/Save/World/Saved_Level.h"
 #include "Sandbox/Data/Structs/LevelInformation.h"
+#include "Sandbox/Game/Saving/SaveableActorRegistry.h"
 #include "Sandbox/Game/MultiplayerGameMode.h"
 
 DEFINE_LOG_CATEGORY(SaveComponentLog);
@@ -449,5 +450,11 @@ void USaveComponent::SetNetAndPlatformId()
 {
 	NetId = -1;
 	PlatformId = GetOwner() ? GetOwner()->GetName() : "Null";
+
+	// The platform id is the character's level id, which the registry retrieved when the character began play
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->UpdateActorId(GetOwner());
+	}
 }
 #pragma endregion
@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Combat/ArmamentMontageCatalog.h"
+
+#include "Animation/AnimMontage.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Data/Enums/ArmamentTypes.h"
+#include "Sandbox/Data/Enums/SkeletonMappings.h"
+#include "Sandbox/Data/Structs/AbilityInformation.h"
+
+DEFINE_LOG_CATEGORY(ArmamentMontageCatalogLog);
+
+
+EArmamentMontageStance FArmamentMontageSet::GetMontageStance(const EArmamentStance Stance)
+{
+	if (Stance == EArmamentStance::OneHanding || Stance == EArmamentStance::TwoWeapons) return EArmamentMontageStance::OneHand;
+	if (Stance == EArmamentStance::DualWielding) return EArmamentMontageStance::DualWield;
+	if (Stance == EArmamentStance::TwoHanding_L || Stance == EArmamentStance::TwoHanding_R) return EArmamentMontageStance::TwoHand;
+	return EArmamentMontageStance::Max;
+}
+
+
+
+
+#pragma region Subsystem
+UArmamentMontageCatalog* UArmamentMontageCatalog::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UArmamentMontageCatalog>() : nullptr;
+}
+
+
+void UArmamentMontageCatalog::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	NumAttackPatterns = StaticEnum<EInputAbilities>()->GetMaxEnumValue() + 1;
+}
+
+
+void UArmamentMontageCatalog::Deinitialize()
+{
+	MontageSets.Empty();
+	ReferencedMontages.Empty();
+	WatchedTables.Empty();
+	Super::Deinitialize();
+}
+#pragma endregion
+
+
+
+
+#pragma region Montage Sets
+TSharedPtr<const FArmamentMontageSet> UArmamentMontageCatalog::FindOrCreateMontageSet(UDataTable* ArmamentMontageDB, const FName ArmamentId, const ECharacterSkeletonMapping Link)
+{
+	check(IsInGameThread());
+	if (!ArmamentMontageDB || ArmamentId.IsNone()) return nullptr;
+
+	const FArmamentMontageKey Key(ArmamentMontageDB, ArmamentId, Link);
+	if (const TSharedPtr<const FArmamentMontageSet>* MontageSet = MontageSets.Find(Key)) return *MontageSet;
+
+	TSharedPtr<const FArmamentMontageSet> MontageSet = CreateMontageSet(ArmamentMontageDB, Key);
+	if (!MontageSet) return nullptr;
+
+	AddReferencedMontages(*MontageSet);
+
+#if WITH_EDITOR
+	// Designers can edit the montage table while playing in editor, rebuild the montage sets the next time they're used
+	if (!WatchedTables.Contains(ArmamentMontageDB))
+	{
+		WatchedTables.Add(ArmamentMontageDB);
+		ArmamentMontageDB->OnDataTableChanged().AddUObject(this, &UArmamentMontageCatalog::OnMontageTableChanged, TObjectKey<UDataTable>(ArmamentMontageDB));
+	}
+#endif
+
+	UE_LOGFMT(ArmamentMontageCatalogLog, Verbose, "{0}() Resolved {1}'s montages for {2}", *FString(__FUNCTION__), ArmamentId, *UEnum::GetValueAsString(Link));
+	return MontageSets.Add(Key, MontageSet);
+}
+
+
+int32 UArmamentMontageCatalog::GetNumMontageSets() const
+{
+	return MontageSets.Num();
+}
+
+
+TSharedPtr<const FArmamentMontageSet> UArmamentMontageCatalog::CreateMontageSet(const UDataTable* ArmamentMontageDB, const FArmamentMontageKey& Key) const
+{
+	const FString RowContext(TEXT("Armament Montage Information Context"));
+	const F_Table_ArmamentMontages* Data = ArmamentMontageDB->FindRow<F_Table_ArmamentMontages>(Key.ArmamentId, RowContext);
+	if (!Data)
+	{
+		UE_LOGFMT(ArmamentMontageCatalogLog, Error, "{0}() Did not find the armament montages for {1} in {2}", *FString(__FUNCTION__), Key.ArmamentId, *GetNameSafe(ArmamentMontageDB));
+		return nullptr;
+	}
+
+	const TSharedPtr<FArmamentMontageSet> MontageSet = MakeShared<FArmamentMontageSet>(Key);
+	for (auto &[Name, MontageMap] : Data->ArmamentMontages.Montages)
+	{
+		if (UAnimMontage* const* Montage = MontageMap.MontageMappings.Find(Key.Link)) MontageSet->Montages.Add(Name, *Montage);
+	}
+
+	const F_ArmamentMeleeMontages& MeleeMontages = Data->ArmamentMontages.MeleeMontages;
+	AddStanceAttacks(*MontageSet, EArmamentMontageStance::OneHand, MeleeMontages.OneHandMontages);
+	AddStanceAttacks(*MontageSet, EArmamentMontageStance::TwoHand, MeleeMontages.TwoHandMontages);
+	AddStanceAttacks(*MontageSet, EArmamentMontageStance::DualWield, MeleeMontages.DualWieldMontages);
+	return MontageSet;
+}
+
+
+void UArmamentMontageCatalog::AddStanceAttacks(FArmamentMontageSet& MontageSet, const EArmamentMontageStance Stance, const TMap<EInputAbilities, F_ArmamentMeleeMontage>& StanceMontages) const
+{
+	TArray<F_ArmamentComboInformation>& Attacks = MontageSet.Attacks[static_cast<int32>(Stance)];
+	TBitArray<>& ValidAttacks = MontageSet.ValidAttacks[static_cast<int32>(Stance)];
+	Attacks.SetNum(NumAttackPatterns);
+	ValidAttacks.Init(false, NumAttackPatterns);
+
+	for (auto &[AttackPattern, MontageMap] : StanceMontages)
+	{
+		UAnimMontage* const* Montage = MontageMap.Montage.MontageMappings.Find(MontageSet.Key.Link);
+		const int32 AttackIndex = static_cast<int32>(AttackPattern);
+		if (!Montage || !Attacks.IsValidIndex(AttackIndex)) continue;
+
+		Attacks[AttackIndex].Montage = *Montage;
+		Attacks[AttackIndex].Combo = MontageMap.Combo;
+		ValidAttacks[AttackIndex] = true;
+	}
+}
+
+
+void UArmamentMontageCatalog::OnMontageTableChanged(const TObjectKey<UDataTable> MontageTable)
+{
+	for (auto Iterator = MontageSets.CreateIterator(); Iterator; ++Iterator)
+	{
+		if (Iterator.Key().MontageTable == MontageTable) Iterator.RemoveCurrent();
+	}
+
+	// Armaments that are using the previous montage sets keep them until they're resolved again, and the montages that are still in the table stay referenced by it
+	ReferencedMontages.Reset();
+	for (const auto& [Key, MontageSet] : MontageSets) AddReferencedMontages(*MontageSet);
+}
+
+
+void UArmamentMontageCatalog::AddReferencedMontages(const FArmamentMontageSet& MontageSet)
+{
+	for (const auto& [Name, Montage] : MontageSet.Montages)
+	{
+		if (Montage) ReferencedMontages.Add(Montage);
+	}
+
+	for (const TArray<F_ArmamentComboInformation>& Attacks : MontageSet.Attacks)
+	{
+		for (const F_ArmamentComboInformation& Attack : Attacks)
+		{
+			if (Attack.Montage) ReferencedMontages.Add(Attack.Montage);
+		}
+	}
+}
+#pragma endregion
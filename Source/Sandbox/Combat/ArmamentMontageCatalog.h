@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Sandbox/Data/Structs/CombatInformation.h"
+#include "ArmamentMontageCatalog.generated.h"
+
+class UAnimMontage;
+class UDataTable;
+enum class ECharacterSkeletonMapping : uint8;
+DECLARE_LOG_CATEGORY_EXTERN(ArmamentMontageCatalogLog, Log, All);
+
+
+/**
+ * The montage table, armament row, and skeleton mapping a montage set was resolved for
+ */
+struct SANDBOX_API FArmamentMontageKey
+{
+	FArmamentMontageKey(const UDataTable* MontageTable, const FName ArmamentId, const ECharacterSkeletonMapping Link) :
+		MontageTable(MontageTable),
+		ArmamentId(ArmamentId),
+		Link(Link)
+	{
+	}
+
+	/** The data table that contains the armament montages */
+	TObjectKey<UDataTable> MontageTable;
+
+	/** The armament's row in the montage table */
+	FName ArmamentId;
+
+	/** The character skeleton to montage mapping reference */
+	ECharacterSkeletonMapping Link;
+
+	bool operator==(const FArmamentMontageKey& Other) const
+	{
+		return MontageTable == Other.MontageTable && ArmamentId == Other.ArmamentId && Link == Other.Link;
+	}
+
+	friend uint32 GetTypeHash(const FArmamentMontageKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.MontageTable), GetTypeHash(Key.ArmamentId)), GetTypeHash(Key.Link));
+	}
+
+};
+
+
+/** The montage stances of an armament. One handing and two weapons share the one hand montages */
+enum class EArmamentMontageStance : uint8
+{
+	OneHand,
+	TwoHand,
+	DualWield,
+	Max
+};
+
+
+/**
+ * An armament's montages for a single skeleton, resolved once and shared by every armament that uses them. @ref UArmamentMontageCatalog \n\n
+ *
+ * The attacks of each stance are indexed by their attack pattern, so retrieving an attack's montage or combo doesn't have to search a map.
+ * Montage sets are immutable once they've been created, and armaments only keep a pointer to them.
+ */
+struct SANDBOX_API FArmamentMontageSet
+{
+	FArmamentMontageSet(const FArmamentMontageKey& Key) :
+		Key(Key)
+	{
+	}
+
+	/** What the montage set was resolved for */
+	const FArmamentMontageKey Key;
+
+	/** Each stance's attacks, indexed by attack pattern */
+	TArray<F_ArmamentComboInformation> Attacks[static_cast<int32>(EArmamentMontageStance::Max)];
+
+	/** Which attack patterns each stance has an attack for */
+	TBitArray<> ValidAttacks[static_cast<int32>(EArmamentMontageStance::Max)];
+
+	/** The armament's general montages */
+	TMap<FName, TObjectPtr<UAnimMontage>> Montages;
+
+	/** Returns an attack's montage and combo information, or nullptr if the stance doesn't have that attack */
+	const F_ArmamentComboInformation* FindAttack(const EArmamentMontageStance Stance, const EInputAbilities AttackPattern) const
+	{
+		const int32 StanceIndex = static_cast<int32>(Stance);
+		const int32 AttackIndex = static_cast<int32>(AttackPattern);
+		if (StanceIndex >= static_cast<int32>(EArmamentMontageStance::Max) || !ValidAttacks[StanceIndex].IsValidIndex(AttackIndex) || !ValidAttacks[StanceIndex][AttackIndex]) return nullptr;
+		return &Attacks[StanceIndex][AttackIndex];
+	}
+
+	/** Returns true if the armament doesn't have any montages */
+	bool IsEmpty() const
+	{
+		return Montages.IsEmpty() && !ValidAttacks[0].Contains(true) && !ValidAttacks[1].Contains(true) && !ValidAttacks[2].Contains(true);
+	}
+
+	/** Returns the montage stance that's used while the character is in an armament stance, or Max if the stance doesn't have montages */
+	static EArmamentMontageStance GetMontageStance(EArmamentStance Stance);
+
+};
+
+
+/**
+ * Shared cache of armament montages, resolved from the armament montage table for each armament and character skeleton. @ref AArmament::SetArmamentMontagesFromDB \n\n
+ *
+ * Identical armaments used to each find their row and copy the montages into their own maps. The catalog resolves each row and skeleton once, and every armament that uses them shares the same montage set.
+ *	- Characters resolve the montage sets of their loadout when it's added (@ref UCombatComponent::PrewarmArmaments), so equipping an armament doesn't have to
+ *	- Montage sets are rebuilt if their montage table is edited
+ */
+UCLASS()
+class SANDBOX_API UArmamentMontageCatalog : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The resolved montage sets */
+	TMap<FArmamentMontageKey, TSharedPtr<const FArmamentMontageSet>> MontageSets;
+
+	/** The montages of every montage set, so they stay loaded while they're shared */
+	UPROPERTY(Transient) TSet<TObjectPtr<UAnimMontage>> ReferencedMontages;
+
+	/** The montage tables that are being watched for edits */
+	TSet<TObjectKey<UDataTable>> WatchedTables;
+
+	/** The highest attack pattern value, for sizing each stance's attacks */
+	int32 NumAttackPatterns = 0;
+
+
+public:
+	/** Retrieves the armament montage catalog */
+	static UArmamentMontageCatalog* Get();
+
+	/** Sizes the attack pattern lookups */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Clears the montage sets */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Returns the shared montage set for an armament and character skeleton, and resolves it if it hasn't been used yet
+	 *
+	 * @param ArmamentMontageDB					The data table that contains the armament montages
+	 * @param ArmamentId						The armament's row in the montage table
+	 * @param Link								The character skeleton to montage mapping reference
+	 * @returns									The montage set, or an invalid pointer if the armament doesn't have montages
+	 */
+	virtual TSharedPtr<const FArmamentMontageSet> FindOrCreateMontageSet(UDataTable* ArmamentMontageDB, FName ArmamentId, ECharacterSkeletonMapping Link);
+
+	/** Returns the amount of montage sets that have been resolved */
+	int32 GetNumMontageSets() const;
+
+
+protected:
+	/** Resolves an armament's montages for a character skeleton */
+	virtual TSharedPtr<const FArmamentMontageSet> CreateMontageSet(const UDataTable* ArmamentMontageDB, const FArmamentMontageKey& Key) const;
+
+	/** Adds one stance's attacks to a montage set */
+	virtual void AddStanceAttacks(FArmamentMontageSet& MontageSet, EArmamentMontageStance Stance, const TMap<EInputAbilities, F_ArmamentMeleeMontage>& StanceMontages) const;
+
+	/** Removes the montage sets of a montage table that was edited */
+	virtual void OnMontageTableChanged(TObjectKey<UDataTable> MontageTable);
+
+	/** Keeps a montage set's montages loaded while it's shared */
+	void AddReferencedMontages(const FArmamentMontageSet& MontageSet);
+
+
+};
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ArmamentPoolSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Combat/Weapons/Armament.h"
+
+
+static TAutoConsoleVariable<bool> CVarArmamentPool(
+	TEXT("Sandbox.ArmamentPool.Enabled"),
+	true,
+	TEXT("Whether unequipped armaments are returned to a pool and reused, instead of being destroyed")
+);
+
+static TAutoConsoleVariable<int32> CVarArmamentPoolMaxPooled(
+	TEXT("Sandbox.ArmamentPool.MaxPooled"),
+	8,
+	TEXT("The most deactivated armaments that are kept for each armament class and database row")
+);
+
+
+#pragma region Subsystem
+UArmamentPoolSubsystem* UArmamentPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UArmamentPoolSubsystem>() : nullptr;
+}
+
+
+bool UArmamentPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UArmamentPoolSubsystem::Deinitialize()
+{
+	PooledArmaments.Empty();
+	Super::Deinitialize();
+}
+#pragma endregion
+
+
+
+
+#pragma region Pooling
+AArmament* UArmamentPoolSubsystem::AcquireArmament(UClass* ArmamentClass, const FName ArmamentId, AActor* Owner, const FTransform& Transform)
+{
+	if (!ArmamentClass || !ArmamentClass->IsChildOf(AArmament::StaticClass())) return nullptr;
+
+	if (CVarArmamentPool.GetValueOnGameThread())
+	{
+		TArray<TWeakObjectPtr<AArmament>>& Pool = FindOrAddPool(FArmamentPoolKey(ArmamentClass, ArmamentId));
+		if (!Pool.IsEmpty())
+		{
+			AArmament* Armament = Pool.Pop(false).Get();
+			Armament->OnAcquiredFromPool(Owner, Transform);
+			return Armament;
+		}
+	}
+
+	return SpawnArmament(ArmamentClass, Owner, Transform);
+}
+
+
+void UArmamentPoolSubsystem::ReleaseArmament(AArmament* Armament)
+{
+	if (!IsValid(Armament) || Armament->IsPooled()) return;
+
+	const FArmamentPoolKey Key(Armament->GetClass(), Armament->GetArmamentId());
+	TArray<TWeakObjectPtr<AArmament>>& Pool = FindOrAddPool(Key);
+	if (!CVarArmamentPool.GetValueOnGameThread() || Key.ArmamentId.IsNone() || Pool.Num() >= CVarArmamentPoolMaxPooled.GetValueOnGameThread())
+	{
+		Armament->Destroy();
+		return;
+	}
+
+	Armament->OnReleasedToPool();
+	Pool.Add(Armament);
+}
+
+
+void UArmamentPoolSubsystem::PrewarmArmament(UClass* ArmamentClass, const F_ArmamentInformation& ArmamentInformation, UDataTable* ArmamentMontageDB, const ECharacterSkeletonMapping Link)
+{
+	if (!CVarArmamentPool.GetValueOnGameThread() || !ArmamentClass || !ArmamentClass->IsChildOf(AArmament::StaticClass()) || !ArmamentInformation.IsValid()) return;
+
+	TArray<TWeakObjectPtr<AArmament>>& Pool = FindOrAddPool(FArmamentPoolKey(ArmamentClass, ArmamentInformation.Id));
+	if (Pool.Num() >= CVarArmamentPoolMaxPooled.GetValueOnGameThread()) return;
+
+	AArmament* Armament = SpawnArmament(ArmamentClass, nullptr, FTransform::Identity);
+	if (!Armament) return;
+
+	// Resolve the montages now so equipping the armament doesn't have to
+	Armament->SetArmamentInformation(ArmamentInformation);
+	Armament->SetArmamentMontagesFromDB(ArmamentMontageDB, Link);
+	Armament->OnReleasedToPool();
+	Pool.Add(Armament);
+}
+
+
+int32 UArmamentPoolSubsystem::GetNumPooledArmaments() const
+{
+	int32 Count = 0;
+	for (const auto& [Key, Pool] : PooledArmaments)
+	{
+		Count += Pool.Num();
+	}
+
+	return Count;
+}
+
+
+AArmament* UArmamentPoolSubsystem::SpawnArmament(UClass* ArmamentClass, AActor* Owner, const FTransform& Transform) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.Owner = Owner;
+	return Cast<AArmament>(World->SpawnActor(ArmamentClass, &Transform, SpawnParameters));
+}
+
+
+TArray<TWeakObjectPtr<AArmament>>& UArmamentPoolSubsystem::FindOrAddPool(const FArmamentPoolKey& Key)
+{
+	TArray<TWeakObjectPtr<AArmament>>& Pool = PooledArmaments.FindOrAdd(Key);
+	Pool.RemoveAllSwap([](const TWeakObjectPtr<AArmament>& Armament) { return !Armament.IsValid(); }, false);
+	return Pool;
+}
+#pragma endregion
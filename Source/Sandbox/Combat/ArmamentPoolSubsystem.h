@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ArmamentPoolSubsystem.generated.h"
+
+class AArmament;
+class UDataTable;
+struct F_ArmamentInformation;
+enum class ECharacterSkeletonMapping : uint8;
+
+
+/**
+ * The armament class and armament database row that pooled armaments are grouped by
+ */
+struct SANDBOX_API FArmamentPoolKey
+{
+	FArmamentPoolKey(const UClass* ArmamentClass, const FName ArmamentId) :
+		ArmamentClass(ArmamentClass),
+		ArmamentId(ArmamentId)
+	{
+	}
+
+	/** The armament's class */
+	TObjectKey<UClass> ArmamentClass;
+
+	/** The armament's row in the armament database */
+	FName ArmamentId;
+
+	bool operator==(const FArmamentPoolKey& Other) const
+	{
+		return ArmamentClass == Other.ArmamentClass && ArmamentId == Other.ArmamentId;
+	}
+
+	friend uint32 GetTypeHash(const FArmamentPoolKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.ArmamentClass), GetTypeHash(Key.ArmamentId));
+	}
+
+};
+
+
+/**
+ * Server side pool of armament actors, grouped by armament class and database row. @ref UCombatComponent::CreateArmament \n\n
+ *
+ * Unequipped armaments are deactivated and returned to the pool instead of being destroyed, and equipping an armament reuses a pooled one before spawning another.
+ * Pooled armaments keep their armament information and resolved montages, so reusing one doesn't retrieve them again.
+ *
+ *	- Pooled armaments are hidden, detached, have their collision disabled, and are net dormant until they're reused
+ *	- Characters prewarm the armaments in their loadout when it's added (@ref UCombatComponent::PrewarmArmaments)
+ *	- Tuned with the Sandbox.ArmamentPool console variables
+ */
+UCLASS()
+class SANDBOX_API UArmamentPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The deactivated armaments of each armament class and database row */
+	TMap<FArmamentPoolKey, TArray<TWeakObjectPtr<AArmament>>> PooledArmaments;
+
+
+public:
+	/** Retrieves the armament pool of the world */
+	static UArmamentPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Only game worlds pool armaments */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Clears the pool */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Retrieves a pooled armament and activates it for a character, or spawns a new armament if there isn't one in the pool
+	 *
+	 * @param ArmamentClass						The armament's class
+	 * @param ArmamentId						The armament's row in the armament database
+	 * @param Owner								The character that's equipping the armament
+	 * @param Transform							Where the armament is placed
+	 * @returns									The armament, or nullptr if the class isn't an armament
+	 */
+	virtual AArmament* AcquireArmament(UClass* ArmamentClass, FName ArmamentId, AActor* Owner, const FTransform& Transform);
+
+	/**
+	 * Deactivates an armament and returns it to the pool, or destroys it if the pool is full. Deconstruct the armament before releasing it
+	 *
+	 * @param Armament							The armament
+	 */
+	virtual void ReleaseArmament(AArmament* Armament);
+
+	/**
+	 * Spawns a deactivated armament into the pool and resolves it's montages, if the pool for that armament isn't full
+	 *
+	 * @param ArmamentClass						The armament's class
+	 * @param ArmamentInformation				The armament's information from the armament database
+	 * @param ArmamentMontageDB					The data table that contains the armament montages
+	 * @param Link								The character skeleton to montage mapping reference
+	 */
+	virtual void PrewarmArmament(UClass* ArmamentClass, const F_ArmamentInformation& ArmamentInformation, UDataTable* ArmamentMontageDB, ECharacterSkeletonMapping Link);
+
+	/** Returns the amount of deactivated armaments in the pool */
+	virtual int32 GetNumPooledArmaments() const;
+
+
+protected:
+	/** Spawns a new armament */
+	virtual AArmament* SpawnArmament(UClass* ArmamentClass, AActor* Owner, const FTransform& Transform) const;
+
+	/** Retrieves the pool for an armament, and removes any armaments that were destroyed while they were pooled */
+	TArray<TWeakObjectPtr<AArmament>>& FindOrAddPool(const FArmamentPoolKey& Key);
+
+
+};
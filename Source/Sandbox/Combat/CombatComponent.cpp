@@ -15,9 +15,15 @@
 #include "Logging/StructuredLog.h"
 
 #include "Sandbox/Characters/CharacterBase.h"
+#include "Sandbox/Characters/Player/PlayerCharacter.h"
 #include "Sandbox/Asc/Attributes/MMOAttributeSet.h"
 #include "Sandbox/Asc/AbilitySystem.h"
+#include "Sandbox/Asc/Effects/StatusEffectRegistry.h"
 #include "Sandbox/Characters/Components/Inventory/InventoryComponent.h"
+#include "Sandbox/Combat/ArmamentPoolSubsystem.h"
+#include "Sandbox/Combat/ArmamentMontageCatalog.h"
+#include "Sandbox/Data/Catalog/ItemCatalogSubsystem.h"
+#include "Sandbox/Data/Interfaces/Save/LevelSaveInformationInterface.h"
 #include "Sandbox/Data/Enums/HitDirection.h"
 #include "Weapons/Armament.h"
 
@@ -232,13 +238,14 @@ AArmament* UCombatComponent::CreateArmament(const EEquipSlot EquipSlot)
 		return nullptr;
 	}
 
-	F_ArmamentInformation ArmamentData = GetArmamentInformationFromDatabase(ArmamentItemData.ItemName);
-	if (!ArmamentData.IsValid())
+	const F_ArmamentInformation* ArmamentInformation = FindArmamentInformation(ArmamentItemData.ItemName);
+	if (!ArmamentInformation || !ArmamentInformation->IsValid())
 	{
 		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Failed to retrieve valid armament information while creating the armament!",
 			UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
 		return nullptr;
 	}
+	const F_ArmamentInformation& ArmamentData = *ArmamentInformation;
 	
 	// If there's nothing to attach the armament to, don't equip the armament
 	FName EquipSocket = GetEquippedSocketName(ArmamentData.Classification, EquipSlot);
@@ -251,13 +258,23 @@ AArmament* UCombatComponent::CreateArmament(const EEquipSlot EquipSlot)
 	}
 
 	
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	SpawnParameters.Owner = GetOwner();
 	const FTransform SpawnLocation = CharacterSocket->GetSocketTransform(Character->GetMesh());
 	
-	// Spawn the armament and retrieve it's information, and if any of that fails delete the armament
-	AArmament* Armament = Cast<AArmament>(GetWorld()->SpawnActor(ArmamentItemData.ActualClass, &SpawnLocation, SpawnParameters));
+	// Retrieve a pooled armament (or spawn one) and it's information, and if any of that fails release the armament
+	UArmamentPoolSubsystem* ArmamentPool = UArmamentPoolSubsystem::Get(this);
+	AArmament* Armament = nullptr;
+	if (ArmamentPool)
+	{
+		Armament = ArmamentPool->AcquireArmament(ArmamentItemData.ActualClass, ArmamentData.Id, GetOwner(), SpawnLocation);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.Owner = GetOwner();
+		Armament = Cast<AArmament>(GetWorld()->SpawnActor(ArmamentItemData.ActualClass, &SpawnLocation, SpawnParameters));
+	}
+	
 	if (Armament)
 	{
 		bool bRightHand = IsRightHandedArmament(EquipSlot);
@@ -304,7 +321,8 @@ AArmament* UCombatComponent::CreateArmament(const EEquipSlot EquipSlot)
 	if (Armament)
 	{
 		Armament->DeconstructArmament();
-		Armament->Destroy();
+		if (ArmamentPool) ArmamentPool->ReleaseArmament(Armament);
+		else Armament->Destroy();
 	}
 
 	UE_LOGFMT(LogTemp, Error, "{0}::{1}() {2} failed to create the armament {3}!",
@@ -345,7 +363,8 @@ bool UCombatComponent::DeleteEquippedArmament(AArmament* Armament)
 		UpdateArmamentStanceAndAbilities();
 
 		OnUnequippedArmament.Broadcast(Armament->GetArmamentId(), Armament->Execute_GetId(Armament), Armament->GetEquipSlot());
-		Armament->Destroy();
+		if (UArmamentPoolSubsystem* ArmamentPool = UArmamentPoolSubsystem::Get(this)) ArmamentPool->ReleaseArmament(Armament);
+		else Armament->Destroy();
 		return true;
 	}
 	
@@ -353,6 +372,39 @@ bool UCombatComponent::DeleteEquippedArmament(AArmament* Armament)
 }
 
 
+void UCombatComponent::PrewarmArmaments()
+{
+	ACharacterBase* Character = Cast<ACharacterBase>(GetOwner());
+	UArmamentMontageCatalog* MontageCatalog = UArmamentMontageCatalog::Get();
+	UArmamentPoolSubsystem* ArmamentPool = Character && Character->HasAuthority() ? UArmamentPoolSubsystem::Get(this) : nullptr;
+	if (!Character || (!MontageCatalog && !ArmamentPool))
+	{
+		return;
+	}
+
+	const EEquipSlot LoadoutSlots[] = {
+		EEquipSlot::LeftHandSlotOne, EEquipSlot::LeftHandSlotTwo, EEquipSlot::LeftHandSlotThree,
+		EEquipSlot::RightHandSlotOne, EEquipSlot::RightHandSlotTwo, EEquipSlot::RightHandSlotThree
+	};
+	
+	for (const EEquipSlot EquipSlot : LoadoutSlots)
+	{
+		// Equipped armaments are already spawned
+		if ((PrimaryArmament && PrimaryArmament->GetEquipSlot() == EquipSlot) || (SecondaryArmament && SecondaryArmament->GetEquipSlot() == EquipSlot)) continue;
+
+		const F_Item ArmamentItemData = GetArmamentInventoryInformation(EquipSlot);
+		if (!ArmamentItemData.ActualClass || ArmamentItemData.ItemName.IsNone()) continue;
+
+		const F_ArmamentInformation* ArmamentInformation = FindArmamentInformation(ArmamentItemData.ItemName);
+		if (!ArmamentInformation || !ArmamentInformation->IsValid()) continue;
+		
+		// Resolve the shared montages even if the armament isn't pooled, so equipping it doesn't have to
+		if (MontageCatalog) MontageCatalog->FindOrCreateMontageSet(MontageInformationTable, ArmamentInformation->Id, Character->GetCharacterSkeletonMapping());
+		if (ArmamentPool) ArmamentPool->PrewarmArmament(ArmamentItemData.ActualClass, *ArmamentInformation, MontageInformationTable, Character->GetCharacterSkeletonMapping());
+	}
+}
+
+
 void UCombatComponent::SetArmamentStance(const EArmamentStance Stance)
 {
 	const EArmamentStance PreviousStance = CurrentStance;
@@ -479,11 +531,8 @@ void UCombatComponent::UpdateArmamentCombatAbilities(EArmamentStance PreviousSta
 	}
 
 
-	// Clear the old abilities
-	Asc->RemoveGameplayAbilities(CombatAbilityHandles);
-	CombatAbilityHandles.Empty();
-
-	// Add the stance's abilities
+	// Retrieve the stance's abilities
+	TArray<FGameplayAbilityInfo> StanceAbilities;
 	for (auto &[AttackPattern, CombatAbility] : CombatAbilities)
 	{
 		// The id for each ability should be specific to the equipped armament
@@ -519,59 +568,11 @@ void UCombatComponent::UpdateArmamentCombatAbilities(EArmamentStance PreviousSta
 		else if (CurrentStance == EArmamentStance::TwoHanding_L && SecondaryArmament) Id = SecondaryId;
 		else if (CurrentStance == EArmamentStance::TwoHanding_R && PrimaryArmament) Id = PrimaryId;
 
-		// Add the ability
-		CombatAbilityHandles.Add(Asc->AddAbility(FGameplayAbilityInfo(CombatAbility.Ability, CombatAbility.Level, CombatAbility.InputId, nullptr, Id)));
+		StanceAbilities.Add(FGameplayAbilityInfo(CombatAbility.Ability, CombatAbility.Level, CombatAbility.InputId, nullptr, Id));
 	}
-	
-
-	/*
-
-		Eventually only add/remove the abilities required using these conditions
-
-			Primary weapon
-				- Every combat ability except the secondary attack
-
-			Two Handed, Two Weapons, Or Dual Wielding
-				- Every combat ability
-
-			Offhand weapon
-				- Secondary attack
-
-			And if they go from dual wielding to two handing a weapon, they need to use the proper abilities
-
-			if (PreviousStance == EArmamentStance::DualWielding || PreviousStance == EArmamentStance::TwoWeapons || PreviousStance == EArmamentStance::TwoHanding)
-			{
-				// Only primary weapon, remove the offhand ability
-
-				// Only offhand weapon, remove all other abilities
-
-				// If dual wielding, use each of the weapon's abilities
-
-				// If they transition to two handing, add the abilities of the specific armament
-			}
-			else if (PreviousStance == EArmamentStance::OneHanding)
-			{
-				// Primary Weapon
-				if (PrimaryArmament)
-				{
-					// Primary weapon
-					// 	- Every combat ability except the secondary attack
-					
-
-				}
-
-				// Offhand Weapon
-				if (SecondaryArmament)
-				{
-					// Offhand weapon
-					// 	- Secondary attack
-
-					
-				}
-			}
-
-	*/
 
+	// Only remove the abilities that left the stance and add the new ones, the abilities that stay keep their specs
+	CombatAbilityHandles = Asc->UpdateAbilities(CombatAbilityHandles, StanceAbilities);
 }
 
 
@@ -685,18 +686,26 @@ F_Item UCombatComponent::GetArmamentInventoryInformation(const EEquipSlot Slot)
 
 
 F_ArmamentInformation UCombatComponent::GetArmamentInformationFromDatabase(const FName ArmamentId)
+{
+	const F_ArmamentInformation* ArmamentInformation = FindArmamentInformation(ArmamentId);
+	return ArmamentInformation ? *ArmamentInformation : F_ArmamentInformation();
+}
+
+
+const F_ArmamentInformation* UCombatComponent::FindArmamentInformation(const FName ArmamentId) const
 {
 	if (ArmamentId.IsNone())
 	{
-		return F_ArmamentInformation();
+		return nullptr;
 	}
 	
-	if (ArmamentInformationTable)
+	UItemCatalogSubsystem* CatalogSubsystem = UItemCatalogSubsystem::Get();
+	const TSharedPtr<const FArmamentCatalog> Catalog = CatalogSubsystem ? CatalogSubsystem->GetArmamentCatalog(ArmamentInformationTable) : nullptr;
+	if (Catalog.IsValid())
 	{
-		const FString RowContext(TEXT("Armament Information Context"));
-		if (const F_Table_ArmamentInformation* Data = ArmamentInformationTable->FindRow<F_Table_ArmamentInformation>(ArmamentId, RowContext))
+		if (const F_ArmamentInformation* ArmamentInformation = Catalog->Find(ArmamentId))
 		{
-			return Data->ArmamentInformation;
+			return ArmamentInformation;
 		}
 		else
 		{
@@ -710,7 +719,7 @@ F_ArmamentInformation UCombatComponent::GetArmamentInformationFromDatabase(const
 			UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
 	}
 
-	return F_ArmamentInformation();
+	return nullptr;
 }
 
 
@@ -836,13 +845,14 @@ bool UCombatComponent::EquipArmor(F_Item Armor)
 		return false;
 	}
 
-	F_Information_Armor ArmorInformation = GetArmorFromDatabase(Armor.ItemName);
-	if (!ArmorInformation.Id.IsValid() || ArmorInformation.ArmorSlot == EArmorSlot::None)
+	const F_Information_Armor* ArmorData = FindArmorInformation(Armor.ItemName);
+	if (!ArmorData || !ArmorData->Id.IsValid() || ArmorData->ArmorSlot == EArmorSlot::None)
 	{
 		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Failed to retrieve the armor information!",
 			UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
 		return false;
 	}
+	const F_Information_Armor& ArmorInformation = *ArmorData;
 	
 	// Remove any of the old armor
 	if (ArmorAbilityHandles.Contains(ArmorInformation.ArmorSlot))
@@ -932,16 +942,24 @@ USkeletalMeshComponent* UCombatComponent::GetArmorMesh(EArmorSlot ArmorSlot)
 
 const F_Information_Armor UCombatComponent::GetArmorFromDatabase(const FName Id) const
 {
-	if (ArmorInformationTable)
+	const F_Information_Armor* ArmorInformation = FindArmorInformation(Id);
+	return ArmorInformation ? *ArmorInformation : F_Information_Armor();
+}
+
+
+const F_Information_Armor* UCombatComponent::FindArmorInformation(const FName Id) const
+{
+	UItemCatalogSubsystem* CatalogSubsystem = UItemCatalogSubsystem::Get();
+	const TSharedPtr<const FArmorCatalog> Catalog = CatalogSubsystem ? CatalogSubsystem->GetArmorCatalog(ArmorInformationTable) : nullptr;
+	if (Catalog.IsValid())
 	{
-		const FString RowContext(TEXT("Armor Information Context"));
-		if (const F_Table_Armors* Data = ArmorInformationTable->FindRow<F_Table_Armors>(Id, RowContext))
+		if (const F_Information_Armor* ArmorInformation = Catalog->Find(Id))
 		{
-			return Data->ArmorInformation;
+			return ArmorInformation;
 		}
 		else
 		{
-			UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Failed to retrieve {2} from the armor information table!",
+			UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Failed to retrieve {3} from the armor information table!",
 				UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), Id);
 		}
 	}
@@ -951,7 +969,7 @@ const F_Information_Armor UCombatComponent::GetArmorFromDatabase(const FName Id)
 			UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
 	}
 
-	return F_Information_Armor();
+	return nullptr;
 }
 
 
@@ -1084,6 +1102,7 @@ void UCombatComponent::HandleDeath(ACharacterBase* Enemy, AActor* Source, FName
 		Character->NetMulticast_PlayMontage(DeathMontage, MontageSection);
 	}
 
+	if (!Cast<APlayerCharacter>(Character)) ILevelSaveInformationInterface::MarkLevelSaveDirty(Character);
 	OnDeath.Broadcast(Character, Enemy);
 }
 
@@ -1214,39 +1233,20 @@ void UCombatComponent::HandleClearingStatuses()
 
 void UCombatComponent::StatusProc(ACharacterBase* Enemy, AActor* Source, const FGameplayAttribute& Attribute, float NewValue)
 {
-	if (!(Attribute == UMMOAttributeSet::GetCurseBuildupAttribute() ||
-		Attribute == UMMOAttributeSet::GetBleedBuildupAttribute() ||
-		Attribute == UMMOAttributeSet::GetPoisonBuildupAttribute() ||
-		Attribute == UMMOAttributeSet::GetFrostbiteBuildupAttribute() ||
-		Attribute == UMMOAttributeSet::GetMadnessBuildupAttribute() ||
-		Attribute == UMMOAttributeSet::GetSleepBuildupAttribute()))
+	const FStatusProcDefinition* StatusProcDefinition = FindStatusProcDefinition(Attribute);
+	if (!StatusProcDefinition)
 	{
 		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to handle a statuc proc with an invalid attribute!",
 			*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
 		return;
 	}
 
-	// Yeah
-	const TSubclassOf<UGameplayEffect>& StatusEffectClass = Attribute == UMMOAttributeSet::GetCurseBuildupAttribute() ? CursedStateClass :
-		                                                        Attribute == UMMOAttributeSet::GetBleedBuildupAttribute() ? GE_Bled :
-		                                                        Attribute == UMMOAttributeSet::GetPoisonBuildupAttribute() ? GE_Poisoned :
-		                                                        Attribute == UMMOAttributeSet::GetFrostbiteBuildupAttribute() ? GE_Frostbitten :
-		                                                        Attribute == UMMOAttributeSet::GetMadnessBuildupAttribute() ? GE_Maddened : GE_Slept;
-
-	FActiveGameplayEffectHandle& EffectHandle = Attribute == UMMOAttributeSet::GetCurseBuildupAttribute() ? CursedHandle :
-												Attribute == UMMOAttributeSet::GetBleedBuildupAttribute() ? BleedHandle :
-												Attribute == UMMOAttributeSet::GetPoisonBuildupAttribute() ? PoisonedHandle :
-												Attribute == UMMOAttributeSet::GetFrostbiteBuildupAttribute() ? FrostbittenHandle :
-												Attribute == UMMOAttributeSet::GetMadnessBuildupAttribute() ? MaddenedHandle : SleepHandle;
-
-	ECombatAttribute BP_Attribute = Attribute == UMMOAttributeSet::GetCurseBuildupAttribute() ? ECombatAttribute::Curse :
-									Attribute == UMMOAttributeSet::GetBleedBuildupAttribute() ? ECombatAttribute::Bleed :
-									Attribute == UMMOAttributeSet::GetPoisonBuildupAttribute() ? ECombatAttribute::Poison :
-									Attribute == UMMOAttributeSet::GetFrostbiteBuildupAttribute() ? ECombatAttribute::Frostbite :
-									Attribute == UMMOAttributeSet::GetMadnessBuildupAttribute() ? ECombatAttribute::Madness : ECombatAttribute::Sleep;
+	const TSubclassOf<UGameplayEffect>& StatusEffectClass = this->*StatusProcDefinition->EffectClass;
+	FActiveGameplayEffectHandle& EffectHandle = this->*StatusProcDefinition->EffectHandle;
+	const ECombatAttribute BP_Attribute = StatusProcDefinition->Status;
 	
 	
-	UGameplayEffect* StatusEffect = StatusEffectClass ? StatusEffectClass->GetDefaultObject<UGameplayEffect>() : nullptr;
+	const UGameplayEffect* StatusEffect = StatusEffectClass ? StatusEffectClass->GetDefaultObject<UGameplayEffect>() : nullptr;
 	if (!StatusEffect)
 	{
 		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to add a status proc when the effect information wasn't valid!",
@@ -1286,6 +1286,26 @@ void UCombatComponent::StatusProc(ACharacterBase* Enemy, AActor* Source, const F
 }
 
 
+const FStatusProcDefinition* UCombatComponent::FindStatusProcDefinition(const FGameplayAttribute& Attribute) const
+{
+	static const FStatusProcDefinition StatusProcDefinitions[] = {
+		{&UMMOAttributeSet::GetCurseBuildupAttribute, ECombatAttribute::Curse, &UCombatComponent::CursedStateClass, &UCombatComponent::CursedHandle},
+		{&UMMOAttributeSet::GetBleedBuildupAttribute, ECombatAttribute::Bleed, &UCombatComponent::GE_Bled, &UCombatComponent::BleedHandle},
+		{&UMMOAttributeSet::GetPoisonBuildupAttribute, ECombatAttribute::Poison, &UCombatComponent::GE_Poisoned, &UCombatComponent::PoisonedHandle},
+		{&UMMOAttributeSet::GetFrostbiteBuildupAttribute, ECombatAttribute::Frostbite, &UCombatComponent::GE_Frostbitten, &UCombatComponent::FrostbittenHandle},
+		{&UMMOAttributeSet::GetMadnessBuildupAttribute, ECombatAttribute::Madness, &UCombatComponent::GE_Maddened, &UCombatComponent::MaddenedHandle},
+		{&UMMOAttributeSet::GetSleepBuildupAttribute, ECombatAttribute::Sleep, &UCombatComponent::GE_Slept, &UCombatComponent::SleepHandle}
+	};
+
+	for (const FStatusProcDefinition& StatusProcDefinition : StatusProcDefinitions)
+	{
+		if (StatusProcDefinition.GetAttribute() == Attribute) return &StatusProcDefinition;
+	}
+
+	return nullptr;
+}
+
+
 void UCombatComponent::HandleBleed(ACharacterBase* Enemy, AActor* Source, const FGameplayAttribute& Attribute, float NewValue)
 {
 	StatusProc(Enemy, Source, Attribute, NewValue);
@@ -1348,42 +1368,9 @@ bool UCombatComponent::IsImmuneToCurses_Implementation(ACharacterBase* Enemy, UO
 bool UCombatComponent::IsImmuneToSleep_Implementation(ACharacterBase* Enemy, UObject* Source, const ECombatAttribute Attribute, float Value) { return false; }
 
 
-UGameplayEffect* UCombatComponent::GetPreventAttributeAccumulationEffect(float Duration, const ECombatAttribute Attribute) const
+FGameplayEffectSpecHandle UCombatComponent::GetPreventAttributeAccumulationSpec(float Duration, const ECombatAttribute Attribute) const
 {
-	ACharacterBase* Character = Cast<ACharacterBase>(GetOwner());
-	if (!Character)
-	{
-		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect when the character wasn't valid!",
-			*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
-		return nullptr;
-	}
-
-	const FGameplayTag AttributeTag = GetAttributePreventionTag(Attribute);
-	if (!AttributeTag.IsValid() || Duration <= 0)
-	{
-		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect when the attribute or duration isn't valid! Duration: {3}, Attribute: {4}",
-			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), Duration, *UEnum::GetValueAsString(Attribute));
-		return nullptr;
-	}
-
-	const FName PreventAttribute = FName(*GetNameSafe(Character) + FString("_PreventAccumulation_").Append(UEnum::GetValueAsString(Attribute)));
-	UGameplayEffect* PreventRegenOrBuildup = NewObject<UGameplayEffect>(Character, PreventAttribute);
-	if (PreventRegenOrBuildup)
-	{
-		PreventRegenOrBuildup->DurationPolicy = EGameplayEffectDurationType::HasDuration;
-		PreventRegenOrBuildup->DurationMagnitude = FGameplayEffectModifierMagnitude(Duration);
-		PreventRegenOrBuildup->StackDurationRefreshPolicy = EGameplayEffectStackingDurationPolicy::RefreshOnSuccessfulApplication;
-
-		PreventRegenOrBuildup->InheritableGameplayEffectTags.AddTag(GetAttributePreventionTag(Attribute, false));
-		PreventRegenOrBuildup->InheritableOwnedTagsContainer.AddTag(AttributeTag);
-
-		return PreventRegenOrBuildup;
-	}
-	
-	// FGameplayEffectSpec* StaminaCostSpec = new FGameplayEffectSpec(StaminaCost, MakeEffectContext(Handle, ActorInfo), 1);
-	// FGameplayEffectSpecHandle StaminaCostHandle = FGameplayEffectSpecHandle(StaminaCostSpec);
-	// ApplyGameplayEffectSpecToOwner(Handle, ActorInfo, ActivationInfo, StaminaCostHandle);
-	return nullptr;
+	return GetPreventAttributesAccumulationSpec(Duration, {Attribute});
 }
 
 
@@ -1437,62 +1424,58 @@ TSubclassOf<UGameplayEffect> UCombatComponent::GetHitStunDurationEffect(EHitStun
 }
 
 
-UGameplayEffect* UCombatComponent::GetPreventAttributesAccumulationEffect(float Duration, const TArray<ECombatAttribute>& Attributes) const
+FGameplayEffectSpecHandle UCombatComponent::GetPreventAttributesAccumulationSpec(float Duration, const TArray<ECombatAttribute>& Attributes) const
 {
 	ACharacterBase* Character = Cast<ACharacterBase>(GetOwner());
-	if (!Character)
+	UAbilitySystem* AbilitySystem = Character ? Character->GetAbilitySystem<UAbilitySystem>() : nullptr;
+	UStatusEffectRegistry* StatusEffectRegistry = UStatusEffectRegistry::Get();
+	if (!AbilitySystem || !StatusEffectRegistry)
 	{
-		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect when the character wasn't valid!",
+		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect when the character or it's ability system wasn't valid!",
 			*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()));
-		return nullptr;
+		return FGameplayEffectSpecHandle();
 	}
 
 	if (Duration <= 0)
 	{
 		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect when the duration wasn't valid! Duration: {3}",
 			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), Duration);
-		return nullptr;
+		return FGameplayEffectSpecHandle();
 	}
-	
-	TArray<FGameplayTag> AttributeTags = {};
-	for (const ECombatAttribute Attribute : Attributes)
-	{
-		const FGameplayTag AttributeTag = GetAttributePreventionTag(Attribute);
-		if (!AttributeTag.IsValid())
-		{
-			UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Creating a prevent regen effect with an invalid tag reference! Attribute: {3}",
-				*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character), *UEnum::GetValueAsString(Attribute));
-		}
 
-		AttributeTags.Add(AttributeTag);
+	// The prevention effects are shared, only the spec is created here
+	const FGameplayEffectSpecHandle PreventionSpec = StatusEffectRegistry->MakePreventionSpec(AbilitySystem, Attributes, Duration);
+	if (!PreventionSpec.IsValid())
+	{
+		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect without any attributes that can be prevented!",
+			*UEnum::GetValueAsString(Character->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(Character));
 	}
 
-	
-	const FName PreventAttributes = FName(*GetNameSafe(Character) + FString("_PreventMultipleAttributeAccumulation_").Append(FString().FromInt(Attributes.Num())));
-	UGameplayEffect* PreventRegenOrBuildup = NewObject<UGameplayEffect>(Character, PreventAttributes);
-	if (PreventRegenOrBuildup)
-	{
-		PreventRegenOrBuildup->DurationPolicy = EGameplayEffectDurationType::HasDuration;
-		PreventRegenOrBuildup->DurationMagnitude = FGameplayEffectModifierMagnitude(Duration);
-		PreventRegenOrBuildup->StackDurationRefreshPolicy = EGameplayEffectStackingDurationPolicy::RefreshOnSuccessfulApplication;
+	return PreventionSpec;
+}
 
-		for (const ECombatAttribute Attribute : Attributes)
-		{
-			PreventRegenOrBuildup->InheritableGameplayEffectTags.AddTag(GetAttributePreventionTag(Attribute, false));
-		}
-		
-		for (const FGameplayTag& AttributeTag : AttributeTags)
-		{
-			PreventRegenOrBuildup->InheritableOwnedTagsContainer.AddTag(AttributeTag);
-		}
 
-		return PreventRegenOrBuildup;
+UGameplayEffect* UCombatComponent::GetPreventAttributeAccumulationEffect(float Duration, const ECombatAttribute Attribute) const
+{
+	return GetPreventAttributesAccumulationEffect(Duration, {Attribute});
+}
+
+
+UGameplayEffect* UCombatComponent::GetPreventAttributesAccumulationEffect(float Duration, const TArray<ECombatAttribute>& Attributes) const
+{
+	UStatusEffectRegistry* StatusEffectRegistry = UStatusEffectRegistry::Get();
+	const UGameplayEffect* PreventionEffect = StatusEffectRegistry ? StatusEffectRegistry->GetPreventionEffect(Attributes) : nullptr;
+	if (!PreventionEffect || !GetOwner() || Duration <= 0)
+	{
+		UE_LOGFMT(CombatComponentLog, Error, "{0}::{1}() {2} Tried to create a prevent regen effect without a valid duration or any attributes that can be prevented! Duration: {3}",
+			*UEnum::GetValueAsString(GetOwnerRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), Duration);
+		return nullptr;
 	}
-	
-	// FGameplayEffectSpec* StaminaCostSpec = new FGameplayEffectSpec(StaminaCost, MakeEffectContext(Handle, ActorInfo), 1);
-	// FGameplayEffectSpecHandle StaminaCostHandle = FGameplayEffectSpecHandle(StaminaCostSpec);
-	// ApplyGameplayEffectSpecToOwner(Handle, ActorInfo, ActivationInfo, StaminaCostHandle);
-	return nullptr;
+
+	// Blueprints apply the effect without a spec, so the duration can't be set by the caller
+	UGameplayEffect* PreventRegenOrBuildup = DuplicateObject<UGameplayEffect>(PreventionEffect, GetOwner());
+	PreventRegenOrBuildup->DurationMagnitude = FGameplayEffectModifierMagnitude(Duration);
+	return PreventRegenOrBuildup;
 }
 #pragma endregion 
 
@@ -1544,16 +1527,16 @@ void UCombatComponent::AddCombatAbilityIfValidStance(TMap<EInputAbilities, F_Arm
 FGameplayTag UCombatComponent::GetAttributePreventionTag(const ECombatAttribute Attribute, const bool bStateTag) const
 {
 	if (Attribute == ECombatAttribute::Health) return bStateTag ? PreventHealthRegen : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::Poise) return bStateTag ? PreventPoiseRegen : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::Stamina) return bStateTag ? PreventStaminaRegen : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::Mana) return bStateTag ? PreventManaRegen : PreventHealthRegenEffect;
-
-	if (Attribute == ECombatAttribute::CurseBuildup) return bStateTag ? PreventCurseBuildup : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::BleedBuildup) return bStateTag ? PreventBleedBuildup : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::PoisonBuildup) return bStateTag ? PreventPoisonBuildup : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::FrostbiteBuildup) return bStateTag ? PreventFrostbiteBuildup : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::MadnessBuildup) return bStateTag ? PreventMadnessBuildup : PreventHealthRegenEffect;
-	if (Attribute == ECombatAttribute::SleepBuildup) return bStateTag ? PreventSleepBuildup : PreventHealthRegenEffect;
+	if (Attribute == ECombatAttribute::Poise) return bStateTag ? PreventPoiseRegen : PreventPoiseRegenEffect;
+	if (Attribute == ECombatAttribute::Stamina) return bStateTag ? PreventStaminaRegen : PreventStaminaRegenEffect;
+	if (Attribute == ECombatAttribute::Mana) return bStateTag ? PreventManaRegen : PreventManaRegenEffect;
+
+	if (Attribute == ECombatAttribute::CurseBuildup) return bStateTag ? PreventCurseBuildup : PreventCurseBuildupEffect;
+	if (Attribute == ECombatAttribute::BleedBuildup) return bStateTag ? PreventBleedBuildup : PreventBleedBuildupEffect;
+	if (Attribute == ECombatAttribute::PoisonBuildup) return bStateTag ? PreventPoisonBuildup : PreventPoisonBuildupEffect;
+	if (Attribute == ECombatAttribute::FrostbiteBuildup) return bStateTag ? PreventFrostbiteBuildup : PreventFrostbiteBuildupEffect;
+	if (Attribute == ECombatAttribute::MadnessBuildup) return bStateTag ? PreventMadnessBuildup : PreventMadnessBuildupEffect;
+	if (Attribute == ECombatAttribute::SleepBuildup) return bStateTag ? PreventSleepBuildup : PreventSleepBuildupEffect;
 	return FGameplayTag();
 }
 
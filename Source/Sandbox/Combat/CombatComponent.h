@@ -20,6 +20,7 @@ DECLARE_LOG_CATEGORY_EXTERN(CombatComponentLog, Log, All);
 
 
 class AArmament;
+class UCombatComponent;
 class UDataTable;
 enum class ECharacterSkeletonMapping : uint8;
 enum class ECombatAttribute : uint8;
@@ -65,6 +66,26 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FArmorEquippedSignature, F_Item,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FArmorUnequippedSignature, F_Item, Item, F_Information_Armor, Armor, EArmorSlot, EquipSlot);
 
 
+/**
+ * A status that's procced when one of the buildup attributes is filled, and where the combat component stores it's effect and handle. @ref UCombatComponent::StatusProc
+ */
+struct SANDBOX_API FStatusProcDefinition
+{
+	/** The buildup attribute's getter */
+	FGameplayAttribute (*GetAttribute)();
+
+	/** The status that's procced */
+	ECombatAttribute Status;
+
+	/** The status effect */
+	TSubclassOf<UGameplayEffect> UCombatComponent::* EffectClass;
+
+	/** The status effect's active handle */
+	FActiveGameplayEffectHandle UCombatComponent::* EffectHandle;
+
+};
+
+
 
 
 /*
@@ -306,7 +327,7 @@ public:
 	/**
 	 * Creates an armament from one of it's equip slots and equips it to one of the character's active armament hands. Only call on authority. \n\n
 	 *
-	 * Handles spawning the armament, calling @ref ConstructArmament() and if it successfully creates and constructs the armament, it equips and returns the armament. Otherwise, reverts the creation and returns nullptr
+	 * Handles retrieving the armament from the armament pool (or spawning it), calling @ref ConstructArmament() and if it successfully creates and constructs the armament, it equips and returns the armament. Otherwise, reverts the creation and returns nullptr
 	 * @note If you call this before unequipping the armament from the specified equip slot, it fails to equip the armament
 	 *
 	 * @param EquipSlot							The equip slot to retrieve the armament information from.
@@ -317,13 +338,21 @@ public:
 
 	/**
 	 * Unequips an equipped armament, removing the armament and it's abilities from the character. Only call on authority. \n\n
-	 * Handles removing the armament, calling @ref DeconstructArmament() and then destroying the armament and handling any cleanup afterwards. If it fails to deconstruct, it returns false.
+	 * Handles removing the armament, calling @ref DeconstructArmament() and then returning the armament to the armament pool and handling any cleanup afterwards. If it fails to deconstruct, it returns false.
 	 * 
 	 * @param Armament							The armament we're removing
 	 * @returns									Whether the armament was successfully removed
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Init")
 	virtual bool DeleteEquippedArmament(AArmament* Armament);
+
+	/**
+	 * Prewarms the armament pool with the armaments in the character's equip slots, so swapping to them reuses an armament instead of spawning one. @ref UArmamentPoolSubsystem \n\n
+	 * Also resolves the shared montages of the armaments (@ref UArmamentMontageCatalog). Call this once the character's loadout has been added.
+	 * Only the server prewarms the armament pool, clients just resolve the montages.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat Component|Equipping")
+	virtual void PrewarmArmaments();
 	
 	/**
 	 * Sets the armament stance for the character. This is more for the player's input driven events for how they want to wield the armament
@@ -337,9 +366,9 @@ public:
 	virtual void UpdateArmamentStanceAndAbilities();
 
 	/**
-	 * Updates the armament's current abilities based on the current stance, only adding/removing abilities that are required
+	 * Updates the armament's current abilities based on the current stance, only adding/removing abilities that are required. @ref UAbilitySystem::UpdateAbilities
 	 *
-	 * @param PreviousStance					The previous armament stance. Use this if you only want to remove the abilities that aren't used
+	 * @param PreviousStance					The previous armament stance. The stance's abilities are compared against the granted abilities, so this isn't required
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Combat")
 	virtual void UpdateArmamentCombatAbilities(EArmamentStance PreviousStance = EArmamentStance::None);
@@ -419,6 +448,15 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Utils") 
 	virtual F_ArmamentInformation GetArmamentInformationFromDatabase(FName ArmamentId);
+
+	/**
+	 * Finds the armament's information in the armament catalog, without copying it. \n
+	 * The catalog subsystem owns the information, and rebuilds the catalog once the table is edited in the editor. Copy it instead of storing the pointer
+	 *
+	 * @param ArmamentId						The id of the armament
+	 * @returns									The armament information, or nullptr if it isn't in the armament information table
+	 */
+	virtual const F_ArmamentInformation* FindArmamentInformation(FName ArmamentId) const;
 	
 
 protected:
@@ -464,6 +502,9 @@ public:
 	/** Accesses the armor information from the database */
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Equipping")
 	virtual const F_Information_Armor GetArmorFromDatabase(const FName Id) const;
+
+	/** Finds the armor information in the armor catalog, without copying it. Only valid until the table is edited, copy it instead of storing the pointer. @returns nullptr if it isn't in the armor information table */
+	virtual const F_Information_Armor* FindArmorInformation(const FName Id) const;
 	
 	
 
@@ -606,6 +647,9 @@ public:
 	/** Handle the logic that happens when the player is cursed / bleeds / poisoned / frostbitten / maddened / slept */
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Statuses")
 	virtual void StatusProc(ACharacterBase* Enemy, AActor* Source, const FGameplayAttribute& Attribute, float Damage);
+
+	/** Returns the status of a buildup attribute, or nullptr if the attribute doesn't proc a status */
+	virtual const FStatusProcDefinition* FindStatusProcDefinition(const FGameplayAttribute& Attribute) const;
 	
 
 	/** Logic when the player takes bleed damage */
@@ -693,14 +737,14 @@ public:
 
 	
 	/**
-	 * Returns a gameplay effect to prevent an attribute from regenerating for a specific duration
+	 * Returns a gameplay effect spec to prevent an attribute from regenerating for a specific duration. The effect is shared from the status effect registry, and the duration is set on the spec
 	 *
 	 * @param Duration							The duration that the attribute isn't allowed to regenerate for
 	 * @param Attribute							The attribute we're preventing from regenerating
-	 * @returns									A gameplay effect for preventing attribute regeneration
+	 * @returns									A gameplay effect spec for preventing attribute regeneration
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Utils")
-	virtual UGameplayEffect* GetPreventAttributeAccumulationEffect(float Duration, const ECombatAttribute Attribute) const;
+	virtual FGameplayEffectSpecHandle GetPreventAttributeAccumulationSpec(float Duration, const ECombatAttribute Attribute) const;
 	
 	/**
 	 * Returns a gameplay effect for handling the hitstun duration once a player's been attacked.
@@ -713,13 +757,21 @@ public:
 	virtual TSubclassOf<UGameplayEffect> GetHitStunDurationEffect(EHitStun HitStun) const;
 
 	/**
-	 * Returns a gameplay effect to prevent certain attributes from regenerating for a specific duration
+	 * Returns a gameplay effect spec to prevent certain attributes from regenerating for a specific duration. The effect is shared from the status effect registry, and the duration is set on the spec
 	 *
 	 * @param Duration							The duration that the attributes aren't allowed to regenerate for
 	 * @param Attributes						The attributes we're preventing from regenerating
-	 * @returns									A gameplay effect for preventing attribute regeneration
+	 * @returns									A gameplay effect spec for preventing attribute regeneration
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Utils")
+	virtual FGameplayEffectSpecHandle GetPreventAttributesAccumulationSpec(float Duration, const TArray<ECombatAttribute>& Attributes) const;
+
+	/** Returns a copy of the shared prevention effect with the duration set on the effect. Kept for blueprints that apply the effect object, @ref GetPreventAttributeAccumulationSpec */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Utils", meta = (DeprecatedFunction, DeprecationMessage = "Use GetPreventAttributeAccumulationSpec, which shares the effect instead of creating one each time"))
+	virtual UGameplayEffect* GetPreventAttributeAccumulationEffect(float Duration, const ECombatAttribute Attribute) const;
+
+	/** Returns a copy of the shared prevention effect with the duration set on the effect. Kept for blueprints that apply the effect object, @ref GetPreventAttributesAccumulationSpec */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Utils", meta = (DeprecatedFunction, DeprecationMessage = "Use GetPreventAttributesAccumulationSpec, which shares the effect instead of creating one each time"))
 	virtual UGameplayEffect* GetPreventAttributesAccumulationEffect(float Duration, const TArray<ECombatAttribute>& Attributes) const;
 	
 	
@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatGridSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Characters/CharacterBase.h"
+
+DEFINE_LOG_CATEGORY(CombatGridLog);
+
+DECLARE_STATS_GROUP(TEXT("CombatGrid"), STATGROUP_CombatGrid, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Update Characters"), STAT_CombatGridUpdate, STATGROUP_CombatGrid);
+DECLARE_CYCLE_STAT(TEXT("Query"), STAT_CombatGridQuery, STATGROUP_CombatGrid);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queried Characters"), STAT_CombatGridQueriedCharacters, STATGROUP_CombatGrid);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters"), STAT_CombatGridCharacters, STATGROUP_CombatGrid);
+
+
+static TAutoConsoleVariable<float> CVarCombatGridCellSize(
+	TEXT("Sandbox.CombatGrid.CellSize"),
+	800.0f,
+	TEXT("The size in cm of each cell of the combat grid. Queries check every cell they overlap, so this should be around the size of the usual query radius")
+);
+
+
+#pragma region Subsystem
+UCombatGridSubsystem::UCombatGridSubsystem()
+{
+	CellSize = 0;
+}
+
+
+UCombatGridSubsystem* UCombatGridSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatGridSubsystem>() : nullptr;
+}
+
+
+bool UCombatGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UCombatGridSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_CombatGridCharacters, 0);
+	Entries.Empty();
+	Cells.Empty();
+	Super::Deinitialize();
+}
+
+
+TStatId UCombatGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatGridSubsystem, STATGROUP_Tickables);
+}
+
+
+void UCombatGridSubsystem::Tick(float DeltaTime)
+{
+	if (Entries.IsEmpty()) return;
+
+	if (CellSize != FMath::Max(CVarCombatGridCellSize.GetValueOnGameThread(), 100.f))
+	{
+		RebuildCells();
+	}
+
+	UpdateCharacters();
+}
+
+
+void UCombatGridSubsystem::RegisterCharacter(ACharacterBase* Character)
+{
+	if (!Character || Entries.Contains(TObjectKey<ACharacterBase>(Character))) return;
+	if (CellSize <= 0) CellSize = FMath::Max(CVarCombatGridCellSize.GetValueOnGameThread(), 100.f);
+
+	FCombatGridEntry Entry;
+	Entry.Character = Character;
+	Entry.Location = Character->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+
+	Entries.Add(TObjectKey<ACharacterBase>(Character), Entry);
+	AddToCell(Entry.Cell, TObjectKey<ACharacterBase>(Character));
+	SET_DWORD_STAT(STAT_CombatGridCharacters, Entries.Num());
+}
+
+
+void UCombatGridSubsystem::UnregisterCharacter(ACharacterBase* Character)
+{
+	FCombatGridEntry Entry;
+	if (Entries.RemoveAndCopyValue(TObjectKey<ACharacterBase>(Character), Entry))
+	{
+		RemoveFromCell(Entry.Cell, TObjectKey<ACharacterBase>(Character));
+		SET_DWORD_STAT(STAT_CombatGridCharacters, Entries.Num());
+	}
+}
+
+
+int32 UCombatGridSubsystem::GetNumCharacters() const
+{
+	return Entries.Num();
+}
+#pragma endregion
+
+
+
+
+#pragma region Grid
+void UCombatGridSubsystem::UpdateCharacters()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatGridUpdate);
+
+	for (auto Iterator = Entries.CreateIterator(); Iterator; ++Iterator)
+	{
+		FCombatGridEntry& Entry = Iterator.Value();
+		const ACharacterBase* Character = Entry.Character.Get();
+
+		// Remove the characters that were destroyed without unregistering
+		if (!Character)
+		{
+			RemoveFromCell(Entry.Cell, Iterator.Key());
+			Iterator.RemoveCurrent();
+			continue;
+		}
+
+		Entry.Location = Character->GetActorLocation();
+		const FIntPoint Cell = GetCell(Entry.Location);
+		if (Cell == Entry.Cell) continue;
+
+		RemoveFromCell(Entry.Cell, Iterator.Key());
+		AddToCell(Cell, Iterator.Key());
+		Entry.Cell = Cell;
+	}
+
+	SET_DWORD_STAT(STAT_CombatGridCharacters, Entries.Num());
+}
+
+
+void UCombatGridSubsystem::RebuildCells()
+{
+	CellSize = FMath::Max(CVarCombatGridCellSize.GetValueOnGameThread(), 100.f);
+	Cells.Reset();
+	for (auto& [Key, Entry] : Entries)
+	{
+		Entry.Cell = GetCell(Entry.Location);
+		AddToCell(Entry.Cell, Key);
+	}
+
+	UE_LOGFMT(CombatGridLog, Verbose, "{0}() Rebuilt the combat grid with a cell size of {1}, {2} characters in {3} cells", *FString(__FUNCTION__), CellSize, Entries.Num(), Cells.Num());
+}
+
+
+int32 UCombatGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, const float Radius, const float HalfAngle, TArray<ACharacterBase*>& OutCharacters, const AActor* IgnoredActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatGridQuery);
+	if (Radius <= 0 || Entries.IsEmpty()) return 0;
+
+	// Cones of 180 degrees or more are spheres
+	const FVector2D Forward = FVector2D(Direction).GetSafeNormal();
+	const bool bCheckAngle = HalfAngle < 180.f && !Forward.IsNearlyZero();
+	const float MinDot = FMath::Cos(FMath::DegreesToRadians(HalfAngle));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	const FIntPoint MinCell = GetCell(Origin - FVector(Radius, Radius, 0));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Radius, Radius, 0));
+	const int32 PreviousNum = OutCharacters.Num();
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const auto* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (const TObjectKey<ACharacterBase>& Key : *Cell)
+			{
+				const FCombatGridEntry* Entry = Entries.Find(Key);
+				if (!Entry) continue;
+
+				const FVector ToCharacter = Entry->Location - Origin;
+				if (ToCharacter.SizeSquared() > RadiusSquared) continue;
+				if (bCheckAngle)
+				{
+					const FVector2D ToCharacter2D = FVector2D(ToCharacter).GetSafeNormal();
+					if (!ToCharacter2D.IsNearlyZero() && FVector2D::DotProduct(Forward, ToCharacter2D) < MinDot) continue;
+				}
+
+				ACharacterBase* Character = Entry->Character.Get();
+				if (Character && Character != IgnoredActor) OutCharacters.Add(Character);
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_CombatGridQueriedCharacters, OutCharacters.Num() - PreviousNum);
+	return OutCharacters.Num() - PreviousNum;
+}
+
+
+FIntPoint UCombatGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+
+void UCombatGridSubsystem::AddToCell(const FIntPoint& Cell, const TObjectKey<ACharacterBase> Key)
+{
+	Cells.FindOrAdd(Cell).Add(Key);
+}
+
+
+void UCombatGridSubsystem::RemoveFromCell(const FIntPoint& Cell, const TObjectKey<ACharacterBase> Key)
+{
+	auto* Characters = Cells.Find(Cell);
+	if (!Characters) return;
+
+	Characters->RemoveSingleSwap(Key, false);
+	if (Characters->IsEmpty()) Cells.Remove(Cell);
+}
+#pragma endregion
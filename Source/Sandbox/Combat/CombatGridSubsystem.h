@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatGridSubsystem.generated.h"
+
+class ACharacterBase;
+
+DECLARE_LOG_CATEGORY_EXTERN(CombatGridLog, Log, All);
+
+
+/**
+ * A registered character, and the cell it was last added to
+ */
+struct SANDBOX_API FCombatGridEntry
+{
+	/** The character */
+	TWeakObjectPtr<ACharacterBase> Character;
+
+	/** The character's location when the grid was last updated */
+	FVector Location = FVector::ZeroVector;
+
+	/** The cell the character is in */
+	FIntPoint Cell = FIntPoint::ZeroValue;
+
+};
+
+
+/**
+ * A uniform grid of the characters in the world, so combat logic can find the characters around a location without overlap queries. @ref ACharacterCameraLogic::AdjustCurrentTarget \n\n
+ *
+ * The grid is split into cells along the ground, and each cell keeps the characters that are inside of it.
+ *	- Characters register themselves on BeginPlay and unregister on EndPlay
+ *	- Each tick updates the characters' locations, and only the characters that crossed into another cell are moved
+ *	- Queries only check the characters in the cells that overlap the query, with the locations from the last update
+ *	- The cell size is adjusted with Sandbox.CombatGrid.CellSize, and the update and query times are in stat CombatGrid
+ */
+UCLASS()
+class SANDBOX_API UCombatGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The registered characters */
+	TMap<TObjectKey<ACharacterBase>, FCombatGridEntry> Entries;
+
+	/** The characters in each cell */
+	TMap<FIntPoint, TArray<TObjectKey<ACharacterBase>, TInlineAllocator<8>>> Cells;
+
+	/** The size of each cell the grid was built with */
+	float CellSize;
+
+
+public:
+	UCombatGridSubsystem();
+
+	/** Retrieves the combat grid of the world */
+	static UCombatGridSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Only game worlds have characters to track */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Clears the grid */
+	virtual void Deinitialize() override;
+
+	/** Moves the characters that crossed into another cell */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Adds a character to the grid */
+	virtual void RegisterCharacter(ACharacterBase* Character);
+
+	/** Removes a character from the grid */
+	virtual void UnregisterCharacter(ACharacterBase* Character);
+
+	/**
+	 * Finds the characters within a cone
+	 *
+	 * @param Origin							Where the cone starts
+	 * @param Direction							The direction of the cone along the ground
+	 * @param Radius							How far the cone reaches
+	 * @param HalfAngle							The angle in degrees between the direction and the edge of the cone. 180 finds every character within the radius
+	 * @param OutCharacters						The characters that were found, this isn't cleared beforehand
+	 * @param IgnoredActor						An actor that's excluded from the results, usually the character that's searching
+	 * @returns									The amount of characters that were found
+	 */
+	virtual int32 QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngle, TArray<ACharacterBase*>& OutCharacters, const AActor* IgnoredActor = nullptr) const;
+
+	/** Returns the amount of registered characters */
+	int32 GetNumCharacters() const;
+
+
+protected:
+	/** Updates each character's location and cell, and removes the characters that are no longer valid */
+	virtual void UpdateCharacters();
+
+	/** Rebuilds every cell after the cell size is adjusted */
+	virtual void RebuildCells();
+
+	/** Returns the cell that contains a location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Adds a character to a cell */
+	void AddToCell(const FIntPoint& Cell, TObjectKey<ACharacterBase> Key);
+
+	/** Removes a character from a cell, and removes the cell once it's empty */
+	void RemoveFromCell(const FIntPoint& Cell, TObjectKey<ACharacterBase> Key);
+
+
+};
@@ -0,0 +1,495 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Combat/CombatTelemetry.h"
+
+#include "Algo/StableSort.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Sandbox/Data/Enums/AttributeTypes.h"
+#include "Sandbox/Data/Enums/HitDirection.h"
+#include "Sandbox/Data/Enums/HitReacts.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY(CombatTelemetryLog);
+
+#if SANDBOX_COMBAT_TELEMETRY || !UE_BUILD_SHIPPING
+/** The folder combat telemetry files are written to */
+static FString GetCombatTelemetryDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Telemetry");
+}
+#endif
+
+
+#if SANDBOX_COMBAT_TELEMETRY
+static TAutoConsoleVariable<bool> CVarCombatTelemetry(
+	TEXT("Sandbox.CombatTelemetry"),
+	true,
+	TEXT("Records damage, status buildup, poise breaks and deaths to Saved/Telemetry")
+);
+
+static TAutoConsoleVariable<float> CVarCombatTelemetryFlushInterval(
+	TEXT("Sandbox.CombatTelemetry.FlushInterval"),
+	2.0f,
+	TEXT("How often (in seconds) combat telemetry is written to disk. Read when the first event is recorded")
+);
+
+
+
+
+#pragma region Buffers
+/** A ring buffer of combat records that's written by a single thread, and drained by the flush */
+struct FCombatTelemetryBuffer
+{
+	static constexpr uint32 Capacity = FCombatTelemetry::BufferCapacity;
+
+	/** The records, indexed by the head / tail modulo the capacity */
+	FCombatTelemetryRecord Records[Capacity];
+
+	/** The amount of records that have been written. Only the owning thread adjusts this */
+	std::atomic<uint32> Head{0};
+
+	/** The amount of records that have been drained. Only the flush adjusts this */
+	std::atomic<uint32> Tail{0};
+
+};
+
+
+/** Every thread's buffer, and the file they're drained to */
+struct FCombatTelemetryState
+{
+	/** Guards adding buffers, and draining them so there's only ever one reader */
+	FCriticalSection BuffersLock;
+	TArray<TUniquePtr<FCombatTelemetryBuffer>> Buffers;
+
+	/** Guards writing to the file */
+	FCriticalSection FileLock;
+	FString FilePath;
+
+	/** Guards the name table ids of the recorded objects */
+	FCriticalSection NamesLock;
+	TMap<FObjectKey, uint32> ObjectIds;
+	TArray<FCombatTelemetryName> PendingNames;
+
+	std::atomic<bool> bFlushing{false};
+	std::atomic<uint32> DroppedRecords{0};
+	FTSTicker::FDelegateHandle FlushHandle;
+
+};
+
+
+static FCombatTelemetryState& GetCombatTelemetryState()
+{
+	static FCombatTelemetryState State;
+	return State;
+}
+
+
+/** Returns the current thread's buffer, and adds it the first time the thread records an event */
+static FCombatTelemetryBuffer& GetThreadBuffer()
+{
+	thread_local FCombatTelemetryBuffer* Buffer = nullptr;
+	if (Buffer) return *Buffer;
+
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+	FScopeLock Lock(&State.BuffersLock);
+	Buffer = State.Buffers.Add_GetRef(MakeUnique<FCombatTelemetryBuffer>()).Get();
+
+	// Start flushing once something's been recorded, and write whatever's left when the engine exits
+	if (!State.FlushHandle.IsValid())
+	{
+		State.FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateLambda([](float) { FCombatTelemetry::Flush(); return true; }),
+			FMath::Max(0.1f, CVarCombatTelemetryFlushInterval.GetValueOnAnyThread())
+		);
+		FCoreDelegates::OnEnginePreExit.AddLambda([]()
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(GetCombatTelemetryState().FlushHandle);
+			FCombatTelemetry::Flush(false);
+		});
+	}
+
+	return *Buffer;
+}
+
+
+/** Drains every buffer and appends the records to the telemetry file */
+static void WriteCombatTelemetry()
+{
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+
+	TArray<FCombatTelemetryRecord> Records;
+	FCombatTelemetry::Drain(Records);
+	if (Records.IsEmpty()) return;
+
+	TArray<FCombatTelemetryName> Names;
+	FCombatTelemetry::DrainNames(Names);
+
+	FScopeLock Lock(&State.FileLock);
+	if (State.FilePath.IsEmpty())
+	{
+		State.FilePath = GetCombatTelemetryDir() / FString::Printf(TEXT("Combat_%s.ctel"), *FDateTime::Now().ToString());
+	}
+
+	const bool bNewFile = !IFileManager::Get().FileExists(*State.FilePath);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*State.FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!Writer)
+	{
+		UE_LOGFMT(CombatTelemetryLog, Warning, "{0}() Failed to open {1}, {2} records were discarded", *FString(__FUNCTION__), *State.FilePath, Records.Num());
+		return;
+	}
+
+	FCombatTelemetryFile::Write(*Writer, Names, Records, bNewFile);
+	UE_LOGFMT(CombatTelemetryLog, Verbose, "{0}() Wrote {1} records to {2}", *FString(__FUNCTION__), Records.Num(), *State.FilePath);
+}
+#pragma endregion
+
+
+
+
+#pragma region Recording
+void FCombatTelemetry::RecordDamage(const UObject* Source, const UObject* Target, const float Damage, const float MagicDamage, const float PoiseDamage, const float Health)
+{
+	Record(ECombatTelemetryEvent::Damage, Source, Target, 0, 0, Damage, MagicDamage, PoiseDamage, Health);
+}
+
+
+void FCombatTelemetry::RecordStatus(const UObject* Source, const UObject* Target, const EDamageChannel Status, const bool bProc, const float Buildup)
+{
+	Record(ECombatTelemetryEvent::Status, Source, Target, static_cast<uint8>(Status), bProc, Buildup);
+}
+
+
+void FCombatTelemetry::RecordPoiseBreak(const UObject* Source, const UObject* Target, const EHitStun HitStun, const EHitDirection HitDirection, const float PoiseDamage)
+{
+	Record(ECombatTelemetryEvent::PoiseBreak, Source, Target, static_cast<uint8>(HitStun), static_cast<uint8>(HitDirection), PoiseDamage);
+}
+
+
+void FCombatTelemetry::RecordDeath(const UObject* Source, const UObject* Target, const float Health)
+{
+	Record(ECombatTelemetryEvent::Death, Source, Target, 0, 0, Health);
+}
+
+
+void FCombatTelemetry::Record(const ECombatTelemetryEvent Event, const UObject* Source, const UObject* Target, const uint8 Detail, const uint8 Extra,
+	const float Value0, const float Value1, const float Value2, const float Value3)
+{
+	if (!CVarCombatTelemetry.GetValueOnAnyThread()) return;
+
+	// Only this thread writes to the head, so the record can be filled in place and published afterwards
+	FCombatTelemetryBuffer& Buffer = GetThreadBuffer();
+	const uint32 Head = Buffer.Head.load(std::memory_order_relaxed);
+	if (Head - Buffer.Tail.load(std::memory_order_acquire) >= FCombatTelemetryBuffer::Capacity)
+	{
+		GetCombatTelemetryState().DroppedRecords.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FCombatTelemetryRecord& Entry = Buffer.Records[Head % FCombatTelemetryBuffer::Capacity];
+	Entry.Event = Event;
+	Entry.Detail = Detail;
+	Entry.Extra = Extra;
+	Entry.Reserved = 0;
+	Entry.Frame = static_cast<uint32>(GFrameCounter);
+	Entry.SourceId = GetObjectId(Source);
+	Entry.TargetId = GetObjectId(Target);
+	Entry.Values[0] = Value0;
+	Entry.Values[1] = Value1;
+	Entry.Values[2] = Value2;
+	Entry.Values[3] = Value3;
+	Buffer.Head.store(Head + 1, std::memory_order_release);
+}
+
+
+uint32 FCombatTelemetry::GetObjectId(const UObject* Object)
+{
+	if (!Object) return MAX_uint32;
+
+	// Object keys include the serial number, so objects that reuse another object's index get their own id
+	thread_local TMap<FObjectKey, uint32> ThreadObjectIds;
+	const FObjectKey Key(Object);
+	if (const uint32* Id = ThreadObjectIds.Find(Key)) return *Id;
+
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+	FScopeLock Lock(&State.NamesLock);
+	uint32* Id = State.ObjectIds.Find(Key);
+	if (!Id)
+	{
+		Id = &State.ObjectIds.Add(Key, State.ObjectIds.Num());
+		State.PendingNames.Add({ *Id, Object->GetPathName() });
+	}
+
+	return ThreadObjectIds.Add(Key, *Id);
+}
+
+
+void FCombatTelemetry::Flush(const bool bAsync)
+{
+	if (!bAsync)
+	{
+		WriteCombatTelemetry();
+		return;
+	}
+
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+	if (State.bFlushing.exchange(true)) return;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, []()
+	{
+		WriteCombatTelemetry();
+		GetCombatTelemetryState().bFlushing = false;
+	});
+}
+
+
+uint32 FCombatTelemetry::GetNumDroppedRecords()
+{
+	return GetCombatTelemetryState().DroppedRecords.load(std::memory_order_relaxed);
+}
+
+
+void FCombatTelemetry::Drain(TArray<FCombatTelemetryRecord>& OutRecords)
+{
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+	{
+		FScopeLock Lock(&State.BuffersLock);
+		for (const TUniquePtr<FCombatTelemetryBuffer>& Buffer : State.Buffers)
+		{
+			const uint32 Tail = Buffer->Tail.load(std::memory_order_relaxed);
+			const uint32 Head = Buffer->Head.load(std::memory_order_acquire);
+			for (uint32 Index = Tail; Index != Head; Index++)
+			{
+				OutRecords.Add(Buffer->Records[Index % FCombatTelemetryBuffer::Capacity]);
+			}
+
+			Buffer->Tail.store(Head, std::memory_order_release);
+		}
+	}
+
+	// Each buffer is in order, interleave the threads by frame
+	Algo::StableSortBy(OutRecords, &FCombatTelemetryRecord::Frame);
+}
+
+
+void FCombatTelemetry::DrainNames(TArray<FCombatTelemetryName>& OutNames)
+{
+	FCombatTelemetryState& State = GetCombatTelemetryState();
+	FScopeLock Lock(&State.NamesLock);
+	OutNames.Append(MoveTemp(State.PendingNames));
+	State.PendingNames.Reset();
+}
+
+
+static FAutoConsoleCommand CombatTelemetryFlushCommand(
+	TEXT("Sandbox.CombatTelemetry.Flush"),
+	TEXT("Writes the recorded combat events to disk"),
+	FConsoleCommandDelegate::CreateLambda([]() { FCombatTelemetry::Flush(false); })
+);
+#pragma endregion
+#endif
+
+
+
+
+#pragma region Files
+void FCombatTelemetryFile::Write(FArchive& Ar, const TConstArrayView<FCombatTelemetryName> Names, const TConstArrayView<FCombatTelemetryRecord> Records, const bool bWriteHeader)
+{
+	if (bWriteHeader)
+	{
+		FCombatTelemetryHeader Header;
+		Ar.Serialize(&Header, sizeof(FCombatTelemetryHeader));
+	}
+
+	uint32 NumNames = Names.Num();
+	Ar << NumNames;
+	for (const FCombatTelemetryName& Name : Names)
+	{
+		const FTCHARToUTF8 Converter(*Name.Name, Name.Name.Len());
+		uint32 Id = Name.Id;
+		uint16 Length = static_cast<uint16>(FMath::Min(Converter.Length(), static_cast<int32>(MAX_uint16)));
+		Ar << Id << Length;
+		Ar.Serialize(const_cast<ANSICHAR*>(Converter.Get()), Length);
+	}
+
+	uint32 NumRecords = Records.Num();
+	Ar << NumRecords;
+	Ar.Serialize(const_cast<FCombatTelemetryRecord*>(Records.GetData()), Records.Num() * sizeof(FCombatTelemetryRecord));
+}
+
+
+bool FCombatTelemetryFile::Read(const TConstArrayView<uint8> Data, TMap<uint32, FString>& OutNames, TArray<FCombatTelemetryRecord>& OutRecords)
+{
+	constexpr int32 HeaderSize = sizeof(FCombatTelemetryHeader);
+	constexpr int32 RecordSize = sizeof(FCombatTelemetryRecord);
+	if (Data.Num() < HeaderSize) return false;
+
+	FCombatTelemetryHeader Header;
+	const FCombatTelemetryHeader Expected;
+	FMemory::Memcpy(&Header, Data.GetData(), HeaderSize);
+	if (Header.Magic != Expected.Magic || Header.Version != Expected.Version || Header.RecordSize != Expected.RecordSize) return false;
+
+	OutNames.Reset();
+	OutRecords.Reset();
+	int64 Offset = HeaderSize;
+	auto ReadBytes = [&Data, &Offset](void* Destination, const int64 Num)
+	{
+		if (Offset + Num > Data.Num()) return false;
+		FMemory::Memcpy(Destination, Data.GetData() + Offset, Num);
+		Offset += Num;
+		return true;
+	};
+
+	// The game could have closed while a block was written, so only the whole names and records of the last block are read
+	while (Offset < Data.Num())
+	{
+		uint32 NumNames = 0;
+		if (!ReadBytes(&NumNames, sizeof(uint32))) break;
+
+		bool bReadNames = true;
+		for (uint32 Index = 0; Index < NumNames && bReadNames; Index++)
+		{
+			uint32 Id = 0;
+			uint16 Length = 0;
+			bReadNames = ReadBytes(&Id, sizeof(uint32)) && ReadBytes(&Length, sizeof(uint16)) && Offset + Length <= Data.Num();
+			if (!bReadNames) break;
+
+			const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Length);
+			OutNames.Add(Id, FString(Converter.Length(), Converter.Get()));
+			Offset += Length;
+		}
+
+		uint32 NumRecords = 0;
+		if (!bReadNames || !ReadBytes(&NumRecords, sizeof(uint32))) break;
+
+		const int32 NumWholeRecords = static_cast<int32>(FMath::Min<int64>(NumRecords, (Data.Num() - Offset) / RecordSize));
+		const int32 Start = OutRecords.AddUninitialized(NumWholeRecords);
+		ReadBytes(OutRecords.GetData() + Start, static_cast<int64>(NumWholeRecords) * RecordSize);
+		if (static_cast<uint32>(NumWholeRecords) < NumRecords) break;
+	}
+
+	return true;
+}
+#pragma endregion
+
+
+
+
+#pragma region Decoder
+#if !UE_BUILD_SHIPPING
+/** Returns the path name of a recorded character from the file's name table */
+static FString GetCombatTelemetryName(const TMap<uint32, FString>& Names, const uint32 Id)
+{
+	if (Id == MAX_uint32) return TEXT("None");
+
+	const FString* Name = Names.Find(Id);
+	return Name ? *Name : FString::Printf(TEXT("#%u"), Id);
+}
+
+
+/** Decodes a combat telemetry file, logs it's first records and a summary of the damage and statuses */
+static void DecodeCombatTelemetry(const TArray<FString>& Args)
+{
+	const FString TelemetryDir = GetCombatTelemetryDir();
+	FString FilePath = Args.Num() > 0 ? Args[0] : FString();
+	if (FilePath.IsEmpty() || FilePath == TEXT("Latest"))
+	{
+		// The file names are timestamps, so the last one is the most recent
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(TelemetryDir / TEXT("*.ctel")), true, false);
+		Files.Sort();
+		FilePath = Files.Num() > 0 ? TelemetryDir / Files.Last() : FString();
+	}
+	else if (FPaths::IsRelative(FilePath))
+	{
+		FilePath = TelemetryDir / FilePath;
+	}
+	const int32 MaxRecords = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 100;
+
+	TArray<uint8> Data;
+	if (FilePath.IsEmpty() || !FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOGFMT(CombatTelemetryLog, Warning, "{0}() Couldn't read combat telemetry file '{1}'", *FString(__FUNCTION__), *FilePath);
+		return;
+	}
+
+	TMap<uint32, FString> Names;
+	TArray<FCombatTelemetryRecord> Records;
+	if (!FCombatTelemetryFile::Read(Data, Names, Records))
+	{
+		UE_LOGFMT(CombatTelemetryLog, Warning, "{0}() {1} isn't a version {2} combat telemetry file", *FString(__FUNCTION__), *FilePath, FCombatTelemetryHeader().Version);
+		return;
+	}
+
+	static const TCHAR* EventNames[] = { TEXT("Damage"), TEXT("Status"), TEXT("PoiseBreak"), TEXT("Death") };
+	static_assert(UE_ARRAY_COUNT(EventNames) == static_cast<int32>(ECombatTelemetryEvent::Max), "Every combat telemetry event needs a name");
+
+	int32 EventCounts[static_cast<int32>(ECombatTelemetryEvent::Max)] = {};
+	int32 StatusProcs[static_cast<int32>(EDamageChannel::Max)] = {};
+	double TotalDamage = 0, TotalMagicDamage = 0, TotalPoiseDamage = 0;
+
+	for (int32 Index = 0; Index < Records.Num(); Index++)
+	{
+		const FCombatTelemetryRecord& Record = Records[Index];
+		if (Record.Event >= ECombatTelemetryEvent::Max) continue;
+
+		EventCounts[static_cast<int32>(Record.Event)]++;
+		FString Detail;
+		if (Record.Event == ECombatTelemetryEvent::Damage)
+		{
+			TotalDamage += Record.Values[0];
+			TotalMagicDamage += Record.Values[1];
+			TotalPoiseDamage += Record.Values[2];
+			Detail = FString::Printf(TEXT("Damage: %.1f, Magic: %.1f, Poise: %.1f, Health: %.1f"), Record.Values[0], Record.Values[1], Record.Values[2], Record.Values[3]);
+		}
+		else if (Record.Event == ECombatTelemetryEvent::Status)
+		{
+			if (Record.Extra && Record.Detail < static_cast<uint8>(EDamageChannel::Max)) StatusProcs[Record.Detail]++;
+			Detail = FString::Printf(TEXT("%s%s: %.1f"), *UEnum::GetValueAsString(static_cast<EDamageChannel>(Record.Detail)), Record.Extra ? TEXT(" (Proc)") : TEXT(""), Record.Values[0]);
+		}
+		else if (Record.Event == ECombatTelemetryEvent::PoiseBreak)
+		{
+			Detail = FString::Printf(TEXT("%s %s, Poise: %.1f"), *UEnum::GetValueAsString(static_cast<EHitStun>(Record.Detail)), *UEnum::GetValueAsString(static_cast<EHitDirection>(Record.Extra)), Record.Values[0]);
+		}
+		else
+		{
+			Detail = FString::Printf(TEXT("Health: %.1f"), Record.Values[0]);
+		}
+
+		if (Index < MaxRecords)
+		{
+			UE_LOGFMT(CombatTelemetryLog, Display, "[{0}] {1}: {2} -> {3}, {4}",
+				Record.Frame, EventNames[static_cast<int32>(Record.Event)], *GetCombatTelemetryName(Names, Record.SourceId), *GetCombatTelemetryName(Names, Record.TargetId), *Detail);
+		}
+	}
+
+	FString Procs;
+	for (int32 Status = 0; Status < static_cast<int32>(EDamageChannel::Max); Status++)
+	{
+		if (StatusProcs[Status]) Procs.Appendf(TEXT("%s(%d) "), *UEnum::GetValueAsString(static_cast<EDamageChannel>(Status)), StatusProcs[Status]);
+	}
+
+	UE_LOGFMT(CombatTelemetryLog, Display, "{0}() {1}: {2} records, {3} hits ({4} damage, {5} magic damage, {6} poise damage), {7} status events, {8} poise breaks, {9} deaths. Procs: {10}",
+		*FString(__FUNCTION__), *FilePath, Records.Num(),
+		EventCounts[static_cast<int32>(ECombatTelemetryEvent::Damage)], TotalDamage, TotalMagicDamage, TotalPoiseDamage,
+		EventCounts[static_cast<int32>(ECombatTelemetryEvent::Status)],
+		EventCounts[static_cast<int32>(ECombatTelemetryEvent::PoiseBreak)],
+		EventCounts[static_cast<int32>(ECombatTelemetryEvent::Death)],
+		Procs.IsEmpty() ? FString(TEXT("None")) : Procs
+	);
+}
+
+static FAutoConsoleCommand CombatTelemetryDecodeCommand(
+	TEXT("Sandbox.CombatTelemetry.Decode"),
+	TEXT("Logs the records and a summary of a combat telemetry file (relative to Saved/Telemetry). Sandbox.CombatTelemetry.Decode [File = Latest] [MaxRecords = 100]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DecodeCombatTelemetry)
+);
+#endif
+#pragma endregion
@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EDamageChannel : uint8;
+enum class EHitDirection : uint8;
+enum class EHitStun : uint8;
+DECLARE_LOG_CATEGORY_EXTERN(CombatTelemetryLog, Log, All);
+
+/** Combat telemetry is compiled into everything except shipping clients, define SANDBOX_COMBAT_TELEMETRY=0 to remove it entirely */
+#ifndef SANDBOX_COMBAT_TELEMETRY
+	#define SANDBOX_COMBAT_TELEMETRY (!UE_BUILD_SHIPPING || UE_SERVER)
+#endif
+
+
+/** The combat events that are recorded */
+enum class ECombatTelemetryEvent : uint8
+{
+	/** Damage: physical damage, magic damage, poise damage, health after the attack */
+	Damage,
+
+	/** Status buildup (Detail: the status channel, Extra: whether it proc'd): the buildup */
+	Status,
+
+	/** Poise break (Detail: the hit stun, Extra: the hit direction): the poise damage */
+	PoiseBreak,
+
+	/** Death: the health after the killing blow */
+	Death,
+
+	Max
+};
+
+
+/**
+ * A single combat event, stored exactly as it's written to the telemetry file. Characters are stored by their id in the file's name table. @ref FCombatTelemetryName
+ */
+struct SANDBOX_API FCombatTelemetryRecord
+{
+	/** The type of event */
+	ECombatTelemetryEvent Event;
+
+	/** Event specific information (status channel / hit stun) */
+	uint8 Detail;
+
+	/** Event specific information (status proc / hit direction) */
+	uint8 Extra;
+
+	uint8 Reserved;
+
+	/** The frame the event happened on */
+	uint32 Frame;
+
+	/** The name table id of the attacker, MAX_uint32 if there wasn't one */
+	uint32 SourceId;
+
+	/** The name table id of the character that was attacked, MAX_uint32 if there wasn't one */
+	uint32 TargetId;
+
+	/** Event specific values */
+	float Values[4];
+
+};
+static_assert(sizeof(FCombatTelemetryRecord) == 32, "Combat telemetry records are written to disk, update the telemetry version if their layout changes");
+
+
+/** An entry of a telemetry file's name table. Every object that's recorded is added once, the first time it's recorded */
+struct SANDBOX_API FCombatTelemetryName
+{
+	/** The id the records refer to the object with */
+	uint32 Id = MAX_uint32;
+
+	/** The object's path name, which stays the same after the game exits */
+	FString Name;
+
+};
+
+
+/** The header at the start of every combat telemetry file */
+struct SANDBOX_API FCombatTelemetryHeader
+{
+	/** Identifies combat telemetry files ('CTEL') */
+	uint32 Magic = 0x4C455443;
+
+	/** The version of the file layout */
+	uint16 Version = 2;
+
+	/** The size of each record */
+	uint16 RecordSize = sizeof(FCombatTelemetryRecord);
+
+};
+
+
+/**
+ * Reads and writes combat telemetry files. Files are a header followed by the blocks of each flush, which don't need the engine to decode (Tools/DecodeCombatTelemetry.py).
+ * Each block is the amount of new names, the names (uint32 id, uint16 utf8 length, utf8 path name), the amount of records and the records. Everything is little endian
+ */
+struct SANDBOX_API FCombatTelemetryFile
+{
+	/**
+	 * Appends a block of records to a telemetry file
+	 *
+	 * @param Ar								The file's archive
+	 * @param Names								The names that haven't been written to the file yet
+	 * @param Records							The records to append
+	 * @param bWriteHeader						Whether this is the start of the file
+	 */
+	static void Write(FArchive& Ar, TConstArrayView<FCombatTelemetryName> Names, TConstArrayView<FCombatTelemetryRecord> Records, bool bWriteHeader);
+
+	/**
+	 * Reads the names and records of a telemetry file. A partially written block at the end of the file is ignored
+	 *
+	 * @param Data								The file's contents
+	 * @param OutNames							The path name of each id in the file
+	 * @param OutRecords						The records in the file
+	 * @returns									False if the file isn't a combat telemetry file of the current version
+	 */
+	static bool Read(TConstArrayView<uint8> Data, TMap<uint32, FString>& OutNames, TArray<FCombatTelemetryRecord>& OutRecords);
+
+};
+
+
+#if SANDBOX_COMBAT_TELEMETRY
+/**
+ * Records combat events as fixed size binary records, instead of formatting log messages during attribute calculations. @ref COMBAT_TELEMETRY \n\n
+ *
+ * Each thread writes to it's own ring buffer without locks, and the buffers are drained on a background task and appended to Saved/Telemetry/Combat_<Time>.ctel.
+ *	- Recording is toggled with Sandbox.CombatTelemetry, records that don't fit in a full buffer are dropped and counted
+ *	- Files are read with FCombatTelemetryFile, Sandbox.CombatTelemetry.Decode logs them in non shipping builds, and Tools/DecodeCombatTelemetry.py decodes them without the engine
+ */
+class SANDBOX_API FCombatTelemetry
+{
+public:
+	/** The amount of records each thread's buffer holds before it drops them */
+	static constexpr uint32 BufferCapacity = 4096;
+
+	/** Records damage that was applied to a character */
+	static void RecordDamage(const UObject* Source, const UObject* Target, float Damage, float MagicDamage, float PoiseDamage, float Health);
+
+	/** Records a character's status buildup, and whether the status proc'd */
+	static void RecordStatus(const UObject* Source, const UObject* Target, EDamageChannel Status, bool bProc, float Buildup);
+
+	/** Records a character's poise breaking */
+	static void RecordPoiseBreak(const UObject* Source, const UObject* Target, EHitStun HitStun, EHitDirection HitDirection, float PoiseDamage);
+
+	/** Records a character's death */
+	static void RecordDeath(const UObject* Source, const UObject* Target, float Health);
+
+	/** Drains every thread's records to the telemetry file. Asynchronous flushes run on a background task, and are skipped if a flush is already running */
+	static void Flush(bool bAsync = true);
+
+	/** Returns the amount of records that were dropped because a buffer was full */
+	static uint32 GetNumDroppedRecords();
+
+	/** Removes the recorded events from every thread's buffer without writing them. Flush uses this before appending the records to the file */
+	static void Drain(TArray<FCombatTelemetryRecord>& OutRecords);
+
+	/** Removes the names of the objects that were recorded for the first time since the last drain. Drain the records first, so every drained record's names are included */
+	static void DrainNames(TArray<FCombatTelemetryName>& OutNames);
+
+	/** Returns the name table id of an object, and adds its name the first time it's recorded */
+	static uint32 GetObjectId(const UObject* Object);
+
+
+protected:
+	/** Adds a record to the current thread's buffer */
+	static void Record(ECombatTelemetryEvent Event, const UObject* Source, const UObject* Target, uint8 Detail, uint8 Extra, float Value0, float Value1 = 0, float Value2 = 0, float Value3 = 0);
+
+};
+
+/** Records a combat event (COMBAT_TELEMETRY(Damage, Source, Target, ...)). The arguments aren't evaluated when telemetry is compiled out */
+#define COMBAT_TELEMETRY(Event, ...) FCombatTelemetry::Record##Event(__VA_ARGS__)
+#else
+#define COMBAT_TELEMETRY(Event, ...) do {} while (0)
+#endif
@@ -0,0 +1,361 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LagCompensationSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Characters/CharacterBase.h"
+
+DEFINE_LOG_CATEGORY(LagCompensationLog);
+
+
+static TAutoConsoleVariable<bool> CVarLagCompensation(
+	TEXT("Sandbox.LagCompensation.Enabled"),
+	true,
+	TEXT("Whether the server rewinds characters to validate client melee hits")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationMaxRewindTime(
+	TEXT("Sandbox.LagCompensation.MaxRewindTime"),
+	0.4f,
+	TEXT("The furthest back in seconds the server rewinds characters. Hits from clients with more latency are validated against the oldest frame")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationMaxHitAge(
+	TEXT("Sandbox.LagCompensation.MaxHitAge"),
+	1.0f,
+	TEXT("The longest in seconds an attack's hits wait on the client before they're sent to the server, which is added to the max rewind time of those hits")
+);
+
+static TAutoConsoleVariable<int32> CVarLagCompensationRecordRate(
+	TEXT("Sandbox.LagCompensation.RecordRate"),
+	0,
+	TEXT("How many frames are recorded each second. 0 uses the net driver's tick rate")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationHitTolerance(
+	TEXT("Sandbox.LagCompensation.HitTolerance"),
+	40.0f,
+	TEXT("How far in cm an impact point can be from the rewound target's capsule")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationMaxReach(
+	TEXT("Sandbox.LagCompensation.MaxReach"),
+	400.0f,
+	TEXT("How far in cm an impact point can be from the rewound attacker's capsule")
+);
+
+/** The most frames a character's history holds */
+static constexpr int32 MaxRewindFrames = 128;
+
+
+#pragma region Rewind History
+float FRewindFrame::GetDistanceTo(const FVector& Point) const
+{
+	const FVector LocalPoint = Transform.InverseTransformPositionNoScale(Point);
+	const float SegmentHalfLength = FMath::Max(HalfHeight - Radius, 0.f);
+	const FVector ClosestPoint(0, 0, FMath::Clamp(LocalPoint.Z, -SegmentHalfLength, SegmentHalfLength));
+	return FMath::Max(FVector::Dist(LocalPoint, ClosestPoint) - Radius, 0.f);
+}
+
+
+FRewindFrame FRewindFrame::Interpolate(const FRewindFrame& From, const FRewindFrame& To, const double Time)
+{
+	const double Duration = To.Time - From.Time;
+	const float Alpha = Duration > UE_KINDA_SMALL_NUMBER ? static_cast<float>(FMath::Clamp((Time - From.Time) / Duration, 0.0, 1.0)) : 1.f;
+
+	FRewindFrame Frame;
+	Frame.Time = Time;
+	Frame.Transform.Blend(From.Transform, To.Transform, Alpha);
+	Frame.Radius = FMath::Lerp(From.Radius, To.Radius, Alpha);
+	Frame.HalfHeight = FMath::Lerp(From.HalfHeight, To.HalfHeight, Alpha);
+	return Frame;
+}
+
+
+FRewindHistory::FRewindHistory(const int32 Capacity) :
+	Head(0),
+	Count(0)
+{
+	Frames.SetNum(FMath::Max(Capacity, 0));
+}
+
+
+void FRewindHistory::Reset(const int32 Capacity)
+{
+	Frames.Reset();
+	Frames.SetNum(FMath::Max(Capacity, 0));
+	Head = 0;
+	Count = 0;
+}
+
+
+void FRewindHistory::Record(const FRewindFrame& Frame)
+{
+	if (Frames.IsEmpty()) return;
+
+	Frames[Head] = Frame;
+	Head = (Head + 1) % Frames.Num();
+	Count = FMath::Min(Count + 1, Frames.Num());
+}
+
+
+const FRewindFrame& FRewindHistory::GetFrame(const int32 Index) const
+{
+	const int32 Oldest = (Head - Count + Frames.Num()) % Frames.Num();
+	return Frames[(Oldest + Index) % Frames.Num()];
+}
+
+
+bool FRewindHistory::Sample(const double Time, FRewindFrame& OutFrame) const
+{
+	if (Count == 0) return false;
+
+	// Times outside of the history use the closest frame
+	if (Time <= GetFrame(0).Time)
+	{
+		OutFrame = GetFrame(0);
+		return true;
+	}
+
+	if (Time >= GetFrame(Count - 1).Time)
+	{
+		OutFrame = GetFrame(Count - 1);
+		return true;
+	}
+
+	// Find the frames that were recorded around the time
+	int32 Low = 0;
+	int32 High = Count - 1;
+	while (High - Low > 1)
+	{
+		const int32 Middle = (Low + High) / 2;
+		if (GetFrame(Middle).Time <= Time) Low = Middle;
+		else High = Middle;
+	}
+
+	OutFrame = FRewindFrame::Interpolate(GetFrame(Low), GetFrame(High), Time);
+	return true;
+}
+#pragma endregion
+
+
+
+
+#pragma region Subsystem
+ULagCompensationSubsystem::ULagCompensationSubsystem()
+{
+	LastRecordTime = -1;
+}
+
+
+ULagCompensationSubsystem* ULagCompensationSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+}
+
+
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	Histories.Empty();
+	Characters.Empty();
+	Super::Deinitialize();
+}
+
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client || Characters.IsEmpty() || !CVarLagCompensation.GetValueOnGameThread()) return;
+
+	const double Time = GetServerWorldTime(World);
+	if (LastRecordTime >= 0 && Time - LastRecordTime < GetRecordInterval()) return;
+
+	LastRecordTime = Time;
+	RecordFrames(Time);
+}
+
+
+void ULagCompensationSubsystem::RegisterCharacter(ACharacterBase* Character)
+{
+	if (!Character || !Character->HasAuthority() || Histories.Contains(TObjectKey<ACharacterBase>(Character))) return;
+
+	Histories.Add(TObjectKey<ACharacterBase>(Character), FRewindHistory(GetHistoryCapacity()));
+	Characters.Add(Character);
+}
+
+
+void ULagCompensationSubsystem::UnregisterCharacter(ACharacterBase* Character)
+{
+	if (Histories.Remove(TObjectKey<ACharacterBase>(Character)))
+	{
+		Characters.RemoveSingleSwap(Character, false);
+	}
+}
+
+
+void ULagCompensationSubsystem::RecordFrames(const double Time)
+{
+	const int32 Capacity = GetHistoryCapacity();
+	for (int32 Index = Characters.Num() - 1; Index >= 0; Index--)
+	{
+		const ACharacterBase* Character = Characters[Index].Get();
+		FRewindHistory* History = Character ? Histories.Find(TObjectKey<ACharacterBase>(Character)) : nullptr;
+		if (!History)
+		{
+			Characters.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		// The record rate or rewind time was adjusted
+		if (History->GetCapacity() != Capacity) History->Reset(Capacity);
+
+		FRewindFrame Frame;
+		if (GetCurrentFrame(Character, Time, Frame))
+		{
+			History->Record(Frame);
+		}
+	}
+
+	// Remove the histories of characters that were destroyed without unregistering
+	if (Histories.Num() != Characters.Num())
+	{
+		for (auto Iterator = Histories.CreateIterator(); Iterator; ++Iterator)
+		{
+			if (!Iterator.Key().ResolveObjectPtr()) Iterator.RemoveCurrent();
+		}
+	}
+}
+
+
+bool ULagCompensationSubsystem::RewindCharacter(const ACharacterBase* Character, const double Time, FRewindFrame& OutFrame) const
+{
+	const FRewindHistory* History = Character ? Histories.Find(TObjectKey<ACharacterBase>(Character)) : nullptr;
+	return History && History->Sample(Time, OutFrame);
+}
+
+
+bool ULagCompensationSubsystem::ValidateHit(const ACharacterBase* Attacker, const ACharacterBase* Target, const FVector& ImpactPoint, const double ClientTime, const float HitAge) const
+{
+	if (!CVarLagCompensation.GetValueOnGameThread()) return true;
+	if (!Attacker || !Target) return false;
+
+	// Hits that waited on the client can be rewound further, by how long they waited
+	const double Time = GetServerWorldTime(this);
+	const double MaxRewindTime = CVarLagCompensationMaxRewindTime.GetValueOnGameThread() + FMath::Clamp(HitAge, 0.f, GetMaxHitAge());
+	const double RewindTime = ClampRewindTime(Time, ClientTime, MaxRewindTime);
+	const float Tolerance = CVarLagCompensationHitTolerance.GetValueOnGameThread();
+
+	// Check the target where the client saw them, and where they are now in case the client is ahead of the server
+	FRewindFrame TargetFrame, CurrentTargetFrame;
+	const bool bRewoundTarget = RewindCharacter(Target, RewindTime, TargetFrame);
+	GetCurrentFrame(Target, Time, CurrentTargetFrame);
+
+	const float TargetDistance = FMath::Min(
+		bRewoundTarget ? TargetFrame.GetDistanceTo(ImpactPoint) : UE_BIG_NUMBER,
+		CurrentTargetFrame.GetDistanceTo(ImpactPoint)
+	);
+
+	// The attacker needs to be within reach of the impact
+	FRewindFrame AttackerFrame;
+	if (!RewindCharacter(Attacker, RewindTime, AttackerFrame)) GetCurrentFrame(Attacker, Time, AttackerFrame);
+	const float AttackerDistance = AttackerFrame.GetDistanceTo(ImpactPoint);
+
+	const bool bValidHit = TargetDistance <= Tolerance && AttackerDistance <= CVarLagCompensationMaxReach.GetValueOnGameThread();
+	if (!bValidHit)
+	{
+		UE_LOGFMT(LagCompensationLog, Warning, "{0}() {1}'s hit on {2} was rejected after rewinding {3} ms. Distance to target: {4}, distance to attacker: {5}",
+			*FString(__FUNCTION__), *GetNameSafe(Attacker), *GetNameSafe(Target), (Time - RewindTime) * 1000.0, TargetDistance, AttackerDistance);
+	}
+
+	return bValidHit;
+}
+#pragma endregion
+
+
+
+
+#pragma region Utility
+double ULagCompensationSubsystem::GetServerWorldTime(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World) return 0;
+
+	const AGameStateBase* GameState = World->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+
+double ULagCompensationSubsystem::GetViewTime(const AActor* Viewer)
+{
+	const APawn* Pawn = Cast<APawn>(Viewer);
+	const APlayerState* PlayerState = Pawn ? Pawn->GetPlayerState() : nullptr;
+	const double HalfRoundTrip = PlayerState ? PlayerState->GetPingInMilliseconds() * 0.0005 : 0;
+	return GetServerWorldTime(Viewer) - HalfRoundTrip;
+}
+
+
+float ULagCompensationSubsystem::GetMaxHitAge()
+{
+	return FMath::Max(CVarLagCompensationMaxHitAge.GetValueOnGameThread(), 0.f);
+}
+
+
+double ULagCompensationSubsystem::ClampRewindTime(const double ServerTime, const double ClientTime, const double MaxRewindTime)
+{
+	return FMath::Clamp(ClientTime, ServerTime - FMath::Max(MaxRewindTime, 0.0), ServerTime);
+}
+
+
+bool ULagCompensationSubsystem::GetCurrentFrame(const ACharacterBase* Character, const double Time, FRewindFrame& OutFrame)
+{
+	const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	if (!Capsule) return false;
+
+	OutFrame.Time = Time;
+	OutFrame.Transform = Capsule->GetComponentTransform();
+	OutFrame.Radius = Capsule->GetScaledCapsuleRadius();
+	OutFrame.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	return true;
+}
+
+
+double ULagCompensationSubsystem::GetRecordInterval() const
+{
+	int32 RecordRate = CVarLagCompensationRecordRate.GetValueOnGameThread();
+	if (RecordRate <= 0)
+	{
+		const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+		RecordRate = NetDriver ? NetDriver->GetNetServerMaxTickRate() : 30;
+	}
+
+	return 1.0 / FMath::Max(RecordRate, 1);
+}
+
+
+int32 ULagCompensationSubsystem::GetHistoryCapacity() const
+{
+	const double MaxRewindTime = CVarLagCompensationMaxRewindTime.GetValueOnGameThread() + GetMaxHitAge();
+	return FMath::Clamp(FMath::CeilToInt(MaxRewindTime / GetRecordInterval()) + 2, 2, MaxRewindFrames);
+}
+#pragma endregion
+
@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class ACharacterBase;
+
+DECLARE_LOG_CATEGORY_EXTERN(LagCompensationLog, Log, All);
+
+
+/**
+ * A character's capsule at a specific time on the server
+ */
+struct SANDBOX_API FRewindFrame
+{
+	/** The server time the frame was recorded at */
+	double Time = 0;
+
+	/** The capsule's transform */
+	FTransform Transform;
+
+	/** The capsule's scaled radius */
+	float Radius = 0;
+
+	/** The capsule's scaled half height */
+	float HalfHeight = 0;
+
+	/** Returns the distance from a point to the surface of the capsule, or 0 if it's inside the capsule */
+	float GetDistanceTo(const FVector& Point) const;
+
+	/** Blends between two frames */
+	static FRewindFrame Interpolate(const FRewindFrame& From, const FRewindFrame& To, double Time);
+
+};
+
+
+/**
+ * A fixed size ring buffer of a character's recent frames. Once it's full the oldest frame is overwritten, so each character's memory doesn't grow
+ */
+struct SANDBOX_API FRewindHistory
+{
+	explicit FRewindHistory(int32 Capacity = 0);
+
+	/** Clears the history and resizes the buffer */
+	void Reset(int32 Capacity);
+
+	/** Adds a frame, and overwrites the oldest frame if the history is full. Frames need to be recorded in order */
+	void Record(const FRewindFrame& Frame);
+
+	/**
+	 * Retrieves the character's capsule at a specific time, and blends between the frames that were recorded around it
+	 *
+	 * @param Time								The server time
+	 * @param OutFrame							The character's capsule at that time. Times outside of the history use the closest frame
+	 * @returns									False if there aren't any frames
+	 */
+	bool Sample(double Time, FRewindFrame& OutFrame) const;
+
+	/** Returns a frame, starting from the oldest frame */
+	const FRewindFrame& GetFrame(int32 Index) const;
+
+	/** Returns the amount of recorded frames */
+	int32 Num() const { return Count; }
+
+	/** Returns the most frames the history holds */
+	int32 GetCapacity() const { return Frames.Num(); }
+
+
+protected:
+	/** The frames, Head is the next frame that's overwritten */
+	TArray<FRewindFrame> Frames;
+	int32 Head;
+	int32 Count;
+
+};
+
+
+/**
+ * Server side lag compensation for melee hits. @ref UAbilityTask_TargetOverlap, @ref FGameplayAbilityTargetData_MeleeHit \n\n
+ *
+ * Records the capsule of every character on the server at the net driver's tick rate, and keeps a short history of each one.
+ * When a client's hit arrives, the target and the attacker are rewound to the time the client saw the hit at, and the hit is validated against the rewound capsules instead of where they are now.
+ *
+ *	- Rewinding samples the recorded frames instead of moving the characters, so there's nothing to restore afterwards and it doesn't cause overlap or physics events
+ *	- Characters register themselves on BeginPlay and unregister on EndPlay
+ *	- Tuned with the Sandbox.LagCompensation console variables
+ */
+UCLASS()
+class SANDBOX_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The history of each registered character */
+	TMap<TObjectKey<ACharacterBase>, FRewindHistory> Histories;
+
+	/** The registered characters */
+	TArray<TWeakObjectPtr<ACharacterBase>> Characters;
+
+	/** The server time of the last recorded frame */
+	double LastRecordTime;
+
+
+public:
+	ULagCompensationSubsystem();
+
+	/** Retrieves the lag compensation subsystem of the world */
+	static ULagCompensationSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Only game worlds record frames */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Clears the histories */
+	virtual void Deinitialize() override;
+
+	/** Records the registered characters when it's time for another frame */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Starts recording a character's history. Only the server records characters */
+	virtual void RegisterCharacter(ACharacterBase* Character);
+
+	/** Stops recording a character's history */
+	virtual void UnregisterCharacter(ACharacterBase* Character);
+
+	/**
+	 * Rewinds a character to a specific server time
+	 *
+	 * @param Character							The character
+	 * @param Time								The server time
+	 * @param OutFrame							The character's capsule at that time
+	 * @returns									False if the character hasn't been recorded
+	 */
+	bool RewindCharacter(const ACharacterBase* Character, double Time, FRewindFrame& OutFrame) const;
+
+	/**
+	 * Checks whether a client's melee hit is valid at the time the client saw it
+	 *
+	 * @param Attacker							The attacking character
+	 * @param Target							The character that was hit
+	 * @param ImpactPoint						Where the client hit the target
+	 * @param ClientTime						The server time the attacking client saw the hit at. @ref GetViewTime
+	 * @param HitAge							How long the hit waited on the client before it was sent, which is added to the max rewind time. Bound it by how long the attack has been active on the server
+	 * @returns									True if the impact was close enough to the rewound target, and within reach of the rewound attacker
+	 */
+	virtual bool ValidateHit(const ACharacterBase* Attacker, const ACharacterBase* Target, const FVector& ImpactPoint, double ClientTime, float HitAge = 0) const;
+
+	/** Returns the longest a hit can wait on the client before it's sent to the server */
+	static float GetMaxHitAge();
+
+	/** Returns the server's world time, or the client's estimate of it */
+	static double GetServerWorldTime(const UObject* WorldContextObject);
+
+	/** Returns the server time of what a client is currently seeing, which is half of their round trip behind the server */
+	static double GetViewTime(const AActor* Viewer);
+
+	/** Returns the time a hit is rewound to. Clients can't rewind further back than the max rewind time, or ahead of the server */
+	static double ClampRewindTime(double ServerTime, double ClientTime, double MaxRewindTime);
+
+	/** Returns the character's current capsule */
+	static bool GetCurrentFrame(const ACharacterBase* Character, double Time, FRewindFrame& OutFrame);
+
+
+protected:
+	/** Records a frame for every registered character, and removes the characters that are no longer valid */
+	virtual void RecordFrames(double Time);
+
+	/** Returns how often frames are recorded, in seconds */
+	virtual double GetRecordInterval() const;
+
+	/** Returns how many frames each character keeps */
+	virtual int32 GetHistoryCapacity() const;
+
+
+};
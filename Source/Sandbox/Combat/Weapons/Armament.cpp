@@ -9,6 +9,8 @@
 #include "Engine/SkeletalMeshSocket.h"
 #include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Combat/CombatComponent.h"
+#include "Sandbox/Combat/ArmamentMontageCatalog.h"
+#include "Sandbox/Data/Structs/AbilityInformation.h"
 #include "Sandbox/Asc/AbilitySystem.h"
 #include "Logging/StructuredLog.h"
 #include "Sandbox/Data/Enums/HitReacts.h"
@@ -26,6 +28,7 @@ AArmament::AArmament()
 	MinNetUpdateFrequency = 33.0f;
 	NetUpdateFrequency = 66.0f;
 	AActor::SetReplicateMovement(true);
+	bPooled = false;
 	
 	/*
 	 * Here's how the collision should be, but this should be created in the subclasses for more adaptability
@@ -185,6 +188,13 @@ void AArmament::OnRep_Item()
 // Once we create the armament, we update the armament's equip slot on the client with an onReplicated function for latent synchronization. i.e. for when people join after it's been created
 void AArmament::OnRep_CreatedArmament()
 {
+	// The armament was returned to the armament pool
+	if (EquipSlot == EEquipSlot::None)
+	{
+		SetActorEnableCollision(false);
+		return;
+	}
+	
 	if (!GetOwner())
 	{
 		// Initial replication happens before the component retrieves the owner, and causes problems.
@@ -241,7 +251,7 @@ void AArmament::RetrieveArmamentInformationOnClient()
 	// We just need the combat information, nothing else really needs to be replicated, and we should already be able to retrieve that from the item information
 	if (!Item.ItemName.IsNone())
 	{
-		SetArmamentInformation(CombatComponent->GetArmamentInformationFromDatabase(Item.ItemName));
+		if (const F_ArmamentInformation* Information = CombatComponent->FindArmamentInformation(Item.ItemName)) SetArmamentInformation(*Information);
 		SetArmamentMontagesFromDB(CombatComponent->GetArmamentMontageTable(), Character->GetCharacterSkeletonMapping());
 		
 		if (!ArmamentInformation.IsValid())
@@ -277,66 +287,26 @@ bool AArmament::IsValidArmanent()
 void AArmament::SetArmamentMontagesFromDB(UDataTable* ArmamentMontageDB, ECharacterSkeletonMapping Link)
 {
 	if (!ArmamentMontageDB || ArmamentInformation.Id.IsNone()) return;
-	
-	const FString RowContext(TEXT("Armament Montage Information Context"));
-	if (const F_Table_ArmamentMontages* Data = ArmamentMontageDB->FindRow<F_Table_ArmamentMontages>(ArmamentInformation.Id, RowContext))
-	{
-		const F_ArmamentMeleeMontages& MeleeMontages = Data->ArmamentMontages.MeleeMontages;
 
-		// Montages
-		Montages.Empty();
-		for (auto &[Name, MontageMap] : Data->ArmamentMontages.Montages)
-		{
-			if (MontageMap.MontageMappings.Contains(Link)) Montages.Add(Name, MontageMap.MontageMappings[Link]);
-		}
-
-		// One hand montages
-		MeleeMontages_OneHand.Empty();
-		for (auto &[AttackPattern, MontageMap] : MeleeMontages.OneHandMontages)
-		{
-			if (MontageMap.Montage.MontageMappings.Contains(Link))
-			{
-				// Attack pattern
-				F_ArmamentComboInformation MeleeMontageInfo;
-				MeleeMontageInfo.Montage = MontageMap.Montage.MontageMappings[Link];
-				MeleeMontageInfo.Combo = MontageMap.Combo;
-				MeleeMontages_OneHand.Add(AttackPattern, MeleeMontageInfo);
-			}
-		}
+	// Reused armaments already have their montages
+	if (MontageSet && MontageSet->Key == FArmamentMontageKey(ArmamentMontageDB, ArmamentInformation.Id, Link)) return;
 
-		// Two hand montages
-		MeleeMontages_TwoHand.Empty();
-		for (auto &[AttackPattern, MontageMap] : MeleeMontages.TwoHandMontages)
-		{
-			if (MontageMap.Montage.MontageMappings.Contains(Link))
-			{
-				// Attack pattern
-				F_ArmamentComboInformation MeleeMontageInfo;
-				MeleeMontageInfo.Montage = MontageMap.Montage.MontageMappings[Link];
-				MeleeMontageInfo.Combo = MontageMap.Combo;
-				MeleeMontages_TwoHand.Add(AttackPattern, MeleeMontageInfo);
-			}
-		}
-		
-		// Dual wielding montages
-		MeleeMontages_DualWield.Empty();
-		for (auto &[AttackPattern, MontageMap] : MeleeMontages.DualWieldMontages)
-		{
-			if (MontageMap.Montage.MontageMappings.Contains(Link))
-			{
-				// Attack pattern
-				F_ArmamentComboInformation MeleeMontageInfo;
-				MeleeMontageInfo.Montage = MontageMap.Montage.MontageMappings[Link];
-				MeleeMontageInfo.Combo = MontageMap.Combo;
-				MeleeMontages_DualWield.Add(AttackPattern, MeleeMontageInfo);
-			}
-		}
-		
+	MontageSet.Reset();
+	if (UArmamentMontageCatalog* MontageCatalog = UArmamentMontageCatalog::Get())
+	{
+		MontageSet = MontageCatalog->FindOrCreateMontageSet(ArmamentMontageDB, ArmamentInformation.Id, Link);
+	}
+	
+	// Armaments that had their montages added to them before the montage table still use them
+	if (!MontageSet)
+	{
+		MontageSet = CreateDeprecatedMontageSet(Link);
 	}
-	else
+	
+	if (!MontageSet)
 	{
 		UE_LOGFMT(ArmamentLog, Error, "{0}::{1}() {2} did not find the armament montages for {3}",
-			*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), ArmamentInformation.Id);
+			*UEnum::GetValueAsString(GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), ArmamentInformation.Id);
 	}
 }
 
@@ -351,14 +321,10 @@ UAnimMontage* AArmament::GetCombatMontage(const EInputAbilities AttackPattern)
 		return nullptr;
 	}
 	
-	const TMap<EInputAbilities, F_ArmamentComboInformation>& CombatMontages = CombatComponent->GetCurrentStance() == EArmamentStance::OneHanding
-		|| CombatComponent->GetCurrentStance() == EArmamentStance::TwoWeapons ? MeleeMontages_OneHand
-		: CombatComponent->GetCurrentStance() == EArmamentStance::DualWielding ? MeleeMontages_DualWield
-		: MeleeMontages_TwoHand;
-	
-	if (CombatMontages.Contains(AttackPattern))
+	const F_ArmamentComboInformation* Attack = MontageSet ? MontageSet->FindAttack(FArmamentMontageSet::GetMontageStance(CombatComponent->GetCurrentStance()), AttackPattern) : nullptr;
+	if (Attack)
 	{
-		return CombatMontages[AttackPattern].Montage;
+		return Attack->Montage;
 	}
 
 	return nullptr;
@@ -375,24 +341,102 @@ const F_ComboAttacks& AArmament::GetComboAttacks(const EInputAbilities AttackPat
 		return DummyMeleeComboInformation;
 	}
 
-	EArmamentStance Stance = CombatComponent->GetCurrentStance();
-	if (Stance == EArmamentStance::OneHanding && MeleeMontages_OneHand.Contains(AttackPattern)) return MeleeMontages_OneHand[AttackPattern].Combo;
-	if (Stance == EArmamentStance::TwoWeapons && MeleeMontages_OneHand.Contains(AttackPattern)) return MeleeMontages_OneHand[AttackPattern].Combo;
-	if (Stance == EArmamentStance::DualWielding && MeleeMontages_DualWield.Contains(AttackPattern)) return MeleeMontages_DualWield[AttackPattern].Combo;
-	if ((Stance == EArmamentStance::TwoHanding_L || Stance == EArmamentStance::TwoHanding_R) && MeleeMontages_TwoHand.Contains(AttackPattern)) return MeleeMontages_TwoHand[AttackPattern].Combo;
+	const F_ArmamentComboInformation* Attack = MontageSet ? MontageSet->FindAttack(FArmamentMontageSet::GetMontageStance(CombatComponent->GetCurrentStance()), AttackPattern) : nullptr;
+	if (Attack) return Attack->Combo;
 	return DummyMeleeComboInformation;
 }
 
 
 UAnimMontage* AArmament::GetMontage(FName Montage)
 {
-	if (Montages.Contains(Montage))
+	const TObjectPtr<UAnimMontage>* SharedMontage = MontageSet ? MontageSet->Montages.Find(Montage) : nullptr;
+	if (SharedMontage)
 	{
-		return Montages[Montage];
+		return *SharedMontage;
 	}
 
 	return nullptr;
 }
+
+
+TMap<FName, UAnimMontage*> AArmament::GetMontages() const
+{
+	TMap<FName, UAnimMontage*> ArmamentMontages;
+	if (MontageSet)
+	{
+		for (const auto& [Name, Montage] : MontageSet->Montages)
+		{
+			ArmamentMontages.Add(Name, Montage);
+		}
+	}
+
+	return ArmamentMontages;
+}
+
+
+TMap<EInputAbilities, F_ArmamentComboInformation> AArmament::GetMeleeMontages_OneHand() const
+{
+	return GetStanceMontages(EArmamentMontageStance::OneHand);
+}
+
+
+TMap<EInputAbilities, F_ArmamentComboInformation> AArmament::GetMeleeMontages_TwoHand() const
+{
+	return GetStanceMontages(EArmamentMontageStance::TwoHand);
+}
+
+
+TMap<EInputAbilities, F_ArmamentComboInformation> AArmament::GetMeleeMontages_DualWield() const
+{
+	return GetStanceMontages(EArmamentMontageStance::DualWield);
+}
+
+
+TMap<EInputAbilities, F_ArmamentComboInformation> AArmament::GetStanceMontages(const EArmamentMontageStance Stance) const
+{
+	TMap<EInputAbilities, F_ArmamentComboInformation> StanceMontages;
+	if (!MontageSet) return StanceMontages;
+
+	const TBitArray<>& ValidAttacks = MontageSet->ValidAttacks[static_cast<int32>(Stance)];
+	for (TConstSetBitIterator<> It(ValidAttacks); It; ++It)
+	{
+		StanceMontages.Add(static_cast<EInputAbilities>(It.GetIndex()), MontageSet->Attacks[static_cast<int32>(Stance)][It.GetIndex()]);
+	}
+
+	return StanceMontages;
+}
+
+
+TSharedPtr<const FArmamentMontageSet> AArmament::CreateDeprecatedMontageSet(const ECharacterSkeletonMapping Link) const
+{
+	if (Montages_DEPRECATED.IsEmpty() && MeleeMontages_OneHand_DEPRECATED.IsEmpty() && MeleeMontages_TwoHand_DEPRECATED.IsEmpty() && MeleeMontages_DualWield_DEPRECATED.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// The armament's own properties keep these montages loaded, so the set isn't added to the montage catalog
+	const TSharedPtr<FArmamentMontageSet> DeprecatedMontageSet = MakeShared<FArmamentMontageSet>(FArmamentMontageKey(nullptr, ArmamentInformation.Id, Link));
+	for (const auto& [Name, Montage] : Montages_DEPRECATED)
+	{
+		DeprecatedMontageSet->Montages.Add(Name, Montage);
+	}
+
+	const int32 NumAttackPatterns = StaticEnum<EInputAbilities>()->GetMaxEnumValue() + 1;
+	const TMap<EInputAbilities, F_ArmamentComboInformation>* StanceMontages[] = { &MeleeMontages_OneHand_DEPRECATED, &MeleeMontages_TwoHand_DEPRECATED, &MeleeMontages_DualWield_DEPRECATED };
+	for (int32 Stance = 0; Stance < static_cast<int32>(EArmamentMontageStance::Max); Stance++)
+	{
+		DeprecatedMontageSet->Attacks[Stance].SetNum(NumAttackPatterns);
+		DeprecatedMontageSet->ValidAttacks[Stance].Init(false, NumAttackPatterns);
+		for (const auto& [AttackPattern, Attack] : *StanceMontages[Stance])
+		{
+			if (!DeprecatedMontageSet->Attacks[Stance].IsValidIndex(static_cast<int32>(AttackPattern))) continue;
+			DeprecatedMontageSet->Attacks[Stance][static_cast<int32>(AttackPattern)] = Attack;
+			DeprecatedMontageSet->ValidAttacks[Stance][static_cast<int32>(AttackPattern)] = true;
+		}
+	}
+
+	return DeprecatedMontageSet;
+}
 #pragma endregion 
 
 
@@ -458,6 +502,43 @@ FName AArmament::GetSheathedSocketName() const
 
 
 
+#pragma region Pooling
+void AArmament::OnAcquiredFromPool(AActor* NewOwner, const FTransform& Transform)
+{
+	bPooled = false;
+	SetNetDormancy(DORM_Awake);
+	SetOwner(NewOwner);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	ForceNetUpdate();
+}
+
+
+void AArmament::OnReleasedToPool()
+{
+	bPooled = true;
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetEquipStatus(EEquipStatus::Unequipped);
+	SetArmamentEquipSlot(EEquipSlot::None);
+	SetOwner(nullptr);
+
+	// The deactivated state is sent to clients before the armament goes dormant
+	SetNetDormancy(DORM_DormantAll);
+}
+
+
+bool AArmament::IsPooled() const
+{
+	return bPooled;
+}
+#pragma endregion 
+
+
+
+
 #pragma region Utility
 const F_ArmamentInformation& AArmament::GetArmamentInformation() const
 {
@@ -7,6 +7,7 @@
 #include "Sandbox/World/Props/Items/Item.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "ActiveGameplayEffectHandle.h"
+#include "UObject/ObjectKey.h"
 #include "Sandbox/Data/Structs/CombatInformation.h"
 #include "Armament.generated.h"
 
@@ -19,6 +20,8 @@ class UCombatComponent;
 class UGameplayEffect;
 struct F_ArmamentAbilityInformation;
 struct FGameplayEffectInfo;
+struct FArmamentMontageSet;
+enum class EArmamentMontageStance : uint8;
 enum class EEquipSlot : uint8;
 enum class EEquipStatus : uint8;
 enum class ECharacterSkeletonMapping : uint8;
@@ -154,17 +157,14 @@ protected:
 	/** The ranged montages for the armament */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Armament") TMap<EInputAbilities, UAnimMontage*> RangedMontages;
 
-	/** The one handing melee montages for the armament */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Armament") TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_OneHand;
+	/** The montages of the armament for the character's skeleton, shared by every armament that uses them */
+	TSharedPtr<const FArmamentMontageSet> MontageSet;
 
-	/** The two handing melee montages for the armament */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Armament") TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_TwoHand;
-	
-	/** The dual wielding melee montages for the armament */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Armament") TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_DualWield;
-	
-	/** The montages for the armament */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Armament") TMap<FName, UAnimMontage*> Montages;
+	/** Montages that were added to the armament before they were shared through the montage catalog. These are only used if the montage table doesn't have the armament */
+	UPROPERTY() TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_OneHand_DEPRECATED;
+	UPROPERTY() TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_TwoHand_DEPRECATED;
+	UPROPERTY() TMap<EInputAbilities, F_ArmamentComboInformation> MeleeMontages_DualWield_DEPRECATED;
+	UPROPERTY() TMap<FName, UAnimMontage*> Montages_DEPRECATED;
 
 	
 private:
@@ -175,7 +175,7 @@ private:
 public:
 	// TODO: Refactor because this is specific to melee armaments, or create functions to differentiate
 	/**
-	 * Retrieves the armament montages from the armament montage database, and adds them to the armament. If you need to retrieve a montage, use one of the get functions
+	 * Retrieves the armament's shared montages from the armament montage catalog. If you need to retrieve a montage, use one of the get functions
 	 *
 	 * @param ArmamentMontageDB					The data table that contains the armament montages
 	 * @param Link								The character skeleton to montage mapping reference  
@@ -192,6 +192,26 @@ public:
 	/** Retrieves one of the armament's montages */
 	UFUNCTION(BlueprintCallable, Category = "Armament|Montages") virtual UAnimMontage* GetMontage(FName Montage);
 
+	/** Retrieves the armament's montages */
+	UFUNCTION(BlueprintPure, Category = "Armament|Montages") TMap<FName, UAnimMontage*> GetMontages() const;
+
+	/** Retrieves the one handing melee montages for the armament */
+	UFUNCTION(BlueprintPure, Category = "Armament|Montages") TMap<EInputAbilities, F_ArmamentComboInformation> GetMeleeMontages_OneHand() const;
+
+	/** Retrieves the two handing melee montages for the armament */
+	UFUNCTION(BlueprintPure, Category = "Armament|Montages") TMap<EInputAbilities, F_ArmamentComboInformation> GetMeleeMontages_TwoHand() const;
+
+	/** Retrieves the dual wielding melee montages for the armament */
+	UFUNCTION(BlueprintPure, Category = "Armament|Montages") TMap<EInputAbilities, F_ArmamentComboInformation> GetMeleeMontages_DualWield() const;
+
+
+protected:
+	/** Returns one stance's attacks from the armament's montage set */
+	TMap<EInputAbilities, F_ArmamentComboInformation> GetStanceMontages(EArmamentMontageStance Stance) const;
+
+	/** Creates a montage set from the montages that were added to the armament before the montage catalog, for armaments that aren't in the montage table */
+	virtual TSharedPtr<const FArmamentMontageSet> CreateDeprecatedMontageSet(ECharacterSkeletonMapping Link) const;
+
 	
 //-------------------------------------------------------------------------------------//
 // Armament equipping and unequipping												   //
@@ -215,6 +235,30 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Combat Component|Equipping") virtual FName GetSheathedSocketName() const;
 
 	
+//-------------------------------------------------------------------------------------//
+// Pooling																			   //
+//-------------------------------------------------------------------------------------//
+protected:
+	/** Whether the armament is deactivated in the armament pool */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Armament|Pooling") bool bPooled;
+	
+
+public:
+	/**
+	 * Reactivates a pooled armament for the character that's equipping it. @ref UArmamentPoolSubsystem
+	 *
+	 * @param NewOwner							The character that's equipping the armament
+	 * @param Transform							Where the armament is placed
+	 */
+	virtual void OnAcquiredFromPool(AActor* NewOwner, const FTransform& Transform);
+
+	/** Deactivates the armament once it's been returned to the pool. It's armament information and montages are kept for when it's reused */
+	virtual void OnReleasedToPool();
+
+	/** Returns whether the armament is deactivated in the armament pool */
+	UFUNCTION(BlueprintCallable, Category = "Armament|Pooling") virtual bool IsPooled() const;
+
+	
 //-------------------------------------------------------------------------------------//
 // Utility																			   //
 //-------------------------------------------------------------------------------------//
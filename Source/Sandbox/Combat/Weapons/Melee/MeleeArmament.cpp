@@ -11,6 +11,7 @@
 #include "Sandbox/World/Props/CharacterAttachment.h"
 #include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Combat/CombatComponent.h"
+#include "Sandbox/Combat/ArmamentMontageCatalog.h"
 #include "Logging/StructuredLog.h"
 #include "Net/UnrealNetwork.h"
 
@@ -180,7 +181,7 @@ bool AMeleeArmament::IsValidArmanent()
 	// }
 
 	// Check if montages are valid for this specific valid
-	if (MeleeMontages_OneHand.IsEmpty() && MeleeMontages_TwoHand.IsEmpty() && MeleeMontages_DualWield.IsEmpty() && Montages.IsEmpty())
+	if (!MontageSet || MontageSet->IsEmpty())
 	{
 		UE_LOGFMT(ArmamentLog, Error, "{0}::{1}() {2}'s {3} montages are invalid!",
 			*UEnum::GetValueAsString(GetOwner()->GetLocalRole()), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), *Item.DisplayName);
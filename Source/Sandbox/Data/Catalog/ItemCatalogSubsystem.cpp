@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Sandbox/Data/Catalog/ItemCatalogSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Logging/StructuredLog.h"
+
+DEFINE_LOG_CATEGORY(ItemCatalogLog);
+
+
+void UItemCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (const TSoftObjectPtr<UDataTable>& Table : PreloadedItemTables) GetItemCatalog(Table.LoadSynchronous());
+	for (const TSoftObjectPtr<UDataTable>& Table : PreloadedArmamentTables) GetArmamentCatalog(Table.LoadSynchronous());
+	for (const TSoftObjectPtr<UDataTable>& Table : PreloadedArmorTables) GetArmorCatalog(Table.LoadSynchronous());
+}
+
+
+void UItemCatalogSubsystem::Deinitialize()
+{
+	ItemCatalogs.Empty();
+	ArmamentCatalogs.Empty();
+	ArmorCatalogs.Empty();
+	Super::Deinitialize();
+}
+
+
+UItemCatalogSubsystem* UItemCatalogSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UItemCatalogSubsystem>() : nullptr;
+}
+
+
+TSharedPtr<const FItemCatalog> UItemCatalogSubsystem::GetItemCatalog(const UDataTable* DataTable)
+{
+	return FindOrCreateCatalog(ItemCatalogs, DataTable, &FInventory_ItemDatabase::ItemInformation);
+}
+
+
+TSharedPtr<const FArmamentCatalog> UItemCatalogSubsystem::GetArmamentCatalog(const UDataTable* DataTable)
+{
+	return FindOrCreateCatalog(ArmamentCatalogs, DataTable, &F_Table_ArmamentInformation::ArmamentInformation);
+}
+
+
+TSharedPtr<const FArmorCatalog> UItemCatalogSubsystem::GetArmorCatalog(const UDataTable* DataTable)
+{
+	return FindOrCreateCatalog(ArmorCatalogs, DataTable, &F_Table_Armors::ArmorInformation);
+}
+
+
+template<typename CatalogType, typename RowType, typename ValueType>
+TSharedPtr<const CatalogType> UItemCatalogSubsystem::FindOrCreateCatalog(TMap<TObjectKey<UDataTable>, TSharedPtr<const CatalogType>>& Catalogs, const UDataTable* DataTable, ValueType RowType::* RowMember)
+{
+	check(IsInGameThread());
+	if (!DataTable) return nullptr;
+
+	const TObjectKey<UDataTable> Key(DataTable);
+	if (const TSharedPtr<const CatalogType>* Catalog = Catalogs.Find(Key))
+	{
+		return *Catalog;
+	}
+
+	if (!DataTable->GetRowStruct() || !DataTable->GetRowStruct()->IsChildOf(RowType::StaticStruct()))
+	{
+		UE_LOGFMT(ItemCatalogLog, Error, "{0}() {1} doesn't use {2} rows, it can't be cataloged!", *FString(__FUNCTION__), *GetNameSafe(DataTable), *RowType::StaticStruct()->GetName());
+		return nullptr;
+	}
+
+	ObserveDataTable(DataTable);
+	TSharedPtr<const CatalogType> Catalog = MakeShared<CatalogType>(DataTable, RowMember);
+	Catalogs.Add(Key, Catalog);
+	return Catalog;
+}
+
+
+void UItemCatalogSubsystem::ObserveDataTable(const UDataTable* DataTable)
+{
+#if WITH_EDITOR
+	const TObjectKey<UDataTable> Key(DataTable);
+	if (ObservedTables.Contains(Key)) return;
+	ObservedTables.Add(Key);
+
+	const TWeakObjectPtr<UItemCatalogSubsystem> WeakThis(this);
+	const_cast<UDataTable*>(DataTable)->OnDataTableChanged().AddLambda([WeakThis, Key]()
+	{
+		if (UItemCatalogSubsystem* Subsystem = WeakThis.Get())
+		{
+			Subsystem->ItemCatalogs.Remove(Key);
+			Subsystem->ArmamentCatalogs.Remove(Key);
+			Subsystem->ArmorCatalogs.Remove(Key);
+		}
+	});
+#endif
+}
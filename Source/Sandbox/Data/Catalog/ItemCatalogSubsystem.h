@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Sandbox/Data/Structs/ArmorInformation.h"
+#include "Sandbox/Data/Structs/CombatInformation.h"
+#include "Sandbox/Data/Structs/InventoryInformation.h"
+#include "ItemCatalogSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(ItemCatalogLog, Log, All);
+
+
+/**
+ * An immutable, contiguous copy of one of a data table's row properties, that's addressed by row index. @ref UItemCatalogSubsystem \n\n
+ *
+ * Lookups return const references into the catalog instead of copying the row, and the row index can be stored as a compact handle for retrieving the information later without another lookup.
+ * Row indexes and references are only valid for the catalog they came from, edited tables are cataloged again with a different row order
+ * Catalogs are created and shared by the catalog subsystem, and should only be used on the game thread
+ */
+template<typename ValueType>
+class TItemCatalog
+{
+public:
+	/**
+	 * Creates the catalog from a data table
+	 *
+	 * @param DataTable					The data table
+	 * @param RowMember					The property of the row struct that's stored in the catalog
+	 */
+	template<typename RowType>
+	TItemCatalog(const UDataTable* DataTable, ValueType RowType::* RowMember) :
+		DataTable(DataTable)
+	{
+		if (!DataTable || !DataTable->GetRowStruct() || !DataTable->GetRowStruct()->IsChildOf(RowType::StaticStruct())) return;
+
+		const TMap<FName, uint8*>& RowMap = DataTable->GetRowMap();
+		Values.Reserve(RowMap.Num());
+		RowNames.Reserve(RowMap.Num());
+		RowIndexes.Reserve(RowMap.Num());
+		for (const auto& [RowName, RowData] : RowMap)
+		{
+			if (!RowData) continue;
+			RowIndexes.Add(RowName, Values.Add(reinterpret_cast<const RowType*>(RowData)->*RowMember));
+			RowNames.Add(RowName);
+		}
+	}
+
+	/** Returns the row index of an entry, or INDEX_NONE if it isn't in the data table */
+	int32 FindRowIndex(const FName RowName) const
+	{
+		const int32* RowIndex = RowIndexes.Find(RowName);
+		return RowIndex ? *RowIndex : INDEX_NONE;
+	}
+
+	/** Returns an entry by it's row index, or nullptr if the row index isn't valid */
+	const ValueType* Get(const int32 RowIndex) const
+	{
+		return Values.IsValidIndex(RowIndex) ? &Values[RowIndex] : nullptr;
+	}
+
+	/** Returns an entry by it's row name, or nullptr if it isn't in the data table */
+	const ValueType* Find(const FName RowName) const
+	{
+		return Get(FindRowIndex(RowName));
+	}
+
+	/** Returns the row name of an entry */
+	FName GetRowName(const int32 RowIndex) const
+	{
+		return RowNames.IsValidIndex(RowIndex) ? RowNames[RowIndex] : NAME_None;
+	}
+
+	/** Returns the amount of entries in the catalog */
+	int32 Num() const
+	{
+		return Values.Num();
+	}
+
+	/** Returns whether this catalog was created from a specific data table */
+	bool IsCatalogOf(const UDataTable* InDataTable) const
+	{
+		return DataTable == TObjectKey<UDataTable>(InDataTable);
+	}
+
+
+protected:
+	/** The data table this was created from */
+	TObjectKey<UDataTable> DataTable;
+
+	/** The entries, in the same order as the data table's rows */
+	TArray<ValueType> Values;
+
+	/** The row name of each entry */
+	TArray<FName> RowNames;
+
+	/** The row index of each entry */
+	TMap<FName, int32> RowIndexes;
+
+
+};
+
+/** Item database catalog (@ref FInventory_ItemDatabase) */
+using FItemCatalog = TItemCatalog<F_Item>;
+
+/** Armament information catalog (@ref F_Table_ArmamentInformation) */
+using FArmamentCatalog = TItemCatalog<F_ArmamentInformation>;
+
+/** Armor information catalog (@ref F_Table_Armors) */
+using FArmorCatalog = TItemCatalog<F_Information_Armor>;
+
+
+/**
+ * Process wide catalog of the item, armament, and armor data tables. @ref UInventoryComponent, @ref UCombatComponent \n\n
+ *
+ * Each data table is copied into an immutable catalog the first time it's retrieved (or during startup for the tables in PreloadedTables), and the catalog is shared by everything that uses that table.
+ * This replaces FindRow() and the row copy for every pickup, equip, and saved item that's loaded.
+ *	- Catalogs are removed when their data table is edited in the editor, and are rebuilt the next time they're retrieved
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UItemCatalogSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** Item databases that are cataloged during startup */
+	UPROPERTY(Config, EditAnywhere, Category = "Catalog") TArray<TSoftObjectPtr<UDataTable>> PreloadedItemTables;
+
+	/** Armament information tables that are cataloged during startup */
+	UPROPERTY(Config, EditAnywhere, Category = "Catalog") TArray<TSoftObjectPtr<UDataTable>> PreloadedArmamentTables;
+
+	/** Armor information tables that are cataloged during startup */
+	UPROPERTY(Config, EditAnywhere, Category = "Catalog") TArray<TSoftObjectPtr<UDataTable>> PreloadedArmorTables;
+
+	/** The catalog of each data table */
+	TMap<TObjectKey<UDataTable>, TSharedPtr<const FItemCatalog>> ItemCatalogs;
+	TMap<TObjectKey<UDataTable>, TSharedPtr<const FArmamentCatalog>> ArmamentCatalogs;
+	TMap<TObjectKey<UDataTable>, TSharedPtr<const FArmorCatalog>> ArmorCatalogs;
+
+#if WITH_EDITOR
+	/** The data tables that remove their catalogs when they're edited */
+	TSet<TObjectKey<UDataTable>> ObservedTables;
+#endif
+
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Returns the catalog subsystem */
+	static UItemCatalogSubsystem* Get();
+
+	/** Returns the catalog of an item database (@ref FInventory_ItemDatabase), or an invalid pointer if the table isn't valid */
+	TSharedPtr<const FItemCatalog> GetItemCatalog(const UDataTable* DataTable);
+
+	/** Returns the catalog of an armament information table (@ref F_Table_ArmamentInformation), or an invalid pointer if the table isn't valid */
+	TSharedPtr<const FArmamentCatalog> GetArmamentCatalog(const UDataTable* DataTable);
+
+	/** Returns the catalog of an armor information table (@ref F_Table_Armors), or an invalid pointer if the table isn't valid */
+	TSharedPtr<const FArmorCatalog> GetArmorCatalog(const UDataTable* DataTable);
+
+
+protected:
+	/** Retrieves or creates the catalog of a data table */
+	template<typename CatalogType, typename RowType, typename ValueType>
+	TSharedPtr<const CatalogType> FindOrCreateCatalog(TMap<TObjectKey<UDataTable>, TSharedPtr<const CatalogType>>& Catalogs, const UDataTable* DataTable, ValueType RowType::* RowMember);
+
+	/** Removes the catalogs of a data table once it's been edited */
+	void ObserveDataTable(const UDataTable* DataTable);
+
+
+};
@@ -66,6 +66,34 @@ enum class ECombatAttribute : uint8
 };
 
 
+/**
+ * The damage and status channels of an attack, in the order they're laid out in an attack payload. @ref FAttackPayload
+ */
+UENUM(BlueprintType)
+enum class EDamageChannel : uint8
+{
+	Standard,
+	Slash,
+	Pierce,
+	Strike,
+	Magic,
+	Ice,
+	Fire,
+	Holy,
+	Lightning,
+
+	Curse,
+	Bleed,
+	Poison,
+	Frostbite,
+	Madness,
+	Sleep,
+
+	Poise,
+	Max							UMETA(Hidden)
+};
+
+
 /**
  *	A list of the attributes as an enum type 
  */
@@ -59,3 +59,30 @@ enum class ESaveIdType : uint8
 	
 	MAX					UMETA(DisplayName = "MAX")
 };
+
+
+
+
+/**
+ *	What kind of information a save slot stores. Used by the save manifest for tracking every slot of a save index
+ */
+UENUM(BlueprintType)
+enum class ESaveSlotType : uint8
+{
+	/** The save slot hasn't been classified */
+	None				UMETA(DisplayName = "None"),
+
+	/** The base save information (USave) of a save index */
+	Save				UMETA(DisplayName = "Save"),
+
+	/** A level's save information (USaved_Level) */
+	Level				UMETA(DisplayName = "Level"),
+
+	/** A player's save information, saved by the player's save components */
+	Player				UMETA(DisplayName = "Player"),
+
+	/** An actor's save information that's specific to a level */
+	Actor				UMETA(DisplayName = "Actor"),
+
+	MAX					UMETA(DisplayName = "MAX")
+};
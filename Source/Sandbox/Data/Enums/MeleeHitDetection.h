@@ -0,0 +1,19 @@
+#pragma once		
+
+
+#include "CoreMinimal.h"
+#include "MeleeHitDetection.generated.h"
+
+
+/**
+ *	How melee attacks detect targets during attack frames
+ */
+UENUM(BlueprintType)
+enum class EMeleeHitDetection : uint8
+{
+	/** Listens for the armament hitboxes' begin overlap events. Fast swings on low tick rates can pass through targets without overlapping them */
+	Overlap					UMETA(DisplayName = "Overlap"),
+	
+	/** Sweeps the armament hitboxes from their previous pose to their current pose every frame, with sub steps in between */
+	Sweep					UMETA(DisplayName = "Sweep")
+};
@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SignificanceTypes.generated.h"
+
+
+/**
+ *	How significant an npc character is to the players, which determines how often it's ticked, animated, moved and perceives it's surroundings. @ref UNpcSignificanceSubsystem
+ */
+UENUM(BlueprintType)
+enum class ENpcSignificance : uint8
+{
+	Critical						UMETA(DisplayName = "Critical"), // In combat, or right next to a player. Updates every frame
+	High							UMETA(DisplayName = "High"), // Visible and close to a player
+	Medium							UMETA(DisplayName = "Medium"), // Visible and far away, or close but not visible
+	Low								UMETA(DisplayName = "Low"), // Far away and not visible
+	Max								UMETA(Hidden)
+};
@@ -73,6 +73,7 @@ bool UEquipmentData::AddToCharacter(ACharacterBase* Character, FText* ErrorText)
 	CombatComponent->AddArmamentToEquipSlot(RightHandArmament_SlotOne, EEquipSlot::RightHandSlotOne);
 	CombatComponent->AddArmamentToEquipSlot(RightHandArmament_SlotTwo, EEquipSlot::RightHandSlotTwo);
 	CombatComponent->AddArmamentToEquipSlot(RightHandArmament_SlotThree, EEquipSlot::RightHandSlotThree);
+	CombatComponent->PrewarmArmaments();
 	
 	if (EquippedLeftHandArmament != EEquipSlot::None)
 	{
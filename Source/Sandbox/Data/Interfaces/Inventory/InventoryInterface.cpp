@@ -103,9 +103,9 @@ bool IInventoryInterface::GetDataBaseItem_Implementation(FName Id, F_Item& Item)
 	return false;
 }
 
-F_Item* IInventoryInterface::CreateInventoryObject() const
+F_Item IInventoryInterface::CreateInventoryObject() const
 {
-	return new F_Item();
+	return F_Item();
 }
 
 TScriptInterface<IInventoryItemInterface> IInventoryInterface::SpawnWorldItem_Implementation(const F_Item& Item, const FTransform& Location)
@@ -331,7 +331,7 @@ protected:
 	 * 
 	 * @remarks If you want to subclass the Item object, use this function. And if you create any Items, do it with this function
 	 */
-	virtual F_Item* CreateInventoryObject() const;
+	virtual F_Item CreateInventoryObject() const;
 	
 	/**
 	 * Spawns an inventory item in the world
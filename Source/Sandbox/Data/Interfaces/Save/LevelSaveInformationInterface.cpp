@@ -3,6 +3,8 @@
 
 #include "LevelSaveInformationInterface.h"
 
+#include "Sandbox/Game/GameModeSaveLogic.h"
+
 F_LevelSaveInformation_Actor ILevelSaveInformationInterface::SaveToLevel_Implementation()
 {
 	return F_LevelSaveInformation_Actor();
@@ -24,3 +26,26 @@ FString ILevelSaveInformationInterface::GetActorLevelId_Implementation() const
 {
 	return FString();
 }
+
+
+void ILevelSaveInformationInterface::MarkLevelSaveDirty(AActor* Actor)
+{
+	if (!Actor || !Actor->HasAuthority() || !Actor->GetWorld()) return;
+	
+	if (AGameModeSaveLogic* GameMode = Actor->GetWorld()->GetAuthGameMode<AGameModeSaveLogic>())
+	{
+		GameMode->MarkActorDirty(Actor);
+	}
+}
+
+
+void ILevelSaveInformationInterface::MarkLevelSaveRemoved(AActor* Actor)
+{
+	if (!Actor || !Actor->HasAuthority() || !Actor->GetWorld()) return;
+	if (!Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass())) return;
+	
+	if (AGameModeSaveLogic* GameMode = Actor->GetWorld()->GetAuthGameMode<AGameModeSaveLogic>())
+	{
+		GameMode->MarkActorRemoved(Execute_GetActorLevelId(Actor));
+	}
+}
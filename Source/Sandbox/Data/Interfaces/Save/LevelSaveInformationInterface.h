@@ -127,5 +127,21 @@ public:
 	FString GetActorLevelId() const;
 	virtual FString GetActorLevelId_Implementation() const;
 
+
+public:
+	/**
+	 * Marks the actor's level save information as changed. Level saves and autosaves only capture the actors that have been marked dirty, so call this on the server whenever something that's saved with SaveToLevel() changes
+	 *
+	 * @param Actor						The actor that implements the level save interface
+	 */
+	static void MarkLevelSaveDirty(AActor* Actor);
+
+	/**
+	 * Removes the actor's save information from the level during the next level save. Used for spawned actors that have been destroyed
+	 *
+	 * @param Actor						The actor that implements the level save interface
+	 */
+	static void MarkLevelSaveRemoved(AActor* Actor);
+
 	
 };
@@ -0,0 +1,564 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CompactSaveArchive.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/Compression.h"
+#include "Sandbox/Data/Enums/ESaveType.h"
+#include "Sandbox/Data/Save/World/Saved_Level.h"
+#include "Sandbox/Data/Structs/InventoryInformation.h"
+#include "Sandbox/Data/Structs/LevelSaveInformation.h"
+#include "Sandbox/Game/Saving/SavePipeline.h"
+
+DEFINE_LOG_CATEGORY(CompactSaveLog);
+
+
+static TAutoConsoleVariable<bool> CVarCompactSaveFormat(
+	TEXT("Sandbox.Save.CompactFormat"),
+	true,
+	TEXT("Whether save games write their large containers in the compact save format. Saves in either format can always be loaded")
+);
+
+static TAutoConsoleVariable<int32> CVarCompactSaveCompression(
+	TEXT("Sandbox.Save.CompactCompression"),
+	0,
+	TEXT("Compression of the compact save block. 0: None (the save pipeline compresses the whole slot), 1: Oodle, 2: LZ4")
+);
+
+
+/** Header of the compact block that's written after the tagged properties */
+namespace CompactSaveFormat
+{
+	static constexpr uint32 Magic = 0x43584253; // "SBXC"
+
+	/** The largest block that's decompressed, anything bigger is treated as a corrupt header */
+	static constexpr int32 MaxUncompressedSize = 256 * 1024 * 1024;
+
+	/** How many times larger than its compressed data a block can be */
+	static constexpr int64 MaxCompressionRatio = 1024;
+
+	enum ECompression : uint8
+	{
+		None = 0,
+		Oodle = 1,
+		LZ4 = 2
+	};
+
+	static FName GetCompressionFormat(const uint8 Compression)
+	{
+		if (Compression == Oodle) return NAME_Oodle;
+		if (Compression == LZ4) return NAME_LZ4;
+		return NAME_None;
+	}
+
+	/** Flags of a level actor's save information */
+	enum EActorFlags : uint8
+	{
+		SaveAttributes = 1 << 0,
+		SaveInventory = 1 << 1,
+		SaveCombat = 1 << 2,
+		SameId = 1 << 3
+	};
+}
+
+
+#pragma region Writer
+void FCompactSaveWriter::WritePacked(uint64 Value)
+{
+	do
+	{
+		uint8 Byte = Value & 0x7F;
+		Value >>= 7;
+		if (Value) Byte |= 0x80;
+		Payload.Add(Byte);
+	}
+	while (Value);
+}
+
+
+void FCompactSaveWriter::WriteSignedPacked(const int64 Value)
+{
+	// Zigzag encoding keeps small negative values small
+	WritePacked((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+}
+
+
+void FCompactSaveWriter::WriteByte(const uint8 Value)
+{
+	Payload.Add(Value);
+}
+
+
+void FCompactSaveWriter::WriteString(const FString& Value)
+{
+	const FTCHARToUTF8 Converter(*Value, Value.Len());
+	WritePacked(Converter.Length());
+	Payload.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+
+void FCompactSaveWriter::WriteName(const FString& Value)
+{
+	int32 Index;
+	if (const int32* NameIndex = NameIndexes.Find(Value)) Index = *NameIndex;
+	else Index = NameIndexes.Add(Value, Names.Add(Value));
+	WritePacked(Index);
+}
+
+
+void FCompactSaveWriter::WriteGuid(const FGuid& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteByte(0);
+		return;
+	}
+
+	WriteByte(1);
+	for (int32 Component = 0; Component < 4; Component++)
+	{
+		const uint32 Bits = Value[Component];
+		for (int32 Shift = 0; Shift < 32; Shift += 8) Payload.Add(static_cast<uint8>(Bits >> Shift));
+	}
+}
+
+
+void FCompactSaveWriter::WriteId(const FString& Value)
+{
+	// Spawned actors and items use guids for their ids
+	FGuid Guid;
+	if (FGuid::ParseExact(Value, EGuidFormats::Digits, Guid) && Guid.IsValid() && Guid.ToString(EGuidFormats::Digits) == Value)
+	{
+		WriteGuid(Guid);
+		return;
+	}
+
+	WriteByte(0);
+	WriteString(Value);
+}
+
+
+void FCompactSaveWriter::WriteLocation(const FVector& Value)
+{
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		const int64 Quantized = FMath::RoundToInt64(Value[Axis] * 100.0);
+		WriteSignedPacked(Quantized - PreviousLocation[Axis]);
+		PreviousLocation[Axis] = Quantized;
+	}
+}
+
+
+void FCompactSaveWriter::WriteRotation(const FRotator& Value)
+{
+	for (const double Axis : { Value.Pitch, Value.Yaw, Value.Roll })
+	{
+		const uint16 Compressed = FRotator::CompressAxisToShort(Axis);
+		Payload.Add(static_cast<uint8>(Compressed));
+		Payload.Add(static_cast<uint8>(Compressed >> 8));
+	}
+}
+
+
+void FCompactSaveWriter::Finish(FArchive& Ar)
+{
+	// The name table is written before the payload
+	FCompactSaveWriter Table;
+	Table.WritePacked(Names.Num());
+	for (const FString& Name : Names) Table.WriteString(Name);
+	TArray<uint8> Body = MoveTemp(Table.Payload);
+	Body.Append(Payload);
+
+	// Optionally compress the block, it's stored uncompressed if compression doesn't help
+	uint8 Compression = static_cast<uint8>(FMath::Clamp(CVarCompactSaveCompression.GetValueOnAnyThread(), 0, 2));
+	int32 UncompressedSize = Body.Num();
+	if (Compression != CompactSaveFormat::None)
+	{
+		const FName Format = CompactSaveFormat::GetCompressionFormat(Compression);
+		int32 CompressedSize = FCompression::CompressMemoryBound(Format, UncompressedSize);
+		TArray<uint8> CompressedBody;
+		CompressedBody.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(Format, CompressedBody.GetData(), CompressedSize, Body.GetData(), UncompressedSize) && CompressedSize < UncompressedSize)
+		{
+			CompressedBody.SetNum(CompressedSize);
+			Body = MoveTemp(CompressedBody);
+		}
+		else
+		{
+			Compression = CompactSaveFormat::None;
+		}
+	}
+
+	uint32 Magic = CompactSaveFormat::Magic;
+	int32 Version = ECompactSaveVersion::Latest;
+	Ar << Magic;
+	Ar << Version;
+	Ar << Compression;
+	Ar << UncompressedSize;
+	Ar << Body;
+}
+#pragma endregion
+
+
+
+
+#pragma region Reader
+bool FCompactSaveReader::Begin(FArchive& Ar)
+{
+	Version = ECompactSaveVersion::Legacy;
+	if (!Ar.IsLoading() || Ar.AtEnd()) return false;
+
+	// Legacy saves end after their tagged properties
+	const int64 Start = Ar.Tell();
+	uint32 Magic = 0;
+	Ar << Magic;
+	if (Magic != CompactSaveFormat::Magic)
+	{
+		Ar.Seek(Start);
+		return false;
+	}
+
+	uint8 Compression = CompactSaveFormat::None;
+	int32 UncompressedSize = 0;
+	TArray<uint8> Body;
+	Ar << Version;
+	Ar << Compression;
+	Ar << UncompressedSize;
+	Ar << Body;
+	if (Ar.IsError() || Version > ECompactSaveVersion::Latest || UncompressedSize < 0)
+	{
+		UE_LOGFMT(CompactSaveLog, Error, "{0}() Failed to read the compact save block, version: {1}, latest version: {2}", *FString(__FUNCTION__), Version, static_cast<int32>(ECompactSaveVersion::Latest));
+		bError = true;
+		return false;
+	}
+
+	if (Compression != CompactSaveFormat::None)
+	{
+		// Don't trust the size from the header of a corrupt save
+		if (UncompressedSize > CompactSaveFormat::MaxUncompressedSize || UncompressedSize > Body.Num() * CompactSaveFormat::MaxCompressionRatio)
+		{
+			UE_LOGFMT(CompactSaveLog, Error, "{0}() The compact save block's uncompressed size ({1}) is invalid for {2} bytes of compressed data", *FString(__FUNCTION__), UncompressedSize, Body.Num());
+			bError = true;
+			return false;
+		}
+
+		Payload.SetNumUninitialized(UncompressedSize);
+		if (!FCompression::UncompressMemory(CompactSaveFormat::GetCompressionFormat(Compression), Payload.GetData(), UncompressedSize, Body.GetData(), Body.Num()))
+		{
+			UE_LOGFMT(CompactSaveLog, Error, "{0}() Failed to decompress the compact save block!", *FString(__FUNCTION__));
+			bError = true;
+			return false;
+		}
+	}
+	else
+	{
+		Payload = MoveTemp(Body);
+	}
+
+	// Name table
+	const uint64 NameCount = ReadPacked();
+	if (NameCount > static_cast<uint64>(Payload.Num())) bError = true;
+	for (uint64 Index = 0; Index < NameCount && !bError; Index++)
+	{
+		Names.Add(ReadString());
+	}
+
+	return !bError;
+}
+
+
+int32 FCompactSaveReader::GetVersion() const
+{
+	return Version;
+}
+
+
+bool FCompactSaveReader::HasError() const
+{
+	return bError;
+}
+
+
+bool FCompactSaveReader::ReadBytes(void* Data, const int32 Num)
+{
+	if (bError || Num < 0 || Offset + Num > Payload.Num())
+	{
+		FMemory::Memzero(Data, FMath::Max(Num, 0));
+		bError = true;
+		return false;
+	}
+
+	FMemory::Memcpy(Data, Payload.GetData() + Offset, Num);
+	Offset += Num;
+	return true;
+}
+
+
+uint64 FCompactSaveReader::ReadPacked()
+{
+	uint64 Value = 0;
+	for (int32 Shift = 0; Shift < 64; Shift += 7)
+	{
+		uint8 Byte = 0;
+		if (!ReadBytes(&Byte, 1)) return 0;
+		Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+		if (!(Byte & 0x80)) return Value;
+	}
+
+	bError = true;
+	return 0;
+}
+
+
+int64 FCompactSaveReader::ReadSignedPacked()
+{
+	const uint64 Value = ReadPacked();
+	return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+}
+
+
+uint8 FCompactSaveReader::ReadByte()
+{
+	uint8 Value = 0;
+	ReadBytes(&Value, 1);
+	return Value;
+}
+
+
+FString FCompactSaveReader::ReadString()
+{
+	const uint64 Length = ReadPacked();
+	if (bError || Length > static_cast<uint64>(Payload.Num() - Offset))
+	{
+		bError = true;
+		return FString();
+	}
+
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Payload.GetData() + Offset), static_cast<int32>(Length));
+	Offset += static_cast<int32>(Length);
+	return FString(Converter.Length(), Converter.Get());
+}
+
+
+FString FCompactSaveReader::ReadName()
+{
+	const uint64 Index = ReadPacked();
+	if (bError || Index >= static_cast<uint64>(Names.Num()))
+	{
+		bError = true;
+		return FString();
+	}
+
+	return Names[Index];
+}
+
+
+FGuid FCompactSaveReader::ReadGuid()
+{
+	FGuid Guid;
+	if (ReadByte() == 0) return Guid;
+
+	for (int32 Component = 0; Component < 4; Component++)
+	{
+		uint8 Bytes[4];
+		ReadBytes(Bytes, 4);
+		Guid[Component] = Bytes[0] | Bytes[1] << 8 | Bytes[2] << 16 | static_cast<uint32>(Bytes[3]) << 24;
+	}
+
+	return Guid;
+}
+
+
+FString FCompactSaveReader::ReadId()
+{
+	const uint8 bGuid = ReadByte();
+	if (!bGuid) return ReadString();
+
+	// The guid's tag has already been read
+	Offset--;
+	return ReadGuid().ToString(EGuidFormats::Digits);
+}
+
+
+FVector FCompactSaveReader::ReadLocation()
+{
+	FVector Location;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		PreviousLocation[Axis] += ReadSignedPacked();
+		Location[Axis] = PreviousLocation[Axis] / 100.0;
+	}
+
+	return Location;
+}
+
+
+FRotator FCompactSaveReader::ReadRotation()
+{
+	double Axes[3];
+	for (double& Axis : Axes)
+	{
+		uint8 Bytes[2];
+		ReadBytes(Bytes, 2);
+		Axis = FRotator::DecompressAxisFromShort(static_cast<uint16>(Bytes[0] | Bytes[1] << 8));
+	}
+
+	return FRotator(Axes[0], Axes[1], Axes[2]);
+}
+#pragma endregion
+
+
+
+
+#pragma region Save Payloads
+bool CompactSave::ShouldSerialize(FArchive& Ar)
+{
+	// Only save slots and their copies use the compact format
+	if (!Ar.IsPersistent() || Ar.GetLinker() || Ar.IsObjectReferenceCollector() || Ar.IsCountingMemory() || Ar.IsTransacting()) return false;
+	return Ar.IsLoading() || CVarCompactSaveFormat.GetValueOnAnyThread();
+}
+
+
+void CompactSave::WriteLevelActors(FCompactSaveWriter& Writer, const TMap<FString, F_LevelSaveInformation_Actor>& Actors)
+{
+	Writer.WritePacked(Actors.Num());
+	for (const auto& [Id, SaveInformation] : Actors)
+	{
+		uint8 Flags = 0;
+		if (SaveInformation.ShouldSaveAttributes()) Flags |= CompactSaveFormat::SaveAttributes;
+		if (SaveInformation.ShouldSaveInventory()) Flags |= CompactSaveFormat::SaveInventory;
+		if (SaveInformation.ShouldSaveCombatInformation()) Flags |= CompactSaveFormat::SaveCombat;
+		if (SaveInformation.Id == Id) Flags |= CompactSaveFormat::SameId;
+
+		Writer.WriteId(Id);
+		Writer.WriteByte(Flags);
+		if (!(Flags & CompactSaveFormat::SameId)) Writer.WriteId(SaveInformation.Id);
+		Writer.WriteByte(static_cast<uint8>(SaveInformation.SaveType));
+		Writer.WriteLocation(SaveInformation.Location);
+		Writer.WriteRotation(SaveInformation.Rotation);
+		Writer.WriteName(SaveInformation.Class.ToString());
+	}
+}
+
+
+void CompactSave::ReadLevelActors(FCompactSaveReader& Reader, TMap<FString, F_LevelSaveInformation_Actor>& OutActors)
+{
+	const uint64 Count = Reader.ReadPacked();
+	OutActors.Reserve(OutActors.Num() + static_cast<int32>(FMath::Min<uint64>(Count, MAX_int16)));
+	for (uint64 Index = 0; Index < Count && !Reader.HasError(); Index++)
+	{
+		F_LevelSaveInformation_Actor SaveInformation;
+		const FString Id = Reader.ReadId();
+		const uint8 Flags = Reader.ReadByte();
+		SaveInformation.Id = Flags & CompactSaveFormat::SameId ? Id : Reader.ReadId();
+		SaveInformation.SaveType = static_cast<ESaveIdType>(Reader.ReadByte());
+		SaveInformation.Location = Reader.ReadLocation();
+		SaveInformation.Rotation = Reader.ReadRotation();
+		SaveInformation.Class = TSoftClassPtr<AActor>(FSoftObjectPath(Reader.ReadName()));
+		SaveInformation.UpdateConfig(
+			(Flags & CompactSaveFormat::SaveAttributes) != 0,
+			(Flags & CompactSaveFormat::SaveInventory) != 0,
+			(Flags & CompactSaveFormat::SaveCombat) != 0
+		);
+
+		if (!Reader.HasError()) OutActors.Add(Id, SaveInformation);
+	}
+}
+
+
+void CompactSave::WriteInventory(FCompactSaveWriter& Writer, const F_InventorySaveInformation& Inventory)
+{
+	Writer.WriteSignedPacked(Inventory.NetId);
+	Writer.WriteString(Inventory.PlatformId);
+	Writer.WritePacked(Inventory.InventoryItems.Num());
+	for (const FS_Item& Item : Inventory.InventoryItems)
+	{
+		Writer.WriteGuid(Item.Id);
+		Writer.WriteName(Item.ItemName.ToString());
+		Writer.WriteSignedPacked(Item.SortOrder);
+	}
+}
+
+
+void CompactSave::ReadInventory(FCompactSaveReader& Reader, F_InventorySaveInformation& OutInventory)
+{
+	OutInventory.NetId = static_cast<int32>(Reader.ReadSignedPacked());
+	OutInventory.PlatformId = Reader.ReadString();
+
+	const uint64 Count = Reader.ReadPacked();
+	OutInventory.InventoryItems.Reserve(static_cast<int32>(FMath::Min<uint64>(Count, MAX_int16)));
+	for (uint64 Index = 0; Index < Count && !Reader.HasError(); Index++)
+	{
+		FS_Item Item;
+		Item.Id = Reader.ReadGuid();
+		Item.ItemName = FName(*Reader.ReadName());
+		Item.SortOrder = static_cast<int32>(Reader.ReadSignedPacked());
+		if (!Reader.HasError()) OutInventory.InventoryItems.Add(Item);
+	}
+}
+#pragma endregion
+
+
+
+
+#pragma region Benchmark
+#if !UE_BUILD_SHIPPING
+/** Compares the size and encode / decode times of the tagged and compact formats with a level save that has a specific amount of actors */
+static void BenchmarkCompactSaveFormat(const TArray<FString>& Args)
+{
+	const int32 ActorCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+	// Half of the actors are placed in the level, and the other half were spawned with guid ids
+	USaved_Level* LevelSave = NewObject<USaved_Level>(GetTransientPackage());
+	FRandomStream Random(ActorCount);
+	for (int32 Index = 0; Index < ActorCount; Index++)
+	{
+		const bool bSpawnedActor = Index % 2 == 0;
+		F_LevelSaveInformation_Actor SaveInformation;
+		SaveInformation.Id = bSpawnedActor ? FGuid::NewGuid().ToString() : FString::Printf(TEXT("BP_WorldItem_C_%d"), Index);
+		SaveInformation.SaveType = bSpawnedActor ? ESaveIdType::SpawnedActor : ESaveIdType::LevelActor;
+		SaveInformation.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 100000.0f);
+		SaveInformation.Rotation = FRotator(0.0, Random.FRandRange(-180.0f, 180.0f), 0.0);
+		SaveInformation.Class = TSoftClassPtr<AActor>(FSoftObjectPath(FString::Printf(TEXT("/Game/Items/BP_Item_%d.BP_Item_%d_C"), Index % 32, Index % 32)));
+		SaveInformation.UpdateConfig(false, false, false);
+		LevelSave->SavedActors.Add(SaveInformation.Id, SaveInformation);
+	}
+
+	const bool bPreviousFormat = CVarCompactSaveFormat.GetValueOnGameThread();
+	for (const bool bCompactFormat : { false, true })
+	{
+		CVarCompactSaveFormat->Set(bCompactFormat, ECVF_SetByCode);
+
+		TArray<uint8> SaveData;
+		double StartTime = FPlatformTime::Seconds();
+		UGameplayStatics::SaveGameToMemory(LevelSave, SaveData);
+		const double EncodeTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		const USaved_Level* LoadedSave = Cast<USaved_Level>(UGameplayStatics::LoadGameFromMemory(SaveData));
+		const double DecodeTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TArray<uint8> CompressedData;
+		USavePipeline::CompressSaveData(SaveData, CompressedData);
+
+		UE_LOGFMT(CompactSaveLog, Display, "{0}() {1} format: {2}/{3} actors loaded, {4} bytes ({5} bytes compressed), encode: {6} ms, decode: {7} ms",
+			*FString(__FUNCTION__), bCompactFormat ? TEXT("Compact") : TEXT("Tagged"),
+			LoadedSave ? LoadedSave->SavedActors.Num() : 0, ActorCount,
+			SaveData.Num(), CompressedData.Num(),
+			EncodeTime, DecodeTime
+		);
+	}
+
+	CVarCompactSaveFormat->Set(bPreviousFormat, ECVF_SetByCode);
+}
+
+static FAutoConsoleCommand CompactSaveBenchmarkCommand(
+	TEXT("Sandbox.Save.BenchmarkFormat"),
+	TEXT("Compares the size and encode / decode time of the tagged and compact save formats. Sandbox.Save.BenchmarkFormat [ActorCount = 10000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkCompactSaveFormat)
+);
+#endif
+#pragma endregion
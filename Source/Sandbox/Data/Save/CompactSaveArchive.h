@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(CompactSaveLog, Log, All);
+
+struct F_LevelSaveInformation_Actor;
+struct F_InventorySaveInformation;
+
+
+/**
+ * Versions of the compact save format. Add a version before VersionPlusOne whenever the layout of a payload changes, and handle the previous versions in the readers / MigrateSaveData()
+ */
+namespace ECompactSaveVersion
+{
+	enum Type : int32
+	{
+		/** Saves that only contain tagged properties, from before the compact format was added */
+		Legacy = 0,
+
+		/** Packed guids, deduplicated names, and delta encoded transforms */
+		Initial = 1,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+}
+
+
+/**
+ * Writes save information in the compact binary format. @ref FCompactSaveReader \n\n
+ *
+ * Save games write their large containers with this after their tagged properties, which skips the property names and type information that's stored for every entry.
+ *	- Guids are packed, and ids that are guids are stored as guids instead of strings
+ *	- Names and class paths are stored once in a name table, and referenced by their index
+ *	- Locations are quantized and stored as the difference from the previous location
+ *	- The block is optionally compressed (Sandbox.Save.CompactCompression), save slots written through the save pipeline are already compressed
+ */
+class SANDBOX_API FCompactSaveWriter
+{
+public:
+	/** Writes an unsigned integer using as few bytes as possible */
+	void WritePacked(uint64 Value);
+
+	/** Writes a signed integer using as few bytes as possible */
+	void WriteSignedPacked(int64 Value);
+
+	/** Writes a single byte */
+	void WriteByte(uint8 Value);
+
+	/** Writes a string as utf8 */
+	void WriteString(const FString& Value);
+
+	/** Writes a name or path that's stored once in the name table */
+	void WriteName(const FString& Value);
+
+	/** Writes a guid, invalid guids are stored as a single byte */
+	void WriteGuid(const FGuid& Value);
+
+	/** Writes an id, ids that are guids are packed and everything else is stored as a string */
+	void WriteId(const FString& Value);
+
+	/** Writes a location quantized to a hundredth of a unit, relative to the previous location */
+	void WriteLocation(const FVector& Value);
+
+	/** Writes a rotation with 16 bits per axis */
+	void WriteRotation(const FRotator& Value);
+
+	/** Writes the block (header, name table and payload) after the save game's tagged properties */
+	void Finish(FArchive& Ar);
+
+
+protected:
+	/** The information that's been written */
+	TArray<uint8> Payload;
+
+	/** Names and paths that are referenced in the payload */
+	TArray<FString> Names;
+
+	/** The index of each name in the name table */
+	TMap<FString, int32> NameIndexes;
+
+	/** The previous quantized location */
+	int64 PreviousLocation[3] = { 0, 0, 0 };
+
+
+};
+
+
+/**
+ * Reads save information that was written in the compact binary format. @ref FCompactSaveWriter
+ */
+class SANDBOX_API FCompactSaveReader
+{
+public:
+	/**
+	 * Reads the block that follows the save game's tagged properties
+	 *
+	 * @param Ar						The archive the save game is loaded from
+	 * @returns							True if there's a valid block. Legacy saves don't have one
+	 */
+	bool Begin(FArchive& Ar);
+
+	/** The version the block was written with, or Legacy if there wasn't one */
+	int32 GetVersion() const;
+
+	/** Whether the payload was malformed */
+	bool HasError() const;
+
+	/** Reads the information that was written with the writer's counterparts. Anything that's read past the end of the payload is zeroed and flags an error */
+	uint64 ReadPacked();
+	int64 ReadSignedPacked();
+	uint8 ReadByte();
+	FString ReadString();
+	FString ReadName();
+	FGuid ReadGuid();
+	FString ReadId();
+	FVector ReadLocation();
+	FRotator ReadRotation();
+
+
+protected:
+	/** Reads raw bytes from the payload */
+	bool ReadBytes(void* Data, int32 Num);
+
+	/** The name table and payload */
+	TArray<uint8> Payload;
+
+	/** The current position in the payload */
+	int32 Offset = 0;
+
+	/** The name table */
+	TArray<FString> Names;
+
+	/** The version of the block */
+	int32 Version = ECompactSaveVersion::Legacy;
+
+	/** Whether the payload was malformed */
+	bool bError = false;
+
+	/** The previous quantized location */
+	int64 PreviousLocation[3] = { 0, 0, 0 };
+
+
+};
+
+
+/**
+ * Readers and writers for the save payloads that use the compact format
+ */
+namespace CompactSave
+{
+	/** Whether the compact format is used for this archive. Saving can be disabled with Sandbox.Save.CompactFormat, loading always checks for the compact block */
+	SANDBOX_API bool ShouldSerialize(FArchive& Ar);
+
+	SANDBOX_API void WriteLevelActors(FCompactSaveWriter& Writer, const TMap<FString, F_LevelSaveInformation_Actor>& Actors);
+	SANDBOX_API void ReadLevelActors(FCompactSaveReader& Reader, TMap<FString, F_LevelSaveInformation_Actor>& OutActors);
+
+	SANDBOX_API void WriteInventory(FCompactSaveWriter& Writer, const F_InventorySaveInformation& Inventory);
+	SANDBOX_API void ReadInventory(FCompactSaveReader& Reader, F_InventorySaveInformation& OutInventory);
+}
@@ -3,3 +3,46 @@
 
 #include "Saved_Inventory.h"
 
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Data/Save/CompactSaveArchive.h"
+
+
+void USaved_Inventory::Serialize(FArchive& Ar)
+{
+	if (!CompactSave::ShouldSerialize(Ar))
+	{
+		Super::Serialize(Ar);
+		return;
+	}
+
+	if (Ar.IsSaving())
+	{
+		// The inventory information is written in the compact format instead of with the tagged properties
+		F_InventorySaveInformation Inventory = MoveTemp(SaveInformation);
+		SaveInformation = F_InventorySaveInformation();
+		Super::Serialize(Ar);
+		SaveInformation = MoveTemp(Inventory);
+
+		FCompactSaveWriter Writer;
+		CompactSave::WriteInventory(Writer, SaveInformation);
+		Writer.Finish(Ar);
+	}
+	else
+	{
+		Super::Serialize(Ar);
+
+		FCompactSaveReader Reader;
+		if (Reader.Begin(Ar)) CompactSave::ReadInventory(Reader, SaveInformation);
+		if (Reader.HasError())
+		{
+			UE_LOGFMT(CompactSaveLog, Error, "{0}() Failed to read the compact save information of {1}!", *FString(__FUNCTION__), *GetName());
+		}
+
+		MigrateSaveData(Reader.GetVersion());
+	}
+}
+
+
+void USaved_Inventory::MigrateSaveData(int32 SavedVersion)
+{
+}
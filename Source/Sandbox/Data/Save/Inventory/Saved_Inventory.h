@@ -19,5 +19,16 @@ public:
 	/** The character's saved inventory information */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite) F_InventorySaveInformation SaveInformation;
 
+
+	/** Writes the inventory in the compact save format after the tagged properties. @ref FCompactSaveWriter */
+	virtual void Serialize(FArchive& Ar) override;
+
+	/**
+	 * Called after the save has been loaded, for updating information that was saved with a previous version of the compact format
+	 *
+	 * @param SavedVersion				The version the save was written with. Legacy saves only have their tagged properties
+	 */
+	virtual void MigrateSaveData(int32 SavedVersion);
+
 	
 };
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Saved_Manifest.h"
+
+#include "Algo/BinarySearch.h"
+
+
+bool USaved_Manifest::GetLatestSave(F_SaveManifestEntry& OutEntry) const
+{
+	if (Entries.IsEmpty()) return false;
+
+	OutEntry = Entries.Last();
+	return true;
+}
+
+
+bool USaved_Manifest::GetSave(const int32 SaveIndex, F_SaveManifestEntry& OutEntry) const
+{
+	const F_SaveManifestEntry* Entry = FindSave(SaveIndex);
+	if (!Entry) return false;
+
+	OutEntry = *Entry;
+	return true;
+}
+
+
+TArray<int32> USaved_Manifest::GetPreviousSaveIndexes(const int32 CurrentSaveIndex, const int32 SavesToRetrieve, const FString& SlotName) const
+{
+	TArray<int32> PreviousSaves;
+	const int32 Start = Algo::LowerBoundBy(Entries, CurrentSaveIndex, &F_SaveManifestEntry::SaveIndex) - 1;
+	for (int32 Index = Start; Index >= 0 && PreviousSaves.Num() < SavesToRetrieve; Index--)
+	{
+		const F_SaveManifestEntry& Entry = Entries[Index];
+		if (!SlotName.IsEmpty() && !Entry.ContainsSlot(SlotName + "_" + FString::FromInt(Entry.SaveIndex))) continue;
+		PreviousSaves.Add(Entry.SaveIndex);
+	}
+
+	return PreviousSaves;
+}
+
+
+TArray<FString> USaved_Manifest::GetAllSlotNames() const
+{
+	TArray<FString> SlotNames;
+	for (const F_SaveManifestEntry& Entry : Entries)
+	{
+		for (const F_SaveManifestSlot& Slot : Entry.Slots) SlotNames.Add(Slot.SlotName);
+	}
+
+	return SlotNames;
+}
+
+
+void USaved_Manifest::RecordSlot(const int32 SaveIndex, const F_SaveManifestSlot& Slot, const FString& LevelName)
+{
+	F_SaveManifestEntry& Entry = FindOrAddSave(SaveIndex);
+	if (!LevelName.IsEmpty()) Entry.LevelName = LevelName;
+	Entry.Timestamp = FMath::Max(Entry.Timestamp, Slot.Timestamp);
+
+	F_SaveManifestSlot* SavedSlot = Entry.Slots.FindByPredicate([&Slot](const F_SaveManifestSlot& Saved) { return Saved.SlotName == Slot.SlotName; });
+	if (SavedSlot) *SavedSlot = Slot;
+	else Entry.Slots.Add(Slot);
+}
+
+
+void USaved_Manifest::RemoveSave(const int32 SaveIndex)
+{
+	const int32 Index = Algo::BinarySearchBy(Entries, SaveIndex, &F_SaveManifestEntry::SaveIndex);
+	if (Index != INDEX_NONE) Entries.RemoveAt(Index);
+}
+
+
+bool USaved_Manifest::IsEmpty() const
+{
+	return Entries.IsEmpty();
+}
+
+
+const F_SaveManifestEntry* USaved_Manifest::FindSave(const int32 SaveIndex) const
+{
+	const int32 Index = Algo::BinarySearchBy(Entries, SaveIndex, &F_SaveManifestEntry::SaveIndex);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+
+F_SaveManifestEntry& USaved_Manifest::FindOrAddSave(const int32 SaveIndex)
+{
+	const int32 Index = Algo::LowerBoundBy(Entries, SaveIndex, &F_SaveManifestEntry::SaveIndex);
+	if (Entries.IsValidIndex(Index) && Entries[Index].SaveIndex == SaveIndex) return Entries[Index];
+
+	F_SaveManifestEntry& Entry = Entries.InsertDefaulted_GetRef(Index);
+	Entry.SaveIndex = SaveIndex;
+	return Entry;
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "Sandbox/Data/Structs/SaveInformation.h"
+#include "Saved_Manifest.generated.h"
+
+
+/**
+ * Index of every save that's been written for an account's save slot. @ref AGameModeSaveLogic \n\n
+ * Entries are sorted by their save index, so finding the current save is constant and searching for a specific save index is a binary search instead of checking if the save slots exist on disk.
+ * The manifest is written to two alternating slots with an incrementing revision, and the most recent valid revision is used when it's loaded. A save that's interrupted while writing the manifest never corrupts the previous one
+ */
+UCLASS()
+class SANDBOX_API USaved_Manifest : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/** The base save url of the save slot (GameModeType + AccountId + SaveSlot) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FString BaseUrl;
+
+	/** Incremented every time the manifest is written */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) int64 Revision = 0;
+
+	/** Every save index of this save slot, sorted by the save index */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TArray<F_SaveManifestEntry> Entries;
+
+	
+public:
+	/** Retrieves the most recent save */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual bool GetLatestSave(F_SaveManifestEntry& OutEntry) const;
+
+	/** Retrieves the information of a specific save index */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual bool GetSave(int32 SaveIndex, F_SaveManifestEntry& OutEntry) const;
+
+	/**
+	 * Retrieves the previous save indexes, beginning from the save before the current save index
+	 *
+	 * @param CurrentSaveIndex			The save index we're backtracking from
+	 * @param SavesToRetrieve			How many previous saves we want to retrieve
+	 * @param SlotName					Optionally only retrieve saves that have written a slot with this name + the save index
+	 * @returns							The previous save indexes, from the most recent to the oldest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual TArray<int32> GetPreviousSaveIndexes(int32 CurrentSaveIndex, int32 SavesToRetrieve, const FString& SlotName = TEXT("")) const;
+
+	/** Retrieves every save slot that's been written for this save slot */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual TArray<FString> GetAllSlotNames() const;
+
+	/** Adds or updates a save slot for a save index */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual void RecordSlot(int32 SaveIndex, const F_SaveManifestSlot& Slot, const FString& LevelName);
+
+	/** Removes a save index from the manifest */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual void RemoveSave(int32 SaveIndex);
+
+	/** Returns whether there aren't any saves for this save slot */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Manifest") virtual bool IsEmpty() const;
+
+	/** Retrieves the entry of a save index, or nullptr if it hasn't been saved */
+	const F_SaveManifestEntry* FindSave(int32 SaveIndex) const;
+
+	/** Retrieves the entry of a save index, and adds it if it hasn't been saved */
+	F_SaveManifestEntry& FindOrAddSave(int32 SaveIndex);
+
+	
+};
@@ -3,3 +3,49 @@
 
 #include "SaveFunctionLibrary.h"
 
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sandbox/Game/GameModeSaveLogic.h"
+#include "Sandbox/Game/Saving/SavePipeline.h"
+
+
+bool USaveFunctionLibrary::SaveGameToSlot(const UObject* WorldContextObject, USaveGame* SaveGameObject, const FString& SlotName, const int32 UserIndex)
+{
+	if (USavePipeline* SavePipeline = GetSavePipeline(WorldContextObject))
+	{
+		return SavePipeline->QueueSave(SaveGameObject, SlotName, UserIndex);
+	}
+
+	return UGameplayStatics::SaveGameToSlot(SaveGameObject, SlotName, UserIndex);
+}
+
+
+USaveGame* USaveFunctionLibrary::LoadGameFromSlot(const UObject* WorldContextObject, const FString& SlotName, const int32 UserIndex)
+{
+	// Don't read the slot while there's newer information waiting to be written
+	if (USavePipeline* SavePipeline = GetSavePipeline(WorldContextObject))
+	{
+		SavePipeline->WaitForSlot(SlotName);
+	}
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || SlotName.IsEmpty()) return nullptr;
+
+	TArray<uint8> SaveData;
+	if (!SaveSystem->LoadGame(false, *SlotName, UserIndex, SaveData)) return nullptr;
+
+	TArray<uint8> UncompressedData;
+	if (!USavePipeline::DecompressSaveData(SaveData, UncompressedData)) return nullptr;
+	return UGameplayStatics::LoadGameFromMemory(UncompressedData);
+}
+
+
+USavePipeline* USaveFunctionLibrary::GetSavePipeline(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (!World) return nullptr;
+
+	const AGameModeSaveLogic* GameMode = Cast<AGameModeSaveLogic>(World->GetAuthGameMode());
+	return GameMode ? GameMode->GetSavePipeline() : nullptr;
+}
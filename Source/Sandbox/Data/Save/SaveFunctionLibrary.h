@@ -6,14 +6,46 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SaveFunctionLibrary.generated.h"
 
+class USaveGame;
+class USavePipeline;
+
+
 /**
- * 
+ * Save and load logic that routes through the game mode's save pipeline. @ref USavePipeline \n\n
+ * Use this instead of UGameplayStatics for saving and loading slots, saves are compressed and written on worker threads when there's a valid pipeline on the server
  */
 UCLASS()
 class SANDBOX_API USaveFunctionLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
-	// Retrieve Save Game Slot  -> SinglePlayer
-	// Retrieve Save Game Slot  -> MultiPlayer
+public:
+	/**
+	 * Saves the information to a save slot. If the game mode has a save pipeline it's captured and written asynchronously, otherwise it's saved synchronously
+	 *
+	 * @param WorldContextObject		Used for retrieving the game mode's save pipeline
+	 * @param SaveGameObject			The save information
+	 * @param SlotName					The save slot
+	 * @param UserIndex					The user index of the save slot
+	 * @returns							True if the information was saved or queued for saving
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Saving", meta = (WorldContext = "WorldContextObject"))
+	static bool SaveGameToSlot(const UObject* WorldContextObject, USaveGame* SaveGameObject, const FString& SlotName, int32 UserIndex);
+
+	/**
+	 * Loads the information from a save slot. Waits for pending writes to the slot, and handles compressed saves
+	 *
+	 * @param WorldContextObject		Used for retrieving the game mode's save pipeline
+	 * @param SlotName					The save slot
+	 * @param UserIndex					The user index of the save slot
+	 * @returns							The save information, or nullptr if there wasn't a valid save
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Saving", meta = (WorldContext = "WorldContextObject"))
+	static USaveGame* LoadGameFromSlot(const UObject* WorldContextObject, const FString& SlotName, int32 UserIndex);
+
+	/** Retrieves the game mode's save pipeline. Only valid on the server */
+	UFUNCTION(BlueprintCallable, Category = "Saving", meta = (WorldContext = "WorldContextObject"))
+	static USavePipeline* GetSavePipeline(const UObject* WorldContextObject);
+
+	
 };
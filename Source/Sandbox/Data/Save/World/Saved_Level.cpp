@@ -5,9 +5,75 @@
 
 #include "Kismet/KismetGuidLibrary.h"
 #include "Logging/StructuredLog.h"
+#include "Sandbox/Data/Save/CompactSaveArchive.h"
 #include "Sandbox/Data/Enums/ESaveType.h"
 #include "Sandbox/Data/Interfaces/Save/LevelSaveInformationInterface.h"
 #include "Sandbox/Game/MultiplayerGameMode.h"
+#include "Sandbox/Game/Saving/SaveableActorRegistry.h"
+#include "Saved_LevelDelta.h"
+
+
+USaved_Level::USaved_Level()
+{
+	DeltaCount = 0;
+}
+
+
+void USaved_Level::Serialize(FArchive& Ar)
+{
+	if (!CompactSave::ShouldSerialize(Ar))
+	{
+		Super::Serialize(Ar);
+		return;
+	}
+
+	if (Ar.IsSaving())
+	{
+		// The saved actors are written in the compact format instead of with the tagged properties
+		TMap<FString, F_LevelSaveInformation_Actor> Actors = MoveTemp(SavedActors);
+		SavedActors = TMap<FString, F_LevelSaveInformation_Actor>();
+		Super::Serialize(Ar);
+		SavedActors = MoveTemp(Actors);
+
+		FCompactSaveWriter Writer;
+		CompactSave::WriteLevelActors(Writer, SavedActors);
+		Writer.Finish(Ar);
+	}
+	else
+	{
+		Super::Serialize(Ar);
+
+		FCompactSaveReader Reader;
+		if (Reader.Begin(Ar)) CompactSave::ReadLevelActors(Reader, SavedActors);
+		if (Reader.HasError())
+		{
+			UE_LOGFMT(CompactSaveLog, Error, "{0}() Failed to read the compact save information of {1}!", *FString(__FUNCTION__), *GetName());
+		}
+
+		MigrateSaveData(Reader.GetVersion());
+	}
+}
+
+
+void USaved_Level::MigrateSaveData(int32 SavedVersion)
+{
+}
+
+
+void USaved_Level::ApplyDelta(const USaved_LevelDelta* Delta)
+{
+	if (!Delta) return;
+
+	for (const FString& Id : Delta->RemovedActors)
+	{
+		SavedActors.Remove(Id);
+	}
+
+	for (const auto& [Id, SaveInformation] : Delta->SavedActors)
+	{
+		SavedActors.Add(Id, SaveInformation);
+	}
+}
 
 
 void USaved_Level::GetSavedAndSpawnedActors(ULevel* Level, TArray<FString>& OutSpawnedActors, TArray<AActor*>& OutLevelActors, TArray<FString>& OutPlayers)
@@ -18,27 +84,21 @@ void USaved_Level::GetSavedAndSpawnedActors(ULevel* Level, TArray<FString>& OutS
 		return;
 	}
 	
-	// Always loop through the list for map updates (while working on levels?)
-
-	// Loop through the saved actors
-	//		- find actors placed in level
-	//		- send actors saved that were spawned in world
-	TMap<FString, bool> LevelActors;
-	for (AActor* Actor : Level->Actors)
+	// Saveable actors register themselves with the registry, only they need to be retrieved instead of every actor in the level
+	USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(Level);
+	if (!SaveableActorRegistry)
 	{
-		FString ActorLevelId;
-		if (!Actor) continue;
-
-		// Is it a saved item
-		const bool bLevelSaveInterface = Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass());
-		if (bLevelSaveInterface)
-		{
-			ActorLevelId = ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor);
+		UE_LOGFMT(GameModeLog, Error, "{0}::{1}() Failed to retrieve the saveable actors, the registry wasn't valid!", *GetOuter()->GetName(), *FString(__FUNCTION__));
+		return;
+	}
 
-			// Items placed in the level
-			LevelActors.Add(ActorLevelId, true); // Spawned actors
-			OutLevelActors.Add(Actor);
-		}
+	// Items placed in the level, and actors that were spawned during play
+	TArray<const FSaveableActor*> SaveableActors;
+	SaveableActorRegistry->GetActorsInLevel(Level, SaveableActors);
+	OutLevelActors.Reserve(OutLevelActors.Num() + SaveableActors.Num());
+	for (const FSaveableActor* SaveableActor : SaveableActors)
+	{
+		OutLevelActors.Add(SaveableActor->Actor.Get());
 	}
 
 	// Find and send the spawned actors and player references
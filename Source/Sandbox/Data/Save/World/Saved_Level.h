@@ -7,10 +7,14 @@
 #include "Sandbox/Data/Structs/LevelSaveInformation.h"
 #include "Saved_Level.generated.h"
 
+class USaved_LevelDelta;
+
 
 /**
  * Save game logic for persistent level save information
  * Subclass this for custom save logic @ref AGameModeSaveLogic
+ *
+ * This is the level's snapshot, changes that are saved afterwards are appended as deltas (@ref USaved_LevelDelta) until they're compacted into a new snapshot
  */
 UCLASS()
 class SANDBOX_API USaved_Level : public USaveGame
@@ -27,7 +31,29 @@ public:
 	/* A stored reference to the current save state of the objects in the level */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite) TMap<FString, F_LevelSaveInformation_Actor> SavedActors;
 
+	/** Unique id of this snapshot. Deltas are only applied to the snapshot they were appended to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FGuid SnapshotId;
+
+	/** The amount of deltas that have been appended to this snapshot */
+	UPROPERTY(Transient, BlueprintReadWrite) int32 DeltaCount;
+
 public:
+	USaved_Level();
+
+	/** Writes the saved actors in the compact save format after the tagged properties. @ref FCompactSaveWriter */
+	virtual void Serialize(FArchive& Ar) override;
+
+	/**
+	 * Called after the save has been loaded, for updating information that was saved with a previous version of the compact format
+	 *
+	 * @param SavedVersion				The version the save was written with. Legacy saves only have their tagged properties
+	 */
+	virtual void MigrateSaveData(int32 SavedVersion);
+
+	/** Applies a delta's changes to the saved actors */
+	UFUNCTION(BlueprintCallable, Category = "Level|Saving")
+	virtual void ApplyDelta(const USaved_LevelDelta* Delta);
+
 	/** Retrieves the saved actors that have been placed in the level, and the ones that were spawned in the world */
 	UFUNCTION(BlueprintCallable, Category = "Level|Saving")
 	virtual void GetSavedAndSpawnedActors(ULevel* Level, TArray<FString>& OutSpawnedActors, TArray<AActor*>& OutLevelActors, TArray<FString>& OutPlayers);
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Saved_LevelDelta.h"
+
+#include "Logging/StructuredLog.h"
+#include "Sandbox/Data/Save/CompactSaveArchive.h"
+
+
+USaved_LevelDelta::USaved_LevelDelta()
+{
+	Sequence = 0;
+}
+
+
+void USaved_LevelDelta::Serialize(FArchive& Ar)
+{
+	if (!CompactSave::ShouldSerialize(Ar))
+	{
+		Super::Serialize(Ar);
+		return;
+	}
+
+	if (Ar.IsSaving())
+	{
+		// The saved actors are written in the compact format instead of with the tagged properties
+		TMap<FString, F_LevelSaveInformation_Actor> Actors = MoveTemp(SavedActors);
+		SavedActors = TMap<FString, F_LevelSaveInformation_Actor>();
+		Super::Serialize(Ar);
+		SavedActors = MoveTemp(Actors);
+
+		FCompactSaveWriter Writer;
+		CompactSave::WriteLevelActors(Writer, SavedActors);
+		Writer.Finish(Ar);
+	}
+	else
+	{
+		Super::Serialize(Ar);
+
+		FCompactSaveReader Reader;
+		if (Reader.Begin(Ar)) CompactSave::ReadLevelActors(Reader, SavedActors);
+		if (Reader.HasError())
+		{
+			UE_LOGFMT(CompactSaveLog, Error, "{0}() Failed to read the compact save information of {1}!", *FString(__FUNCTION__), *GetName());
+		}
+
+		MigrateSaveData(Reader.GetVersion());
+	}
+}
+
+
+void USaved_LevelDelta::MigrateSaveData(int32 SavedVersion)
+{
+}
+
+
+bool USaved_LevelDelta::IsEmpty() const
+{
+	return SavedActors.IsEmpty() && RemovedActors.IsEmpty();
+}
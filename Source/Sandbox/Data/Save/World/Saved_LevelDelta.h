@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "Sandbox/Data/Structs/LevelSaveInformation.h"
+#include "Saved_LevelDelta.generated.h"
+
+
+/**
+ * The changes to a level's save information since it's snapshot was written. @ref USaved_Level, @ref AGameModeSaveLogic \n\n
+ * Deltas are appended to the level's save slot (LevelSaveUrl + Delta + Sequence), and applied in order on top of the snapshot when the level is loaded.
+ * Only the deltas that were written for the current snapshot are applied, the chain stops at the first delta that's missing or belongs to another snapshot.
+ */
+UCLASS()
+class SANDBOX_API USaved_LevelDelta : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/** The snapshot this delta was appended to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FGuid SnapshotId;
+
+	/** The order of this delta, starting from 1 after the snapshot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) int32 Sequence;
+
+	/** The save information of the actors that changed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TMap<FString, F_LevelSaveInformation_Actor> SavedActors;
+
+	/** The ids of actors that were removed from the level */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TArray<FString> RemovedActors;
+
+	
+public:
+	USaved_LevelDelta();
+
+	/** Writes the saved actors in the compact save format after the tagged properties. @ref FCompactSaveWriter */
+	virtual void Serialize(FArchive& Ar) override;
+
+	/**
+	 * Called after the save has been loaded, for updating information that was saved with a previous version of the compact format
+	 *
+	 * @param SavedVersion				The version the save was written with. Legacy saves only have their tagged properties
+	 */
+	virtual void MigrateSaveData(int32 SavedVersion);
+
+	/** Whether there aren't any changes in this delta */
+	UFUNCTION(BlueprintCallable, Category = "Level|Saving") virtual bool IsEmpty() const;
+
+	
+};
@@ -4,7 +4,9 @@
 #include "CoreMinimal.h"
 #include "AbilityInformation.h" // TODO: This might cause dependency errors
 #include "AttributeSet.h"
+#include "GameplayTagContainer.h"
 #include "Sandbox/Data/Enums/SkeletonMappings.h"
+#include "Sandbox/Data/Enums/MeleeHitDetection.h"
 #include "CombatInformation.generated.h"
 
 class AArmament;
@@ -132,6 +134,30 @@ struct F_ComboAttacks
 };
 
 
+/**
+ * How a melee attack traces for targets during it's attack frames
+ */
+USTRUCT(BlueprintType)
+struct F_MeleeTraceSettings
+{
+	GENERATED_USTRUCT_BODY()
+	F_MeleeTraceSettings() = default;
+
+	/** Whether the hitboxes listen for overlaps, or are swept along the armament's path */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) EMeleeHitDetection HitDetection = EMeleeHitDetection::Sweep;
+
+	/** The minimum amount of sweeps between the hitbox's previous and current pose each frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 1, ClampMax = 16, EditCondition = "HitDetection == EMeleeHitDetection::Sweep")) int32 SubSteps = 2;
+
+	/** The furthest a hitbox travels during a single sweep. Fast swings add sub steps until each sweep is within this distance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 1, Units = "cm", EditCondition = "HitDetection == EMeleeHitDetection::Sweep")) float MaxSubStepDistance = 20;
+
+	/** The cue that's played on a target as soon as the attacking client hits them, until the server confirms or rejects the hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Categories = "GameplayCue")) FGameplayTag PredictedHitCue;
+	
+};
+
+
 
 
 
@@ -114,7 +114,7 @@ struct F_LevelSaveInformation_Actor
 			const FVector& Location = FVector(),
 			const FRotator& Rotation = FRotator(),
 			const F_SaveActorConfig& Config = F_SaveActorConfig(),
-			const TSubclassOf<AActor> Class = AActor::StaticClass(),
+			const TSoftClassPtr<AActor>& Class = TSoftClassPtr<AActor>(),
 			const TWeakObjectPtr<AActor> Actor = nullptr
 		) :
 		Id(Id),
@@ -154,8 +154,8 @@ struct F_LevelSaveInformation_Actor
 	/** The save config for the actor's component. Used when saving level information */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite) F_SaveActorConfig Config;
 
-	/** A reference to the class of the object spawned in the world */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite) TSubclassOf<AActor> Class;
+	/** A reference to the class of the object spawned in the world. This is a soft reference so the class can be loaded asynchronously before respawning the actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TSoftClassPtr<AActor> Class;
 
 	/** A stored weak reference to the actor spawned in the world */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite) TWeakObjectPtr<AActor> Actor;
@@ -177,7 +177,7 @@ public:
 	/** Is this valid information for spawning in the level? */
 	virtual bool IsValidForSpawning() const
 	{
-		return this->Class && this->Location != FVector::ZeroVector && this->Rotation != FRotator::ZeroRotator;
+		return !this->Class.IsNull() && this->Location != FVector::ZeroVector && this->Rotation != FRotator::ZeroRotator;
 	}
 
 	/** Retrieves whether we should save the attributes */
@@ -210,7 +210,7 @@ public:
 	virtual FString Print() const
 	{
 		FString Result = FString::Printf(TEXT("Type: %s, Id: %s"), *UEnum::GetValueAsString(this->SaveType), *Id); // TODO: SaveIdType dependency fix potential error
-		if (Class) Result.Append(FString::Printf(TEXT(", Class: '%s'"), *Class->GetName()));
+		if (!Class.IsNull()) Result.Append(FString::Printf(TEXT(", Class: '%s'"), *Class.GetAssetName()));
 		Result.Append(FString::Printf(TEXT("Location: '%s', Rotation: %s,"), *Location.ToString(), *Rotation.ToString()));
 		return Result;
 	}
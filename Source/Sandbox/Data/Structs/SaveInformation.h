@@ -4,9 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataTable.h"
+#include "Sandbox/Data/Enums/ESaveType.h"
 #include "SaveInformation.generated.h"
 
-enum class ESaveType : uint8;
 class USaveLogic;
 
 
@@ -82,3 +82,81 @@ protected:
 };
 
 
+
+
+
+
+/**
+ * A save slot that's been written for a specific save index. @ref USaved_Manifest
+ */
+USTRUCT(BlueprintType)
+struct F_SaveManifestSlot
+{
+	GENERATED_USTRUCT_BODY()
+
+	virtual ~F_SaveManifestSlot() = default;
+	F_SaveManifestSlot() = default;
+
+public:
+	/** The name of the save slot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FString SlotName;
+
+	/** What kind of information is stored in the save slot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) ESaveSlotType SlotType = ESaveSlotType::None;
+
+	/** The size of the save slot on disk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) int64 Size = 0;
+
+	/** When the slot was last written */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FDateTime Timestamp;
+};
+
+
+
+
+/**
+ * Every save slot that's been written for a save index. @ref USaved_Manifest
+ */
+USTRUCT(BlueprintType)
+struct F_SaveManifestEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	virtual ~F_SaveManifestEntry() = default;
+	F_SaveManifestEntry() = default;
+
+public:
+	/** The save index */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) int32 SaveIndex = INDEX_NONE;
+
+	/** The level the players were on during this save */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FString LevelName;
+
+	/** When this save index was last updated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) FDateTime Timestamp;
+
+	/** The save, level, player, and actor slots of this save index */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite) TArray<F_SaveManifestSlot> Slots;
+
+	
+public:
+	/** Is this a valid entry? */
+	virtual bool IsValid() const
+	{
+		return this->SaveIndex != INDEX_NONE;
+	}
+
+	/** Whether a specific slot has been saved for this save index */
+	virtual bool ContainsSlot(const FString& SlotName) const
+	{
+		return this->Slots.ContainsByPredicate([&SlotName](const F_SaveManifestSlot& Slot) { return Slot.SlotName == SlotName; });
+	}
+
+	/** The size of every slot of this save index */
+	virtual int64 GetSize() const
+	{
+		int64 Size = 0;
+		for (const F_SaveManifestSlot& Slot : this->Slots) Size += Slot.Size;
+		return Size;
+	}
+};
@@ -5,8 +5,16 @@
 
 #include "GameModeLibrary.h"
 #include "Instances/MultiplayerGameInstance.h"
+#include "Saving/SavePipeline.h"
+#include "Saving/SaveableActorRegistry.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/FileManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Logging/StructuredLog.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Sandbox/Characters/CharacterBase.h"
 #include "Sandbox/Characters/Components/Saving/SaveComponent.h"
 #include "Sandbox/Characters/Player/BasePlayerState.h"
 #include "Sandbox/Characters/Player/PlayerCharacter.h"
@@ -14,7 +22,10 @@
 #include "Sandbox/Data/Enums/GameModeTypes.h"
 #include "Sandbox/Data/Interfaces/Save/LevelSaveInformationInterface.h"
 #include "Sandbox/Data/Save/Save.h"
+#include "Sandbox/Data/Save/SaveFunctionLibrary.h"
+#include "Sandbox/Data/Save/Manifest/Saved_Manifest.h"
 #include "Sandbox/Data/Save/World/Saved_Level.h"
+#include "Sandbox/Data/Save/World/Saved_LevelDelta.h"
 
 
 DEFINE_LOG_CATEGORY(GameModeLog);
@@ -28,6 +39,21 @@ AGameModeSaveLogic::AGameModeSaveLogic(const FObjectInitializer& ObjectInitializ
 	// Save information pertaining to each Game Mode
 	CurrentSave = nullptr;
 	CurrentLevelSave = nullptr;
+	CurrentManifest = nullptr;
+
+	// Asynchronous saving
+	SavePipeline = nullptr;
+	MaxInFlightSaves = 2;
+	bCompressSaves = true;
+
+	// Incremental level saves
+	LevelSaveCompactionThreshold = 16;
+	CharacterSaveLocationTolerance = 1.0f;
+	CharacterSaveRotationTolerance = 1.0f;
+
+	// Time sliced level loading
+	bTimeSliceLevelLoading = true;
+	LevelLoadFrameBudget = 4.0f;
 
 	// Retrieve this game's levels
 	AGameModeSaveLogic::RetrieveLevels();
@@ -38,6 +64,10 @@ AGameModeSaveLogic::AGameModeSaveLogic(const FObjectInitializer& ObjectInitializ
 
 void AGameModeSaveLogic::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Write everything that's still pending, anything saved after this is saved synchronously
+	if (SavePipeline) SavePipeline->Shutdown();
+	CancelLevelLoad();
+	
 	StoreGameModeInformation();
 	PrintMessage("EndPlay");
 	Super::EndPlay(EndPlayReason);
@@ -48,6 +78,14 @@ void AGameModeSaveLogic::BeginPlay()
 	Super::BeginPlay();
 	PrintMessage("BeginPlay");
 
+	if (HasAuthority() && !SavePipeline)
+	{
+		SavePipeline = NewObject<USavePipeline>(this, USavePipeline::StaticClass());
+		SavePipeline->Initialize(MaxInFlightSaves, bCompressSaves);
+		SavePipeline->OnSaveBatchWritten.AddUObject(this, &AGameModeSaveLogic::HandleSaveBatchWritten);
+		SavePipeline->OnSaveBatchFailed.AddUObject(this, &AGameModeSaveLogic::HandleSaveBatchFailed);
+	}
+
 	RetrieveGameModeInformation();
 }
 
@@ -89,6 +127,12 @@ bool AGameModeSaveLogic::SaveGame(const FString& BaseSaveUrl, const int32 Index)
 	// Handle save information specific to multiplayer game state here (Quests, objectives, etc.)
 	//	- Games with save information that persists across multiple games, or from singleplayer / multiplayer should have custom save logic for save / retrieving that information 
 	
+	// Every slot for this save index is written together
+	if (SavePipeline) SavePipeline->BeginBatch(Index);
+
+	// The base save information for this save index
+	if (CurrentSave && Index >= 0) USaveFunctionLibrary::SaveGameToSlot(this, CurrentSave, BaseSaveUrl + AppendSaveIndex(Index), 0);
+	
 	// Save the player information
 	SavePlayers(BaseSaveUrl, Index);
 
@@ -97,7 +141,9 @@ bool AGameModeSaveLogic::SaveGame(const FString& BaseSaveUrl, const int32 Index)
 	//			- Actor->SaveToLevel() saves level information, and optionally additionally save character specific information
 	//			- Actor->SaveActorData() saves character specific information
 	//			- Having a function that binds to the level save component to update latent information (like inventory updates, weapon equips, etc. should be handled at all times)
-	SaveLevel(BaseSaveUrl, Index, true);
+	SaveLevel(ConstructLevelSaveUrl(BaseSaveUrl, CurrentLevel), Index, true);
+
+	if (SavePipeline) SavePipeline->SubmitBatch();
 
 	// TODO: fix save references that work in code however are causing trouble in game. Check if values are being edited when the information is created on clients
 
@@ -112,7 +158,7 @@ bool AGameModeSaveLogic::LoadSave(const FString& BaseSaveUrl, const int32 Index)
 
 	// Check if it's a valid save
 	FString SaveUrl = BaseSaveUrl + AppendSaveIndex(Index);
-	USave* Save = Cast<USave>(UGameplayStatics::LoadGameFromSlot(SaveUrl, 0));
+	USave* Save = Cast<USave>(USaveFunctionLibrary::LoadGameFromSlot(this, SaveUrl, 0));
 	if (!Save)
 	{
 		UE_LOGFMT(GameModeLog, Error, "{0}() SaveUrl {1} is invalid", *FString(__FUNCTION__), *SaveUrl);
@@ -160,65 +206,17 @@ bool AGameModeSaveLogic::LoadSave(const FString& BaseSaveUrl, const int32 Index)
 #pragma region Save Handling
 bool AGameModeSaveLogic::FindCurrentSave(const FString& BaseUrl, FString& OutSaveUrl, int32& OutSaveIndex) const
 {
-	// Construct the SaveGameId
-	int32 Index = 0;
-	FString SaveUrl = BaseUrl + AppendSaveIndex(Index);
-	
-	// Check if there's save information for this slot
-	if (!UGameplayStatics::DoesSaveGameExist(SaveUrl, 0))
+	// The manifest's entries are sorted by their save index, the most recent save is the last entry
+	const USaved_Manifest* Manifest = GetManifest(BaseUrl);
+	F_SaveManifestEntry CurrentSaveEntry;
+	if (!Manifest || !Manifest->GetLatestSave(CurrentSaveEntry))
 	{
-		UE_LOGFMT(GameModeLog, Error, "!{0}() wasn't save information for SaveUrl: {2}, Index: {3}", *FString(__FUNCTION__), *SaveUrl, Index);
+		UE_LOGFMT(GameModeLog, Error, "!{0}() wasn't save information for BaseUrl: {1}", *FString(__FUNCTION__), *BaseUrl);
 		return false;
 	}
 
-	// Find the most recent save, and delete the saves
-	int32 SearchIndex = Index;
-	int32 SearchStep = 100;
-	bool bFoundCurrentSaveIndex = false;
-	int32 bSaveSearchErrorCount = 0;
-	
-	FString LastValidSaveUrl = SaveUrl;
-	int32 LastValidSaveIndex = 0;
-	while (!bFoundCurrentSaveIndex || bSaveSearchErrorCount < 5)
-	{
-		SearchIndex = SearchIndex + SearchStep;
-		SaveUrl = BaseUrl + AppendSaveIndex(SearchIndex);
-
-		// If there's still save slots
-		if (UGameplayStatics::DoesSaveGameExist(SaveUrl, 0))
-		{
-			LastValidSaveUrl = SaveUrl;
-			LastValidSaveIndex = SearchIndex;
-			continue;
-		}
-		
-		// If the search step is one, this is the most current save
-		if (SearchStep == 1)
-		{
-			bFoundCurrentSaveIndex = true;
-			SearchIndex = SearchIndex - 1;
-
-			bSaveSearchErrorCount++;
-		}
-		else // Backstep and search again  // IndexToFind = 479 ->  100, 200, 300, 400, 500/, 450, 500/, 475, etc.
-		{
-			SearchIndex = SearchIndex - SearchStep;
-			SearchStep = SearchStep / 2;
-			// if (SearchStep == 0) SearchStep = 1;
-		}
-	}
-
-	// An error occured 
-	if (bSaveSearchErrorCount >= 5)
-	{
-		OutSaveUrl = LastValidSaveUrl;
-		OutSaveIndex = LastValidSaveIndex;
-	}
-	else
-	{
-		OutSaveUrl = BaseUrl + AppendSaveIndex(SearchIndex);
-		OutSaveIndex = SearchIndex;
-	}
+	OutSaveUrl = BaseUrl + AppendSaveIndex(CurrentSaveEntry.SaveIndex);
+	OutSaveIndex = CurrentSaveEntry.SaveIndex;
 	return true;
 }
 
@@ -226,12 +224,9 @@ bool AGameModeSaveLogic::FindCurrentSave(const FString& BaseUrl, FString& OutSav
 TArray<FString> AGameModeSaveLogic::FindPreviousSaves(const FString& SaveUrl, int32 CurrentSaveIndex, int32 SavesToRetrieve) const
 {
 	TArray<FString> PreviousSaves;
-	for (int32 Index = CurrentSaveIndex - 1; Index >= 0; Index--)
+	for (const int32 Index : FindPreviousSaveIndexes(SaveUrl, CurrentSaveIndex, SavesToRetrieve))
 	{
-		// Check if it's a valid save
-		FString CurrentSaveUrl = SaveUrl + AppendSaveIndex(Index);
-		if (UGameplayStatics::DoesSaveGameExist(CurrentSaveUrl, 0)) PreviousSaves.AddUnique(CurrentSaveUrl);
-		if (PreviousSaves.Num() >= SavesToRetrieve) return PreviousSaves;
+		PreviousSaves.Add(SaveUrl + AppendSaveIndex(Index));
 	}
 
 	return PreviousSaves;
@@ -239,16 +234,10 @@ TArray<FString> AGameModeSaveLogic::FindPreviousSaves(const FString& SaveUrl, in
 
 TArray<int32> AGameModeSaveLogic::FindPreviousSaveIndexes(const FString& SaveUrl, int32 CurrentSaveIndex, int32 SavesToRetrieve) const
 {
-	TArray<int32> PreviousSaves;
-	for (int32 Index = CurrentSaveIndex - 1; Index >= 0; Index--)
-	{
-		// Check if it's a valid save
-		FString CurrentSaveUrl = SaveUrl + AppendSaveIndex(Index);
-		if (UGameplayStatics::DoesSaveGameExist(CurrentSaveUrl, 0)) PreviousSaves.AddUnique(Index);
-		if (PreviousSaves.Num() >= SavesToRetrieve) return PreviousSaves;
-	}
-
-	return PreviousSaves;
+	// Only retrieve the saves that have written this save url (base, level, or player saves)
+	const USaved_Manifest* Manifest = GetManifest(SaveUrl);
+	if (!Manifest) return TArray<int32>();
+	return Manifest->GetPreviousSaveIndexes(CurrentSaveIndex, SavesToRetrieve, SaveUrl);
 }
 
 
@@ -263,15 +252,13 @@ bool AGameModeSaveLogic::ReadyNextSave()
 		return false;
 	}
 
-	// Check if the next save index is empty, if not increment until we find an empty slot
-	FString Url;
-	int32 CurrentIndex;
-	FindCurrentSave(Save->SaveUrl, Url, CurrentIndex);
-	if (UGameplayStatics::DoesSaveGameExist(Save->SaveUrl + AppendSaveIndex(CurrentIndex + 1), 0))
+	// The next save index is after the most recent save in the manifest
+	int32 CurrentIndex = CurrentSave->SaveIndex;
+	F_SaveManifestEntry CurrentSaveEntry;
+	const USaved_Manifest* Manifest = GetCurrentManifest();
+	if (Manifest && Manifest->GetLatestSave(CurrentSaveEntry))
 	{
-		// Something is wrong with finding the most recent function
-		UE_LOGFMT(GameModeLog, Warning, "!{0}() Failed to find the next save index while readying the next save! Url: {1}, Index: {2}", *FString(__FUNCTION__), Url, CurrentIndex + 1);
-		return false;
+		CurrentIndex = FMath::Max(CurrentIndex, CurrentSaveEntry.SaveIndex);
 	}
 
 	// Save 
@@ -309,51 +296,28 @@ bool AGameModeSaveLogic::ReadyNextSave()
 
 bool AGameModeSaveLogic::DeleteSaveSlot(const FString& AccountId, int32 SaveSlot)
 {
-	// Construct the SaveGameId
-	FString SaveUrl = ConstructSaveUrl(AccountId, SaveSlot).Append(AppendSaveIndex(0));
-
-	// Check if there's save information for this slot
-	if (!UGameplayStatics::DoesSaveGameExist(SaveUrl, 0))
-	{
-		UE_LOGFMT(GameModeLog, Error, "!{0}() wasn't save information in slot {1}, SaveUrl: {2}", *FString(__FUNCTION__), SaveSlot, *SaveUrl);
-		return true;
-	}
-
-	// Find the most recent save, and delete the saves
+	// Find every save slot from the manifest
 	FString BaseSaveUrl = ConstructSaveUrl(AccountId, SaveSlot);
-	FString CurrentSaveUrl; // TODO: This needs to be adjusted
-	int32 CurrentSaveIndex = 0;
-	if (!FindCurrentSave(BaseSaveUrl, CurrentSaveUrl, CurrentSaveIndex))
+	USaved_Manifest* Manifest = GetManifest(BaseSaveUrl);
+	if (!Manifest || Manifest->IsEmpty())
 	{
-		UE_LOGFMT(GameModeLog, Error, "!{0}() couldn't find the current save information in slot {1}, SaveUrl: {2}", *FString(__FUNCTION__), SaveSlot, *SaveUrl);
+		UE_LOGFMT(GameModeLog, Error, "!{0}() wasn't save information in slot {1}, SaveUrl: {2}", *FString(__FUNCTION__), SaveSlot, *BaseSaveUrl);
 		return true;
 	}
 
-	// Delete all the previous saves
-	USave* SaveToDelete = Cast<USave>(UGameplayStatics::LoadGameFromSlot(CurrentSaveUrl, 0));
-	if (SaveToDelete)
-	{
-		for (int32 i = CurrentSaveIndex; CurrentSaveIndex > 0; i--)
-		{
-			// Actual Saves
-			CurrentSaveUrl = ConstructSaveUrl(AccountId, SaveSlot).Append(AppendSaveIndex(i));
-			UGameplayStatics::DeleteGameInSlot(CurrentSaveUrl, 0);
-			
-			// Level Saves
-			for (FString Level : SaveToDelete->SavedLevels)
-			{
-				FString LevelSaveUrl = ConstructLevelSaveUrl(BaseSaveUrl, Level, CurrentSaveIndex);
-				UGameplayStatics::DeleteGameInSlot(LevelSaveUrl, 0);
-			}
+	// Don't let pending saves recreate the slots after they've been deleted
+	if (SavePipeline) SavePipeline->Flush();
 
-			// Player Saves
-			for (FString Player : SaveToDelete->SavedPlayers)
-			{
-				FString PlayerSaveUrl = ConstructPlayerSaveUrl(BaseSaveUrl, Player, CurrentSaveIndex).Append(AppendSaveIndex(i));
-				UGameplayStatics::DeleteGameInSlot(PlayerSaveUrl, 0);
-			}
-		}
+	// Delete the save, level, player, and actor slots of every save index
+	for (const FString& SlotName : Manifest->GetAllSlotNames())
+	{
+		UGameplayStatics::DeleteGameInSlot(SlotName, 0);
 	}
+
+	// Delete the manifest
+	UGameplayStatics::DeleteGameInSlot(ConstructManifestSaveUrl(BaseSaveUrl, 0), 0);
+	UGameplayStatics::DeleteGameInSlot(ConstructManifestSaveUrl(BaseSaveUrl, 1), 0);
+	if (CurrentManifest == Manifest) CurrentManifest = nullptr;
 	
 	return true;
 }
@@ -365,7 +329,8 @@ USave* AGameModeSaveLogic::NewSaveSlot(const FString& AccountId, int32 SaveSlot)
 	FString SaveUrl = ConstructSaveUrl(AccountId, SaveSlot).Append(AppendSaveIndex(0));
 
 	// Check if there's already save information for this slot
-	if (UGameplayStatics::DoesSaveGameExist(SaveUrl, 0))
+	const USaved_Manifest* Manifest = GetManifest(ConstructSaveUrl(AccountId, SaveSlot));
+	if (Manifest && !Manifest->IsEmpty())
 	{
 		UE_LOGFMT(GameModeLog, Error, "!{0}() Unable to create a new save, there's already a save in slot {1}, SaveUrl: {2}", *FString(__FUNCTION__), SaveSlot, *SaveUrl);
 		return nullptr;
@@ -393,60 +358,32 @@ USave* AGameModeSaveLogic::NewSaveSlot(const FString& AccountId, int32 SaveSlot)
 bool AGameModeSaveLogic::SaveLevel_Implementation(const FString& SaveLevelUrl, int32 Index, bool bSaveActorData)
 {
 	// Safety precautions
-	if (!GetLevel()) return false;
-
-	// Check if we have a valid save game slot, otherwise create one
-	USaved_Level* LevelSave = Cast<USaved_Level>(UGameplayStatics::LoadGameFromSlot(SaveLevelUrl + AppendSaveIndex(Index), 0));
-	if (!LevelSave)
+	if (!GetLevel() || SaveLevelUrl.IsEmpty()) return false;
+	if (!IsValidToCurrentlySaveLevel())
 	{
-		LevelSave = NewObject<USaved_Level>(this, USaved_Level::StaticClass());
-		if (!LevelSave) return false;
+		UE_LOGFMT(GameModeLog, Warning, "{0}() {1} Unable to save the level to {2} while it's being restored", *FString(__FUNCTION__), *GetName(), *SaveLevelUrl);
+		return false;
 	}
-	
-	
-	// Retrieve actors in the level, players, and spawned actors
-	TArray<FString> SpawnedActors;
-	TArray<FString> Players;
-	TArray<AActor*> LevelActors;
-	CurrentLevelSave = LevelSave;
-	CurrentLevelSave->GetSavedAndSpawnedActors(GetLevel(), SpawnedActors, LevelActors, Players);
 
-	// Search through the level for actors with save logic, and find the actors that have save state
-	for (AActor* Actor : LevelActors)
+	// Continue from the level's current save state, otherwise retrieve the save from the slot or create one
+	const FString IndexedLevelSaveUrl = SaveLevelUrl + AppendSaveIndex(Index);
+	const bool bCaptureLevel = !CurrentLevelSave || bSaveActorData || CurrentLevelSaveUrl != IndexedLevelSaveUrl;
+	if (!CurrentLevelSave)
 	{
-		if (!Actor) continue;
-		if (!Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass())) continue;
-		if (APlayerCharacter* Player = Cast<APlayerCharacter>(Actor)) continue;
-
-		// Retrieve save information
-		FString Id = ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor);
-		F_LevelSaveInformation_Actor SaveInformation = ILevelSaveInformationInterface::Execute_SaveToLevel(Actor);
-		if (SaveInformation.IsValid())
-		{
-			// Save Level Information
-			TMap<FString, F_LevelSaveInformation_Actor>& LevelSaveInformation = CurrentLevelSave->SavedActors;
-			if (LevelSaveInformation.Contains(Id)) LevelSaveInformation[Id] = SaveInformation;
-			else LevelSaveInformation.Add(Id, SaveInformation);
-
-			// If we save it to it's own game slot // TODO: this is handled for all character information on their own save component. Either use ILevelSaveInformationInterface to save / retrieve information, or handle it here for non players
-			FString ActorSaveUrl = SaveLevelUrl + AppendSaveIndex(Index) + "_" + Id; // SaveComponent -> ActorSaveUrl + SaveComponent save
-			if (USaveGame* ActorSaveInformation = UGameplayStatics::LoadGameFromSlot(ActorSaveUrl, 0))
-			{
-				// ILevelSaveInformationInterface::Execute_Save()
-			}
-
-			// Save Actor Information
-			if (bSaveActorData)
-			{
-				ILevelSaveInformationInterface::Execute_SaveActorData(Actor, SaveInformation);
-			}
-		}
+		CurrentLevelSave = LoadLevelSave(IndexedLevelSaveUrl);
+		if (!CurrentLevelSave) CurrentLevelSave = NewObject<USaved_Level>(this, USaved_Level::StaticClass());
+		if (!CurrentLevelSave) return false;
 	}
 
+	// Capture the actors that have changed since the level was last saved. Every actor is captured when we're writing a new snapshot
+	// TODO: Save actor information to it's own game slot. This is handled for all character information on their own save component. Either use ILevelSaveInformationInterface to save / retrieve information, or handle it here for non players
+	USaved_LevelDelta* Delta = CaptureLevelDelta(bCaptureLevel, bSaveActorData);
+	CurrentLevelSave->ApplyDelta(Delta);
+
 	// TODO: Add to saved levels list
 	
 	// Save the level information to the game slot
-	return UGameplayStatics::SaveGameToSlot(CurrentLevelSave, SaveLevelUrl + AppendSaveIndex(Index), 0);
+	return WriteLevelSave(IndexedLevelSaveUrl, Delta, bCaptureLevel);
 }
 
 
@@ -454,9 +391,15 @@ bool AGameModeSaveLogic::LoadLevel_Implementation(const FString& SaveLevelUrl, i
 {
 	// Safety precautions
 	if (!GetLevel()) return false;
+	CancelLevelLoad();
+
+	// The level's current changes are replaced by the save, gameplay changes made while it's restored are kept
+	DirtyActors.Reset();
+	RemovedActors.Reset();
 
 	// Check if we have a valid save game slot
-	CurrentLevelSave = Cast<USaved_Level>(UGameplayStatics::LoadGameFromSlot(SaveLevelUrl + AppendSaveIndex(Index), 0));
+	const FString IndexedLevelSaveUrl = SaveLevelUrl + AppendSaveIndex(Index);
+	CurrentLevelSave = LoadLevelSave(IndexedLevelSaveUrl);
 	if (!CurrentLevelSave)
 	{
 		// Try to find a previous save where the player was on this level
@@ -466,111 +409,238 @@ bool AGameModeSaveLogic::LoadLevel_Implementation(const FString& SaveLevelUrl, i
 		return false;
 	}
 	
-	// Retrieve actors in the level, players, and spawned actors
+	// Retrieve the saveable actors in the level, players, and spawned actors
 	TMap<FString, F_LevelSaveInformation_Actor>& SavedActors = CurrentLevelSave->SavedActors;
 	TArray<FString> SpawnedActors;
 	TArray<FString> Players;
 	TArray<AActor*> LevelActors;
 	CurrentLevelSave->GetSavedAndSpawnedActors(GetLevel(), SpawnedActors, LevelActors, Players);
+	
+	TArray<const FSaveableActor*> SaveableActors;
+	if (const USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->GetActorsInLevel(GetLevel(), SaveableActors);
+	}
 
-	// Search through the level for actors with save logic, and find players with save state
-	// TODO: Refactor this for proper structure for handling level/spawned actors and player information dynamically, and with efficient retrieving of the references
-	for (AActor* Actor : LevelActors)
+	// Queue the saveable actors in the level that have save state. Players aren't registered, and are loaded with their own save components
+	LevelLoad = FLevelLoadState();
+	LevelLoad.bLoading = true;
+	LevelLoad.bRetrieveActorData = bRetrieveActorData;
+	LevelLoad.IndexedLevelSaveUrl = IndexedLevelSaveUrl;
+	LevelLoad.ActorsToRestore.Reserve(SaveableActors.Num());
+	for (const FSaveableActor* SaveableActor : SaveableActors)
 	{
+		AActor* Actor = SaveableActor->Actor.Get();
 		if (!Actor) continue;
-		if (!Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass())) continue;
-		if (APlayerCharacter* Player = Cast<APlayerCharacter>(Actor)) continue;
 
-		FString Id = ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor);
-		if (SavedActors.Contains(Id))
+		// TODO: Logic for handling level actors that don't have save information?
+		if (F_LevelSaveInformation_Actor* SavedInformation = SavedActors.Find(SaveableActor->Id))
 		{
-			// Load the level actor / current player's saved information
-			SavedActors[Id].Actor = Actor;
-			const F_LevelSaveInformation_Actor& SaveData = SavedActors[Id];
+			SavedInformation->Actor = Actor;
+			LevelLoad.ActorsToRestore.Emplace(Actor, SaveableActor->Id);
+		}
+	}
+	
+	// Queue the actors that were previously spawned in the world, and load their classes while the level actors are being restored
+	TArray<FSoftObjectPath> SpawnedClasses;
+	LevelLoad.ActorsToSpawn.Reserve(SpawnedActors.Num());
+	for (const FString& Id : SpawnedActors)
+	{
+		const F_LevelSaveInformation_Actor* SaveData = SavedActors.Find(Id);
+		if (!SaveData || !SaveData->IsValidForSpawning()) continue;
 
-			// Handle actor specific logic here
-			if (SaveData.SaveType == ESaveIdType::LevelActor)
-			{
-				
-			}
-			else if (SaveData.SaveType == ESaveIdType::SpawnedActor)
-			{
-				
-			}
+		LevelLoad.ActorsToSpawn.Add(Id);
+		if (SaveData->Class.IsPending()) SpawnedClasses.AddUnique(SaveData->Class.ToSoftObjectPath());
+	}
 
-			// Load the actor's information
-			if (bRetrieveActorData)
-			{
-				ILevelSaveInformationInterface::Execute_LoadFromLevel(Actor, SavedActors[Id], bRetrieveActorData);
-			}
-		}
+	if (!bTimeSliceLevelLoading)
+	{
+		ProcessLevelLoad();
+		return true;
+	}
 
-		// TODO: Logic for handling level actors that don't have save information?
-		
+	if (!SpawnedClasses.IsEmpty())
+	{
+		LevelLoad.ClassLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SpawnedClasses, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
 	}
 	
-	// Spawn actors that were previously spawned in the world
-	for (FString Id : SpawnedActors)
+	OnLevelLoadProgress.Broadcast(0.0f);
+	LevelLoad.TimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AGameModeSaveLogic::ProcessLevelLoad);
+	return true;
+}
+
+
+void AGameModeSaveLogic::ProcessLevelLoad()
+{
+	if (!LevelLoad.bLoading) return;
+	if (!CurrentLevelSave || !GetWorld())
 	{
-		if (!SavedActors.Contains(Id)) continue;
-		if (!SavedActors[Id].IsValidForSpawning()) continue;
+		FinishLevelLoad(false);
+		return;
+	}
 
-		// Spawn and place the actor in the level
-		const F_LevelSaveInformation_Actor& SaveData = SavedActors[Id];
-		FActorSpawnParameters SpawnInfo;
-		SpawnInfo.OverrideLevel = GetLevel();
-		FTransform SpawnTransform = FTransform(SaveData.Rotation, SaveData.Location, FVector(0));
+	// Restore and spawn actors until we've used the frame's budget. At least one actor is handled each frame
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = bTimeSliceLevelLoading ? LevelLoadFrameBudget / 1000.0 : TNumericLimits<double>::Max();
+	auto HasTimeRemaining = [StartTime, Budget]() { return FPlatformTime::Seconds() - StartTime < Budget; };
+	TMap<FString, F_LevelSaveInformation_Actor>& SavedActors = CurrentLevelSave->SavedActors;
 
-		AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(SaveData.Class, SpawnTransform, SpawnInfo);
-		if (!SpawnedActor)
+	// Restore the actors that are placed in the level
+	while (LevelLoad.RestoreIndex < LevelLoad.ActorsToRestore.Num())
+	{
+		const TPair<TWeakObjectPtr<AActor>, FString>& ActorToRestore = LevelLoad.ActorsToRestore[LevelLoad.RestoreIndex++];
+		AActor* Actor = ActorToRestore.Key.Get();
+		const F_LevelSaveInformation_Actor* SaveData = SavedActors.Find(ActorToRestore.Value);
+		if (Actor && SaveData)
 		{
-			UE_LOGFMT(GameModeLog, Error, "{0}() {1} Failed to spawn actor {2}!", *FString(__FUNCTION__), *GetName(), *SaveData.Class->GetName());
+			TGuardValue<bool> RestoringActor(LevelLoad.bRestoringActor, true);
+			RestoreSavedActor(Actor, *SaveData, LevelLoad.bRetrieveActorData);
 		}
-		else
+
+		if (!HasTimeRemaining()) break;
+	}
+
+	// Spawn the actors that were previously spawned in the world once their classes have been loaded
+	const bool bClassesLoaded = !LevelLoad.ClassLoadHandle.IsValid() || LevelLoad.ClassLoadHandle->HasLoadCompleted();
+	if (LevelLoad.RestoreIndex >= LevelLoad.ActorsToRestore.Num() && bClassesLoaded && HasTimeRemaining())
+	{
+		while (LevelLoad.SpawnIndex < LevelLoad.ActorsToSpawn.Num())
 		{
-			// Load the actor's save information
-			if (SpawnedActor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass()))
+			const F_LevelSaveInformation_Actor* SaveData = SavedActors.Find(LevelLoad.ActorsToSpawn[LevelLoad.SpawnIndex++]);
+			if (SaveData)
 			{
-				ILevelSaveInformationInterface::Execute_LoadFromLevel(SpawnedActor, SaveData, bRetrieveActorData);
-				
-				// Init logic for when we spawn actors that were saved to the level
+				TGuardValue<bool> RestoringActor(LevelLoad.bRestoringActor, true);
+				SpawnSavedActor(*SaveData, LevelLoad.bRetrieveActorData);
 			}
+
+			if (!HasTimeRemaining()) break;
 		}
 	}
 
+	// Continue next frame until every actor has been restored
+	if (LevelLoad.RestoreIndex < LevelLoad.ActorsToRestore.Num() || LevelLoad.SpawnIndex < LevelLoad.ActorsToSpawn.Num())
+	{
+		OnLevelLoadProgress.Broadcast(GetLevelLoadProgress());
+		LevelLoad.TimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AGameModeSaveLogic::ProcessLevelLoad);
+		return;
+	}
+
+	FinishLevelLoad(true);
+}
+
+
+void AGameModeSaveLogic::FinishLevelLoad(const bool bSuccessfullyLoaded)
+{
+	const FString IndexedLevelSaveUrl = LevelLoad.IndexedLevelSaveUrl;
+	if (LevelLoad.ClassLoadHandle.IsValid()) LevelLoad.ClassLoadHandle->ReleaseHandle();
+	LevelLoad = FLevelLoadState();
+
+	// The level's state matches it's save, further changes (including the ones made while it was restored) are appended to this snapshot
+	if (bSuccessfullyLoaded)
+	{
+		CurrentLevelSaveUrl = IndexedLevelSaveUrl;
+		OnLevelLoadProgress.Broadcast(1.0f);
+	}
+	
+	OnLevelLoadCompleted.Broadcast(bSuccessfullyLoaded);
+}
+
+
+bool AGameModeSaveLogic::RestoreSavedActor(AActor* Actor, const F_LevelSaveInformation_Actor& SaveData, const bool bRetrieveActorData)
+{
+	if (!Actor) return false;
+	
+	// Handle actor specific logic here
+	if (SaveData.SaveType == ESaveIdType::LevelActor)
+	{
+		
+	}
+	else if (SaveData.SaveType == ESaveIdType::SpawnedActor)
+	{
+		
+	}
+
+	// Load the actor's information
+	if (bRetrieveActorData)
+	{
+		return ILevelSaveInformationInterface::Execute_LoadFromLevel(Actor, SaveData, bRetrieveActorData);
+	}
+
 	return true;
 }
 
 
+AActor* AGameModeSaveLogic::SpawnSavedActor(const F_LevelSaveInformation_Actor& SaveData, const bool bRetrieveActorData)
+{
+	// The class is usually loaded asynchronously before this, otherwise it's loaded here
+	UClass* ActorClass = SaveData.Class.LoadSynchronous();
+	if (!ActorClass)
+	{
+		UE_LOGFMT(GameModeLog, Error, "{0}() {1} Failed to load the class {2} of {3}!", *FString(__FUNCTION__), *GetName(), *SaveData.Class.ToString(), *SaveData.Id);
+		return nullptr;
+	}
+	
+	// Spawn and place the actor in the level
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.OverrideLevel = GetLevel();
+	FTransform SpawnTransform = FTransform(SaveData.Rotation, SaveData.Location, FVector::OneVector);
+
+	AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnInfo);
+	if (!SpawnedActor)
+	{
+		UE_LOGFMT(GameModeLog, Error, "{0}() {1} Failed to spawn actor {2}!", *FString(__FUNCTION__), *GetName(), *ActorClass->GetName());
+		return nullptr;
+	}
+	
+	// Load the actor's save information
+	if (SpawnedActor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass()))
+	{
+		ILevelSaveInformationInterface::Execute_LoadFromLevel(SpawnedActor, SaveData, bRetrieveActorData);
+		
+		// Init logic for when we spawn actors that were saved to the level
+	}
+
+	return SpawnedActor;
+}
+
+
 bool AGameModeSaveLogic::AutoSaveHandling_Implementation()
 {
 	// Safety precautions
-	if (!CurrentSave || !GetLevel()) return false;
+	if (!CurrentSave || !GetLevel() || !CurrentLevelSave) return false;
+
+	// Changes made while the level is restored are saved by the next autosave once it's finished
+	if (!IsValidToCurrentlySaveLevel()) return false;
 	
 	// Everything's already been saved
-	if (PendingSaves.IsEmpty()) return false;
+	MarkCharactersDirty();
+	if (PendingSaves.IsEmpty() && DirtyActors.IsEmpty() && RemovedActors.IsEmpty()) return false;
 
 	// Check if we have a valid save game slot, otherwise create one
-	FString IndexedLevelSaveUrl = GetCurrentSaveUrl() + "_" + CurrentSave->LevelInformation.LevelName + AppendSaveIndex(CurrentSave->SaveIndex);
+	FString IndexedLevelSaveUrl = ConstructLevelSaveUrl(GetCurrentSaveUrl(), CurrentSave->LevelInformation.LevelName, CurrentSave->SaveIndex);
 	
+	// Only the actors that have changed are captured, the cost of an autosave is based on the amount of changes instead of the size of the level
+	if (SavePipeline) SavePipeline->BeginBatch(CurrentSave->SaveIndex);
+	USaved_LevelDelta* Delta = CaptureLevelDelta(false, false);
+
 	// Update the actors save state for those that are pending save
 	for (auto &[Id, Data] : PendingSaves) // TODO: Add ways of handling this based on the server's capacity to handle it at the moment
 	{
-		TMap<FString, F_LevelSaveInformation_Actor>& SaveData = CurrentLevelSave->SavedActors;
-
-		// Update the level save information if there's already save information, otherwise initialize the save information
-		if (SaveData.Contains(Id)) SaveData[Id] = Data;
-		else SaveData.Add(Id, Data);
+		Delta->SavedActors.Add(Id, Data);
+		Delta->RemovedActors.Remove(Id);
 
 		// Save character specific state update based on the save configurations. This is where you'd handle saving multiplayer state for specific characters, or just saving that information to the level based on your game
-		if (Data.Actor.Get()->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass()))
+		AActor* Actor = Data.Actor.Get();
+		if (Actor && Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass()))
 		{
-			ILevelSaveInformationInterface::Execute_SaveActorData(Data.Actor.Get(), Data);
+			ILevelSaveInformationInterface::Execute_SaveActorData(Actor, Data);
 		}
 	}
 
-	// Save the information to the save game slot. Subclass to add Subsystem functionality or to save the information to an api
-	bool bSuccessfullySaved = UGameplayStatics::SaveGameToSlot(CurrentLevelSave, IndexedLevelSaveUrl, 0);
+	// Append the changes to the level's snapshot. Subclass to add Subsystem functionality or to save the information to an api
+	CurrentLevelSave->ApplyDelta(Delta);
+	bool bSuccessfullySaved = WriteLevelSave(IndexedLevelSaveUrl, Delta);
+	if (SavePipeline) SavePipeline->SubmitBatch();
 
 	// Clear out the pending save list if we saved the data properly
 	if (bSuccessfullySaved) PendingSaves.Empty();
@@ -588,13 +658,199 @@ void AGameModeSaveLogic::AddPendingActor_Implementation(const F_LevelSaveInforma
 
 bool AGameModeSaveLogic::IsValidToCurrentlySaveLevel_Implementation() const
 {
+	return !IsLoadingLevel();
+}
+
+
+void AGameModeSaveLogic::MarkActorDirty(AActor* Actor)
+{
+	if (!Actor || !HasAuthority() || LevelLoad.bRestoringActor) return;
+	if (!Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass())) return;
+
+	DirtyActors.Add(Actor);
+}
+
+
+void AGameModeSaveLogic::MarkActorRemoved(const FString& Id)
+{
+	if (Id.IsEmpty() || !HasAuthority() || LevelLoad.bRestoringActor) return;
+
+	PendingSaves.Remove(Id);
+	RemovedActors.AddUnique(Id);
+}
+
+
+void AGameModeSaveLogic::MarkCharactersDirty()
+{
+	const USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this);
+	if (!SaveableActorRegistry || !HasAuthority()) return;
+
+	// Players are saved with their own save slots. Attribute changes and deaths mark characters as they happen, movement is compared against the last save
+	TArray<const FSaveableActor*> SaveableActors;
+	SaveableActorRegistry->GetActorsInLevel(GetLevel(), SaveableActors);
+	for (const FSaveableActor* SaveableActor : SaveableActors)
+	{
+		AActor* Actor = SaveableActor->Actor.Get();
+		if (!Cast<ACharacterBase>(Actor) || Cast<APlayerCharacter>(Actor) || DirtyActors.Contains(Actor)) continue;
+
+		const F_LevelSaveInformation_Actor* SavedCharacter = CurrentLevelSave ? CurrentLevelSave->SavedActors.Find(SaveableActor->Id) : nullptr;
+		if (!SavedCharacter
+			|| !SavedCharacter->Location.Equals(Actor->GetActorLocation(), CharacterSaveLocationTolerance)
+			|| !SavedCharacter->Rotation.Equals(Actor->GetActorRotation(), CharacterSaveRotationTolerance))
+		{
+			DirtyActors.Add(Actor);
+		}
+	}
+}
+
+
+USaved_Level* AGameModeSaveLogic::LoadLevelSave(const FString& IndexedLevelSaveUrl)
+{
+	USaved_Level* LevelSave = Cast<USaved_Level>(USaveFunctionLibrary::LoadGameFromSlot(this, IndexedLevelSaveUrl, 0));
+	if (!LevelSave) return nullptr;
+
+	// Apply the deltas in order until one is missing, or was appended to a previous snapshot (stale deltas are overwritten once the slot is reused)
+	LevelSave->DeltaCount = 0;
+	if (!LevelSave->SnapshotId.IsValid()) return LevelSave;
+	for (int32 Sequence = 1; ; Sequence++)
+	{
+		const USaved_LevelDelta* Delta = Cast<USaved_LevelDelta>(USaveFunctionLibrary::LoadGameFromSlot(this, ConstructLevelDeltaSaveUrl(IndexedLevelSaveUrl, Sequence), 0));
+		if (!Delta || Delta->SnapshotId != LevelSave->SnapshotId || Delta->Sequence != Sequence) break;
+
+		LevelSave->ApplyDelta(Delta);
+		LevelSave->DeltaCount = Sequence;
+	}
+
+	return LevelSave;
+}
+
+
+USaved_LevelDelta* AGameModeSaveLogic::CaptureLevelDelta(const bool bCaptureLevel, const bool bSaveActorData)
+{
+	USaved_LevelDelta* Delta = NewObject<USaved_LevelDelta>(this, USaved_LevelDelta::StaticClass());
+	
+	// Capture the save information of actors with save state
+	auto CaptureActor = [Delta, bSaveActorData](AActor* Actor, const FString& Id)
+	{
+		F_LevelSaveInformation_Actor SaveInformation = ILevelSaveInformationInterface::Execute_SaveToLevel(Actor);
+		if (!SaveInformation.IsValid()) return;
+		Delta->SavedActors.Add(Id, SaveInformation);
+
+		// Save Actor Information
+		if (bSaveActorData)
+		{
+			ILevelSaveInformationInterface::Execute_SaveActorData(Actor, SaveInformation);
+		}
+	};
+	
+	// Every saveable actor in the level, otherwise only the ones that have been marked dirty
+	const USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this);
+	if (bCaptureLevel && SaveableActorRegistry)
+	{
+		TArray<const FSaveableActor*> SaveableActors;
+		SaveableActorRegistry->GetActorsInLevel(GetLevel(), SaveableActors);
+		for (const FSaveableActor* SaveableActor : SaveableActors)
+		{
+			if (AActor* Actor = SaveableActor->Actor.Get()) CaptureActor(Actor, SaveableActor->Id);
+		}
+	}
+	else
+	{
+		MarkCharactersDirty();
+		for (const TWeakObjectPtr<AActor>& DirtyActor : DirtyActors)
+		{
+			AActor* Actor = DirtyActor.Get();
+			if (!Actor || Cast<APlayerCharacter>(Actor)) continue;
+			CaptureActor(Actor, ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor));
+		}
+	}
+
+	// Actors that have been removed, unless they've been added back with the same id
+	for (const FString& Id : RemovedActors)
+	{
+		if (!Delta->SavedActors.Contains(Id)) Delta->RemovedActors.Add(Id);
+	}
+
+	DirtyActors.Reset();
+	RemovedActors.Reset();
+	return Delta;
+}
+
+
+bool AGameModeSaveLogic::WriteLevelSave(const FString& IndexedLevelSaveUrl, USaved_LevelDelta* Delta, const bool bCompact)
+{
+	if (!CurrentLevelSave) return false;
+
+	// Deltas are only valid for the snapshot they're appended to. Compact the level save into a new snapshot for another slot, or once there's enough deltas
+	const bool bWriteSnapshot = bCompact
+		|| !Delta
+		|| !CurrentLevelSave->SnapshotId.IsValid()
+		|| CurrentLevelSaveUrl != IndexedLevelSaveUrl
+		|| CurrentLevelSave->DeltaCount >= LevelSaveCompactionThreshold;
+	
+	if (bWriteSnapshot)
+	{
+		CurrentLevelSave->SnapshotId = FGuid::NewGuid();
+		CurrentLevelSave->DeltaCount = 0;
+		CurrentLevelSaveUrl = IndexedLevelSaveUrl;
+		if (USaveFunctionLibrary::SaveGameToSlot(this, CurrentLevelSave, IndexedLevelSaveUrl, 0)) return true;
+
+		UE_LOGFMT(GameModeLog, Error, "{0}() {1} Failed to save the level's snapshot to {2}!", *FString(__FUNCTION__), *GetName(), *IndexedLevelSaveUrl);
+		CurrentLevelSaveUrl.Empty();
+		return false;
+	}
+
+	// Nothing's changed
+	if (Delta->IsEmpty()) return true;
+
+	Delta->SnapshotId = CurrentLevelSave->SnapshotId;
+	Delta->Sequence = CurrentLevelSave->DeltaCount + 1;
+	if (!USaveFunctionLibrary::SaveGameToSlot(this, Delta, ConstructLevelDeltaSaveUrl(IndexedLevelSaveUrl, Delta->Sequence), 0))
+	{
+		// A missing delta ends the chain when the level is loaded, the next save writes a new snapshot with every change
+		UE_LOGFMT(GameModeLog, Error, "{0}() {1} Failed to append delta {2} to {3}!", *FString(__FUNCTION__), *GetName(), Delta->Sequence, *IndexedLevelSaveUrl);
+		CurrentLevelSaveUrl.Empty();
+		return false;
+	}
+
+	CurrentLevelSave->DeltaCount = Delta->Sequence;
 	return true;
 }
 
 
+void AGameModeSaveLogic::CancelLevelLoad()
+{
+	if (!LevelLoad.bLoading) return;
+
+	GetWorldTimerManager().ClearTimer(LevelLoad.TimerHandle);
+	if (LevelLoad.ClassLoadHandle.IsValid()) LevelLoad.ClassLoadHandle->CancelHandle();
+	LevelLoad = FLevelLoadState();
+}
+
+
+bool AGameModeSaveLogic::IsLoadingLevel() const
+{
+	return LevelLoad.bLoading;
+}
+
+
+float AGameModeSaveLogic::GetLevelLoadProgress() const
+{
+	if (!LevelLoad.bLoading) return 1.0f;
+	
+	const int32 Total = LevelLoad.GetTotal();
+	if (Total == 0) return 0.0f;
+	return static_cast<float>(LevelLoad.RestoreIndex + LevelLoad.SpawnIndex) / Total;
+}
+
+
 void AGameModeSaveLogic::ResetLevelSaveComponentState()
 {
+	CancelLevelLoad();
 	PendingSaves.Empty();
+	DirtyActors.Reset();
+	RemovedActors.Reset();
+	CurrentLevelSaveUrl.Empty();
 	CurrentLevelSave = nullptr;
 }
 #pragma endregion
@@ -709,6 +965,217 @@ void AGameModeSaveLogic::UpdatePlayerWithSaveReferences(APlayerController* Playe
 
 
 
+#pragma region Save Manifest
+USaved_Manifest* AGameModeSaveLogic::GetCurrentManifest()
+{
+	if (!CurrentSave) return nullptr;
+	if (!CurrentManifest || CurrentManifest->BaseUrl != CurrentSave->SaveUrl)
+	{
+		CurrentManifest = LoadManifest(CurrentSave->SaveUrl);
+	}
+
+	return CurrentManifest;
+}
+
+
+USaved_Manifest* AGameModeSaveLogic::GetManifest(const FString& BaseUrl) const
+{
+	// Level and player save urls are prefixed with the base url
+	if (CurrentManifest && IsSaveUrlOf(BaseUrl, CurrentManifest->BaseUrl)) return CurrentManifest;
+	return LoadManifest(BaseUrl);
+}
+
+
+bool AGameModeSaveLogic::IsSaveUrlOf(const FString& SaveUrl, const FString& BaseUrl)
+{
+	if (BaseUrl.IsEmpty() || !SaveUrl.StartsWith(BaseUrl, ESearchCase::CaseSensitive)) return false;
+	return SaveUrl.Len() == BaseUrl.Len() || SaveUrl[BaseUrl.Len()] == TEXT('_');
+}
+
+
+USaved_Manifest* AGameModeSaveLogic::LoadManifest(const FString& BaseUrl) const
+{
+	// Use the most recent revision that was completely written
+	USaved_Manifest* Manifest = nullptr;
+	for (int64 Buffer = 0; Buffer < 2; Buffer++)
+	{
+		USaved_Manifest* SavedManifest = Cast<USaved_Manifest>(USaveFunctionLibrary::LoadGameFromSlot(this, ConstructManifestSaveUrl(BaseUrl, Buffer), 0));
+		if (!SavedManifest || SavedManifest->BaseUrl != BaseUrl) continue;
+		if (!Manifest || SavedManifest->Revision > Manifest->Revision) Manifest = SavedManifest;
+	}
+
+	if (!Manifest)
+	{
+		UE_LOGFMT(GameModeLog, Log, "{0}() There wasn't a valid manifest for {1}, rebuilding it from the save slots", *FString(__FUNCTION__), *BaseUrl);
+		Manifest = RebuildManifest(BaseUrl);
+	}
+
+	return Manifest;
+}
+
+
+USaved_Manifest* AGameModeSaveLogic::RebuildManifest(const FString& BaseUrl) const
+{
+	USaved_Manifest* Manifest = NewObject<USaved_Manifest>();
+	Manifest->BaseUrl = BaseUrl;
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	TArray<FString> SlotNames;
+	if (!SaveSystem || !SaveSystem->GetSaveGameNames(SlotNames, 0))
+	{
+		UE_LOGFMT(GameModeLog, Warning, "!{0}() Failed to retrieve the save slots while rebuilding the manifest for {1}", *FString(__FUNCTION__), *BaseUrl);
+		return Manifest;
+	}
+
+	for (const FString& SlotName : SlotNames)
+	{
+		int32 SaveIndex;
+		ESaveSlotType SlotType;
+		FString LevelName;
+		if (!ClassifySaveSlot(BaseUrl, SlotName, SaveIndex, SlotType, LevelName)) continue;
+
+		// The size and timestamp are only available for platforms that save to the saved directory
+		const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".sav"));
+		F_SaveManifestSlot Slot;
+		Slot.SlotName = SlotName;
+		Slot.SlotType = SlotType;
+		Slot.Size = FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+		Slot.Timestamp = IFileManager::Get().GetTimeStamp(*Filename);
+		Manifest->RecordSlot(SaveIndex, Slot, LevelName);
+	}
+
+	return Manifest;
+}
+
+
+bool AGameModeSaveLogic::SaveManifest(USaved_Manifest* Manifest)
+{
+	if (!Manifest || Manifest->BaseUrl.IsEmpty()) return false;
+
+	Manifest->Revision++;
+	return USaveFunctionLibrary::SaveGameToSlot(this, Manifest, ConstructManifestSaveUrl(Manifest->BaseUrl, Manifest->Revision), 0);
+}
+
+
+bool AGameModeSaveLogic::ClassifySaveSlot(const FString& BaseUrl, const FString& SlotName, int32& OutSaveIndex, ESaveSlotType& OutSlotType, FString& OutLevelName) const
+{
+	OutSaveIndex = INDEX_NONE;
+	OutSlotType = ESaveSlotType::None;
+	OutLevelName.Reset();
+	
+	const FString Prefix = BaseUrl + "_";
+	if (BaseUrl.IsEmpty() || !SlotName.StartsWith(Prefix)) return false;
+	const FString SlotUrl = SlotName.RightChop(Prefix.Len());
+	if (SlotUrl.StartsWith(TEXT("Manifest"))) return false;
+
+	// Level deltas: BaseUrl + LevelName + SaveIndex + Delta + Sequence
+	FString DeltaLevelUrl;
+	if (SlotUrl.Split(TEXT("_Delta_"), &DeltaLevelUrl, nullptr, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+	{
+		if (!ClassifySaveSlot(BaseUrl, Prefix + DeltaLevelUrl, OutSaveIndex, OutSlotType, OutLevelName)) return false;
+		OutSlotType = ESaveSlotType::Level;
+		return true;
+	}
+
+	// Save: BaseUrl + SaveIndex
+	if (SlotUrl.IsNumeric())
+	{
+		OutSaveIndex = FCString::Atoi(*SlotUrl);
+		OutSlotType = ESaveSlotType::Save;
+		return true;
+	}
+
+	// Level and actor saves: BaseUrl + LevelName + SaveIndex (+ ActorId)
+	auto ClassifyLevelSlot = [&](const FString& LevelName)
+	{
+		if (LevelName.IsEmpty() || !SlotUrl.StartsWith(LevelName + "_")) return false;
+		
+		FString SaveIndex, ActorId;
+		const FString LevelSlotUrl = SlotUrl.RightChop(LevelName.Len() + 1);
+		if (!LevelSlotUrl.Split(TEXT("_"), &SaveIndex, &ActorId)) SaveIndex = LevelSlotUrl;
+		if (!SaveIndex.IsNumeric()) return false;
+
+		OutSaveIndex = FCString::Atoi(*SaveIndex);
+		OutSlotType = ActorId.IsEmpty() ? ESaveSlotType::Level : ESaveSlotType::Actor;
+		OutLevelName = LevelName;
+		return true;
+	};
+	
+	if (ClassifyLevelSlot(CurrentLevel)) return true;
+	for (const auto& [LevelName, LevelInformation] : Levels)
+	{
+		if (ClassifyLevelSlot(LevelName)) return true;
+	}
+
+	// Player saves: BaseUrl + PlayerId + SaveIndex + Category. Level saves of levels that aren't in the level table end with their save index
+	TArray<FString> Segments;
+	SlotUrl.ParseIntoArray(Segments, TEXT("_"));
+	if (Segments.Num() >= 2 && Segments.Last().IsNumeric())
+	{
+		OutSaveIndex = FCString::Atoi(*Segments.Last());
+		OutSlotType = ESaveSlotType::Level;
+		OutLevelName = SlotUrl.LeftChop(Segments.Last().Len() + 1);
+		return true;
+	}
+	
+	if (Segments.Num() >= 3 && Segments[Segments.Num() - 2].IsNumeric())
+	{
+		OutSaveIndex = FCString::Atoi(*Segments[Segments.Num() - 2]);
+		OutSlotType = ESaveSlotType::Player;
+		return true;
+	}
+
+	return false;
+}
+
+
+void AGameModeSaveLogic::HandleSaveBatchWritten(const FSaveBatch& Batch)
+{
+	USaved_Manifest* Manifest = GetCurrentManifest();
+	if (!Manifest) return;
+
+	// Record the slots once they've been written, so the manifest never references a save that isn't on disk
+	bool bUpdatedManifest = false;
+	for (const FSaveSlotWrite& Write : Batch.Writes)
+	{
+		int32 SaveIndex;
+		ESaveSlotType SlotType;
+		FString LevelName;
+		if (!ClassifySaveSlot(Manifest->BaseUrl, Write.SlotName, SaveIndex, SlotType, LevelName)) continue;
+		if (LevelName.IsEmpty() && CurrentSave) LevelName = CurrentSave->LevelInformation.LevelName;
+
+		F_SaveManifestSlot Slot;
+		Slot.SlotName = Write.SlotName;
+		Slot.SlotType = SlotType;
+		Slot.Size = Write.Data.Num();
+		Slot.Timestamp = Write.Timestamp;
+		Manifest->RecordSlot(SaveIndex, Slot, LevelName);
+		bUpdatedManifest = true;
+	}
+
+	if (bUpdatedManifest) SaveManifest(Manifest);
+}
+
+
+void AGameModeSaveLogic::HandleSaveBatchFailed(const FSaveBatch& Batch)
+{
+	if (CurrentLevelSaveUrl.IsEmpty()) return;
+
+	// The level save already has every change, a new snapshot replaces the deltas that are missing from the chain
+	for (const FSaveSlotWrite& Write : Batch.Writes)
+	{
+		if (!IsSaveUrlOf(Write.SlotName, CurrentLevelSaveUrl)) continue;
+
+		UE_LOGFMT(GameModeLog, Warning, "{0}() {1} Failed to write {2}, the next save writes a new snapshot of the level", *FString(__FUNCTION__), *GetName(), *Write.SlotName);
+		CurrentLevelSaveUrl.Empty();
+		return;
+	}
+}
+#pragma endregion
+
+
+
+
 #pragma region Save Url
 bool AGameModeSaveLogic::SetCurrentSave(USave* Save)
 {
@@ -721,6 +1188,7 @@ bool AGameModeSaveLogic::SetCurrentSave(USave* Save)
 	// Update the current save
 	CurrentSave = Save;
 	CurrentSave->SaveUrl = ConstructSaveUrl(SavePlatformId, CurrentSave->SaveSlot);
+	CurrentManifest = LoadManifest(CurrentSave->SaveUrl);
 	
 	// Update the player's client information with the current save reference (for individual save components, this is singleplayer logic)
 	for (APlayerController* PlayerController : GetPlayers())
@@ -750,6 +1218,11 @@ USave* AGameModeSaveLogic::GetCurrentSave() const
 	return CurrentSave;
 }
 
+USavePipeline* AGameModeSaveLogic::GetSavePipeline() const
+{
+	return SavePipeline;
+}
+
 FString AGameModeSaveLogic::GetCurrentSaveUrl() const
 {
 	if (!CurrentSave) return FString();
@@ -782,6 +1255,18 @@ FString AGameModeSaveLogic::ConstructPlayerSaveUrl(FString BaseUrl, FString Play
 	return SaveUrl;
 }
 
+FString AGameModeSaveLogic::ConstructLevelDeltaSaveUrl(const FString& IndexedLevelSaveUrl, const int32 Sequence) const
+{
+	// LevelDeltaUrl: GameModeType + OwnerAccountId + SaveSlot + LevelName + SaveIndex + Delta + Sequence ->  Adventure_Character1_S1_Level1_45_Delta_3
+	return IndexedLevelSaveUrl + "_Delta" + AppendSaveIndex(Sequence);
+}
+
+FString AGameModeSaveLogic::ConstructManifestSaveUrl(const FString& BaseUrl, const int64 Revision) const
+{
+	// ManifestUrl: GameModeType + OwnerAccountId + SaveSlot + Manifest + Buffer ->  Adventure_Character1_S1_Manifest_A
+	return BaseUrl + "_Manifest" + (Revision % 2 == 0 ? "_A" : "_B");
+}
+
 FString AGameModeSaveLogic::AppendSaveIndex(int32 Index) const
 {
 	return "_" + FString::FromInt(Index);
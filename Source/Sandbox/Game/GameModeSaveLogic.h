@@ -10,9 +10,58 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(GameModeLog, Log, All);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelLoadProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelLoadCompleted, bool, bSuccessfullyLoaded);
+
 enum class EGameModeType : uint8;
 class USave;
 class USaved_Level;
+class USaved_LevelDelta;
+class USaved_Manifest;
+class USavePipeline;
+struct FSaveBatch;
+enum class ESaveSlotType : uint8;
+struct FStreamableHandle;
+
+
+/**
+ * The state of a level that's being restored over multiple frames. @ref AGameModeSaveLogic::LoadLevel
+ */
+struct FLevelLoadState
+{
+	/** Whether the level is currently being restored */
+	bool bLoading = false;
+
+	/** Whether the actor's save information is also retrieved */
+	bool bRetrieveActorData = false;
+
+	/** Whether an actor is currently being restored or spawned. The changes it marks are already part of the level save */
+	bool bRestoringActor = false;
+
+	/** The level save slot that's being restored */
+	FString IndexedLevelSaveUrl;
+
+	/** The saveable actors in the level that have save information, and their level id */
+	TArray<TPair<TWeakObjectPtr<AActor>, FString>> ActorsToRestore;
+
+	/** The ids of the actors that were spawned during play and need to be respawned */
+	TArray<FString> ActorsToSpawn;
+
+	/** The next actor that's restored */
+	int32 RestoreIndex = 0;
+
+	/** The next actor that's spawned */
+	int32 SpawnIndex = 0;
+
+	/** Handle for the classes of the spawned actors that are loaded asynchronously */
+	TSharedPtr<FStreamableHandle> ClassLoadHandle;
+
+	/** Handle for processing the next frame */
+	FTimerHandle TimerHandle;
+
+	/** Returns the amount of actors that are restored and spawned */
+	int32 GetTotal() const { return ActorsToRestore.Num() + ActorsToSpawn.Num(); }
+};
 
 
 /**
@@ -23,7 +72,8 @@ class USaved_Level;
  * 
  * TODO: This needs to be refactored in favor of another way of saving multiple indices of a slot.
  *			- I wanted fallbacks for saving while dividing the save, level, and player information, however with the choice of saving to specific instances it just makes for messy code (forward indexing with a previous save reference saving logic) 1, 2, 3, 4, 5, 3, 4, 5, 6 -> 1-9
- * TODO: Add asynchronous save logic. Errors that happen while abruptly stopping save functionality rarely corrupt save logic, however we don't want problems with performance
+ *
+ * Saves are written through the @ref USavePipeline, every slot of a save index is captured on the game thread and written on worker threads as a single batch
  *
  */
 UCLASS()
@@ -50,9 +100,39 @@ protected:
 	/** A stored reference to the save game slot for the current level */
 	UPROPERTY(BlueprintReadWrite, Category= "GameMode|Saving State") TObjectPtr<USaved_Level> CurrentLevelSave;
 
+	/** The manifest of every save index and save slot for the current save. Used instead of searching for saves on disk */
+	UPROPERTY(BlueprintReadWrite, Category= "GameMode|Saving State") TObjectPtr<USaved_Manifest> CurrentManifest;
+
 	/** Hash table of the saved actors that we need to update in the save slot */ // We're just going to store the updated information here, and remove it once saved for batching
 	UPROPERTY(BlueprintReadWrite, Category = "GameMode|Saving State") TMap<FString, F_LevelSaveInformation_Actor> PendingSaves;
 
+	/** Actors that have changed since the level was last saved. Only these are captured during level saves and autosaves */
+	TSet<TWeakObjectPtr<AActor>> DirtyActors;
+
+	/** How far (in units) a character has to move from its saved location before the level save captures it again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") float CharacterSaveLocationTolerance;
+
+	/** How far (in degrees) a character has to turn from its saved rotation before the level save captures it again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") float CharacterSaveRotationTolerance;
+
+	/** The ids of actors that have been removed from the level since it was last saved */
+	UPROPERTY(BlueprintReadWrite, Category = "GameMode|Saving State") TArray<FString> RemovedActors;
+
+	/** The level save slot of the current level save's snapshot. Deltas are appended to this slot until the level is saved to another index */
+	UPROPERTY(BlueprintReadWrite, Category = "GameMode|Saving State") FString CurrentLevelSaveUrl;
+
+	/** The amount of deltas that are appended to a level's snapshot before they're compacted into a new snapshot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") int32 LevelSaveCompactionThreshold;
+
+	/** Whether the level's actors are restored over multiple frames when loading a level. Otherwise everything's restored during LoadLevel() */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") bool bTimeSliceLevelLoading;
+
+	/** The time in milliseconds that's spent restoring and spawning actors each frame while a level is loading */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") float LevelLoadFrameBudget;
+
+	/** The level that's currently being restored */
+	FLevelLoadState LevelLoad;
+
 	/** The name of the current level */
 	UPROPERTY(BlueprintReadWrite, Category = "GameMode|Saving State") FString CurrentLevel;
 
@@ -61,6 +141,15 @@ protected:
 
 	/** A stored reference to the data table that contains all the base level information */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Levels") TObjectPtr<UDataTable> LevelInformationTable;
+
+	/** Handles compressing and writing save slots on worker threads. Only valid on the server */
+	UPROPERTY(BlueprintReadWrite, Category = "GameMode|Saving State") TObjectPtr<USavePipeline> SavePipeline;
+
+	/** The max amount of save batches that are written at the same time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") int32 MaxInFlightSaves;
+
+	/** Whether save slots are compressed before they're written to disk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameMode|Saving State") bool bCompressSaves;
 	
 	
 public:
@@ -152,6 +241,61 @@ public:
 
 
 
+//----------------------------------------------------------------------------------//
+// Save Manifest																	//
+//----------------------------------------------------------------------------------//
+public:
+	/** Retrieves the manifest for the current save, and loads it if it hasn't been loaded yet */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual USaved_Manifest* GetCurrentManifest();
+
+	/** Retrieves the manifest of a save url. Uses the current manifest if it's for the same save, otherwise it's loaded from the save slot */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual USaved_Manifest* GetManifest(const FString& BaseUrl) const;
+
+	/** Returns true if a save url is the base url, or one of it's level or player saves. Slot 1's base url is a prefix of slot 10's, so this checks for the delimiter */
+	static bool IsSaveUrlOf(const FString& SaveUrl, const FString& BaseUrl);
+
+	/**
+	 * Loads the most recent valid revision of a save's manifest. If there isn't a valid manifest, it's rebuilt from the save slots on disk
+	 *
+	 * @param BaseUrl					The base url of the save (GameModeType + AccountId + SaveSlot)
+	 * @returns							The save's manifest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual USaved_Manifest* LoadManifest(const FString& BaseUrl) const;
+
+	/**
+	 * Rebuilds a save's manifest from the save slots on disk. Used for recovering saves that don't have a valid manifest
+	 *
+	 * @param BaseUrl					The base url of the save (GameModeType + AccountId + SaveSlot)
+	 * @returns							The rebuilt manifest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual USaved_Manifest* RebuildManifest(const FString& BaseUrl) const;
+
+	/** Writes the next revision of the manifest. Revisions alternate between two save slots so a failed write never loses the previous manifest */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual bool SaveManifest(USaved_Manifest* Manifest);
+
+	/**
+	 * Retrieves the save index and the kind of information a save slot stores from it's save url
+	 *
+	 * @param BaseUrl					The base url of the save (GameModeType + AccountId + SaveSlot)
+	 * @param SlotName					The save slot
+	 * @param OutSaveIndex				The save index of the slot
+	 * @param OutSlotType				What kind of information the save slot stores
+	 * @param OutLevelName				The name of the level for level and actor slots
+	 * @returns							True if it's one of the save's slots
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Manifest") virtual bool ClassifySaveSlot(const FString& BaseUrl, const FString& SlotName, int32& OutSaveIndex, ESaveSlotType& OutSlotType, FString& OutLevelName) const;
+
+
+protected:
+	/** Records the slots of a save batch in the manifest once they've been written */
+	virtual void HandleSaveBatchWritten(const FSaveBatch& Batch);
+
+	/** Starts a new level snapshot on the next save if the batch failed to write the current level save or one of it's deltas */
+	virtual void HandleSaveBatchFailed(const FSaveBatch& Batch);
+
+
+
+	
 //----------------------------------------------------------------------------------//
 // Save Url																			//
 //----------------------------------------------------------------------------------//
@@ -165,6 +309,9 @@ public:
 	/** Retrieves the current save */
 	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Utility") virtual USave* GetCurrentSave() const;
 
+	/** Retrieves the save pipeline used for writing save slots */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Utility") virtual USavePipeline* GetSavePipeline() const;
+
 	/** Retrieves the current save url */
 	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Url") virtual FString GetCurrentSaveUrl() const;
 	
@@ -200,6 +347,18 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Url") virtual FString ConstructPlayerSaveUrl(FString BaseUrl, FString PlayerAccountId, int32 OptionalIndex = -1) const;
 
+	/**
+	 * Constructs the save url of a delta that's appended to a level save
+	 * - LevelDeltaUrl: GameModeType + OwnerAccountId + SaveSlot + LevelName + SaveIndex + Delta + Sequence ->  Adventure_Character1_S1_Level1_45_Delta_3
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Url") virtual FString ConstructLevelDeltaSaveUrl(const FString& IndexedLevelSaveUrl, int32 Sequence) const;
+
+	/**
+	 * Constructs the save url of a save's manifest. Revisions alternate between two slots
+	 * - ManifestUrl: GameModeType + OwnerAccountId + SaveSlot + Manifest + Buffer ->  Adventure_Character1_S1_Manifest_A
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Url") virtual FString ConstructManifestSaveUrl(const FString& BaseUrl, int64 Revision) const;
+
 	/** Utility to append formatted save indexes to the end of save urls */
 	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Utility") virtual FString AppendSaveIndex(int32 Index) const;
 
@@ -273,7 +432,9 @@ public:
 
 
 	/**
-	 * Saves information of the level, and the world specific state of actors in the level. Optionally saves actor information
+	 * Saves information of the level, and the world specific state of actors in the level. Optionally saves actor information \n\n
+	 * Only the actors that have been marked dirty are captured, and their changes are appended to the level's snapshot as a delta.
+	 * Saving the actor information, or saving to another index captures every actor in the level and writes a new snapshot
 	 *
 	 * @note TODO: Add save priority based on what kind of objects are saved
 	 * @param SaveLevelUrl			The level url used to save information to the level 
@@ -284,17 +445,19 @@ public:
 	virtual bool SaveLevel_Implementation(const FString& SaveLevelUrl, int32 Index, bool bSaveActorData = false);
 
 	/**
-	 * Loads the level's save state information and updates the actors within the level. Optionally handles additionally loading the actor's save information
+	 * Loads the level's save state information and updates the actors within the level. Optionally handles additionally loading the actor's save information \n\n
+	 * With time sliced loading the actors are restored over multiple frames within the LevelLoadFrameBudget, and the classes of spawned actors are loaded asynchronously before they're spawned.
+	 * Use OnLevelLoadProgress and OnLevelLoadCompleted to keep the loading screen up until everything has been restored
 	 *
 	 * @note TODO: Add load order based on the objects that we're retrieving from a save
 	 * @param SaveLevelUrl			The level url used to retrieve save information about a specific level
 	 * @param bRetrieveActorData	Whether to retrieve the actor's save information additionally from the level  
-	 * @returns						Whether the save information was successfully retrieved
+	 * @returns						Whether the save information was successfully retrieved, and the level has begun loading
 	 */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Player State|Saving|Level") bool LoadLevel(const FString& SaveLevelUrl, int32 Index, bool bRetrieveActorData = true);
 	virtual bool LoadLevel_Implementation(const FString& SaveLevelUrl, int32 Index, bool bRetrieveActorData = true);
 
-	/** Autosave logic for saving components efficiently to prevent performance issues */
+	/** Autosave logic for saving components efficiently to prevent performance issues. Appends the dirty actors and pending saves to the level's snapshot */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Player State|Saving|Level") bool AutoSaveHandling();
 	virtual bool AutoSaveHandling_Implementation();
 
@@ -302,10 +465,91 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Player State|Saving|Level") void AddPendingActor(const F_LevelSaveInformation_Actor& SaveInformation);
 	virtual void AddPendingActor_Implementation(const F_LevelSaveInformation_Actor& SaveInformation);
 
-	/** Returns whether we're able to currently save the level's state information */
+	/** Returns whether we're able to currently save the level's state information. Levels aren't saved while they're being restored */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Player State|Saving|Level") bool IsValidToCurrentlySaveLevel() const;
 	virtual bool IsValidToCurrentlySaveLevel_Implementation() const;
 
+	/** Marks an actor's level save information as changed, and captures it during the next level save. @ref ILevelSaveInformationInterface::MarkLevelSaveDirty */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual void MarkActorDirty(AActor* Actor);
+
+	/** Removes an actor's save information from the level during the next level save */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual void MarkActorRemoved(const FString& Id);
+
+	/**
+	 * Marks the characters that have moved since the last level save as changed. Characters don't notify the level when they move,
+	 * so their transforms are compared against the current level save. Attribute changes and deaths are marked when they happen
+	 */
+	virtual void MarkCharactersDirty();
+
+	/**
+	 * Loads a level's snapshot, and applies every delta that was appended to it
+	 *
+	 * @param IndexedLevelSaveUrl	The level save slot of a specific save index
+	 * @returns						The level's save information, or nullptr if there isn't a snapshot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual USaved_Level* LoadLevelSave(const FString& IndexedLevelSaveUrl);
+
+	/** Stops restoring the level that's currently loading */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual void CancelLevelLoad();
+
+	/** Returns whether a level is currently being restored */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual bool IsLoadingLevel() const;
+
+	/** Returns the progress of the level that's being restored, from 0 to 1 */
+	UFUNCTION(BlueprintCallable, Category = "Player State|Saving|Level") virtual float GetLevelLoadProgress() const;
+
+	/** Delegate for the progress of the level that's being restored */
+	UPROPERTY(BlueprintAssignable) FOnLevelLoadProgress OnLevelLoadProgress;
+
+	/** Delegate for when every actor of the level has been restored */
+	UPROPERTY(BlueprintAssignable) FOnLevelLoadCompleted OnLevelLoadCompleted;
+
+
+protected:
+	/**
+	 * Captures the save information of the actors that have changed since the level was last saved, and clears the dirty actors
+	 *
+	 * @param bCaptureLevel			Whether to capture every actor in the level instead of only the dirty actors
+	 * @param bSaveActorData		Whether to save the captured actors combat / inventory information
+	 * @returns						The changes to the level
+	 */
+	virtual USaved_LevelDelta* CaptureLevelDelta(bool bCaptureLevel, bool bSaveActorData);
+
+	/**
+	 * Appends a delta to the current level save's snapshot. A new snapshot is written instead when saving to another level slot, or once enough deltas have been appended
+	 *
+	 * @param IndexedLevelSaveUrl	The level save slot of a specific save index
+	 * @param Delta					The changes that have already been applied to the current level save
+	 * @param bCompact				Whether to write a new snapshot regardless of how many deltas there are
+	 * @returns						Whether the delta or snapshot was saved
+	 */
+	virtual bool WriteLevelSave(const FString& IndexedLevelSaveUrl, USaved_LevelDelta* Delta, bool bCompact = false);
+
+	/** Restores and spawns the level's actors until the frame's budget has been spent, and continues next frame until everything's been restored */
+	virtual void ProcessLevelLoad();
+
+	/** Finishes loading the level, and notifies anything that's waiting for it */
+	virtual void FinishLevelLoad(bool bSuccessfullyLoaded);
+
+	/**
+	 * Restores an actor in the level with it's saved information
+	 *
+	 * @param Actor					The actor in the level
+	 * @param SaveData				The actor's saved information
+	 * @param bRetrieveActorData	Whether to retrieve the actor's save information additionally from the level
+	 * @returns						Whether the actor was restored
+	 */
+	virtual bool RestoreSavedActor(AActor* Actor, const F_LevelSaveInformation_Actor& SaveData, bool bRetrieveActorData);
+
+	/**
+	 * Spawns an actor that was previously spawned in the world, and loads it's saved information
+	 *
+	 * @param SaveData				The actor's saved information
+	 * @param bRetrieveActorData	Whether to retrieve the actor's save information additionally from the level
+	 * @returns						The spawned actor
+	 */
+	virtual AActor* SpawnSavedActor(const F_LevelSaveInformation_Actor& SaveData, bool bRetrieveActorData);
+
 	
 public:
 	/** Resets Level Component's state. Helpful during level transitions */
@@ -0,0 +1,349 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SavePipeline.h"
+
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/SaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY(SavePipelineLog);
+
+
+/** Header prepended to compressed save slots. Slots without it are legacy (uncompressed) saves */
+namespace SavePipelineFormat
+{
+	static constexpr uint32 Magic = 0x5A584253; // "SBXZ"
+	static constexpr int32 HeaderSize = sizeof(uint32) + sizeof(int32);
+
+	/** The largest save that's decompressed, anything bigger is treated as a corrupt header */
+	static constexpr int32 MaxUncompressedSize = 256 * 1024 * 1024;
+
+	/** How many times larger than it's compressed data a save can be */
+	static constexpr int64 MaxCompressionRatio = 1024;
+}
+
+
+USavePipeline::USavePipeline()
+{
+	MaxInFlightBatches = 2;
+	bCompressSaves = true;
+	bAcceptingSaves = true;
+	NextBatchId = 1;
+}
+
+
+void USavePipeline::Initialize(const int32 MaxInFlight, const bool bCompress)
+{
+	MaxInFlightBatches = FMath::Max(1, MaxInFlight);
+	bCompressSaves = bCompress;
+	bAcceptingSaves = true;
+}
+
+
+#pragma region Batching
+void USavePipeline::BeginBatch(const int32 SaveIndex)
+{
+	// Only one batch captures information at a time, submit the previous one
+	if (OpenBatch.IsValid())
+	{
+		UE_LOGFMT(SavePipelineLog, Warning, "{0}() Began a new batch for save index {1} before batch {2} was submitted, submitting the previous batch",
+			*FString(__FUNCTION__), SaveIndex, OpenBatch->SaveIndex
+		);
+		SubmitBatch();
+	}
+
+	OpenBatch = MakeShared<FSaveBatch>();
+	OpenBatch->BatchId = NextBatchId++;
+	OpenBatch->SaveIndex = SaveIndex;
+}
+
+
+void USavePipeline::SubmitBatch(FOnSaveBatchCompletedNative OnCompleted)
+{
+	if (!OpenBatch.IsValid())
+	{
+		OnCompleted.ExecuteIfBound(INDEX_NONE, true);
+		return;
+	}
+
+	TSharedPtr<FSaveBatch> Batch = OpenBatch;
+	OpenBatch.Reset();
+	if (OnCompleted.IsBound()) Batch->Callbacks.Add(OnCompleted);
+
+	// Nothing was saved during this batch
+	if (Batch->Writes.IsEmpty())
+	{
+		for (const FOnSaveBatchCompletedNative& Callback : Batch->Callbacks) Callback.ExecuteIfBound(Batch->SaveIndex, true);
+		OnSaveBatchCompleted.Broadcast(Batch->SaveIndex, true);
+		return;
+	}
+
+	if (InFlightBatches.Num() < MaxInFlightBatches) DispatchBatch(Batch);
+	else QueuedBatches.Add(Batch);
+}
+
+
+void USavePipeline::BP_SubmitBatch()
+{
+	SubmitBatch();
+}
+
+
+bool USavePipeline::QueueSave(USaveGame* SaveGameObject, const FString& SlotName, const int32 UserIndex)
+{
+	if (!SaveGameObject || SlotName.IsEmpty()) return false;
+
+	// Anything that's saved after shutdown (EndPlay) is saved synchronously so the information isn't lost
+	if (!bAcceptingSaves)
+	{
+		return UGameplayStatics::SaveGameToSlot(SaveGameObject, SlotName, UserIndex);
+	}
+
+	// Capture the save information on the game thread. Property serialization isn't safe once the object could be garbage collected
+	TArray<uint8> SaveData;
+	if (!UGameplayStatics::SaveGameToMemory(SaveGameObject, SaveData))
+	{
+		UE_LOGFMT(SavePipelineLog, Error, "{0}() Failed to serialize {1} while saving to {2}!", *FString(__FUNCTION__), *GetNameSafe(SaveGameObject), *SlotName);
+		return false;
+	}
+
+	const bool bImplicitBatch = !OpenBatch.IsValid();
+	if (bImplicitBatch) BeginBatch(INDEX_NONE);
+
+	// A slot that's saved multiple times in one batch only needs the most recent information
+	FSaveSlotWrite* Write = OpenBatch->Writes.FindByPredicate([&SlotName, UserIndex](const FSaveSlotWrite& Entry)
+	{
+		return Entry.UserIndex == UserIndex && Entry.SlotName == SlotName;
+	});
+	if (!Write)
+	{
+		Write = &OpenBatch->Writes.AddDefaulted_GetRef();
+		Write->SlotName = SlotName;
+		Write->UserIndex = UserIndex;
+	}
+	Write->Data = MoveTemp(SaveData);
+	Write->Timestamp = FDateTime::UtcNow();
+
+	if (bImplicitBatch) SubmitBatch();
+	return true;
+}
+
+
+void USavePipeline::Flush()
+{
+	if (OpenBatch.IsValid()) SubmitBatch();
+
+	while (!InFlightBatches.IsEmpty() || !QueuedBatches.IsEmpty())
+	{
+		if (InFlightBatches.IsEmpty())
+		{
+			DispatchQueuedBatches();
+			continue;
+		}
+
+		// The game thread notification is ignored once the batch has been handled here
+		const TSharedPtr<FSaveBatch> Batch = InFlightBatches[0];
+		Batch->WriteTask.Wait();
+		HandleBatchFinished(Batch->BatchId);
+	}
+}
+
+
+void USavePipeline::Shutdown()
+{
+	Flush();
+	bAcceptingSaves = false;
+}
+
+
+void USavePipeline::WaitForSlot(const FString& SlotName)
+{
+	if (IsSlotPending(SlotName)) Flush();
+}
+#pragma endregion
+
+
+
+
+#pragma region Worker Logic
+void USavePipeline::DispatchBatch(const TSharedPtr<FSaveBatch>& Batch)
+{
+	InFlightBatches.Add(Batch);
+
+	// Compress each of the slots in parallel
+	const bool bCompress = bCompressSaves;
+	Batch->CompressTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch, bCompress]()
+	{
+		if (!bCompress) return;
+		ParallelFor(Batch->Writes.Num(), [&Batch](const int32 Index)
+		{
+			TArray<uint8> CompressedData;
+			FSaveSlotWrite& Write = Batch->Writes[Index];
+			if (USavePipeline::CompressSaveData(Write.Data, CompressedData)) Write.Data = MoveTemp(CompressedData);
+		});
+	});
+
+	// Write every slot as one I/O job, after the previous batch has been written
+	TArray<UE::Tasks::FTask> Prerequisites = { Batch->CompressTask };
+	if (LastWriteTask.IsValid()) Prerequisites.Add(LastWriteTask);
+
+	const TWeakObjectPtr<USavePipeline> WeakThis(this);
+	const uint32 BatchId = Batch->BatchId;
+	Batch->WriteTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch, WeakThis, BatchId]()
+	{
+		ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+		for (const FSaveSlotWrite& Write : Batch->Writes)
+		{
+			if (!SaveSystem || !SaveSystem->SaveGame(false, *Write.SlotName, Write.UserIndex, Write.Data))
+			{
+				Batch->bSucceeded = false;
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, BatchId]()
+		{
+			if (USavePipeline* Pipeline = WeakThis.Get()) Pipeline->HandleBatchFinished(BatchId);
+		});
+	}, UE::Tasks::Prerequisites(Prerequisites));
+
+	LastWriteTask = Batch->WriteTask;
+}
+
+
+void USavePipeline::HandleBatchFinished(const uint32 BatchId)
+{
+	const int32 BatchIndex = InFlightBatches.IndexOfByPredicate([BatchId](const TSharedPtr<FSaveBatch>& Batch) { return Batch->BatchId == BatchId; });
+	if (BatchIndex == INDEX_NONE) return;
+
+	const TSharedPtr<FSaveBatch> Batch = InFlightBatches[BatchIndex];
+	InFlightBatches.RemoveAt(BatchIndex);
+
+	if (!Batch->bSucceeded)
+	{
+		UE_LOGFMT(SavePipelineLog, Error, "{0}() Failed to write one or more save slots for save index {1}!", *FString(__FUNCTION__), Batch->SaveIndex);
+		OnSaveBatchFailed.Broadcast(*Batch);
+	}
+	else
+	{
+		OnSaveBatchWritten.Broadcast(*Batch);
+	}
+
+	for (const FOnSaveBatchCompletedNative& Callback : Batch->Callbacks) Callback.ExecuteIfBound(Batch->SaveIndex, Batch->bSucceeded);
+	OnSaveBatchCompleted.Broadcast(Batch->SaveIndex, Batch->bSucceeded);
+
+	DispatchQueuedBatches();
+}
+
+
+void USavePipeline::DispatchQueuedBatches()
+{
+	while (!QueuedBatches.IsEmpty() && InFlightBatches.Num() < MaxInFlightBatches)
+	{
+		DispatchBatch(QueuedBatches[0]);
+		QueuedBatches.RemoveAt(0);
+	}
+}
+#pragma endregion
+
+
+
+
+#pragma region Compression
+bool USavePipeline::CompressSaveData(const TArray<uint8>& SaveData, TArray<uint8>& OutCompressedData)
+{
+	const int32 UncompressedSize = SaveData.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+	OutCompressedData.SetNumUninitialized(SavePipelineFormat::HeaderSize + CompressedSize);
+
+	if (!FCompression::CompressMemory(NAME_Oodle, OutCompressedData.GetData() + SavePipelineFormat::HeaderSize, CompressedSize, SaveData.GetData(), UncompressedSize))
+	{
+		OutCompressedData.Reset();
+		return false;
+	}
+
+	OutCompressedData.SetNum(SavePipelineFormat::HeaderSize + CompressedSize);
+	FMemoryWriter Writer(OutCompressedData);
+	uint32 Magic = SavePipelineFormat::Magic;
+	int32 Size = UncompressedSize;
+	Writer << Magic;
+	Writer << Size;
+	return true;
+}
+
+
+bool USavePipeline::DecompressSaveData(const TArray<uint8>& SaveData, TArray<uint8>& OutUncompressedData)
+{
+	uint32 Magic = 0;
+	int32 UncompressedSize = 0;
+	if (SaveData.Num() >= SavePipelineFormat::HeaderSize)
+	{
+		FMemoryReader Reader(SaveData);
+		Reader << Magic;
+		Reader << UncompressedSize;
+	}
+
+	// Legacy and uncompressed saves
+	if (Magic != SavePipelineFormat::Magic)
+	{
+		OutUncompressedData = SaveData;
+		return true;
+	}
+
+	// Don't trust the size from the header of a corrupt save
+	const int32 CompressedSize = SaveData.Num() - SavePipelineFormat::HeaderSize;
+	if (UncompressedSize < 0 || UncompressedSize > SavePipelineFormat::MaxUncompressedSize || UncompressedSize > CompressedSize * SavePipelineFormat::MaxCompressionRatio)
+	{
+		UE_LOGFMT(SavePipelineLog, Error, "{0}() The save's uncompressed size ({1}) is invalid for {2} bytes of compressed data", *FString(__FUNCTION__), UncompressedSize, CompressedSize);
+		OutUncompressedData.Reset();
+		return false;
+	}
+
+	OutUncompressedData.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Oodle, OutUncompressedData.GetData(), UncompressedSize, SaveData.GetData() + SavePipelineFormat::HeaderSize, CompressedSize))
+	{
+		UE_LOGFMT(SavePipelineLog, Error, "{0}() Failed to decompress the save", *FString(__FUNCTION__));
+		OutUncompressedData.Reset();
+		return false;
+	}
+
+	return true;
+}
+#pragma endregion
+
+
+
+
+#pragma region Utility
+bool USavePipeline::IsAcceptingSaves() const
+{
+	return bAcceptingSaves;
+}
+
+
+int32 USavePipeline::GetPendingBatchCount() const
+{
+	return InFlightBatches.Num() + QueuedBatches.Num() + (OpenBatch.IsValid() ? 1 : 0);
+}
+
+
+bool USavePipeline::IsSlotPending(const FString& SlotName) const
+{
+	auto ContainsSlot = [&SlotName](const TSharedPtr<FSaveBatch>& Batch)
+	{
+		return Batch.IsValid() && Batch->Writes.ContainsByPredicate([&SlotName](const FSaveSlotWrite& Write) { return Write.SlotName == SlotName; });
+	};
+
+	if (ContainsSlot(OpenBatch)) return true;
+	for (const TSharedPtr<FSaveBatch>& Batch : InFlightBatches) if (ContainsSlot(Batch)) return true;
+	for (const TSharedPtr<FSaveBatch>& Batch : QueuedBatches) if (ContainsSlot(Batch)) return true;
+	return false;
+}
+#pragma endregion
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "UObject/NoExportTypes.h"
+#include "SavePipeline.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(SavePipelineLog, Log, All);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSaveBatchCompleted, int32, SaveIndex, bool, bSuccessfullySaved);
+DECLARE_DELEGATE_TwoParams(FOnSaveBatchCompletedNative, int32 /* SaveIndex */, bool /* bSuccessfullySaved */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSaveBatchWritten, const struct FSaveBatch& /* Batch */);
+
+class USaveGame;
+
+
+/**
+ * A single save slot that's been captured on the game thread and is waiting to be compressed and written to disk
+ */
+struct FSaveSlotWrite
+{
+	/** The save slot the information is written to */
+	FString SlotName;
+
+	/** The user index of the save slot */
+	int32 UserIndex = 0;
+
+	/** The serialized save game. This is replaced with the compressed payload on the worker thread, and is what's written to disk */
+	TArray<uint8> Data;
+
+	/** When the slot was captured */
+	FDateTime Timestamp;
+};
+
+
+/**
+ * Every save slot that's written for a specific save index. Batches are compressed in parallel, and written to disk in the order they were submitted
+ */
+struct FSaveBatch
+{
+	/** Unique id of the batch, used to match the worker's completion with the batch on the game thread */
+	uint32 BatchId = 0;
+
+	/** The save index this batch is saving to */
+	int32 SaveIndex = INDEX_NONE;
+
+	/** The slots that are written during this batch */
+	TArray<FSaveSlotWrite> Writes;
+
+	/** Native callbacks for when this specific batch has finished writing */
+	TArray<FOnSaveBatchCompletedNative> Callbacks;
+
+	/** Whether every slot was successfully written. Only written by the worker, and read on the game thread once the write task has completed */
+	bool bSucceeded = true;
+
+	/** The task that compresses each of the slots */
+	UE::Tasks::FTask CompressTask;
+
+	/** The task that writes every slot of the batch to disk */
+	UE::Tasks::FTask WriteTask;
+};
+
+
+/**
+ * Save pipeline for handling saving without blocking the game thread. @ref AGameModeSaveLogic, @ref USaveFunctionLibrary \n\n
+ *
+ * Save games are serialized into memory on the game thread (the snapshot), and then compressed and written to disk on worker threads.
+ * Every slot that's saved between BeginBatch() and SubmitBatch() is written as a single I/O job, and batches are written in the order they're submitted so a newer save is never overwritten by an older one.
+ *
+ *	- Saves that are queued without an open batch are submitted as their own batch
+ *	- Once MaxInFlightBatches is reached, batches are queued until one of the current batches has finished writing
+ *	- Flush() blocks until everything has been written, and Shutdown() flushes and falls back to synchronous saving for anything that's saved afterwards (EndPlay)
+ */
+UCLASS()
+class SANDBOX_API USavePipeline : public UObject
+{
+	GENERATED_BODY()
+
+protected:
+	/** The max amount of batches that are compressed / written at the same time. Additional batches wait until one of these has finished */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Saving") int32 MaxInFlightBatches;
+
+	/** Whether save slots are compressed before they're written to disk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Saving") bool bCompressSaves;
+
+	/** Whether the pipeline is still accepting saves. Once it's been shutdown every save is written synchronously */
+	UPROPERTY(BlueprintReadOnly, Category = "Saving") bool bAcceptingSaves;
+
+	/** The batch that's currently capturing save slots */
+	TSharedPtr<FSaveBatch> OpenBatch;
+
+	/** Batches that are currently being compressed / written */
+	TArray<TSharedPtr<FSaveBatch>> InFlightBatches;
+
+	/** Batches that are waiting for an in flight batch to finish */
+	TArray<TSharedPtr<FSaveBatch>> QueuedBatches;
+
+	/** The write task of the most recently dispatched batch. Every write waits on the previous one to keep the slots in order */
+	UE::Tasks::FTask LastWriteTask;
+
+	/** Used for creating batch ids */
+	uint32 NextBatchId;
+
+
+public:
+	USavePipeline();
+
+	/** Delegate for when every save slot of a batch has been written */
+	UPROPERTY(BlueprintAssignable) FOnSaveBatchCompleted OnSaveBatchCompleted;
+
+	/** Native delegate for when a batch has been successfully written, with the slots and their size on disk. Used for updating the save manifest */
+	FOnSaveBatchWritten OnSaveBatchWritten;
+
+	/** Native delegate for when one or more slots of a batch failed to write. Slots that were chained to the failed ones need to be rewritten */
+	FOnSaveBatchWritten OnSaveBatchFailed;
+
+	/** Updates the pipeline's configuration */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual void Initialize(int32 MaxInFlight, bool bCompress);
+
+	/**
+	 * Begins capturing save slots for a specific save index. Every slot that's queued before SubmitBatch() is written together
+	 *
+	 * @param SaveIndex					The save index of the batch
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual void BeginBatch(int32 SaveIndex);
+
+	/**
+	 * Submits the current batch for compressing and writing
+	 *
+	 * @param OnCompleted				Optional callback for when this batch has finished writing
+	 */
+	virtual void SubmitBatch(FOnSaveBatchCompletedNative OnCompleted = FOnSaveBatchCompletedNative());
+	UFUNCTION(BlueprintCallable, Category = "Saving", DisplayName = "Submit Batch") virtual void BP_SubmitBatch();
+
+	/**
+	 * Captures the save game's information and queues it for saving. If there isn't an open batch, it's saved in it's own batch
+	 *
+	 * @param SaveGameObject			The save information
+	 * @param SlotName					The save slot it's written to
+	 * @param UserIndex					The user index of the save slot
+	 * @returns							True if the save game was captured, or saved synchronously after the pipeline has been shutdown
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual bool QueueSave(USaveGame* SaveGameObject, const FString& SlotName, int32 UserIndex);
+
+	/** Blocks until every submitted and queued batch has been written. The open batch is submitted first */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual void Flush();
+
+	/** Flushes every save and stops accepting new ones. Anything saved afterwards is saved synchronously */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual void Shutdown();
+
+	/** Flushes the pipeline if the slot is currently waiting to be written. Called before loading a slot so we never read stale information */
+	UFUNCTION(BlueprintCallable, Category = "Saving") virtual void WaitForSlot(const FString& SlotName);
+
+	/** Returns whether the pipeline is still accepting saves */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Utility") virtual bool IsAcceptingSaves() const;
+
+	/** Returns the amount of batches that are currently being written or waiting to be written */
+	UFUNCTION(BlueprintCallable, Category = "Saving|Utility") virtual int32 GetPendingBatchCount() const;
+
+
+//----------------------------------------------------------------------------------//
+// Compression																		//
+//----------------------------------------------------------------------------------//
+public:
+	/** Compresses serialized save information. Thread safe */
+	static bool CompressSaveData(const TArray<uint8>& SaveData, TArray<uint8>& OutCompressedData);
+
+	/** Decompresses save information, and passes uncompressed information through unchanged. Thread safe */
+	static bool DecompressSaveData(const TArray<uint8>& SaveData, TArray<uint8>& OutUncompressedData);
+
+
+protected:
+	/** Dispatches the batch to the worker threads */
+	virtual void DispatchBatch(const TSharedPtr<FSaveBatch>& Batch);
+
+	/** Called on the game thread once a batch has finished writing */
+	virtual void HandleBatchFinished(uint32 BatchId);
+
+	/** Dispatches queued batches while there's room for them */
+	virtual void DispatchQueuedBatches();
+
+	/** Whether any of the batches are saving to a specific slot */
+	virtual bool IsSlotPending(const FString& SlotName) const;
+
+
+};
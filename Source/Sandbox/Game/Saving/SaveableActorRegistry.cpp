@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SaveableActorRegistry.h"
+
+#include "Engine/World.h"
+#include "Hash/CityHash.h"
+#include "Sandbox/Characters/Player/PlayerCharacter.h"
+#include "Sandbox/Data/Interfaces/Save/LevelSaveInformationInterface.h"
+
+
+USaveableActorRegistry* USaveableActorRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USaveableActorRegistry>() : nullptr;
+}
+
+
+void USaveableActorRegistry::Deinitialize()
+{
+	SaveableActors.Empty();
+	IdIndexes.Empty();
+	ActorIndexes.Empty();
+	Super::Deinitialize();
+}
+
+
+#pragma region Registration
+void USaveableActorRegistry::RegisterActor(AActor* Actor)
+{
+	if (!Actor || !Actor->HasAuthority() || ActorIndexes.Contains(Actor)) return;
+	if (!Actor->GetClass()->ImplementsInterface(ULevelSaveInformationInterface::StaticClass())) return;
+	if (Cast<APlayerCharacter>(Actor)) return;
+
+	AddActor(Actor, ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor));
+}
+
+
+void USaveableActorRegistry::UnregisterActor(AActor* Actor)
+{
+	if (const int32* Index = ActorIndexes.Find(Actor))
+	{
+		RemoveActorAt(*Index);
+	}
+}
+
+
+void USaveableActorRegistry::UpdateActorId(AActor* Actor)
+{
+	const int32* Index = ActorIndexes.Find(Actor);
+	if (!Index) return;
+
+	const FString Id = ILevelSaveInformationInterface::Execute_GetActorLevelId(Actor);
+	if (SaveableActors[*Index].Id == Id) return;
+
+	RemoveActorAt(*Index);
+	AddActor(Actor, Id);
+}
+
+
+void USaveableActorRegistry::AddActor(AActor* Actor, const FString& Id)
+{
+	FSaveableActor& Entry = SaveableActors.AddDefaulted_GetRef();
+	Entry.Id = Id;
+	Entry.IdHash = HashActorId(Id);
+	Entry.Actor = Actor;
+	Entry.Level = Actor->GetLevel();
+
+	const int32 Index = SaveableActors.Num() - 1;
+	ActorIndexes.Add(Actor, Index);
+	if (!Id.IsEmpty()) IdIndexes.Add(Entry.IdHash, Index);
+}
+
+
+void USaveableActorRegistry::RemoveActorAt(const int32 Index)
+{
+	if (!SaveableActors.IsValidIndex(Index)) return;
+
+	// Actors with duplicate ids share the same hash, only remove this actor's index
+	const FSaveableActor& Entry = SaveableActors[Index];
+	IdIndexes.RemoveSingle(Entry.IdHash, Index);
+	ActorIndexes.Remove(Entry.Actor.Get());
+
+	// Keep the array compact, and update the indexes of the entry that was moved
+	const int32 LastIndex = SaveableActors.Num() - 1;
+	SaveableActors.RemoveAtSwap(Index, 1, false);
+	if (Index == LastIndex) return;
+
+	const FSaveableActor& Moved = SaveableActors[Index];
+	if (int32* MovedIdIndex = IdIndexes.FindPair(Moved.IdHash, LastIndex)) *MovedIdIndex = Index;
+	if (int32* MovedActorIndex = ActorIndexes.Find(Moved.Actor.Get())) *MovedActorIndex = Index;
+}
+#pragma endregion
+
+
+
+
+#pragma region Utility
+const FSaveableActor* USaveableActorRegistry::FindActor(const FString& Id) const
+{
+	for (auto Iterator = IdIndexes.CreateConstKeyIterator(HashActorId(Id)); Iterator; ++Iterator)
+	{
+		const FSaveableActor& Entry = SaveableActors[Iterator.Value()];
+		if (Entry.Id == Id) return &Entry;
+	}
+
+	return nullptr;
+}
+
+
+const FSaveableActor* USaveableActorRegistry::FindActorByHash(const uint64 IdHash) const
+{
+	const int32* Index = IdIndexes.Find(IdHash);
+	return Index ? &SaveableActors[*Index] : nullptr;
+}
+
+
+const TArray<FSaveableActor>& USaveableActorRegistry::GetActors() const
+{
+	return SaveableActors;
+}
+
+
+void USaveableActorRegistry::GetActorsInLevel(const ULevel* Level, TArray<const FSaveableActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + SaveableActors.Num());
+	for (const FSaveableActor& Entry : SaveableActors)
+	{
+		if (Entry.Level.Get() == Level && Entry.Actor.IsValid()) OutActors.Add(&Entry);
+	}
+}
+
+
+uint64 USaveableActorRegistry::HashActorId(const FString& Id)
+{
+	return CityHash64(reinterpret_cast<const char*>(*Id), Id.Len() * sizeof(TCHAR));
+}
+#pragma endregion
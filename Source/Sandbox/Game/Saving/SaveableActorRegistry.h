@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SaveableActorRegistry.generated.h"
+
+
+/**
+ * An actor with level save information that's registered with the @ref USaveableActorRegistry
+ */
+struct FSaveableActor
+{
+	/** The actor's level id. @ref ILevelSaveInformationInterface::GetActorLevelId */
+	FString Id;
+
+	/** Hash of the level id, used for finding the actor without hashing it's id again */
+	uint64 IdHash = 0;
+
+	/** The saveable actor */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** The level the actor was placed or spawned in */
+	TWeakObjectPtr<ULevel> Level;
+};
+
+
+/**
+ * Registry of the actors in the world that have level save information. @ref ILevelSaveInformationInterface, @ref AGameModeSaveLogic \n\n
+ *
+ * Saveable actors register themselves on BeginPlay and unregister on EndPlay, so saving and loading the level only iterates the actors with save information instead of every actor in the level.
+ * The actor's level id is retrieved once when it's registered, and actors are found using the hash of their level id.
+ *
+ *	- Only the server saves the level, so actors are only registered on authority
+ *	- Players are saved with their own save components, and aren't registered
+ *	- Actors that change their level id after BeginPlay need to call UpdateActorId(). Characters update it once their save component assigns their platform id
+ *	- Actors can share a level id. FindActor() returns one of them, and removing it keeps the others
+ */
+UCLASS()
+class SANDBOX_API USaveableActorRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** The registered actors. Removing an actor swaps the last actor into it's place */
+	TArray<FSaveableActor> SaveableActors;
+
+	/** The index of each actor, keyed by the hash of it's level id. Actors with the same id share a key */
+	TMultiMap<uint64, int32> IdIndexes;
+
+	/** The index of each actor, keyed by the actor */
+	TMap<const AActor*, int32> ActorIndexes;
+
+	
+public:
+	/** Retrieves the registry of the world */
+	static USaveableActorRegistry* Get(const UObject* WorldContextObject);
+
+	/** Clears the registry */
+	virtual void Deinitialize() override;
+
+	/** Adds an actor with level save information to the registry. Actors that don't implement the level save interface, players, and actors without authority are ignored */
+	virtual void RegisterActor(AActor* Actor);
+
+	/** Removes an actor from the registry */
+	virtual void UnregisterActor(AActor* Actor);
+
+	/** Retrieves the actor's level id again. Used for actors that update their level id after they've been registered */
+	virtual void UpdateActorId(AActor* Actor);
+
+	/** Finds a registered actor using it's level id */
+	const FSaveableActor* FindActor(const FString& Id) const;
+
+	/** Finds a registered actor using the hash of it's level id. @ref HashActorId */
+	const FSaveableActor* FindActorByHash(uint64 IdHash) const;
+
+	/** Retrieves every registered actor */
+	const TArray<FSaveableActor>& GetActors() const;
+
+	/** Retrieves the registered actors of a specific level */
+	void GetActorsInLevel(const ULevel* Level, TArray<const FSaveableActor*>& OutActors) const;
+
+	/** Hashes an actor's level id */
+	static uint64 HashActorId(const FString& Id);
+
+	
+protected:
+	/** Adds the actor's entry and it's indexes */
+	virtual void AddActor(AActor* Actor, const FString& Id);
+
+	/** Removes the entry at an index, and updates the indexes of the entry that's swapped into it's place */
+	virtual void RemoveActorAt(int32 Index);
+
+	
+};
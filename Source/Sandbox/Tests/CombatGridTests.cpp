@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Sandbox/Characters/CharacterBase.h"
+#include "Sandbox/Characters/Components/Camera/CharacterCameraLogic.h"
+#include "Sandbox/Combat/CombatGridSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CombatGridTests
+{
+	/** A game world the characters are spawned in, which is destroyed once the test finishes. The world doesn't begin play, so characters are registered by hand */
+	struct FTestWorld
+	{
+		UWorld* World = nullptr;
+
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("CombatGridTests"));
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		template<class T = ACharacterBase>
+		T* Spawn(const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator) const
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			return World->SpawnActor<T>(T::StaticClass(), Location, Rotation, SpawnParameters);
+		}
+	};
+
+	float GetCellSize()
+	{
+		const IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Sandbox.CombatGrid.CellSize"));
+		return FMath::Max(CVar ? CVar->GetFloat() : 0.0f, 100.f);
+	}
+
+	/** Returns the location of a target at an angle and distance from a character at the origin that's facing along the x axis */
+	FVector GetTargetLocation(const float Angle, const float Distance)
+	{
+		return FRotator(0.0f, Angle, 0.0f).Vector() * Distance;
+	}
+
+	/** Returns the targets in the target lock data, from left to right */
+	TArray<AActor*> GetTargetOrder(const TArray<FTargetLockInformation>& TargetLockData)
+	{
+		TArray<AActor*> Targets;
+		for (const FTargetLockInformation& TargetLockInfo : TargetLockData) Targets.Add(TargetLockInfo.Target);
+		return Targets;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatGridCellMigrationTest, "Sandbox.Combat.CombatGrid.CellMigration", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCombatGridCellMigrationTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatGridTests;
+
+	const FTestWorld TestWorld;
+	UCombatGridSubsystem* CombatGrid = UCombatGridSubsystem::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("Game worlds have a combat grid"), CombatGrid)) return false;
+
+	const float CellSize = GetCellSize();
+	const FVector Start = FVector(CellSize * 0.5f, CellSize * 0.5f, 0);
+	const FVector End = Start + FVector(CellSize * 4, -CellSize * 3, 0);
+	const float Radius = CellSize * 0.25f;
+	ACharacterBase* Character = TestWorld.Spawn(Start);
+	ACharacterBase* Destroyed = TestWorld.Spawn(Start);
+	if (!TestNotNull(TEXT("The characters spawned"), Character) || !TestNotNull(TEXT("The characters spawned"), Destroyed)) return false;
+
+	CombatGrid->RegisterCharacter(Character);
+	CombatGrid->RegisterCharacter(Destroyed);
+	CombatGrid->RegisterCharacter(Character);
+	TestEqual(TEXT("Characters are only registered once"), CombatGrid->GetNumCharacters(), 2);
+
+	TArray<ACharacterBase*> Characters;
+	TestEqual(TEXT("Characters are found where they were registered"), CombatGrid->QueryCone(Start, FVector::ForwardVector, Radius, 180.f, Characters), 2);
+
+	// Queries use the locations from the last update
+	Character->SetActorLocation(End);
+	Characters.Reset();
+	TestEqual(TEXT("Characters aren't found in their new cell before the grid updates"), CombatGrid->QueryCone(End, FVector::ForwardVector, Radius, 180.f, Characters), 0);
+
+	CombatGrid->Tick(0.0f);
+	Characters.Reset();
+	TestEqual(TEXT("Characters are found in their new cell once the grid updates"), CombatGrid->QueryCone(End, FVector::ForwardVector, Radius, 180.f, Characters), 1);
+	TestTrue(TEXT("The moved character is found in its new cell"), Characters.Contains(Character));
+	Characters.Reset();
+	TestEqual(TEXT("Characters are removed from their previous cell"), CombatGrid->QueryCone(Start, FVector::ForwardVector, Radius, 180.f, Characters), 1);
+	TestFalse(TEXT("The moved character isn't in its previous cell"), Characters.Contains(Character));
+
+	// Characters moving within their cell only update their location
+	const FVector WithinCell = End + FVector(CellSize * 0.1f, 0, 0);
+	Character->SetActorLocation(WithinCell);
+	CombatGrid->Tick(0.0f);
+	Characters.Reset();
+	TestEqual(TEXT("Characters that move within their cell are found at their new location"), CombatGrid->QueryCone(WithinCell, FVector::ForwardVector, CellSize * 0.05f, 180.f, Characters), 1);
+
+	// Characters that are destroyed without unregistering are removed once the grid updates
+	TestWorld.World->DestroyActor(Destroyed);
+	CombatGrid->Tick(0.0f);
+	TestEqual(TEXT("Destroyed characters are removed from the grid"), CombatGrid->GetNumCharacters(), 1);
+
+	CombatGrid->UnregisterCharacter(Character);
+	TestEqual(TEXT("Unregistered characters are removed from the grid"), CombatGrid->GetNumCharacters(), 0);
+	Characters.Reset();
+	TestEqual(TEXT("Unregistered characters aren't found"), CombatGrid->QueryCone(WithinCell, FVector::ForwardVector, Radius, 180.f, Characters), 0);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatGridConeTest, "Sandbox.Combat.CombatGrid.Cone", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCombatGridConeTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatGridTests;
+
+	const FTestWorld TestWorld;
+	UCombatGridSubsystem* CombatGrid = UCombatGridSubsystem::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("Game worlds have a combat grid"), CombatGrid)) return false;
+
+	// Characters around the origin, facing along the x axis. The far character is a few cells away
+	const float CellSize = GetCellSize();
+	const float Radius = CellSize * 1.5f;
+	ACharacterBase* Searcher = TestWorld.Spawn(FVector::ZeroVector);
+	ACharacterBase* Front = TestWorld.Spawn(FVector(Radius * 0.5f, 0, 0));
+	ACharacterBase* Side = TestWorld.Spawn(FVector(0, Radius * 0.5f, 0));
+	ACharacterBase* Behind = TestWorld.Spawn(FVector(-Radius * 0.5f, -Radius * 0.1f, 0));
+	ACharacterBase* Far = TestWorld.Spawn(FVector(Radius * 3, 0, 0));
+	ACharacterBase* Above = TestWorld.Spawn(FVector(Radius * 0.2f, 0, Radius * 2));
+	for (ACharacterBase* Character : { Searcher, Front, Side, Behind, Far, Above })
+	{
+		if (!TestNotNull(TEXT("The characters spawned"), Character)) return false;
+		CombatGrid->RegisterCharacter(Character);
+	}
+
+	TArray<ACharacterBase*> Characters;
+	TestEqual(TEXT("A narrow cone only finds the characters in front"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, Radius, 45.f, Characters, Searcher), 1);
+	TestTrue(TEXT("A narrow cone finds the character in front"), Characters.Contains(Front));
+
+	Characters.Reset();
+	TestEqual(TEXT("A wide cone finds the characters to the side"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, Radius, 100.f, Characters, Searcher), 2);
+	TestTrue(TEXT("A wide cone finds the character to the side"), Characters.Contains(Side));
+	TestFalse(TEXT("A wide cone doesn't find the character behind"), Characters.Contains(Behind));
+
+	// 180 degrees is a sphere, and includes the character at the origin
+	Characters.Reset();
+	TestEqual(TEXT("A 180 degree cone finds every character within the radius"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, Radius, 180.f, Characters), 4);
+	TestTrue(TEXT("A 180 degree cone finds the character behind"), Characters.Contains(Behind));
+	TestTrue(TEXT("A 180 degree cone finds the character at the origin"), Characters.Contains(Searcher));
+	TestFalse(TEXT("Characters past the radius aren't found"), Characters.Contains(Far));
+	TestFalse(TEXT("The radius includes the height"), Characters.Contains(Above));
+
+	Characters.Reset();
+	TestEqual(TEXT("A cone without a direction is a sphere"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ZeroVector, Radius, 45.f, Characters, Searcher), 3);
+
+	Characters.Reset();
+	TestEqual(TEXT("A larger radius finds the characters in other cells"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, Radius * 4, 45.f, Characters, Searcher), 3);
+	TestTrue(TEXT("A larger radius finds the far character"), Characters.Contains(Far));
+	TestFalse(TEXT("The ignored actor isn't found"), Characters.Contains(Searcher));
+
+	// Results are appended
+	const int32 PreviousNum = Characters.Num();
+	TestEqual(TEXT("Queries return the amount of characters they found"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, Radius, 45.f, Characters, Searcher), 1);
+	TestEqual(TEXT("Queries add to the characters that were already found"), Characters.Num(), PreviousNum + 1);
+	TestEqual(TEXT("Queries without a radius don't find anything"), CombatGrid->QueryCone(FVector::ZeroVector, FVector::ForwardVector, 0.0f, 180.f, Characters), 0);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetLockNeighboursTest, "Sandbox.Camera.TargetLock.Neighbours", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTargetLockNeighboursTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatGridTests;
+
+	const FTestWorld TestWorld;
+	ACharacterCameraLogic* Player = TestWorld.Spawn<ACharacterCameraLogic>(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("The player spawned"), Player)) return false;
+
+	// The targets from left to right
+	const float Angles[] = { 120.f, 60.f, 20.f, -30.f, -90.f };
+	TArray<AActor*> Targets;
+	for (const float Angle : Angles)
+	{
+		AActor* Target = TestWorld.Spawn(GetTargetLocation(Angle, 500.f));
+		if (!TestNotNull(TEXT("The targets spawned"), Target)) return false;
+		Targets.Add(Target);
+	}
+
+	// Add the targets out of order
+	Player->TargetLockCharacters = { Targets[3], Targets[0], Targets[4], Targets[2], Targets[1] };
+	Player->UpdateTargetLockData();
+	TestEqual(TEXT("Every target has target lock data"), Player->TargetLockData.Num(), Targets.Num());
+	TestTrue(TEXT("The target lock data is sorted from left to right"), GetTargetOrder(Player->TargetLockData) == Targets);
+	TestEqual(TEXT("Targets are found at their own index"), Player->FindTargetLockIndex(Player->TargetLockData[2].AngleFromForwardVector), 2);
+
+	// The current target leaves the list, and the next target is found from where it would have been
+	AActor* CurrentTarget = Targets[2];
+	Player->TargetLockCharacters.Remove(CurrentTarget);
+	Player->UpdateTargetLockData();
+	TestEqual(TEXT("Targets that leave are removed from the target lock data"), Player->TargetLockData.Num(), Targets.Num() - 1);
+
+	const int32 Index = Player->FindTargetLockIndex(20.f);
+	TestEqual(TEXT("A target that left is found between its neighbours"), Index, 2);
+	if (Player->TargetLockData.IsValidIndex(Index) && Player->TargetLockData.IsValidIndex(Index - 1))
+	{
+		TestTrue(TEXT("The neighbour to the left of a target that left is the next target on the left"), Player->TargetLockData[Index - 1].Target == Targets[1]);
+		TestTrue(TEXT("The neighbour to the right of a target that left is the next target on the right"), Player->TargetLockData[Index].Target == Targets[3]);
+	}
+
+	// Angles past either end of the list
+	TestEqual(TEXT("Angles further left than every target are at the start"), Player->FindTargetLockIndex(170.f), 0);
+	TestEqual(TEXT("Angles further right than every target are at the end"), Player->FindTargetLockIndex(-170.f), Player->TargetLockData.Num());
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetLockOrderTest, "Sandbox.Camera.TargetLock.Order", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTargetLockOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatGridTests;
+
+	const FTestWorld TestWorld;
+	ACharacterCameraLogic* Player = TestWorld.Spawn<ACharacterCameraLogic>(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("The player spawned"), Player)) return false;
+
+	// Targets with exactly the same angle at different distances, and one target to the left of them
+	AActor* Near = TestWorld.Spawn(FVector(300, 300, 0));
+	AActor* Middle = TestWorld.Spawn(FVector(600, 600, 0));
+	AActor* Far = TestWorld.Spawn(FVector(900, 900, 0));
+	AActor* Left = TestWorld.Spawn(GetTargetLocation(80.f, 500.f));
+	if (!TestTrue(TEXT("The targets spawned"), Near && Middle && Far && Left)) return false;
+
+	Player->TargetLockCharacters = { Middle, Far, Left, Near };
+	Player->UpdateTargetLockData();
+	const TArray<AActor*> Order = GetTargetOrder(Player->TargetLockData);
+	TestTrue(TEXT("Targets with the same angle are kept in the order they were added"), Order == TArray<AActor*>({ Left, Middle, Far, Near }));
+
+	// Reordering the target lock characters doesn't swap the targets with the same angle
+	Player->TargetLockCharacters = { Near, Left, Far, Middle };
+	Player->UpdateTargetLockData();
+	TestTrue(TEXT("Targets with the same angle don't swap places between updates"), GetTargetOrder(Player->TargetLockData) == Order);
+
+	// Only the targets that moved past each other are shifted
+	Left->SetActorLocation(GetTargetLocation(-10.f, 500.f));
+	Player->UpdateTargetLockData();
+	TestTrue(TEXT("Targets that move past the others are shifted, and the rest keep their order"), GetTargetOrder(Player->TargetLockData) == TArray<AActor*>({ Middle, Far, Near, Left }));
+
+	// Turning the player changes every angle by the same amount, which keeps the order
+	Player->SetActorRotation(FRotator(0.0f, 30.0f, 0.0f));
+	Player->UpdateTargetLockData();
+	TestTrue(TEXT("Turning the player keeps the order of the targets"), GetTargetOrder(Player->TargetLockData) == TArray<AActor*>({ Middle, Far, Near, Left }));
+	TestEqual(TEXT("Targets with the same angle are found at the first of them"), Player->FindTargetLockIndex(Player->TargetLockData[1].AngleFromForwardVector), 0);
+	return true;
+}
+
+#endif
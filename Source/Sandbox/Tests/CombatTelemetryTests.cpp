@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Sandbox/Combat/CombatTelemetry.h"
+#include "Sandbox/Data/Enums/AttributeTypes.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTelemetryFileTest, "Sandbox.Combat.Telemetry.Files", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCombatTelemetryFileTest::RunTest(const FString& Parameters)
+{
+	TArray<FCombatTelemetryRecord> Records;
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		FCombatTelemetryRecord& Record = Records.AddZeroed_GetRef();
+		Record.Event = static_cast<ECombatTelemetryEvent>(Index);
+		Record.Detail = static_cast<uint8>(Index);
+		Record.Frame = 100 + Index;
+		Record.SourceId = 7;
+		Record.TargetId = MAX_uint32;
+		Record.Values[0] = Index * 10.5f;
+		Record.Values[3] = -1.0f;
+	}
+
+	// Each flush appends a block with the names that were recorded since the previous one, only the first one writes the header
+	const FCombatTelemetryName Attacker = { 7, TEXT("/Game/Maps/Arena.Arena:PersistentLevel.BP_Enemy_C_3") };
+	const FCombatTelemetryName Player = { 8, TEXT("/Game/Maps/Arena.Arena:PersistentLevel.BP_Player_C_0") };
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	FCombatTelemetryFile::Write(Writer, { Attacker }, TConstArrayView<FCombatTelemetryRecord>(Records.GetData(), 2), true);
+	FCombatTelemetryFile::Write(Writer, { Player }, TConstArrayView<FCombatTelemetryRecord>(Records.GetData() + 2, 1), false);
+
+	TMap<uint32, FString> ReadNames;
+	TArray<FCombatTelemetryRecord> ReadRecords;
+	TestTrue(TEXT("The file is read"), FCombatTelemetryFile::Read(Data, ReadNames, ReadRecords));
+	TestEqual(TEXT("Every record is read"), ReadRecords.Num(), Records.Num());
+	TestTrue(TEXT("The records are read back unchanged"), ReadRecords.Num() == Records.Num() && FMemory::Memcmp(ReadRecords.GetData(), Records.GetData(), Records.Num() * sizeof(FCombatTelemetryRecord)) == 0);
+	TestEqual(TEXT("The names of every block are read"), ReadNames.Num(), 2);
+	TestEqual(TEXT("Ids are resolved to the path names"), ReadNames.FindRef(Attacker.Id), Attacker.Name);
+	TestEqual(TEXT("Ids of later blocks are resolved to the path names"), ReadNames.FindRef(Player.Id), Player.Name);
+
+	// A record that was only partially written when the game closed
+	TArray<uint8> Truncated = Data;
+	Truncated.SetNum(Data.Num() - 5);
+	TestTrue(TEXT("Truncated files are read"), FCombatTelemetryFile::Read(Truncated, ReadNames, ReadRecords));
+	TestEqual(TEXT("Partially written records are ignored"), ReadRecords.Num(), Records.Num() - 1);
+	TestEqual(TEXT("The names before the partially written record are read"), ReadNames.Num(), 2);
+
+	TArray<uint8> WrongVersion = Data;
+	reinterpret_cast<FCombatTelemetryHeader*>(WrongVersion.GetData())->Version++;
+	TestFalse(TEXT("Files of other versions aren't read"), FCombatTelemetryFile::Read(WrongVersion, ReadNames, ReadRecords));
+	TestFalse(TEXT("Files without a header aren't read"), FCombatTelemetryFile::Read(TConstArrayView<uint8>(Data.GetData(), 4), ReadNames, ReadRecords));
+	return true;
+}
+
+
+#if SANDBOX_COMBAT_TELEMETRY
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTelemetryRecordingTest, "Sandbox.Combat.Telemetry.Recording", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCombatTelemetryRecordingTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* RecordingCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Sandbox.CombatTelemetry"));
+	if (!TestNotNull(TEXT("The recording console variable exists"), RecordingCVar)) return false;
+	const bool bWasRecording = RecordingCVar->GetBool();
+
+	// Write anything that was already recorded, so it isn't mixed in with the test's records
+	FCombatTelemetry::Flush(false);
+	TArray<FCombatTelemetryRecord> Records;
+
+	RecordingCVar->Set(false, ECVF_SetByCode);
+	FCombatTelemetry::RecordDeath(nullptr, nullptr, 0);
+	FCombatTelemetry::Drain(Records);
+	TestEqual(TEXT("Nothing is recorded while recording is disabled"), Records.Num(), 0);
+
+	RecordingCVar->Set(true, ECVF_SetByCode);
+	FCombatTelemetry::RecordDamage(nullptr, nullptr, 120, 30, 15, 50);
+	FCombatTelemetry::RecordStatus(nullptr, nullptr, EDamageChannel::Bleed, true, 80);
+	FCombatTelemetry::Drain(Records);
+	if (TestEqual(TEXT("Every event is recorded"), Records.Num(), 2))
+	{
+		TestTrue(TEXT("Damage is recorded"), Records[0].Event == ECombatTelemetryEvent::Damage);
+		TestEqual(TEXT("The damage values are recorded"), Records[0].Values[1], 30.0f);
+		TestTrue(TEXT("Missing characters are recorded as none"), Records[0].SourceId == MAX_uint32);
+		TestTrue(TEXT("The status channel is recorded"), Records[1].Detail == static_cast<uint8>(EDamageChannel::Bleed));
+		TestTrue(TEXT("The status proc is recorded"), Records[1].Extra == 1);
+	}
+
+	// Objects are added to the name table once, and keep their id
+	const UObject* Target = GetDefault<UObject>();
+	FCombatTelemetry::RecordDeath(nullptr, Target, 0);
+	FCombatTelemetry::RecordDeath(nullptr, Target, 0);
+	Records.Reset();
+	FCombatTelemetry::Drain(Records);
+	TArray<FCombatTelemetryName> Names;
+	FCombatTelemetry::DrainNames(Names);
+	if (TestEqual(TEXT("Both deaths are recorded"), Records.Num(), 2))
+	{
+		TestTrue(TEXT("An object keeps its id"), Records[0].TargetId == Records[1].TargetId && Records[0].TargetId == FCombatTelemetry::GetObjectId(Target));
+		const FCombatTelemetryName* Name = Names.FindByPredicate([&Records](const FCombatTelemetryName& Entry) { return Entry.Id == Records[0].TargetId; });
+		TestTrue(TEXT("The object's path name is added to the name table"), Name && Name->Name == Target->GetPathName());
+		TestEqual(TEXT("The object is only named once"), Names.FilterByPredicate([&Records](const FCombatTelemetryName& Entry) { return Entry.Id == Records[0].TargetId; }).Num(), 1);
+	}
+
+	// Records that don't fit in a full buffer are dropped instead of overwriting the oldest ones
+	const uint32 DroppedRecords = FCombatTelemetry::GetNumDroppedRecords();
+	for (uint32 Index = 0; Index < FCombatTelemetry::BufferCapacity + 3; Index++)
+	{
+		FCombatTelemetry::RecordDeath(nullptr, nullptr, Index);
+	}
+
+	Records.Reset();
+	FCombatTelemetry::Drain(Records);
+	TestEqual(TEXT("A full buffer keeps its records"), Records.Num(), static_cast<int32>(FCombatTelemetry::BufferCapacity));
+	TestEqual(TEXT("Records that don't fit are counted"), static_cast<int32>(FCombatTelemetry::GetNumDroppedRecords() - DroppedRecords), 3);
+	TestEqual(TEXT("The oldest records are kept"), Records.Num() > 0 ? Records[0].Values[0] : -1.0f, 0.0f);
+
+	RecordingCVar->Set(bWasRecording, ECVF_SetByCode);
+	return true;
+}
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Sandbox/Data/Enums/ESaveType.h"
+#include "Sandbox/Data/Save/CompactSaveArchive.h"
+#include "Sandbox/Data/Structs/InventoryInformation.h"
+#include "Sandbox/Data/Structs/LevelSaveInformation.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CompactSaveTests
+{
+	/** Level actors that were placed in the level, and actors that were spawned with guid ids */
+	TMap<FString, F_LevelSaveInformation_Actor> CreateLevelActors()
+	{
+		TMap<FString, F_LevelSaveInformation_Actor> Actors;
+		FRandomStream Random(100);
+		for (int32 Index = 0; Index < 100; Index++)
+		{
+			const bool bSpawnedActor = Index % 2 == 0;
+			F_LevelSaveInformation_Actor SaveInformation;
+			SaveInformation.Id = bSpawnedActor ? FGuid::NewGuid().ToString() : FString::Printf(TEXT("BP_WorldItem_C_%d"), Index);
+			SaveInformation.SaveType = bSpawnedActor ? ESaveIdType::SpawnedActor : ESaveIdType::LevelActor;
+			SaveInformation.Location = Random.GetUnitVector() * Random.FRandRange(-100000.0f, 100000.0f);
+			SaveInformation.Rotation = FRotator(0.0, Random.FRandRange(-180.0f, 180.0f), 0.0);
+			SaveInformation.Class = TSoftClassPtr<AActor>(FSoftObjectPath(FString::Printf(TEXT("/Game/Items/BP_Item_%d.BP_Item_%d_C"), Index % 8, Index % 8)));
+			SaveInformation.UpdateConfig(Index % 3 == 0, Index % 5 == 0, Index % 7 == 0);
+			Actors.Add(SaveInformation.Id, SaveInformation);
+		}
+
+		return Actors;
+	}
+
+	F_InventorySaveInformation CreateInventory()
+	{
+		F_InventorySaveInformation Inventory;
+		Inventory.NetId = -12;
+		Inventory.PlatformId = TEXT("Steam_76561198000000000");
+		for (int32 Index = 0; Index < 20; Index++)
+		{
+			FS_Item& Item = Inventory.InventoryItems.AddDefaulted_GetRef();
+			Item.Id = Index % 4 == 0 ? FGuid() : FGuid::NewGuid();
+			Item.ItemName = FName(*FString::Printf(TEXT("Item_%d"), Index % 6));
+			Item.SortOrder = Index - 5;
+		}
+
+		return Inventory;
+	}
+
+	/** Writes the level actors and inventory as a compact block */
+	TArray<uint8> WriteBlock(const TMap<FString, F_LevelSaveInformation_Actor>& Actors, const F_InventorySaveInformation& Inventory)
+	{
+		FCompactSaveWriter Writer;
+		CompactSave::WriteLevelActors(Writer, Actors);
+		CompactSave::WriteInventory(Writer, Inventory);
+
+		TArray<uint8> Data;
+		FMemoryWriter Archive(Data, true);
+		Writer.Finish(Archive);
+		return Data;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompactSaveRoundTripTest, "Sandbox.Save.CompactFormat.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCompactSaveRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace CompactSaveTests;
+
+	IConsoleVariable* CompressionCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Sandbox.Save.CompactCompression"));
+	if (!TestNotNull(TEXT("The compression console variable exists"), CompressionCVar)) return false;
+	const int32 PreviousCompression = CompressionCVar->GetInt();
+
+	const TMap<FString, F_LevelSaveInformation_Actor> Actors = CreateLevelActors();
+	const F_InventorySaveInformation Inventory = CreateInventory();
+	for (const int32 Compression : { 0, 1, 2 })
+	{
+		CompressionCVar->Set(Compression, ECVF_SetByCode);
+		const TArray<uint8> Data = WriteBlock(Actors, Inventory);
+
+		FMemoryReader Archive(Data, true);
+		FCompactSaveReader Reader;
+		if (!TestTrue(FString::Printf(TEXT("Compression %d: The block is read"), Compression), Reader.Begin(Archive))) continue;
+		TestEqual(FString::Printf(TEXT("Compression %d: The block is the latest version"), Compression), Reader.GetVersion(), static_cast<int32>(ECompactSaveVersion::Latest));
+
+		TMap<FString, F_LevelSaveInformation_Actor> ReadActors;
+		F_InventorySaveInformation ReadInventory;
+		CompactSave::ReadLevelActors(Reader, ReadActors);
+		CompactSave::ReadInventory(Reader, ReadInventory);
+		TestFalse(FString::Printf(TEXT("Compression %d: The payload is read without errors"), Compression), Reader.HasError());
+
+		// Locations are quantized to a hundredth of a unit, and rotations to 16 bits per axis
+		int32 Mismatches = Actors.Num() - ReadActors.Num();
+		for (const auto& [Id, Actor] : Actors)
+		{
+			const F_LevelSaveInformation_Actor* ReadActor = ReadActors.Find(Id);
+			if (!ReadActor
+				|| ReadActor->Id != Actor.Id
+				|| ReadActor->SaveType != Actor.SaveType
+				|| !ReadActor->Location.Equals(Actor.Location, 0.005 + UE_KINDA_SMALL_NUMBER)
+				|| !ReadActor->Rotation.Equals(Actor.Rotation, 360.0 / 65536.0)
+				|| ReadActor->Class != Actor.Class
+				|| ReadActor->ShouldSaveAttributes() != Actor.ShouldSaveAttributes()
+				|| ReadActor->ShouldSaveInventory() != Actor.ShouldSaveInventory()
+				|| ReadActor->ShouldSaveCombatInformation() != Actor.ShouldSaveCombatInformation())
+			{
+				Mismatches++;
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("Compression %d: The level actors are read back"), Compression), Mismatches, 0);
+		TestEqual(FString::Printf(TEXT("Compression %d: The inventory's net id is read back"), Compression), ReadInventory.NetId, Inventory.NetId);
+		TestEqual(FString::Printf(TEXT("Compression %d: The inventory's platform id is read back"), Compression), ReadInventory.PlatformId, Inventory.PlatformId);
+		if (TestEqual(FString::Printf(TEXT("Compression %d: Every item is read back"), Compression), ReadInventory.InventoryItems.Num(), Inventory.InventoryItems.Num()))
+		{
+			for (int32 Index = 0; Index < Inventory.InventoryItems.Num(); Index++)
+			{
+				const FS_Item& Item = Inventory.InventoryItems[Index];
+				const FS_Item& ReadItem = ReadInventory.InventoryItems[Index];
+				TestTrue(FString::Printf(TEXT("Compression %d: Item %d is read back"), Compression, Index), ReadItem.Id == Item.Id && ReadItem.ItemName == Item.ItemName && ReadItem.SortOrder == Item.SortOrder);
+			}
+		}
+	}
+
+	CompressionCVar->Set(PreviousCompression, ECVF_SetByCode);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompactSaveCorruptionTest, "Sandbox.Save.CompactFormat.Corruption", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FCompactSaveCorruptionTest::RunTest(const FString& Parameters)
+{
+	using namespace CompactSaveTests;
+
+	// Saves from before the compact format end after their tagged properties
+	{
+		TArray<uint8> Data = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		FMemoryReader Archive(Data, true);
+		FCompactSaveReader Reader;
+		TestFalse(TEXT("Legacy saves don't have a block"), Reader.Begin(Archive));
+		TestFalse(TEXT("Legacy saves aren't errors"), Reader.HasError());
+		TestEqual(TEXT("Legacy saves are left where the block would start"), Archive.Tell(), static_cast<int64>(0));
+	}
+
+	// A compressed block that claims to be much larger than its data could decompress to
+	AddExpectedError(TEXT("uncompressed size"), EAutomationExpectedErrorFlags::Contains, 2);
+	for (const int32 UncompressedSize : { 1 << 30, 64 * 1024 })
+	{
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data, true);
+		uint32 Magic = 0x43584253;
+		int32 Version = ECompactSaveVersion::Latest;
+		uint8 Compression = 1;
+		int32 Size = UncompressedSize;
+		TArray<uint8> Body = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		Writer << Magic << Version << Compression << Size << Body;
+
+		FMemoryReader Archive(Data, true);
+		FCompactSaveReader Reader;
+		TestFalse(FString::Printf(TEXT("A block that claims to be %d bytes isn't decompressed"), UncompressedSize), Reader.Begin(Archive));
+		TestTrue(FString::Printf(TEXT("A block that claims to be %d bytes is an error"), UncompressedSize), Reader.HasError());
+	}
+
+	// Reading past the end of a truncated payload flags an error instead of reading garbage
+	{
+		F_InventorySaveInformation Inventory = CreateInventory();
+		FCompactSaveWriter Writer;
+		CompactSave::WriteInventory(Writer, Inventory);
+		TArray<uint8> Data;
+		FMemoryWriter Archive(Data, true);
+		Writer.Finish(Archive);
+
+		FMemoryReader Reader(Data, true);
+		FCompactSaveReader CompactReader;
+		TestTrue(TEXT("The block is read"), CompactReader.Begin(Reader));
+
+		F_InventorySaveInformation ReadInventory;
+		CompactSave::ReadInventory(CompactReader, ReadInventory);
+		CompactReader.ReadPacked();
+		TestTrue(TEXT("Reading past the end of the payload is an error"), CompactReader.HasError());
+		TestEqual(TEXT("The items before the end are read"), ReadInventory.InventoryItems.Num(), Inventory.InventoryItems.Num());
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Sandbox/Asc/Effects/DamageCalculation_Default.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DamageCalculationTests
+{
+	/** Creates random attacks, including attacks that are weaker than the defences, and negations over 100 */
+	static void CreateAttacks(const int32 AttackCount, TArray<FDamageChannels>& OutChannels)
+	{
+		FRandomStream Random(AttackCount);
+		OutChannels.SetNum(AttackCount);
+		for (FDamageChannels& Channels : OutChannels)
+		{
+			for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+			{
+				Channels.Damage[Index] = Random.FRandRange(-10.0f, 1000.0f);
+				Channels.Defence[Index] = Random.FRandRange(0.0f, 400.0f);
+				Channels.Negation[Index] = Random.FRandRange(-20.0f, 120.0f);
+			}
+
+			for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+			{
+				Channels.Status[Index] = Random.FRandRange(0.0f, 200.0f);
+				Channels.Resistance[Index] = Random.FRandRange(0.0f, 150.0f);
+				Channels.StatusNegation[Index] = Random.FRandRange(0.0f, 100.0f);
+			}
+		}
+	}
+
+	/** Calculates an attack's channels one at a time with the scalar calculations */
+	static void CalculateScalarChannels(const UDamageCalculation_Default* DamageCalculation, const FDamageChannels& Channels, FDamageChannelResults& Results)
+	{
+		for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+		{
+			Results.Damage[Index] = DamageCalculation->DamageCalculation(Channels.Damage[Index], Channels.Defence[Index], Channels.Negation[Index]);
+		}
+
+		for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+		{
+			Results.Status[Index] = DamageCalculation->StatusCalculation(Channels.Status[Index], Channels.Resistance[Index], Channels.StatusNegation[Index]);
+		}
+	}
+
+	/** Returns the amount of channels that don't match exactly */
+	static int32 CountMismatches(const FDamageChannelResults& A, const FDamageChannelResults& B)
+	{
+		int32 Mismatches = 0;
+		for (int32 Index = 0; Index < FDamageChannels::NumDamageChannels; Index++)
+		{
+			if (FMemory::Memcmp(&A.Damage[Index], &B.Damage[Index], sizeof(float)) != 0) Mismatches++;
+		}
+
+		for (int32 Index = 0; Index < FDamageChannels::NumStatusChannels; Index++)
+		{
+			if (FMemory::Memcmp(&A.Status[Index], &B.Status[Index], sizeof(float)) != 0) Mismatches++;
+		}
+
+		return Mismatches;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageCalculationChannelsTest, "Sandbox.Combat.DamageCalculation.Channels", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FDamageCalculationChannelsTest::RunTest(const FString& Parameters)
+{
+	const UDamageCalculation_Default* DamageCalculation = GetDefault<UDamageCalculation_Default>();
+	TestTrue(TEXT("The default calculation uses the vectorized channels"), DamageCalculation->UsesDefaultChannelCalculations());
+
+	TArray<FDamageChannels> Attacks;
+	DamageCalculationTests::CreateAttacks(1000, Attacks);
+	for (int32 Attack = 0; Attack < Attacks.Num(); Attack++)
+	{
+		FDamageChannelResults Results;
+		UDamageCalculation_Default::CalculateDamageChannels(Attacks[Attack], Results);
+
+		// Every channel should match the scalar calculations exactly, so a hit deals the same damage either way
+		FDamageChannelResults ScalarResults;
+		DamageCalculationTests::CalculateScalarChannels(DamageCalculation, Attacks[Attack], ScalarResults);
+		if (!TestEqual(FString::Printf(TEXT("Attack %d's vectorized channels match the scalar calculations"), Attack), DamageCalculationTests::CountMismatches(ScalarResults, Results), 0))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+
+/** Times the scalar and vectorized calculations for a large batch of attacks. Only runs with the performance filter */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageCalculationChannelsTimingTest, "Sandbox.Combat.DamageCalculation.ChannelsTiming", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FDamageCalculationChannelsTimingTest::RunTest(const FString& Parameters)
+{
+	const UDamageCalculation_Default* DamageCalculation = GetDefault<UDamageCalculation_Default>();
+	TArray<FDamageChannels> Attacks;
+	DamageCalculationTests::CreateAttacks(100000, Attacks);
+
+	TArray<FDamageChannelResults> ScalarResults;
+	ScalarResults.SetNum(Attacks.Num());
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Attack = 0; Attack < Attacks.Num(); Attack++)
+	{
+		DamageCalculationTests::CalculateScalarChannels(DamageCalculation, Attacks[Attack], ScalarResults[Attack]);
+	}
+	const double ScalarTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TArray<FDamageChannelResults> VectorResults;
+	VectorResults.SetNum(Attacks.Num());
+	StartTime = FPlatformTime::Seconds();
+	UDamageCalculation_Default::CalculateDamageChannels(Attacks, VectorResults);
+	const double VectorTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	int32 Mismatches = 0;
+	for (int32 Attack = 0; Attack < Attacks.Num(); Attack++)
+	{
+		Mismatches += DamageCalculationTests::CountMismatches(ScalarResults[Attack], VectorResults[Attack]);
+	}
+
+	AddInfo(FString::Printf(TEXT("%d attacks, scalar: %.3f ms, vectorized: %.3f ms"), Attacks.Num(), ScalarTime, VectorTime));
+	TestEqual(TEXT("The batched vectorized channels match the scalar calculations"), Mismatches, 0);
+	return true;
+}
+
+#endif
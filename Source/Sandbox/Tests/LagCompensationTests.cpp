@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Sandbox/Combat/LagCompensationSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LagCompensationTests
+{
+	constexpr double RecordInterval = 1.0 / 30.0;
+	constexpr double MaxRewindTime = 0.4;
+	constexpr double ServerTime = 1.0;
+	constexpr float Tolerance = 40.0f;
+
+	/** A target that's strafing past the attacker at 600 cm/s */
+	FRewindFrame GetTargetFrame(const double Time)
+	{
+		FRewindFrame Frame;
+		Frame.Time = Time;
+		Frame.Transform = FTransform(FVector(150, 0, 90) + FVector(0, 600, 0) * Time);
+		Frame.Radius = 35;
+		Frame.HalfHeight = 90;
+		return Frame;
+	}
+
+	/** Records one second of the target's movement, with enough frames for the max rewind time */
+	FRewindHistory RecordTarget()
+	{
+		FRewindHistory History(FMath::CeilToInt(MaxRewindTime / RecordInterval) + 2);
+		for (double Time = 0; Time <= ServerTime + UE_KINDA_SMALL_NUMBER; Time += RecordInterval)
+		{
+			History.Record(GetTargetFrame(Time));
+		}
+
+		return History;
+	}
+
+	/** Hits the edge of the target the client saw, and returns the distance from the impact to the target after rewinding */
+	float GetRewoundDistance(const FRewindHistory& History, const double RewindOffset)
+	{
+		const double ClientTime = ServerTime - RewindOffset;
+		const FRewindFrame SeenFrame = GetTargetFrame(ClientTime);
+		const FVector ImpactPoint = SeenFrame.Transform.GetLocation() - FVector(SeenFrame.Radius, 0, 0);
+
+		FRewindFrame RewoundFrame;
+		History.Sample(ULagCompensationSubsystem::ClampRewindTime(ServerTime, ClientTime, MaxRewindTime), RewoundFrame);
+		return RewoundFrame.GetDistanceTo(ImpactPoint);
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLagCompensationRewindTimeTest, "Sandbox.Combat.LagCompensation.RewindTime", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLagCompensationRewindTimeTest::RunTest(const FString& Parameters)
+{
+	using namespace LagCompensationTests;
+
+	TestEqual(TEXT("Hits within the max rewind time are rewound to the client's time"), ULagCompensationSubsystem::ClampRewindTime(ServerTime, ServerTime - 0.15, MaxRewindTime), ServerTime - 0.15);
+	TestEqual(TEXT("Hits older than the max rewind time are clamped"), ULagCompensationSubsystem::ClampRewindTime(ServerTime, ServerTime - 0.6, MaxRewindTime), ServerTime - MaxRewindTime);
+	TestEqual(TEXT("Hits that waited on the client are rewound further by their age"), ULagCompensationSubsystem::ClampRewindTime(ServerTime, ServerTime - 0.6, MaxRewindTime + 0.3), ServerTime - 0.6);
+	TestEqual(TEXT("Hits ahead of the server aren't rewound"), ULagCompensationSubsystem::ClampRewindTime(ServerTime, ServerTime + 0.1, MaxRewindTime), ServerTime);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLagCompensationHistoryTest, "Sandbox.Combat.LagCompensation.History", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLagCompensationHistoryTest::RunTest(const FString& Parameters)
+{
+	using namespace LagCompensationTests;
+
+	const FRewindHistory History = RecordTarget();
+	TestEqual(TEXT("The history is full once it's recorded more frames than it holds"), History.Num(), History.GetCapacity());
+	TestTrue(TEXT("The newest frame is the last one that was recorded"), FMath::IsNearlyEqual(History.GetFrame(History.Num() - 1).Time, ServerTime, 0.001));
+
+	// Sampling between two frames blends them
+	FRewindFrame Frame;
+	const double Time = ServerTime - RecordInterval * 1.5;
+	TestTrue(TEXT("The history samples frames"), History.Sample(Time, Frame));
+	TestTrue(TEXT("Sampled frames are interpolated"), Frame.Transform.GetLocation().Equals(GetTargetFrame(Time).Transform.GetLocation(), 0.1));
+
+	// Times before the oldest frame use the oldest frame
+	History.Sample(0, Frame);
+	TestTrue(TEXT("Times before the history use the oldest frame"), FMath::IsNearlyEqual(Frame.Time, History.GetFrame(0).Time));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLagCompensationHitTest, "Sandbox.Combat.LagCompensation.Hits", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLagCompensationHitTest::RunTest(const FString& Parameters)
+{
+	using namespace LagCompensationTests;
+
+	const FRewindHistory History = RecordTarget();
+	for (const double RewindOffset : { 0.0, 0.05, 0.1, 0.25, MaxRewindTime })
+	{
+		TestTrue(FString::Printf(TEXT("A hit %.0f ms behind the server is accepted"), RewindOffset * 1000.0), GetRewoundDistance(History, RewindOffset) <= Tolerance);
+	}
+
+	// The target moves 120 cm in the 200 ms the hit is clamped by
+	TestFalse(TEXT("A hit 600 ms behind the server is rejected by the max rewind time"), GetRewoundDistance(History, 0.6) <= Tolerance);
+
+	// Without rewinding, the target has already moved past the impact
+	const FRewindFrame SeenFrame = GetTargetFrame(ServerTime - 0.2);
+	const FVector ImpactPoint = SeenFrame.Transform.GetLocation() - FVector(SeenFrame.Radius, 0, 0);
+	TestFalse(TEXT("A hit 200 ms behind the server is rejected without rewinding"), GetTargetFrame(ServerTime).GetDistanceTo(ImpactPoint) <= Tolerance);
+	return true;
+}
+
+#endif
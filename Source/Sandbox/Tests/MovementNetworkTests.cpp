@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Sandbox/Characters/Components/AdvancedMovement/AdvancedMovementComponent.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MovementNetworkTests
+{
+	using FMoveData = UAdvancedMovementComponent::FMCharacterNetworkMoveData;
+
+	/** A move at a location that survives the location's own quantization */
+	void InitMove(FMoveData& Move, const float TimeStamp, const FVector2D& Input)
+	{
+		Move.TimeStamp = TimeStamp;
+		Move.Location = FVector(1200.25, -340.5, 96.75);
+		Move.Acceleration = FVector(2048, 0, 0);
+		Move.ControlRotation = FRotator(0, 90, 0);
+		Move.MovementMode = MOVE_Walking;
+		Move.MoveData_Input = Input;
+		Move.MoveData_LedgeClimbLocation = FVector_NetQuantize10::ZeroVector;
+		Move.MoveData_MantleLocation = FVector_NetQuantize10::ZeroVector;
+	}
+
+	/** Sends the client's new, pending and old moves to the server in one packet, and returns the amount of bits that were sent */
+	int64 SendPacket(UAdvancedMovementComponent& Client, UAdvancedMovementComponent& Server)
+	{
+		FBitWriter Writer(0, true);
+		Client.CustomMoveDataContainer.Serialize(Client, Writer, nullptr);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		Server.CustomMoveDataContainer.Serialize(Server, Reader, nullptr);
+		return Writer.GetNumBits();
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovementNetworkMoveDataTest, "Sandbox.Movement.Network.MoveData", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FMovementNetworkMoveDataTest::RunTest(const FString& Parameters)
+{
+	using namespace MovementNetworkTests;
+
+	UAdvancedMovementComponent* Client = NewObject<UAdvancedMovementComponent>();
+	UAdvancedMovementComponent* Server = NewObject<UAdvancedMovementComponent>();
+	UAdvancedMovementComponent::FMCharacterNetworkMoveDataContainer& ClientMoves = Client->CustomMoveDataContainer;
+	UAdvancedMovementComponent::FMCharacterNetworkMoveDataContainer& ServerMoves = Server->CustomMoveDataContainer;
+	const float InputPrecision = 0.5f / 127.0f;
+
+	// The old and pending moves keep the same input, and only the new move changes it
+	ClientMoves.bHasOldMove = true;
+	ClientMoves.bHasPendingMove = true;
+	InitMove(ClientMoves.CustomDefaultMoveData[2], 1.0f, FVector2D(1, 0));
+	InitMove(ClientMoves.CustomDefaultMoveData[1], 1.1f, FVector2D(1, 0));
+	InitMove(ClientMoves.CustomDefaultMoveData[0], 1.2f, FVector2D(0.53, -0.31));
+
+	// A ledge next to the character, and a mantle that's too far away to be sent relative to it
+	FMoveData& NewMove = ClientMoves.CustomDefaultMoveData[0];
+	NewMove.MoveData_LedgeClimbLocation = NewMove.Location + FVector(60.3, -12.6, 140.9);
+	NewMove.MoveData_MantleLocation = NewMove.Location + FVector(900, 0, 0);
+	const FVector_NetQuantize10 LedgeClimbLocation = NewMove.MoveData_LedgeClimbLocation;
+	const FVector_NetQuantize10 MantleLocation = NewMove.MoveData_MantleLocation;
+
+	const int64 PacketBits = SendPacket(*Client, *Server);
+	TestTrue(TEXT("The old move is received"), ServerMoves.bHasOldMove);
+	TestTrue(TEXT("The pending move is received"), ServerMoves.bHasPendingMove);
+	TestTrue(TEXT("The old move's keyboard input is exact"), ServerMoves.CustomDefaultMoveData[2].MoveData_Input == FVector2D(1, 0));
+	TestTrue(TEXT("The pending move's input is elided and copied from the old move"), ServerMoves.CustomDefaultMoveData[1].MoveData_Input == FVector2D(1, 0));
+	TestEqual(TEXT("The pending move's time stamp is received"), ServerMoves.CustomDefaultMoveData[1].TimeStamp, 1.1f);
+
+	const FMoveData& ReceivedMove = ServerMoves.CustomDefaultMoveData[0];
+	TestTrue(TEXT("Analog input is within 8 bit precision"), ReceivedMove.MoveData_Input.Equals(FVector2D(0.53, -0.31), InputPrecision));
+	TestTrue(TEXT("The client predicts with the input the server receives"), NewMove.MoveData_Input == ReceivedMove.MoveData_Input);
+	TestTrue(TEXT("Ledge targets are sent relative to the character at a quarter unit precision"), ReceivedMove.MoveData_LedgeClimbLocation.Equals(LedgeClimbLocation, 0.125 + 0.01));
+	TestTrue(TEXT("Targets that are too far away are sent as full locations"), ReceivedMove.MoveData_MantleLocation.Equals(MantleLocation, 0.1));
+	TestTrue(TEXT("Missing targets stay empty"), ServerMoves.CustomDefaultMoveData[2].MoveData_LedgeClimbLocation.IsZero());
+
+	// Moves with the same input and targets as the previous move only send a bit for each of them
+	InitMove(ClientMoves.CustomDefaultMoveData[2], 2.0f, FVector2D(0.53, -0.31));
+	InitMove(ClientMoves.CustomDefaultMoveData[1], 2.1f, FVector2D(0.53, -0.31));
+	InitMove(ClientMoves.CustomDefaultMoveData[0], 2.2f, FVector2D(0.53, -0.31));
+	const int64 ElidedPacketBits = SendPacket(*Client, *Server);
+	TestTrue(TEXT("Unchanged input and targets are elided"), ElidedPacketBits < PacketBits);
+	TestTrue(TEXT("Elided input is copied from the previous move"), ServerMoves.CustomDefaultMoveData[0].MoveData_Input.Equals(FVector2D(0.53, -0.31), InputPrecision));
+	TestTrue(TEXT("Targets from the previous packet aren't used as a baseline"), ServerMoves.CustomDefaultMoveData[0].MoveData_LedgeClimbLocation.IsZero());
+	return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Sandbox/Characters/Components/AdvancedMovement/MovementSimulation.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+/**
+ * Simulates every recording in the project's Tests/MovementSimulation folder in the map it was recorded in, and fails if it diverged from its golden trace.
+ * Recordings are only simulated in game worlds, run these with -game -nullrhi -ExecCmds="Automation RunTests Sandbox.Movement.Simulation"
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMovementSimulationTest, "Sandbox.Movement.Simulation", EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+void FMovementSimulationTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(FMovementRecording::GetDirectory() / TEXT("*.msim")), true, false);
+	for (const FString& File : Files)
+	{
+		OutBeautifiedNames.Add(FPaths::GetBaseFilename(File));
+		OutTestCommands.Add(FPaths::GetBaseFilename(File));
+	}
+
+	// Fail instead of quietly skipping the movement checks when the recordings are missing
+	if (Files.IsEmpty())
+	{
+		OutBeautifiedNames.Add(TEXT("MissingRecordings"));
+		OutTestCommands.Add(FString());
+	}
+}
+
+bool FMovementSimulationTest::RunTest(const FString& Parameters)
+{
+	if (Parameters.IsEmpty())
+	{
+		AddError(FString::Printf(TEXT("There aren't any movement recordings in %s, record one on a simple geometry map with Sandbox.Movement.Record"), *FMovementRecording::GetDirectory()));
+		return false;
+	}
+
+	FMovementRecording Recording;
+	if (!Recording.Load(Parameters))
+	{
+		AddError(FString::Printf(TEXT("Failed to load the %s recording"), *Parameters));
+		return false;
+	}
+
+	// Simulating without a golden trace would save one instead of checking the movement
+	if (Recording.GoldenTrace.IsEmpty())
+	{
+		AddError(FString::Printf(TEXT("The %s recording doesn't have a golden trace, simulate it with Sandbox.Movement.Simulate to save one"), *Parameters));
+		return false;
+	}
+
+	if (!Recording.MapName.IsEmpty())
+	{
+		AutomationOpenMap(Recording.MapName);
+	}
+
+	const FString Name = Parameters;
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Name]()
+	{
+		UWorld* World = AutomationCommon::GetAnyGameWorld();
+		if (TestNotNull(TEXT("The recording is simulated in a game world"), World))
+		{
+			TestTrue(FString::Printf(TEXT("The %s recording matches its golden trace"), *Name), FMovementSimulation::Simulate(World, Name, false));
+		}
+
+		return true;
+	}));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovementRecordingFileTest, "Sandbox.Movement.Simulation.Files", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FMovementRecordingFileTest::RunTest(const FString& Parameters)
+{
+	FMovementRecording Recording;
+	Recording.CharacterClass = FSoftClassPath(TEXT("/Script/Engine.Character"));
+	Recording.MapName = TEXT("/Game/Maps/Sandbox");
+	Recording.StartLocation = FVector(100, -200, 90);
+	Recording.StartRotation = FRotator(0, 45, 0);
+	Recording.TimeStep = 1.0f / 60.0f;
+	for (int32 Index = 0; Index < 4; Index++)
+	{
+		FMovementInputFrame& Frame = Recording.Frames.AddDefaulted_GetRef();
+		Frame.InputVector = FVector(1, Index * 0.25, 0);
+		Frame.Yaw = Index * 10.0f;
+		Recording.GoldenTrace.Add(Recording.StartLocation + FVector(Index * 10.0, 0, 0));
+	}
+
+	const FString Name = TEXT("AutomationTest_Files");
+	if (!TestTrue(TEXT("The recording is saved"), Recording.Save(Name))) return false;
+
+	FMovementRecording Loaded;
+	TestTrue(TEXT("The recording is loaded"), Loaded.Load(Name));
+	TestTrue(TEXT("The character class is loaded"), Loaded.CharacterClass == Recording.CharacterClass);
+	TestEqual(TEXT("The map is loaded"), Loaded.MapName, Recording.MapName);
+	TestTrue(TEXT("The start location is loaded"), Loaded.StartLocation.Equals(Recording.StartLocation));
+	TestEqual(TEXT("The time step is loaded"), Loaded.TimeStep, Recording.TimeStep);
+	TestEqual(TEXT("Every frame is loaded"), Loaded.Frames.Num(), Recording.Frames.Num());
+	TestTrue(TEXT("The golden trace is loaded"), Loaded.GoldenTrace == Recording.GoldenTrace);
+
+	IFileManager::Get().Delete(*FMovementRecording::GetPath(Name));
+	return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Sandbox/Characters/Components/AdvancedMovement/AdvancedMovementComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovementTraceSharingTest, "Sandbox.Movement.Traces.Sharing", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FMovementTraceSharingTest::RunTest(const FString& Parameters)
+{
+	const FVector Start(0, 0, 50);
+	const FVector End(100, 0, 50);
+	constexpr uint64 Frame = 10;
+
+	// A wall hit against a static object
+	FMovementTraceResult Trace;
+	Trace.Start = Start;
+	Trace.End = End;
+	Trace.Radius = 0;
+	Trace.bObjectQuery = true;
+	Trace.Frame = Frame;
+	Trace.Hit = FHitResult(Start, End);
+	Trace.Hit.bBlockingHit = true;
+
+	TestTrue(TEXT("Identical probes on the same frame share the trace"), Trace.Matches(Start, End, 0, true, Frame));
+	TestTrue(TEXT("Probes within the tolerance share the trace"), Trace.Matches(Start + FVector(0.05), End, 0, true, Frame));
+	TestFalse(TEXT("Blocking hits aren't reused on the next frame, something could have moved in front of them"), Trace.Matches(Start, End, 0, true, Frame + 1));
+	TestFalse(TEXT("Probes with another end are traced"), Trace.Matches(Start, End + FVector(0, 0, 1), 0, true, Frame));
+	TestFalse(TEXT("Sweeps don't share line traces"), Trace.Matches(Start, End, 34, true, Frame));
+	TestFalse(TEXT("Channel traces don't share object traces"), Trace.Matches(Start, End, 0, false, Frame));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovementTraceRevalidationTest, "Sandbox.Movement.Traces.Revalidation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FMovementTraceRevalidationTest::RunTest(const FString& Parameters)
+{
+	const FVector Start(0, 0, 50);
+	const FVector End(100, 0, 50);
+	constexpr uint64 Frame = 10;
+
+	// The wall needs to be registered in a world for its hits to be revalidated
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MovementTraceTests"));
+	GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+	AStaticMeshActor* Wall = World->SpawnActor<AStaticMeshActor>(FVector(100, 0, 0), FRotator::ZeroRotator);
+	if (TestNotNull(TEXT("The wall spawned"), Wall))
+	{
+		UStaticMeshComponent* WallComponent = Wall->GetStaticMeshComponent();
+		WallComponent->SetMobility(EComponentMobility::Static);
+
+		// A wall hit from the previous frame
+		FMovementTraceResult Trace;
+		Trace.Start = Start;
+		Trace.End = End;
+		Trace.Radius = 0;
+		Trace.bObjectQuery = true;
+		Trace.Frame = Frame - 1;
+		Trace.Hit = FHitResult(Wall, WallComponent, FVector(90, 0, 50), FVector(-1, 0, 0));
+		Trace.Hit.bBlockingHit = true;
+		Trace.Hit.Distance = 90;
+
+		TestTrue(TEXT("Static hits from the previous frame are revalidated"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+		TestFalse(TEXT("Static hits aren't shared without revalidating them"), Trace.Matches(Start, End, 0, true, Frame));
+		TestFalse(TEXT("Hits from older frames are traced"), Trace.CanRevalidate(Start, End, 0, true, Frame + 1));
+		TestFalse(TEXT("Probes with another end are traced"), Trace.CanRevalidate(Start, End + FVector(0, 0, 1), 0, true, Frame));
+
+		Trace.Hit.bStartPenetrating = true;
+		TestFalse(TEXT("Probes that started inside of the wall are traced"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+		Trace.Hit.bStartPenetrating = false;
+
+		Trace.Hit.bBlockingHit = false;
+		TestFalse(TEXT("Misses are traced, anything could have moved into the path"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+		Trace.Hit.bBlockingHit = true;
+
+		WallComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		TestFalse(TEXT("Walls without collision are traced"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+		WallComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+		WallComponent->SetMobility(EComponentMobility::Movable);
+		TestFalse(TEXT("Hits against movable objects are traced"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+		WallComponent->SetMobility(EComponentMobility::Static);
+
+		Wall->Destroy();
+		TestFalse(TEXT("Hits against destroyed walls are traced"), Trace.CanRevalidate(Start, End, 0, true, Frame));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Sandbox/AI/Significance/NpcSignificanceSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NpcSignificanceTests
+{
+	float GetDistance(const TCHAR* Name)
+	{
+		const IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(Name);
+		return CVar ? CVar->GetFloat() : 0.0f;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNpcSignificanceTierTest, "Sandbox.AI.Significance.Tiers", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FNpcSignificanceTierTest::RunTest(const FString& Parameters)
+{
+	using namespace NpcSignificanceTests;
+
+	const float CriticalDistance = GetDistance(TEXT("Sandbox.Significance.CriticalDistance"));
+	const float HighDistance = GetDistance(TEXT("Sandbox.Significance.HighDistance"));
+	const float MediumDistance = GetDistance(TEXT("Sandbox.Significance.MediumDistance"));
+	if (!TestTrue(TEXT("The tier distances increase"), 0 < CriticalDistance && CriticalDistance < HighDistance && HighDistance < MediumDistance)) return false;
+
+	TestTrue(TEXT("Npcs next to a player are critical"), UNpcSignificanceSubsystem::CalculateSignificanceTier(CriticalDistance * 0.5, true, false) == ENpcSignificance::Critical);
+	TestTrue(TEXT("Npcs next to a player are critical while they aren't visible"), UNpcSignificanceSubsystem::CalculateSignificanceTier(CriticalDistance * 0.5, false, false) == ENpcSignificance::Critical);
+	TestTrue(TEXT("Npcs in combat are critical at any distance"), UNpcSignificanceSubsystem::CalculateSignificanceTier(MediumDistance * 10, false, true) == ENpcSignificance::Critical);
+	TestTrue(TEXT("Visible npcs within the high distance are high"), UNpcSignificanceSubsystem::CalculateSignificanceTier((CriticalDistance + HighDistance) * 0.5, true, false) == ENpcSignificance::High);
+	TestTrue(TEXT("Visible npcs within the medium distance are medium"), UNpcSignificanceSubsystem::CalculateSignificanceTier((HighDistance + MediumDistance) * 0.5, true, false) == ENpcSignificance::Medium);
+	TestTrue(TEXT("Npcs past the medium distance are low"), UNpcSignificanceSubsystem::CalculateSignificanceTier(MediumDistance * 2, true, false) == ENpcSignificance::Low);
+	TestTrue(TEXT("Npcs without any players are low"), UNpcSignificanceSubsystem::CalculateSignificanceTier(TNumericLimits<double>::Max(), true, false) == ENpcSignificance::Low);
+
+	// Hidden npcs drop a tier, but never below low
+	TestTrue(TEXT("Hidden npcs within the high distance are medium"), UNpcSignificanceSubsystem::CalculateSignificanceTier((CriticalDistance + HighDistance) * 0.5, false, false) == ENpcSignificance::Medium);
+	TestTrue(TEXT("Hidden npcs past the medium distance stay low"), UNpcSignificanceSubsystem::CalculateSignificanceTier(MediumDistance * 2, false, false) == ENpcSignificance::Low);
+
+	// Npcs just past the edge of their tier keep it until they're further than the hysteresis
+	const double PastHighDistance = HighDistance * 1.05;
+	TestTrue(TEXT("Npcs just past the high distance are medium when moving up"), UNpcSignificanceSubsystem::CalculateSignificanceTier(PastHighDistance, true, false) == ENpcSignificance::Medium);
+	TestTrue(TEXT("Npcs just past the high distance stay high when dropping a tier"), UNpcSignificanceSubsystem::CalculateSignificanceTier(PastHighDistance, true, false, true) == ENpcSignificance::High);
+	TestTrue(TEXT("Npcs well past the high distance drop a tier"), UNpcSignificanceSubsystem::CalculateSignificanceTier(HighDistance * 1.5, true, false, true) == ENpcSignificance::Medium);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNpcSignificanceSightTest, "Sandbox.AI.Significance.Sight", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FNpcSignificanceSightTest::RunTest(const FString& Parameters)
+{
+	using namespace NpcSignificanceTests;
+
+	const float HighDistance = GetDistance(TEXT("Sandbox.Significance.HighDistance"));
+	const float MediumDistance = GetDistance(TEXT("Sandbox.Significance.MediumDistance"));
+
+	// Hidden npcs drop a tier, but their sight only depends on the distance
+	const double BetweenHighAndMedium = (HighDistance + MediumDistance) * 0.5;
+	TestTrue(TEXT("Hidden npcs within the medium distance are low"), UNpcSignificanceSubsystem::CalculateSignificanceTier(BetweenHighAndMedium, false, false) == ENpcSignificance::Low);
+	TestTrue(TEXT("Npcs within the medium distance can see"), UNpcSignificanceSubsystem::CalculateSightEnabled(BetweenHighAndMedium, false));
+	TestFalse(TEXT("Npcs past the medium distance can't see"), UNpcSignificanceSubsystem::CalculateSightEnabled(MediumDistance * 2, false));
+	TestFalse(TEXT("Npcs without any players can't see"), UNpcSignificanceSubsystem::CalculateSightEnabled(TNumericLimits<double>::Max(), false));
+	TestTrue(TEXT("Npcs in combat can see at any distance"), UNpcSignificanceSubsystem::CalculateSightEnabled(MediumDistance * 10, true));
+
+	// Npcs keep their sight just past the medium distance
+	const double PastMediumDistance = MediumDistance * 1.05;
+	TestFalse(TEXT("Npcs just past the medium distance don't start seeing"), UNpcSignificanceSubsystem::CalculateSightEnabled(PastMediumDistance, false, false));
+	TestTrue(TEXT("Npcs just past the medium distance keep seeing"), UNpcSignificanceSubsystem::CalculateSightEnabled(PastMediumDistance, false, true));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNpcSignificanceSettingsTest, "Sandbox.AI.Significance.Settings", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FNpcSignificanceSettingsTest::RunTest(const FString& Parameters)
+{
+	const FNpcSignificanceSettings& Critical = FNpcSignificanceSettings::Get(ENpcSignificance::Critical);
+	const FNpcSignificanceSettings& High = FNpcSignificanceSettings::Get(ENpcSignificance::High);
+	TestFalse(TEXT("Critical npcs don't skip animation frames"), Critical.bUpdateRateOptimizations);
+	TestEqual(TEXT("Critical npcs animate every frame while they aren't rendered"), Critical.NonRenderedAnimationUpdateRate, 1);
+	TestEqual(TEXT("High npcs animate every frame while they aren't rendered"), High.NonRenderedAnimationUpdateRate, 1);
+	TestEqual(TEXT("Critical npcs tick every frame"), Critical.ActorTickInterval + Critical.AnimationTickInterval + Critical.MovementTickInterval + Critical.AITickInterval, 0.0f);
+
+	// Every tier should update at most as often as the tier above it
+	for (int32 Index = 1; Index < static_cast<int32>(ENpcSignificance::Max); Index++)
+	{
+		const FNpcSignificanceSettings& Previous = FNpcSignificanceSettings::Get(static_cast<ENpcSignificance>(Index - 1));
+		const FNpcSignificanceSettings& Settings = FNpcSignificanceSettings::Get(static_cast<ENpcSignificance>(Index));
+		TestTrue(FString::Printf(TEXT("Tier %d updates less often than the tier above it"), Index),
+			Settings.ActorTickInterval >= Previous.ActorTickInterval && Settings.AnimationTickInterval >= Previous.AnimationTickInterval
+			&& Settings.NonRenderedAnimationUpdateRate >= Previous.NonRenderedAnimationUpdateRate && Settings.MovementTickInterval >= Previous.MovementTickInterval
+			&& Settings.AITickInterval >= Previous.AITickInterval);
+	}
+
+	TestTrue(TEXT("Significances past low use the low settings"), &FNpcSignificanceSettings::Get(ENpcSignificance::Max) == &FNpcSignificanceSettings::Get(ENpcSignificance::Low));
+	return true;
+}
+
+#endif
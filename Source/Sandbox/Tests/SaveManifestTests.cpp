@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Sandbox/Game/GameModeSaveLogic.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveManifestUrlTest, "Sandbox.Saving.Manifest.SaveUrls", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FSaveManifestUrlTest::RunTest(const FString& Parameters)
+{
+	const FString Slot1 = TEXT("Adventure_Character1_S1");
+	const FString Slot10 = TEXT("Adventure_Character1_S10");
+
+	TestTrue(TEXT("A base url belongs to itself"), AGameModeSaveLogic::IsSaveUrlOf(Slot1, Slot1));
+	TestTrue(TEXT("Level saves belong to their base url"), AGameModeSaveLogic::IsSaveUrlOf(Slot1 + TEXT("_Level_3"), Slot1));
+	TestTrue(TEXT("Slot 10's level saves belong to slot 10"), AGameModeSaveLogic::IsSaveUrlOf(Slot10 + TEXT("_Level_3"), Slot10));
+	TestFalse(TEXT("Slot 10 doesn't belong to slot 1"), AGameModeSaveLogic::IsSaveUrlOf(Slot10, Slot1));
+	TestFalse(TEXT("Slot 10's level saves don't belong to slot 1"), AGameModeSaveLogic::IsSaveUrlOf(Slot10 + TEXT("_Level_3"), Slot1));
+	TestFalse(TEXT("Slot 1 doesn't belong to slot 10"), AGameModeSaveLogic::IsSaveUrlOf(Slot1, Slot10));
+	TestFalse(TEXT("Nothing belongs to an empty base url"), AGameModeSaveLogic::IsSaveUrlOf(Slot1, FString()));
+	return true;
+}
+
+#endif
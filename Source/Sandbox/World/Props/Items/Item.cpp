@@ -4,6 +4,7 @@
 #include "Sandbox/World/Props/Items/Item.h"
 
 #include "Sandbox/Characters/Components/Inventory/InventoryComponent.h"
+#include "Sandbox/Data/Catalog/ItemCatalogSubsystem.h"
 #include "Logging/StructuredLog.h"
 #include "Net/UnrealNetwork.h"
 
@@ -90,12 +91,13 @@ void AItem::SetItemInformationDatabase_Implementation(UDataTable* Database) { It
 
 bool AItem::RetrieveItemFromDataTable(const FName Id, F_Item& ItemData)
 {
-	if (ItemInformationTable)
+	UItemCatalogSubsystem* CatalogSubsystem = UItemCatalogSubsystem::Get();
+	const TSharedPtr<const FItemCatalog> Catalog = CatalogSubsystem ? CatalogSubsystem->GetItemCatalog(ItemInformationTable) : nullptr;
+	if (Catalog.IsValid())
 	{
-		const FString RowContext(TEXT("Item Information Context"));
-		if (const FInventory_ItemDatabase* Data = ItemInformationTable->FindRow<FInventory_ItemDatabase>(Id, RowContext))
+		if (const F_Item* Data = Catalog->Find(Id))
 		{
-			ItemData = Data->ItemInformation;
+			ItemData = *Data;
 			return true;
 		}
 		
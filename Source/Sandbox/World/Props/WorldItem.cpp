@@ -4,6 +4,7 @@
 #include "Sandbox/World/Props/WorldItem.h"
 
 #include "Sandbox/Data/Enums/CollisionChannels.h"
+#include "Sandbox/Game/Saving/SaveableActorRegistry.h"
 
 AWorldItem::AWorldItem()
 {
@@ -31,6 +32,28 @@ void AWorldItem::BeginPlay()
 {
 	Super::BeginPlay();
 	OnSpawnedInWorld();
+
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->RegisterActor(this);
+	}
+}
+
+
+void AWorldItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Items that were spawned during play aren't respawned once they've been picked up or destroyed
+	if (EndPlayReason == EEndPlayReason::Destroyed && !ActorSaveLevelId.IsEmpty())
+	{
+		MarkLevelSaveRemoved(this);
+	}
+
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->UnregisterActor(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -103,7 +126,7 @@ F_LevelSaveInformation_Actor AWorldItem::SaveToLevel_Implementation()
 	SavedInformation.Location = GetActorLocation();
 	SavedInformation.Actor = this;
 	SavedInformation.Rotation = GetActorRotation();
-	SavedInformation.Class = GetClass()->StaticClass();
+	SavedInformation.Class = GetClass();
 	SavedInformation.UpdateConfig(false, false, false);
 
 	Execute_OnSaveToLevel(this, SavedInformation);
@@ -153,6 +176,12 @@ FString AWorldItem::GetActorLevelId_Implementation() const
 void AWorldItem::SetActorSaveLevelId(const FString& Id)
 {
 	ActorSaveLevelId = Id;
+	if (USaveableActorRegistry* SaveableActorRegistry = USaveableActorRegistry::Get(this))
+	{
+		SaveableActorRegistry->UpdateActorId(this);
+	}
+	
+	MarkLevelSaveDirty(this);
 }
 #pragma endregion
 
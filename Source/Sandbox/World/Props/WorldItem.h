@@ -36,6 +36,9 @@ public:
 	/** Overridable native event for when play begins for this actor. */
 	virtual void BeginPlay() override;
 
+	/** Removes spawned items from the level's save once they've been destroyed, and unregisters the item from the saveable actors */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * Function that needs to be called when the object has been spawned in the world. Used for initializing information specific to the item. \n\n
 	 * Initially intended for creating an Id for saving if it wasn't one that was spawned in the world already. \n  
@@ -103,7 +106,7 @@ public:
 	/**
 	 * Utility function for setting the ActorSaveLevelId when the inventory item is spawned in the world.
 	 *
-	 * This should be called when you spawn an actor during play that needs to be saved
+	 * This should be called when you spawn an actor during play that needs to be saved, and marks the item's level save information as changed
 	 * @note TODO: This is hacky
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Level|Saving") virtual void SetActorSaveLevelId(const FString& Id); 
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Decodes combat telemetry files (Saved/Telemetry/Combat_<Time>.ctel) without the engine.
+
+The layout matches FCombatTelemetryFile in Source/Sandbox/Combat/CombatTelemetry.h. Keep the two in sync, and update the
+version in both when the layout changes.
+
+    python Tools/DecodeCombatTelemetry.py <File.ctel> [--records 100] [--csv Out.csv]
+"""
+
+import argparse
+import csv
+import struct
+import sys
+from collections import Counter
+
+MAGIC = 0x4C455443  # 'CTEL'
+VERSION = 2
+HEADER = struct.Struct("<IHH")
+RECORD = struct.Struct("<BBBBIII4f")
+NO_OBJECT = 0xFFFFFFFF
+
+EVENTS = ["Damage", "Status", "PoiseBreak", "Death"]
+DAMAGE_CHANNELS = ["Standard", "Slash", "Pierce", "Strike", "Magic", "Ice", "Fire", "Holy", "Lightning",
+                   "Curse", "Bleed", "Poison", "Frostbite", "Madness", "Sleep", "Poise"]
+HIT_STUNS = ["None", "VeryShort", "Short", "Medium", "Long", "Knockdown", "FrontFlip"]
+HIT_DIRECTIONS = ["None", "Left", "Front", "Right", "Back"]
+
+
+def enum_name(names, value):
+    return names[value] if value < len(names) else str(value)
+
+
+def read(data):
+    """Returns the name table and records of a file. A partially written block at the end of the file is ignored"""
+    if len(data) < HEADER.size:
+        raise ValueError("The file is too small to be a combat telemetry file")
+
+    magic, version, record_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        raise ValueError(f"The file isn't a version {VERSION} combat telemetry file (version {version})")
+
+    names, records = {}, []
+    offset = HEADER.size
+    while offset + 4 <= len(data):
+        (num_names,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        for _ in range(num_names):
+            if offset + 6 > len(data):
+                return names, records
+            object_id, length = struct.unpack_from("<IH", data, offset)
+            offset += 6
+            if offset + length > len(data):
+                return names, records
+            names[object_id] = data[offset:offset + length].decode("utf-8", "replace")
+            offset += length
+
+        if offset + 4 > len(data):
+            break
+        (num_records,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        whole_records = min(num_records, (len(data) - offset) // RECORD.size)
+        for _ in range(whole_records):
+            records.append(RECORD.unpack_from(data, offset))
+            offset += RECORD.size
+        if whole_records < num_records:
+            break
+
+    return names, records
+
+
+def describe(record):
+    event, detail, extra, _, _, _, _, v0, v1, v2, v3 = record
+    if event == 0:
+        return f"Damage: {v0:.1f}, Magic: {v1:.1f}, Poise: {v2:.1f}, Health: {v3:.1f}"
+    if event == 1:
+        return f"{enum_name(DAMAGE_CHANNELS, detail)}{' (Proc)' if extra else ''}: {v0:.1f}"
+    if event == 2:
+        return f"{enum_name(HIT_STUNS, detail)} {enum_name(HIT_DIRECTIONS, extra)}, Poise: {v0:.1f}"
+    return f"Health: {v0:.1f}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", help="The .ctel file")
+    parser.add_argument("--records", type=int, default=100, help="How many records to print (default 100)")
+    parser.add_argument("--csv", help="Writes every record to a csv file")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as file:
+        data = file.read()
+
+    try:
+        names, records = read(data)
+    except ValueError as error:
+        print(f"{args.file}: {error}", file=sys.stderr)
+        return 1
+
+    def name(object_id):
+        return "None" if object_id == NO_OBJECT else names.get(object_id, f"#{object_id}")
+
+    for record in records[:args.records]:
+        event, frame, source, target = record[0], record[4], record[5], record[6]
+        print(f"[{frame}] {enum_name(EVENTS, event)}: {name(source)} -> {name(target)}, {describe(record)}")
+
+    events = Counter(enum_name(EVENTS, record[0]) for record in records)
+    procs = Counter(enum_name(DAMAGE_CHANNELS, record[1]) for record in records if record[0] == 1 and record[2])
+    damage = [sum(record[7 + index] for record in records if record[0] == 0) for index in range(3)]
+    print(f"{args.file}: {len(records)} records, {len(names)} characters, {events['Damage']} hits "
+          f"({damage[0]:.1f} damage, {damage[1]:.1f} magic damage, {damage[2]:.1f} poise damage), "
+          f"{events['Status']} status events, {events['PoiseBreak']} poise breaks, {events['Death']} deaths. "
+          f"Procs: {', '.join(f'{status}({count})' for status, count in procs.items()) or 'None'}")
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as file:
+            writer = csv.writer(file)
+            writer.writerow(["Frame", "Event", "Source", "Target", "Detail", "Extra", "Value0", "Value1", "Value2", "Value3"])
+            for record in records:
+                event, detail, extra, _, frame, source, target, *values = record
+                writer.writerow([frame, enum_name(EVENTS, event), name(source), name(target), detail, extra, *values])
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())